@@ -138,6 +138,18 @@ int main(int argc, char* argv[]) {
 				"gen-travel-times-app: Using FileExtension: " + extension);
 	}
 
+	// number of threads
+	int numThreads = 0;
+	if (genConfig->getConfigJSON().HasKey("NumThreads")
+			&& ((genConfig->getConfigJSON())["NumThreads"].GetType()
+					== json::ValueType::IntVal)) {
+		numThreads = (genConfig->getConfigJSON())["NumThreads"].ToInt();
+		glassutil::CLogit::log(
+				glassutil::log_level::info,
+				"gen-travel-times-app: Using NumThreads: "
+						+ std::to_string(numThreads));
+	}
+
 	logger::log("info", "gen-travel-times-app: Setup.");
 
 	// create generator
@@ -147,7 +159,7 @@ int main(int argc, char* argv[]) {
 	glassutil::CLogit::setLogCallback(
 			std::bind(logTravelTimes, std::placeholders::_1));
 
-	travelGenerator->setup(model, path, extension);
+	travelGenerator->setup(model, path, extension, numThreads);
 
 	logger::log("info", "gen-travel-times-app: Startup.");
 
@@ -193,6 +193,9 @@ void fileOutput::sendOutput(const std::string &type, const std::string &id,
 	if (type == "Detection") {
 		OutputData = message;
 		Extension = std::string(DETECTIONEXTENSION);
+	} else if (type == "DetectionDelta") {
+		OutputData = message;
+		Extension = std::string(DETECTIONDELTAEXTENSION);
 	} else if (type == "Retraction") {
 		OutputData = message;
 		Extension = std::string(RETRACTEXTENSION);
@@ -20,6 +20,9 @@
 #include <fstream>
 #include <vector>
 
+// file extension for incremental detection updates
+#define DETECTIONDELTAEXTENSION "jsondelta"
+
 namespace glass {
 /**
  * \brief glass fileOutput class
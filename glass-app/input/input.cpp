@@ -218,6 +218,9 @@ bool input::setup(json::Object *config) {
 						+ std::to_string(m_QueueMaxSize) + ".");
 	}
 
+	// work batch size and time
+	setupWorkBatch(config);
+
 	// shutdown when no data
 	if (!(config->HasKey("ShutdownWhenNoData"))) {
 		// m_bShutdownWhenNoData is optional
@@ -320,7 +323,7 @@ int input::dataCount() {
 	return (m_DataQueue->size());
 }
 
-bool input::work() {
+util::WorkState input::work() {
 	// pull data from our config at the start of each loop
 	// so that we can have config that changes
 	// should I do this?
@@ -335,7 +338,7 @@ bool input::work() {
 
 	// make sure we have formats
 	if (formats.size() == 0)
-		return (true);
+		return (util::WorkState::Idle);
 
 	bool foundFile = false;
 
@@ -353,12 +356,15 @@ bool input::work() {
 
 	// don't shutdown if we're not allowed to
 	if (m_bShutdownWhenNoData == false) {
-		return (true);
+		if (foundFile == true) {
+			return (util::WorkState::OK);
+		}
+		return (util::WorkState::Idle);
 	}
 
 	// work was successful, found a file to process, keep going
 	if (foundFile == true) {
-		return (true);
+		return (util::WorkState::OK);
 	} else {
 		// no file to process, check to see if we still have data in the queue
 		if (dataCount() <= 0) {
@@ -376,12 +382,12 @@ bool input::work() {
 				std::this_thread::sleep_for(std::chrono::milliseconds(1000));
 			}
 
-			// we don't, we have nothing to do now, return false
+			// we don't, we have nothing to do now, return an error
 			// so we exit
-			return (false);
+			return (util::WorkState::Error);
 		} else {
-			// we do, don't exit
-			return (true);
+			// we do, don't exit, wait for the queue to drain
+			return (util::WorkState::Idle);
 		}
 	}
 }
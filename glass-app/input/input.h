@@ -226,9 +226,12 @@ class input : public util::iInput, public util::ThreadBaseClass {
 	 * \brief input work function
 	 *
 	 * The function (from threadclassbase) used to do work.
-	 * \return returns true if work was successful, false otherwise.
+	 * \return returns util::WorkState::OK if a file was read,
+	 * util::WorkState::Idle if there were no files to read, and
+	 * util::WorkState::Error when there is no more data and the input should
+	 * shut down.
 	 */
-	bool work() override;
+	util::WorkState work() override;
 
 	/**
 	 * \brief read files function
@@ -1,4 +1,6 @@
 #include <brokerOutput.h>
+#include <brokerProducer.h>
+#include <Producer.h>
 #include <json.h>
 #include <convert.h>
 #include <detection-formats.h>
@@ -20,10 +22,9 @@ brokerOutput::brokerOutput()
 		: output() {
 	logger::log("debug", "brokerOutput::brokerOutput(): Construction.");
 
-	m_OutputProducer = NULL;
-	m_StationRequestProducer = NULL;
-	m_OutputTopic = NULL;
-	m_StationRequestTopic = NULL;
+	m_Producer = NULL;
+	m_BatchProducer = new util::BatchProducer();
+	m_iFailedCount = 0;
 
 	// init config to defaults and allocate
 	clear();
@@ -34,10 +35,9 @@ brokerOutput::brokerOutput(json::Object *config)
 	logger::log("debug",
 				"brokerOutput::brokerOutput(): Advanced Construction.");
 
-	m_OutputProducer = NULL;
-	m_StationRequestProducer = NULL;
-	m_OutputTopic = NULL;
-	m_StationRequestTopic = NULL;
+	m_Producer = NULL;
+	m_BatchProducer = new util::BatchProducer();
+	m_iFailedCount = 0;
 
 	// init config to defaults and allocate
 	clear();
@@ -54,6 +54,15 @@ brokerOutput::~brokerOutput() {
 
 	// stop the input thread
 	stop();
+
+	// stop the batch producer, sending anything still pending
+	if (m_BatchProducer != NULL) {
+		delete (m_BatchProducer);
+	}
+
+	if (m_Producer != NULL) {
+		delete (m_Producer);
+	}
 }
 
 // configuration
@@ -159,54 +168,64 @@ bool brokerOutput::setup(json::Object *config) {
 						+ stationRequestTopic + ".");
 	}
 
+	// batch size
+	if (!(config->HasKey("BatchSize"))) {
+		// batch size is optional
+		m_iBatchSize = 100;
+		logger::log(
+				"info",
+				"brokerOutput::setup(): BatchSize not specified, using default "
+						"of " + std::to_string(m_iBatchSize) + ".");
+	} else {
+		m_iBatchSize = (*config)["BatchSize"].ToInt();
+		logger::log(
+				"info",
+				"brokerOutput::setup(): Using BatchSize: "
+						+ std::to_string(m_iBatchSize) + ".");
+	}
+
+	// batch linger time
+	if (!(config->HasKey("BatchLingerTime"))) {
+		// linger time is optional
+		m_iBatchLingerTime = 50;
+		logger::log(
+				"info",
+				"brokerOutput::setup(): BatchLingerTime not specified, using "
+						"default of " + std::to_string(m_iBatchLingerTime)
+						+ " milliseconds.");
+	} else {
+		m_iBatchLingerTime = (*config)["BatchLingerTime"].ToInt();
+		logger::log(
+				"info",
+				"brokerOutput::setup(): Using BatchLingerTime: "
+						+ std::to_string(m_iBatchLingerTime)
+						+ " milliseconds.");
+	}
+
+	m_sOutputTopic = brokerOutputTopic;
+	m_sStationRequestTopic = stationRequestTopic;
+
 	// unlock our configuration
 	m_BrokerOutputConfigMutex.unlock();
 
-	// set up brokerOutput producer
-	if (m_OutputProducer != NULL)
-		delete (m_OutputProducer);
-	if (m_OutputTopic != NULL)
-		delete (m_OutputTopic);
-
-	// create new producer
-	m_OutputProducer = new hazdevbroker::Producer();
+	// create new producer, the output and station request topics share
+	// the producer
+	hazdevbroker::Producer * producer = new hazdevbroker::Producer();
 
 	// set up logging
-	m_OutputProducer->setLogCallback(
+	producer->setLogCallback(
 			std::bind(&brokerOutput::logProducer, this, std::placeholders::_1));
 
 	// set up producer
-	m_OutputProducer->setup(producerConfig, topicConfig);
-
-	// create topic
-	m_OutputTopic = m_OutputProducer->createTopic(brokerOutputTopic);
-
-	// set up station request producer if wanted
-	if (stationRequestTopic != "") {
-		if (m_StationRequestProducer != NULL)
-			delete (m_StationRequestProducer);
-		if (m_StationRequestTopic != NULL)
-			delete (m_StationRequestTopic);
-
-		// create new producer
-		m_StationRequestProducer = new hazdevbroker::Producer();
-
-		// set up logging
-		m_StationRequestProducer->setLogCallback(
-				std::bind(&brokerOutput::logProducer, this,
-							std::placeholders::_1));
-
-		// set up producer
-		// same producer config as brokerOutput
-		m_StationRequestProducer->setup(producerConfig, topicConfig);
-
-		// create topic
-		// different topic
-		m_StationRequestTopic = m_StationRequestProducer->createTopic(
-				stationRequestTopic);
-	} else {
-		m_StationRequestProducer = NULL;
-		m_StationRequestTopic = NULL;
+	producer->setup(producerConfig, topicConfig);
+
+	setProducer(new brokerProducer(producer));
+
+	// set up and start the batch producer
+	m_BatchProducer->setBatchSize(getBatchSize());
+	m_BatchProducer->setLingerTime(getBatchLingerTime());
+	if (m_BatchProducer->getStarted() == false) {
+		m_BatchProducer->start();
 	}
 
 	logger::log("debug", "brokerOutput::setup(): Done Setting Up.");
@@ -221,10 +240,61 @@ bool brokerOutput::setup(json::Object *config) {
 void brokerOutput::clear() {
 	logger::log("debug", "brokerOutput::clear(): clearing configuration.");
 
+	m_BrokerOutputConfigMutex.lock();
+	m_sOutputTopic = "";
+	m_sStationRequestTopic = "";
+	m_iBatchSize = 100;
+	m_iBatchLingerTime = 50;
+	m_BrokerOutputConfigMutex.unlock();
+
 	// finally do baseclass clear
 	output::clear();
 }
 
+bool brokerOutput::check() {
+	// log what the batch producer has delivered since the last check
+	util::DeliveryReport report;
+	while (m_BatchProducer->getDeliveryReport(&report) == true) {
+		if (report.iFailed > 0) {
+			m_iFailedCount += report.iFailed;
+			logger::log(
+					"error",
+					"brokerOutput::check(): Failed to send "
+							+ std::to_string(report.iFailed) + " of "
+							+ std::to_string(report.iDelivered + report.iFailed)
+							+ " messages to topic " + report.sTopic + " ("
+							+ std::to_string(m_iFailedCount)
+							+ " failed in total).");
+		} else {
+			logger::log(
+					"trace",
+					"brokerOutput::check(): Sent "
+							+ std::to_string(report.iDelivered)
+							+ " messages to topic " + report.sTopic + ".");
+		}
+	}
+
+	// check the batch producer thread
+	if (m_BatchProducer->check() == false) {
+		return (false);
+	}
+
+	// finally do baseclass check
+	return (output::check());
+}
+
+void brokerOutput::setProducer(util::iProducer *producer) {
+	util::iProducer * oldProducer = m_BatchProducer->getProducer();
+
+	// the batch producer won't use the old producer once this returns
+	m_BatchProducer->setProducer(producer);
+	m_Producer = producer;
+
+	if ((oldProducer != NULL) && (oldProducer != producer)) {
+		delete (oldProducer);
+	}
+}
+
 // handle output
 void brokerOutput::sendOutput(const std::string &type, const std::string &id,
 								const std::string &message) {
@@ -244,19 +314,19 @@ void brokerOutput::sendOutput(const std::string &type, const std::string &id,
 		return;
 	}
 
-	if (type == "Detection") {
-		if ((m_OutputProducer != NULL) && (m_OutputTopic != NULL)) {
-			m_OutputProducer->sendString(m_OutputTopic, message);
-		}
-	} else if (type == "Retraction") {
-		if ((m_OutputProducer != NULL) && (m_OutputTopic != NULL)) {
-			m_OutputProducer->sendString(m_OutputTopic, message);
+	m_BrokerOutputConfigMutex.lock();
+	std::string outputTopic = m_sOutputTopic;
+	std::string stationRequestTopic = m_sStationRequestTopic;
+	m_BrokerOutputConfigMutex.unlock();
+
+	if ((type == "Detection") || (type == "DetectionDelta")
+			|| (type == "Retraction")) {
+		if (outputTopic != "") {
+			m_BatchProducer->addMessage(outputTopic, message);
 		}
 	} else if (type == "StationInfoRequest") {
-		if ((m_StationRequestProducer != NULL)
-				&& (m_StationRequestTopic != NULL)) {
-			m_StationRequestProducer->sendString(m_StationRequestTopic,
-													message);
+		if (stationRequestTopic != "") {
+			m_BatchProducer->addMessage(stationRequestTopic, message);
 		}
 	} else if (type == "StationList") {
 		std::string filename = getSStationFile();
@@ -9,8 +9,10 @@
 
 #include <json.h>
 #include <output.h>
-#include <Producer.h>
+#include <batchproducer.h>
+#include <producerinterface.h>
 
+#include <atomic>
 #include <mutex>
 #include <string>
 
@@ -76,11 +78,63 @@ class brokerOutput : public output {
 	 */
 	void clear() override;
 
+	/**
+	 * \brief brokerOutput check function
+	 *
+	 * Checks the base output threads and the batch producer thread, and logs
+	 * the delivery reports queued by the batch producer since the last check.
+	 *
+	 * \return returns true if all threads are still functional, false
+	 * otherwise
+	 */
+	bool check() override;
+
+	/**
+	 * \brief setter for the producer used to send messages
+	 *
+	 * Replaces the producer created by setup, allowing a stand-in producer
+	 * to be used. The brokerOutput takes ownership of the producer.
+	 *
+	 * \param producer - A pointer to the util::iProducer to send messages
+	 * with
+	 */
+	void setProducer(util::iProducer *producer);
+
+	/**
+	 * \brief getter for the m_iBatchSize configuration variable
+	 */
+	int getBatchSize() {
+		m_BrokerOutputConfigMutex.lock();
+		int batchsize = m_iBatchSize;
+		m_BrokerOutputConfigMutex.unlock();
+
+		return (batchsize);
+	}
+
+	/**
+	 * \brief getter for the m_iBatchLingerTime configuration variable
+	 */
+	int getBatchLingerTime() {
+		m_BrokerOutputConfigMutex.lock();
+		int lingertime = m_iBatchLingerTime;
+		m_BrokerOutputConfigMutex.unlock();
+
+		return (lingertime);
+	}
+
+	/**
+	 * \brief getter for the count of messages that failed to send
+	 */
+	int getFailedCount() {
+		return (m_iFailedCount);
+	}
+
  protected:
 	/**
 	 * \brief output file writing function
 	 *
-	 * The function used output detection data
+	 * The function used output detection data. Broker messages are added to
+	 * the batch for their topic and sent asynchronously by the batch producer.
 	 *
 	 * \param data - A pointer to a json::Object containing the data to be
 	 * output.
@@ -101,11 +155,43 @@ class brokerOutput : public output {
 	 */
 	util::ThreadPool * m_ThreadPool;
 
-	hazdevbroker::Producer * m_OutputProducer;
-	hazdevbroker::Producer * m_StationRequestProducer;
+	/**
+	 * \brief the producer used to send batches of messages
+	 */
+	util::iProducer * m_Producer;
+
+	/**
+	 * \brief the batch producer used to batch messages per topic
+	 */
+	util::BatchProducer * m_BatchProducer;
+
+	/**
+	 * \brief the name of the topic for detection output
+	 */
+	std::string m_sOutputTopic;
+
+	/**
+	 * \brief the name of the topic for station requests, empty if station
+	 * requests are not wanted
+	 */
+	std::string m_sStationRequestTopic;
+
+	/**
+	 * \brief the integer configuration value indicating the maximum number of
+	 * messages in a batch
+	 */
+	int m_iBatchSize;
 
-	RdKafka::Topic * m_OutputTopic;
-	RdKafka::Topic * m_StationRequestTopic;
+	/**
+	 * \brief the integer configuration value indicating the maximum time in
+	 * milliseconds a message waits in a batch before it is sent
+	 */
+	int m_iBatchLingerTime;
+
+	/**
+	 * \brief the count of messages that failed to send
+	 */
+	std::atomic<int> m_iFailedCount;
 
 	/**
 	 * \brief the mutex for configuration
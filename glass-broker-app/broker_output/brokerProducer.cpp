@@ -0,0 +1,67 @@
+#include <brokerProducer.h>
+#include <logger.h>
+
+#include <map>
+#include <string>
+#include <vector>
+
+namespace glass {
+
+brokerProducer::brokerProducer(hazdevbroker::Producer *producer) {
+	m_Producer = producer;
+}
+
+brokerProducer::~brokerProducer() {
+	for (auto &topic : m_Topics) {
+		if (topic.second != NULL) {
+			delete (topic.second);
+		}
+	}
+	m_Topics.clear();
+
+	if (m_Producer != NULL) {
+		delete (m_Producer);
+	}
+}
+
+int brokerProducer::sendBatch(const std::string &topic,
+								const std::vector<std::string> &messages) {
+	if (m_Producer == NULL) {
+		return (0);
+	}
+
+	// get or create the topic
+	RdKafka::Topic * kafkaTopic = NULL;
+	auto found = m_Topics.find(topic);
+	if (found != m_Topics.end()) {
+		kafkaTopic = found->second;
+	} else {
+		kafkaTopic = m_Producer->createTopic(topic);
+		if (kafkaTopic == NULL) {
+			logger::log(
+					"error",
+					"brokerProducer::sendBatch(): Failed to create topic "
+							+ topic + ".");
+			return (0);
+		}
+		m_Topics[topic] = kafkaTopic;
+	}
+
+	// hand the messages to the producer, librdkafka queues them and
+	// delivers them asynchronously
+	int delivered = 0;
+	for (const auto &message : messages) {
+		try {
+			m_Producer->sendString(kafkaTopic, message);
+			delivered++;
+		} catch (const std::exception &e) {
+			logger::log(
+					"error",
+					"brokerProducer::sendBatch(): Exception sending to topic "
+							+ topic + ": " + std::string(e.what()));
+		}
+	}
+
+	return (delivered);
+}
+}  // namespace glass
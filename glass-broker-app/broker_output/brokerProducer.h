@@ -0,0 +1,75 @@
+/*****************************************
+ * This file is documented for Doxygen.
+ * If you modify this file please update
+ * the comments so that Doxygen will still
+ * be able to work.
+ ****************************************/
+#ifndef BROKERPRODUCER_H
+#define BROKERPRODUCER_H
+
+#include <producerinterface.h>
+#include <Producer.h>
+
+#include <map>
+#include <string>
+#include <vector>
+
+namespace glass {
+/**
+ * \brief glass broker producer class
+ *
+ * The glass broker producer class adapts a hazdevbroker::Producer to the
+ * util::iProducer interface used by util::BatchProducer. Topics are created
+ * on first use and cached by name.
+ *
+ * brokerProducer implements the util::iProducer interface.
+ */
+class brokerProducer : public util::iProducer {
+ public:
+	/**
+	 * \brief brokerProducer constructor
+	 *
+	 * The constructor for the brokerProducer class.
+	 *
+	 * \param producer - A pointer to the configured hazdevbroker::Producer to
+	 * send with, the brokerProducer takes ownership
+	 */
+	explicit brokerProducer(hazdevbroker::Producer *producer);
+
+	/**
+	 * \brief brokerProducer destructor
+	 *
+	 * The destructor for the brokerProducer class.
+	 * Deletes the topics and the producer.
+	 */
+	~brokerProducer();
+
+	/**
+	 * \brief Send a batch of messages
+	 *
+	 * Sends each message in the batch to the named topic with the
+	 * hazdevbroker::Producer, creating the topic if needed.
+	 *
+	 * \param topic - A std::string containing the name of the topic to send
+	 * the messages to
+	 * \param messages - A std::vector of std::strings containing the messages
+	 * to send, in order
+	 * \return Returns an integer value containing the number of messages that
+	 * were successfully handed to the broker
+	 */
+	int sendBatch(const std::string &topic,
+					const std::vector<std::string> &messages) override;
+
+ private:
+	/**
+	 * \brief the hazdevbroker producer
+	 */
+	hazdevbroker::Producer * m_Producer;
+
+	/**
+	 * \brief the std::map of topic names to topics
+	 */
+	std::map<std::string, RdKafka::Topic *> m_Topics;
+};
+}  // namespace glass
+#endif  // BROKERPRODUCER_H
@@ -0,0 +1,24 @@
+#include <brokerConsumer.h>
+
+#include <string>
+
+namespace glass {
+
+brokerConsumer::brokerConsumer(hazdevbroker::Consumer *consumer) {
+	m_Consumer = consumer;
+}
+
+brokerConsumer::~brokerConsumer() {
+	if (m_Consumer != NULL) {
+		delete (m_Consumer);
+	}
+}
+
+std::string brokerConsumer::pollString(int timeout) {
+	if (m_Consumer == NULL) {
+		return ("");
+	}
+
+	return (m_Consumer->pollString(timeout));
+}
+}  // namespace glass
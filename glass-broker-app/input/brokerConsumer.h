@@ -0,0 +1,63 @@
+/*****************************************
+ * This file is documented for Doxygen.
+ * If you modify this file please update
+ * the comments so that Doxygen will still
+ * be able to work.
+ ****************************************/
+#ifndef BROKERCONSUMER_H
+#define BROKERCONSUMER_H
+
+#include <consumerinterface.h>
+#include <Consumer.h>
+
+#include <string>
+
+namespace glass {
+/**
+ * \brief glass broker consumer class
+ *
+ * The glass broker consumer class adapts a hazdevbroker::Consumer to the
+ * util::iConsumer interface used by input.
+ *
+ * brokerConsumer implements the util::iConsumer interface.
+ */
+class brokerConsumer : public util::iConsumer {
+ public:
+	/**
+	 * \brief brokerConsumer constructor
+	 *
+	 * The constructor for the brokerConsumer class.
+	 *
+	 * \param consumer - A pointer to the configured and subscribed
+	 * hazdevbroker::Consumer to poll, the brokerConsumer takes ownership
+	 */
+	explicit brokerConsumer(hazdevbroker::Consumer *consumer);
+
+	/**
+	 * \brief brokerConsumer destructor
+	 *
+	 * The destructor for the brokerConsumer class.
+	 * Deletes the consumer.
+	 */
+	~brokerConsumer();
+
+	/**
+	 * \brief Poll for a message
+	 *
+	 * Polls the hazdevbroker::Consumer for the next message.
+	 *
+	 * \param timeout - An integer containing the maximum time to wait for a
+	 * message in milliseconds, 0 to return immediately
+	 * \return Returns a std::string containing the message, or an empty
+	 * string if no message was available before the timeout
+	 */
+	std::string pollString(int timeout) override;
+
+ private:
+	/**
+	 * \brief the hazdevbroker consumer
+	 */
+	hazdevbroker::Consumer * m_Consumer;
+};
+}  // namespace glass
+#endif  // BROKERCONSUMER_H
@@ -1,4 +1,6 @@
 #include <input.h>
+#include <brokerConsumer.h>
+#include <Consumer.h>
 #include <logger.h>
 #include <fileutil.h>
 #include <timeutil.h>
@@ -192,25 +194,46 @@ bool input::setup(json::Object *config) {
 						+ std::to_string(m_QueueMaxSize) + ".");
 	}
 
+	// work batch size and time
+	setupWorkBatch(config);
+
+	// batch size
+	if (!(config->HasKey("BatchSize"))) {
+		// batch size is optional
+		m_iBatchSize = 100;
+		logger::log(
+				"info",
+				"input::setup(): BatchSize not specified, using default of "
+						+ std::to_string(m_iBatchSize) + ".");
+	} else {
+		m_iBatchSize = (*config)["BatchSize"].ToInt();
+		if (m_iBatchSize < 1) {
+			m_iBatchSize = 1;
+		}
+		logger::log(
+				"info",
+				"input::setup(): Using BatchSize: "
+						+ std::to_string(m_iBatchSize) + ".");
+	}
+
 	// unlock our configuration
 	m_ConfigMutex.unlock();
 
-	// set up consumer
-	if (m_Consumer != NULL)
-		delete (m_Consumer);
-
 	// create new consumer
-	m_Consumer = new hazdevbroker::Consumer();
+	hazdevbroker::Consumer * consumer = new hazdevbroker::Consumer();
 
 	// set up logging
-	m_Consumer->setLogCallback(
+	consumer->setLogCallback(
 			std::bind(&input::logConsumer, this, std::placeholders::_1));
 
 	// set up consumer, set up default topic config
-	m_Consumer->setup(consumerConfig, topicConfig);
+	consumer->setup(consumerConfig, topicConfig);
 
 	// subscribe to topics
-	m_Consumer->subscribe(m_sTopicList);
+	consumer->subscribe(m_sTopicList);
+
+	// set up consumer
+	setConsumer(new brokerConsumer(consumer));
 
 	if (m_JSONParser != NULL)
 		delete (m_JSONParser);
@@ -241,6 +264,7 @@ void input::clear() {
 	m_sDefaultAgencyID = "";
 	m_sDefaultAuthor = "";
 	m_QueueMaxSize = -1;
+	m_iBatchSize = 100;
 
 	// unlock our configuration
 	m_ConfigMutex.unlock();
@@ -266,14 +290,50 @@ int input::dataCount() {
 	return (m_DataQueue->size());
 }
 
-bool input::work() {
+void input::setConsumer(util::iConsumer *consumer) {
+	std::lock_guard<std::mutex> guard(m_ConsumerMutex);
+
+	if (m_Consumer != NULL) {
+		delete (m_Consumer);
+	}
+
+	m_Consumer = consumer;
+}
+
+util::WorkState input::work() {
+	std::lock_guard<std::mutex> guard(m_ConsumerMutex);
+
 	// make sure we have a consumer
 	if (m_Consumer == NULL)
-		return (false);
+		return (util::WorkState::Error);
+
+	// don't take more than the queue allows
+	int batchSize = getBatchSize();
+	int queueMaxSize = getQueueMaxSize();
+	if (queueMaxSize > 0) {
+		int queueRoom = queueMaxSize - m_DataQueue->size();
+		if (queueRoom <= 0) {
+			// work was successful, just nothing to do until the queue
+			// drains
+			return (util::WorkState::Idle);
+		}
+		if (queueRoom < batchSize) {
+			batchSize = queueRoom;
+		}
+	}
+
+	// drain what the consumer already has, only waiting for the first
+	// message
+	std::vector<std::shared_ptr<json::Object>> batch;
+	int received = 0;
+	for (int i = 0; i < batchSize; i++) {
+		std::string message = m_Consumer->pollString(i == 0 ? 100 : 0);
 
-	std::string message = m_Consumer->pollString(100);
+		if (message == "") {
+			break;
+		}
+		received++;
 
-	if (message != "") {
 		logger::log("trace", "input::work(): Got message: " + message);
 		std::shared_ptr<json::Object> newdata;
 		try {
@@ -286,12 +346,22 @@ bool input::work() {
 		}
 
 		if ((newdata != NULL) && (m_JSONParser->validate(newdata) == true)) {
-			m_DataQueue->addDataToQueue(newdata);
+			batch.push_back(newdata);
 		}
 	}
 
+	// add the whole batch at once
+	if (batch.size() > 0) {
+		m_DataQueue->addDataToQueue(batch);
+	}
+
+	// the consumer had nothing for us, even after waiting
+	if (received == 0) {
+		return (util::WorkState::Idle);
+	}
+
 	// work was successful
-	return (true);
+	return (util::WorkState::OK);
 }
 
 void input::logConsumer(const std::string &message) {
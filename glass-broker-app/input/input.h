@@ -12,7 +12,7 @@
 #include <inputinterface.h>
 #include <jsonparser.h>
 #include <queue.h>
-#include <Consumer.h>
+#include <consumerinterface.h>
 
 #include <vector>
 #include <queue>
@@ -125,6 +125,27 @@ class input : public util::iInput, public util::ThreadBaseClass {
 		return (maxsize);
 	}
 
+	/**
+	 * \brief getter for the m_iBatchSize configuration variable
+	 */
+	int getBatchSize() {
+		m_ConfigMutex.lock();
+		int batchsize = m_iBatchSize;
+		m_ConfigMutex.unlock();
+
+		return (batchsize);
+	}
+
+	/**
+	 * \brief setter for the consumer used to get messages
+	 *
+	 * Replaces the consumer created by setup, allowing a stand-in consumer
+	 * to be used. The input takes ownership of the consumer.
+	 *
+	 * \param consumer - A pointer to the util::iConsumer to get messages from
+	 */
+	void setConsumer(util::iConsumer *consumer);
+
 	/**
 	 * \brief getter for the m_sDefaultAgencyID configuration variable
 	 */
@@ -151,10 +172,14 @@ class input : public util::iInput, public util::ThreadBaseClass {
 	/**
 	 * \brief input work function
 	 *
-	 * The function (from threadclassbase) used to do work.
-	 * \return returns true if work was successful, false otherwise.
+	 * The function (from threadclassbase) used to do work. Drains up to
+	 * m_iBatchSize messages from the consumer, waiting only for the first,
+	 * and adds the valid ones to the data queue in one operation.
+	 * \return returns util::WorkState::OK if any messages were received,
+	 * util::WorkState::Idle if there were none or the data queue is full,
+	 * and util::WorkState::Error if there is no consumer.
 	 */
-	bool work() override;
+	util::WorkState work() override;
 
 	/**
 	 * \brief the function for consumer logging
@@ -185,6 +210,12 @@ class input : public util::iInput, public util::ThreadBaseClass {
 	 */
 	int m_QueueMaxSize;
 
+	/**
+	 * \brief the integer configuration value indicating the maximum number of
+	 * messages to drain from the consumer per work cycle
+	 */
+	int m_iBatchSize;
+
 	/**
 	 * \brief the mutex for configuration
 	 */
@@ -203,7 +234,12 @@ class input : public util::iInput, public util::ThreadBaseClass {
 	/**
 	 * \brief the consumer object to get messages from
 	 */
-	hazdevbroker::Consumer * m_Consumer;
+	util::iConsumer * m_Consumer;
+
+	/**
+	 * \brief the mutex for the consumer
+	 */
+	std::mutex m_ConsumerMutex;
 };
 }  // namespace glass
 #endif  // INPUT_H
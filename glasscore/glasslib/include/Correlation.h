@@ -145,6 +145,24 @@ class CCorrelation {
 	void addHypo(std::shared_ptr<CHypo> hyp, std::string ass = "", bool force =
 							false);
 
+	/**
+	 * \brief Move this correlation from one hypo to another
+	 *
+	 * Links this correlation to the given hypo only if it is still linked to the
+	 * hypo the caller expects, so hypos competing for the correlation can decide
+	 * without holding each other's locks. The loser sees the change and
+	 * tries again later.
+	 *
+	 * \param oldHyp - A std::shared_ptr to the hypocenter the correlation is
+	 * expected to be linked to, NULL if it is expected to be unlinked
+	 * \param newHyp - A std::shared_ptr to the hypocenter to link
+	 * \param ass - A std::string containing a note about the association reason
+	 * \return Returns true if the link was changed, false if the correlation was
+	 * no longer linked to oldHyp
+	 */
+	bool replaceHypo(std::shared_ptr<CHypo> oldHyp,
+						std::shared_ptr<CHypo> newHyp, std::string ass = "");
+
 	/**
 	 * \brief Remove hypo specific reference to this correlation
 	 *
@@ -242,6 +260,13 @@ class CCorrelation {
 	 */
 	const std::shared_ptr<CSite>& getSite() const;
 
+	/**
+	 * \brief Site id getter
+	 * \return the interned id of the site, or -1 if the site is not in a
+	 * site list
+	 */
+	int getSiteId() const;
+
 	/**
 	 * \brief Association string getter
 	 * \return the association string
@@ -278,6 +303,14 @@ class CCorrelation {
 	 */
 	double getTGlassCreate() const;
 
+
+	/**
+	 * \brief Estimate memory usage
+	 * \return the approximate number of bytes used by this correlation,
+	 * including its input json
+	 */
+	size_t getMemoryUsage() const;
+
  private:
 	/**
 	 * \brief A std::shared_ptr to a CSite object
@@ -286,6 +319,12 @@ class CCorrelation {
 	 */
 	std::shared_ptr<CSite> pSite;
 
+	/**
+	 * \brief An integer containing the interned id of the site this
+	 * correlation was correlated at
+	 */
+	int iSiteId;
+
 	/**
 	 * \brief A std::weak_ptr to a CHypo object
 	 * representing the links between this correlation and associated hypocenter
@@ -8,11 +8,16 @@
 #define CORRELATIONLIST_H
 
 #include <json.h>
+#include <cstdint>
+#include <deque>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <unordered_map>
 #include <vector>
 #include <map>
 #include <utility>
+#include "GeoPoint.h"
 
 namespace glasscore {
 
@@ -41,6 +46,12 @@ class CGlass;
  * database links between  this correlation and various hypocenters.  A single
  * correlation may belinked to multiple hypocenters
  *
+ * CCorrelationList keeps its correlations in a space-time bucketed index
+ * as well as in time order, so that duplicate checks and scavenging only
+ * look at the correlations near a given time and location, rather than at
+ * every correlation in a time window. The index buckets are sized from the
+ * correlation matching windows.
+ *
  * CCorrelationList uses smart pointers (std::shared_ptr).
  */
 class CCorrelationList {
@@ -149,6 +160,30 @@ class CCorrelationList {
 	bool checkDuplicate(CCorrelation * newCorrelation, double tWindow,
 						double xWindow);
 
+	/**
+	 * \brief Get the correlations near a time and location
+	 *
+	 * Looks up the correlations in the index buckets that overlap the given
+	 * time and distance windows. The result holds every correlation within
+	 * tWindow seconds and xWindow degrees of the given time and location, but
+	 * may also hold some that are a little further away, so callers should
+	 * still apply their own distance checks.
+	 *
+	 * \param tCorrelation - A double containing the time to search around in
+	 * julian seconds
+	 * \param lat - A double containing the geographic latitude to search
+	 * around in degrees
+	 * \param lon - A double containing the geographic longitude to search
+	 * around in degrees
+	 * \param tWindow - A double containing the time window in seconds
+	 * \param xWindow - A double containing the distance window in degrees
+	 * \return Returns a std::vector of std::shared_ptrs to the correlations
+	 * found
+	 */
+	std::vector<std::shared_ptr<CCorrelation>> getCorrelations(
+			double tCorrelation, double lat, double lon, double tWindow,
+			double xWindow);
+
 	/**
 	 * \brief Search for any associable picks that match hypo
 	 *
@@ -236,7 +271,88 @@ class CCorrelationList {
 	 */
 	int getVCorrelationSize() const;
 
+
+	/**
+	 * \brief Estimate memory usage
+	 * \return the approximate number of bytes used by the correlation list
+	 * and the correlations in it
+	 */
+	size_t getMemoryUsage() const;
+
  private:
+	/**
+	 * \brief The key of a space-time index bucket, made up of the time
+	 * bucket and the cell of the geocentric unit vector
+	 */
+	struct IndexKey {
+		/**
+		 * \brief The time bucket
+		 */
+		int64_t iTime;
+
+		/**
+		 * \brief The cells along the x, y, and z axes
+		 */
+		int iX;
+		int iY;
+		int iZ;
+
+		bool operator==(const IndexKey &key) const {
+			return ((iTime == key.iTime) && (iX == key.iX) && (iY == key.iY)
+					&& (iZ == key.iZ));
+		}
+	};
+
+	/**
+	 * \brief Hash functor for IndexKey
+	 */
+	struct IndexKeyHash {
+		size_t operator()(const IndexKey &key) const;
+	};
+
+	/**
+	 * \brief A correlation in an index bucket
+	 */
+	struct IndexEntry {
+		/**
+		 * \brief The integer id of the correlation
+		 */
+		int iCorrelation;
+
+		/**
+		 * \brief The time of the correlation, kept here so that bucket
+		 * scans don't need to touch the correlation itself
+		 */
+		double tCorrelation;
+
+		/**
+		 * \brief The correlation
+		 */
+		std::shared_ptr<CCorrelation> corr;
+	};
+
+	/**
+	 * \brief Get the index key for a time and location
+	 */
+	IndexKey indexKey(double tCorrelation,
+						const glassutil::CGeoPoint &point) const;
+
+	/**
+	 * \brief Resize the index buckets to the given windows, rebuilding the
+	 * index if they changed
+	 */
+	void resizeIndex(double tWindow, double xWindow);
+
+	/**
+	 * \brief Add a correlation to the index
+	 */
+	void insertIndex(int idCorrelation, std::shared_ptr<CCorrelation> corr);
+
+	/**
+	 * \brief Remove a correlation from the index
+	 */
+	void eraseIndex(int idCorrelation, std::shared_ptr<CCorrelation> corr);
+
 	/**
 	 * \brief A pointer to the parent CGlass class, used to send output,
 	 * look up site information, encode/decode time, get configuration values,
@@ -270,12 +386,12 @@ class CCorrelationList {
 	int nCorrelationTotal;
 
 	/**
-	 * \brief A std::vector mapping the arrival time of each correlation in
+	 * \brief A std::deque mapping the arrival time of each correlation in
 	 * CCorrelationListto it's integer correlation id. The elements in this
-	 * vector object are inserted in a manner to keep it in sequential time
-	 * order from oldest to youngest.
+	 * deque object are inserted in a manner to keep it in sequential time
+	 * order from oldest to youngest, so the oldest can be dropped cheaply.
 	 */
-	std::vector<std::pair<double, int>> vCorrelation;
+	std::deque<std::pair<double, int>> vCorrelation;
 
 	/**
 	 * \brief A std::map containing a std::shared_ptr to each correlation in
@@ -283,6 +399,36 @@ class CCorrelationList {
 	 */
 	std::map<int, std::shared_ptr<CCorrelation>> mCorrelation;
 
+	/**
+	 * \brief A std::unordered_map containing the space-time index buckets
+	 * of the correlations in CCorrelationList
+	 */
+	std::unordered_map<IndexKey, std::vector<IndexEntry>, IndexKeyHash> mIndex;
+
+	/**
+	 * \brief A double containing the length of an index time bucket in
+	 * seconds
+	 */
+	double dIndexTime;
+
+	/**
+	 * \brief A double containing the size of an index cell, as a chord
+	 * length of the geocentric unit sphere
+	 */
+	double dIndexCell;
+
+	/**
+	 * \brief A double containing the time window in seconds the index was
+	 * sized for
+	 */
+	double dIndexTWindow;
+
+	/**
+	 * \brief A double containing the distance window in degrees the index
+	 * was sized for
+	 */
+	double dIndexXWindow;
+
 	/**
 	 * \brief A recursive_mutex to control threading access to vCorrelation.
 	 * NOTE: recursive mutexes are frowned upon, so maybe redesign around it
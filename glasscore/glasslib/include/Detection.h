@@ -9,6 +9,7 @@
 
 #include <json.h>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -17,6 +18,41 @@ namespace glasscore {
 // forward declarations
 class CSite;
 class CHypo;
+class CGlass;
+
+/**
+ * \brief glasscore detection record
+ *
+ * The typed values of a detection, decoded once from an incoming
+ * 'Detection' message, or filled in directly by a caller that already has
+ * them, such as a peer glass instance, so that they can be processed
+ * without any json lookups.
+ */
+struct DetectionRecord {
+	/**
+	 * \brief A double value containing the origin time of the detection in
+	 * julian seconds
+	 */
+	double tOrg;
+
+	/**
+	 * \brief A double value containing the geographic latitude of the
+	 * detection in degrees
+	 */
+	double dLat;
+
+	/**
+	 * \brief A double value containing the geographic longitude of the
+	 * detection in degrees
+	 */
+	double dLon;
+
+	/**
+	 * \brief A double value containing the depth of the detection in
+	 * kilometers
+	 */
+	double dZ;
+};
 
 /**
  * \brief glasscore pick class
@@ -86,6 +122,33 @@ class CDetection {
 	 */
 	bool process(std::shared_ptr<json::Object> com);
 
+	/**
+	 * \brief Process a typed detection
+	 *
+	 * The typed path behind process(), which does the same hypocenter
+	 * matching and creation on an already decoded detection. Detections are
+	 * not serialized against each other, only the hypo list is used to find
+	 * a matching hypocenter.
+	 *
+	 * \param detection - The DetectionRecord to process
+	 * \return Returns true if the detection was processed, false otherwise
+	 */
+	bool process(const DetectionRecord &detection);
+
+	/**
+	 * \brief Decode a detection message
+	 *
+	 * Decodes the hypocenter of a 'Detection' message into a DetectionRecord,
+	 * looking each key up once and without copying the hypocenter object.
+	 *
+	 * \param com - A reference to a json::Object containing the 'Detection'
+	 * message
+	 * \param detection - A pointer to the DetectionRecord to fill in
+	 * \return Returns true if the message had all the required keys, false
+	 * otherwise
+	 */
+	static bool decode(const json::Object &com, DetectionRecord *detection);
+
 	/**
 	 * \brief CGlass getter
 	 * \return the CGlass pointer
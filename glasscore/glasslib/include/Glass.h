@@ -14,6 +14,7 @@
 #include "Ray.h"
 #include "TTT.h"
 #include "TravelTime.h"
+#include "Executor.h"
 
 namespace glasscore {
 
@@ -25,6 +26,20 @@ class CHypoList;
 class CDetection;
 class CCorrelationList;
 struct IGlassSend;
+struct HypoRecord;
+
+/**
+ * \brief glasscore executor task classes
+ *
+ * The task_class enum defines the classes of work glasscore runs on a shared
+ * executor, see CGlass::getExecutor().  The values are the class indexes
+ * given to the executor.
+ */
+typedef enum {
+	nucleation = 0,
+	evolution = 1,
+	maintenance = 2
+} task_class;
 
 /**
  * \brief glasscore interface class
@@ -97,6 +112,19 @@ class CGlass {
 	 */
 	bool send(std::shared_ptr<json::Object> com);
 
+	/**
+	 * \brief CGlass hypocenter record sending function
+	 *
+	 * The function used by CGlass to send typed hypocenter records
+	 * to outside the glasscore library using an IGlassSend interface
+	 * pointer.
+	 *
+	 * \param hypo - A shared pointer to the immutable HypoRecord to send
+	 * \return Returns true if the record was sent via a valid IGlassSend
+	 * interface pointer, false otherwise
+	 */
+	bool send(std::shared_ptr<const HypoRecord> hypo);
+
 	/**
 	 * \brief CGlass initialization function
 	 *
@@ -157,6 +185,21 @@ class CGlass {
 	 */
 	bool statusCheck();
 
+	/**
+	 * \brief Memory usage report
+	 *
+	 * Builds a one line breakdown of the estimated memory used by each
+	 * glass subsystem (webs, sites, picks, correlations, hypos, and travel
+	 * times) and their total, for logging and capacity planning, followed
+	 * by the memory reserved by the object pools, which holds the picks,
+	 * correlations, triggers, and hypos already counted in the total. The
+	 * estimate walks every list, so it should be called occasionally rather
+	 * than per pick.
+	 *
+	 * \return Returns a std::string containing the breakdown
+	 */
+	std::string getMemoryReport();
+
 	/**
 	 * \brief Average delta getter
 	 * \return the average delta
@@ -176,10 +219,10 @@ class CGlass {
 	double getBeamMatchingAzimuthWindow() const;
 
 	/**
-	 * \brief Beam matching distance window getter
-	 * \return the beam matching distance window in degrees
+	 * \brief Beam matching slowness window getter
+	 * \return the beam matching slowness window in seconds per degree
 	 */
-	double getBeamMatchingDistanceWindow() const;
+	double getBeamMatchingSlownessWindow() const;
 
 	/**
 	 * \brief Correlation cancel age getter
@@ -265,6 +308,13 @@ class CGlass {
 	 */
 	int getCycleLimit() const;
 
+	/**
+	 * \brief Locator refinement pick count getter
+	 * \return the number of picks a hypo needs before its location is
+	 * refined with Levenberg-Marquardt steps, 0 if refinement is disabled
+	 */
+	int getLocatorRefinementPicks() const;
+
 	/**
 	 * \brief Graphics minimize TT locator getter
 	 * \return the flag indicating whether to use the minimizing tt locator
@@ -307,6 +357,41 @@ class CGlass {
 	 */
 	double getReportCut() const;
 
+	/**
+	 * \brief Hypo priority bayes weight getter
+	 * \return the weight of a hypo's bayesian value relative to its
+	 * threshold in its processing priority
+	 */
+	double getHypoPriorityBayesWeight() const;
+
+	/**
+	 * \brief Hypo priority data weight getter
+	 * \return the processing priority added each time new data is
+	 * added to a queued hypo
+	 */
+	double getHypoPriorityDataWeight() const;
+
+	/**
+	 * \brief Hypo priority report weight getter
+	 * \return the processing priority added to a hypo that is ready
+	 * to be reported for the first time
+	 */
+	double getHypoPriorityReportWeight() const;
+
+	/**
+	 * \brief Hypo priority cycle weight getter
+	 * \return the processing priority removed from a hypo that has
+	 * used all of its processing cycles
+	 */
+	double getHypoPriorityCycleWeight() const;
+
+	/**
+	 * \brief Hypo priority aging weight getter
+	 * \return the processing priority a queued hypo gains for each
+	 * second it waits
+	 */
+	double getHypoPriorityAgingWeight() const;
+
 	/**
 	 * \brief Maximum number of picks with a site getter
 	 * \return the maximum number of picks stored with a site
@@ -325,6 +410,13 @@ class CGlass {
 	 */
 	CDetection*& getDetection();
 
+	/**
+	 * \brief Executor getter
+	 * \return a pointer to the executor shared by the pick, hypo, and web
+	 * lists, or NULL if each list runs its own threads
+	 */
+	glassutil::CExecutor* getExecutor();
+
 	/**
 	 * \brief Hypocenter list getter
 	 * \return a pointer to the hypocenter list
@@ -518,6 +610,12 @@ class CGlass {
 	 */
 	CDetection *pDetection;
 
+	/**
+	 * \brief A pointer to the CExecutor shared by pPickList, pHypoList, and
+	 * pWebList, or NULL if each list runs its own threads
+	 */
+	glassutil::CExecutor *pExecutor;
+
 	/**
 	 * \brief An integer containing the maximum number of picks stored by
 	 * pPickList
@@ -569,10 +667,10 @@ class CGlass {
 	double beamMatchingAzimuthWindow;
 
 	/**
-	 * \brief Distance Window to check for matching beams in degrees. Used for
-	 * nucleating beams and associating beams to hypos
+	 * \brief Slowness Window to check for matching beams in seconds per
+	 * degree. Used for nucleating beams
 	 */
-	double beamMatchingDistanceWindow;
+	double beamMatchingSlownessWindow;
 
 	/**
 	 * \brief age of correlations before allowing cancel in seconds
@@ -615,6 +713,13 @@ class CGlass {
 	 */
 	int iCycleLimit;
 
+	/**
+	 * \brief Number of picks a hypo needs before localize() refines its
+	 * location with Levenberg-Marquardt steps on the travel time residuals,
+	 * 0 to disable refinement
+	 */
+	int locatorRefinementPicks;
+
 	/**
 	 * \brief boolean to use a locator which minimizes TT as opposed to
 	 * maximizes significance functions
@@ -631,6 +736,36 @@ class CGlass {
 	 * to for reporting a hypo
 	 */
 	double dReportThresh;
+
+	/**
+	 * \brief the weight of a hypo's bayesian value relative to its
+	 * threshold in its processing priority
+	 */
+	double hypoPriorityBayesWeight;
+
+	/**
+	 * \brief the processing priority added each time new data is
+	 * added to a queued hypo
+	 */
+	double hypoPriorityDataWeight;
+
+	/**
+	 * \brief the processing priority added to a hypo that is ready
+	 * to be reported for the first time
+	 */
+	double hypoPriorityReportWeight;
+
+	/**
+	 * \brief the processing priority removed from a hypo that has
+	 * used all of its processing cycles
+	 */
+	double hypoPriorityCycleWeight;
+
+	/**
+	 * \brief the processing priority a queued hypo gains for each
+	 * second it waits
+	 */
+	double hypoPriorityAgingWeight;
 };
 }  // namespace glasscore
 #endif  // GLASS_H
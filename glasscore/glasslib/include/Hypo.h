@@ -9,6 +9,8 @@
 
 #include <json.h>
 #include "TTT.h"
+#include "HypoRecord.h"
+#include "GeoPoint.h"
 #include <memory>
 #include <string>
 #include <vector>
@@ -45,6 +47,13 @@ class CTrigger;
  * calculations.
  *
  * CHypo uses smart pointers (std::shared_ptr).
+ *
+ * Hypocenters are evolved in parallel by CHypoList. To keep that free of
+ * deadlocks, a hypocenter never holds hypoMutex while locking another
+ * hypocenter, and picks and correlations never lock a hypocenter while locked
+ * themselves. Picks and correlations move between hypocenters with
+ * replaceHypo, which only succeeds if the link hasn't changed since it was
+ * read, so competing hypocenters never need each other's locks.
  */
 class CHypo {
  public:
@@ -312,6 +321,23 @@ class CHypo {
 	 */
 	std::shared_ptr<json::Object> hypo(bool send = true);
 
+	/**
+	 * \brief Generate Hypo record
+	 *
+	 * Generate an immutable HypoRecord representing this hypocenter and
+	 * send it to CGlass (and out of glasscore) using the send function
+	 * (pGlass->send). Unlike hypo(), the supporting data input messages are
+	 * shared rather than copied, and no json::Object tree is built.
+	 *
+	 * \param send - A boolean flag indicating whether to send the record
+	 * \param snapshot - A boolean flag indicating whether a full snapshot
+	 * was requested, rather than allowing an incremental update
+	 * \return Returns the generated record, or NULL if the hypo is not
+	 * reportable.
+	 */
+	std::shared_ptr<const HypoRecord> hypoRecord(bool send = true,
+													bool snapshot = true);
+
 	/**
 	 * \brief Generate Event message
 	 *
@@ -380,6 +406,26 @@ class CHypo {
 	 */
 	double getResidual(std::shared_ptr<CPick> pick);
 
+	/**
+	 * \brief Get the picks that could be associated
+	 *
+	 * For each site within the association distance cutoff (dCut), compute
+	 * the times at which any phase could arrive from this hypocenter, and
+	 * collect the site's picks within tWindow seconds of those times. This
+	 * is a superset of the picks that associate() could accept with
+	 * sigma * sdassoc <= tWindow, and scales with the number of plausible
+	 * picks rather than the number of picks in the time range.
+	 *
+	 * \param tWindow - A double value containing the time window (+/-)
+	 * around each predicted arrival in seconds
+	 * \param tDuration - A double value containing the maximum time after
+	 * the origin time to consider in seconds
+	 * \return Returns a std::vector of the candidate picks, in pick time
+	 * order
+	 */
+	std::vector<std::shared_ptr<CPick>> getCandidatePicks(double tWindow,
+															double tDuration);
+
 	/**
 	 * \brief Check to see if correlation could be associated
 	 *
@@ -459,6 +505,11 @@ class CHypo {
 	 * distance.  The values are reflected to give a mean of 0.  These
 	 * statistics are used in the automatic supporting data disassocation
 	 * process cull()
+	 *
+	 * The pick distances and azimuths are kept sorted as picks are added and
+	 * removed, so this is linear in the number of picks. They are only
+	 * recomputed from scratch once the hypo has moved more than
+	 * STATSTOLERANCE degrees from where they were measured.
 	 */
 	void stats();
 
@@ -556,6 +607,22 @@ class CHypo {
 									double tStart, double tStop, int nucleate =
 											0);
 
+	/**
+	 * Locator which refines the current location with Levenberg-Marquardt
+	 * steps on the weighted travel time residuals, using the travel time
+	 * derivatives from the association phases. The picks are reweighted each
+	 * step so that the iteration climbs the same objective as the annealing
+	 * locators, the bayesian stack or, if residual is true, the sum of
+	 * absolute residuals, and a step is only kept if it improves that
+	 * objective.
+	 *
+	 * \param nIter - An integer value containing the maximum number of
+	 * objective evaluations
+	 * \param residual - A boolean flag indicating whether to minimize the sum
+	 * of absolute residuals instead of maximizing the bayesian stack
+	 */
+	void refineLocate(int nIter, bool residual = false);
+
 	/**
 	 * Calculates azimuthal gap for a proposed location
 	 *
@@ -611,7 +678,9 @@ class CHypo {
 	 *
 	 * Calculate the weight of each station for each pick in this
 	 * hypo from the hypocentral distance and distance to nearby stations
-	 * to reduce biases induced by network density differences
+	 * to reduce biases induced by network density differences. The weights
+	 * are reused until the picks change or the hypo moves more than
+	 * STATSTOLERANCE degrees.
 	 * \return Returns false if all weights are zero
 	 */
 	bool weights();
@@ -915,7 +984,48 @@ class CHypo {
 	void setZ(double z);
 	void setTOrg(double newTOrg);
 
+
+	/**
+	 * \brief Estimate memory usage
+	 * \return the approximate number of bytes used by this hypo, including
+	 * its pick and correlation vectors and its travel time copies, but not
+	 * the picks and correlations themselves
+	 */
+	size_t getMemoryUsage() const;
+
  private:
+	/**
+	 * \brief Gather the precomputed geographic points of the sites of the
+	 * picks in this hypo, in vPick order, for use with the batched
+	 * CGeoPoint distance and azimuth functions. Callers must hold hypoMutex.
+	 *
+	 * \param points - A pointer to a std::vector to hold the points, resized
+	 * to match vPick
+	 */
+	void getSitePoints(std::vector<glassutil::CGeoPoint> *points) const;
+
+	/**
+	 * \brief Recompute the sorted pick distances and azimuths used by
+	 * stats() from the current location. Callers must hold hypoMutex.
+	 */
+	void rebaseStats();
+
+	/**
+	 * \brief Add a pick's distance and azimuth to the sorted values used by
+	 * stats(), if they are current. Callers must hold hypoMutex.
+	 *
+	 * \param pck - A std::shared_ptr to the pick being added
+	 */
+	void addStatsPick(const std::shared_ptr<CPick> &pck);
+
+	/**
+	 * \brief Remove a pick's distance and azimuth from the sorted values used
+	 * by stats(), if they are current. Callers must hold hypoMutex.
+	 *
+	 * \param pck - A std::shared_ptr to the pick being removed
+	 */
+	void remStatsPick(const std::shared_ptr<CPick> &pck);
+
 	/**
 	 * \brief A pointer to the main CGlass class, used to send output,
 	 * look up travel times, encode/decode time, and call significance
@@ -1123,6 +1233,68 @@ class CHypo {
 	 */
 	std::vector<double> vWts;
 
+	/**
+	 * \brief A boolean flag indicating whether vStatsDistance and
+	 * vStatsAzimuth hold the current picks
+	 */
+	bool bStatsValid;
+
+	/**
+	 * \brief A double value containing the latitude vStatsDistance and
+	 * vStatsAzimuth were measured from
+	 */
+	double dStatsLat;
+
+	/**
+	 * \brief A double value containing the longitude vStatsDistance and
+	 * vStatsAzimuth were measured from
+	 */
+	double dStatsLon;
+
+	/**
+	 * \brief A sorted vector of the distances in degrees to the picks
+	 */
+	std::vector<double> vStatsDistance;
+
+	/**
+	 * \brief A sorted vector of the azimuths in degrees to the picks
+	 */
+	std::vector<double> vStatsAzimuth;
+
+	/**
+	 * \brief A double value containing the sum of the squared distances in
+	 * vStatsDistance
+	 */
+	double dStatsSum2;
+
+	/**
+	 * \brief A double value containing the sum of the distances in
+	 * vStatsDistance to the fourth power
+	 */
+	double dStatsSum4;
+
+	/**
+	 * \brief An integer value incremented whenever vPick changes
+	 */
+	int iPickVersion;
+
+	/**
+	 * \brief The iPickVersion as of the last call to weights()
+	 */
+	int iWtsVersion;
+
+	/**
+	 * \brief A double value containing the latitude as of the last call to
+	 * weights()
+	 */
+	double dWtsLat;
+
+	/**
+	 * \brief A double value containing the longitude as of the last call to
+	 * weights()
+	 */
+	double dWtsLon;
+
 	/**
 	 * \brief A vector of shared_ptr's to the pick data that supports this hypo.
 	 */
@@ -18,6 +18,7 @@
 #include <thread>
 #include <random>
 #include "Glass.h"
+#include "HypoQueue.h"
 
 namespace glasscore {
 
@@ -180,16 +181,33 @@ class CHypoList {
 	/**
 	 * \brief Find CHypo in given time range
 	 *
-	 * Use a binary search to find a hypocenter in
-	 * vHypo with origin time within given range
+	 * Use the time index to find the earliest hypocenter with origin time
+	 * within given range
 	 *
 	 * \param t1 - Starting time of selection range in gregorian seconds
 	 * \param t2 - Ending time of selection range in gregorian seconds
-	 * \return First CHypo in vHypo withing range,
+	 * \return First CHypo withing range,
 	 * or NULL if none fit in the time range.
 	 */
 	std::shared_ptr<CHypo> findHypo(double t1, double t2);
 
+	/**
+	 * \brief Find the closest CHypo to a location in given time range
+	 *
+	 * Use the time index to find the hypocenters with origin time within the
+	 * given range, and return the one closest to the given location, if it
+	 * is within the given distance.
+	 *
+	 * \param t1 - Starting time of selection range in gregorian seconds
+	 * \param t2 - Ending time of selection range in gregorian seconds
+	 * \param lat - The geographic latitude to match in degrees
+	 * \param lon - The geographic longitude to match in degrees
+	 * \param xWindow - The distance a hypo must be within in degrees
+	 * \return Closest CHypo within range and distance, or NULL if none fit
+	 */
+	std::shared_ptr<CHypo> findHypo(double t1, double t2, double lat,
+									double lon, double xWindow);
+
 	/**
 	 * \brief Get the current size of the hypocenter processing queue
 	 */
@@ -204,7 +222,8 @@ class CHypoList {
 	/**
 	 * \brief Get list of CHypos in given time range
 	 *
-	 * Get a list of hypocenters in vHypo with origin time within given range
+	 * Get a list of hypocenters with origin time within given range, in
+	 * origin time order
 	 *
 	 * \param t1 - Starting time of selection range
 	 * \param t2 - Ending time of selection range
@@ -239,15 +258,16 @@ class CHypoList {
 	/**
 	 * \brief Get insertion index for hypo
 	 *
-	 * This function looks up the proper insertion index for the vector given an
-	 * origin time using a binary search to identify the index element
-	 * is less than the time provided, and the next element is greater.
+	 * This function looks up the position in the time index of the last
+	 * hypocenter with an origin time less than or equal to the time provided.
+	 * Note that it counts from the start of the index, so is linear in the
+	 * number of hypocenters.
 	 *
 	 * \param tOrg - A double value containing the origin time to use, in
 	 * julian seconds of the hypo to add.
 	 * \return Returns the insertion index, if the insertion is before
 	 * the beginning, -1 is returned, if insertion is after the last element,
-	 * the index of the last element is returned, if the vector is empty,
+	 * the index of the last element is returned, if the index is empty,
 	 * -2 is returned.
 	 */
 	int indexHypo(double tOrg);
@@ -260,6 +280,20 @@ class CHypoList {
 	 */
 	void listHypos();
 
+	/**
+	 * \brief Move a hypocenter in the time index
+	 *
+	 * Called by CHypo whenever its origin time changes, so the time index
+	 * stays in origin time order without resorting. Does nothing if the
+	 * hypocenter is not in the list.
+	 *
+	 * \param hypo - A pointer to the hypocenter that moved
+	 * \param oldTOrg - A double value containing the origin time the
+	 * hypocenter was indexed at
+	 * \param newTOrg - A double value containing the new origin time
+	 */
+	void moveHypo(const CHypo * hypo, double oldTOrg, double newTOrg);
+
 	/** \brief Try to merge events close in space time
 	 *
 	 * 	Tries to created a new event from picks of two nearby events
@@ -273,17 +307,31 @@ class CHypoList {
 	 * \brief Add hypo to processing queue
 	 *
 	 * Add the given hypocenter to the processing queue if it
-	 * is not already in the queue.
+	 * is not already in the queue, otherwise update its priority and
+	 * count the push as new data for it.
 	 *
 	 * \param hyp - A std::shared_ptr to the hypocenter to add
 	 * \return Returns the current size of the processing queue
 	 */
 	int pushFifo(std::shared_ptr<CHypo> hyp);
 
+	/**
+	 * \brief Compute a hypo's processing priority
+	 *
+	 * Computes the priority used to order the processing queue from the
+	 * hypo's bayesian value relative to its threshold, whether it is about
+	 * to be reported for the first time, and how many of its processing
+	 * cycles it has used, weighted by the HypoPriority configuration.
+	 *
+	 * \param hyp - A std::shared_ptr to the hypocenter
+	 * \return Returns the priority, higher is processed sooner
+	 */
+	double getPriority(std::shared_ptr<CHypo> hyp);
+
 	/**
 	 * \brief Get hypo from processing queue
 	 *
-	 * Get the first hypocenter from the processing queue.
+	 * Get the highest priority hypocenter from the processing queue.
 	 *
 	 * \return Returns a std::shared_ptr to the hypocenter retrieved
 	 * from the queue.
@@ -306,9 +354,10 @@ class CHypoList {
 	/**
 	 * \brief Cause CHypoList to generate a Hypo message for a hypocenter
 	 *
-	 * Causes CHypoList to generate a json formatted hypocenter message
-	 * for the id in the given ReqHypo message and send a pointer to this object
-	 * to CGlass (and out of glasscore) by calling the hypo's Hypo() function
+	 * Causes CHypoList to generate a hypocenter record for the id in the
+	 * given ReqHypo message and send a pointer to this record to CGlass (and
+	 * out of glasscore) by calling the hypo's hypoRecord() function. The
+	 * record is a full snapshot unless the message sets Delta to true.
 	 *
 	 * \param com - A pointer to a json::object containing the id of the
 	 * hypocenter to use
@@ -327,6 +376,17 @@ class CHypoList {
 	 */
 	bool resolve(std::shared_ptr<CHypo> hyp);
 
+	/**
+	 * \brief CExecutor setter
+	 *
+	 * When an executor is set, each hypo added to the processing queue is
+	 * processed by one of its evolution tasks instead of by the hypo list's
+	 * own threads.
+	 * \param executor - the CExecutor pointer, NULL to use the hypo list's
+	 * own threads
+	 */
+	void setExecutor(glassutil::CExecutor* executor);
+
 	/**
 	 * \brief CGlass setter
 	 * \param glass - the CGlass pointer
@@ -346,6 +406,14 @@ class CHypoList {
 	 */
 	bool statusCheck();
 
+
+	/**
+	 * \brief Estimate memory usage
+	 * \return the approximate number of bytes used by the hypo list and the
+	 * hypos in it
+	 */
+	size_t getMemoryUsage();
+
  private:
 	/**
 	 * \brief the job sleep
@@ -370,9 +438,17 @@ class CHypoList {
 	void setStatus(bool status);
 
 	/**
-	 * \brief HypoList sort function
+	 * \brief Remove a hypocenter from the time index
+	 *
+	 * Callers must hold m_TimeIndexMutex.
+	 *
+	 * \param hypo - A pointer to the hypocenter to remove
+	 * \param tOrg - A double value containing the origin time the hypocenter
+	 * is expected to be indexed at, the whole index is searched if it isn't
+	 * found there
+	 * \return Returns true if the hypocenter was found and removed
 	 */
-	void sort();
+	bool eraseTimeIndex(const CHypo * hypo, double tOrg);
 
 	/**
 	 * \brief A pointer to the parent CGlass class, used to send output,
@@ -380,6 +456,12 @@ class CHypoList {
 	 */
 	CGlass *pGlass;
 
+	/**
+	 * \brief A pointer to the CExecutor that runs the evolution tasks, or
+	 * NULL if the hypo list runs its own threads
+	 */
+	glassutil::CExecutor *pExecutor;
+
 	/**
 	 * \brief An integer containing the total number of hypocenters
 	 * ever added to CHypoList
@@ -399,24 +481,32 @@ class CHypoList {
 	int nHypo;
 
 	/**
-	 * \brief A std::vector containing the queue of hypocenters that need
-	 * to be processed
+	 * \brief A CHypoQueue containing the priority queue of hypocenters that
+	 * need to be processed
 	 */
-	std::vector<std::string> qFifo;
+	CHypoQueue qFifo;
 
 	/**
-	 * \brief the std::mutex for qFifo
+	 * \brief the std::mutex for qFifo, always the last hypo list mutex
+	 * locked, and never held while locking a hypo
 	 */
 	std::mutex m_QueueMutex;
 
 	/**
-	 * \brief A std::vector mapping the origin time of each hypocenter
-	 * in CHypoList to it's std::string hypo id.
+	 * \brief A std::multimap containing a std::shared_ptr to each hypocenter
+	 * in CHypoList indexed by its current origin time.
 	 *
-	 * Note that the origin time is never updated after the hypocenter is
-	 * first added to CHypoList
+	 * CHypo::setTOrg calls moveHypo, so the index is kept in origin time
+	 * order as hypocenters relocate.
+	 */
+	std::multimap<double, std::shared_ptr<CHypo>> mTimeIndex;
+
+	/**
+	 * \brief the std::mutex for mTimeIndex. It is locked from within
+	 * CHypo::setTOrg while the hypo is locked, so nothing else may be locked
+	 * while it is held.
 	 */
-	std::vector<std::pair<double, std::string>> vHypo;
+	mutable std::mutex m_TimeIndexMutex;
 
 	/**
 	 * \brief A std::map containing a std::shared_ptr to each hypocenter
@@ -425,7 +515,7 @@ class CHypoList {
 	std::map<std::string, std::shared_ptr<CHypo>> mHypo;
 
 	/**
-	 * \brief A recursive_mutex to control threading access to vHypo.
+	 * \brief A recursive_mutex to control threading access to mHypo.
 	 * NOTE: recursive mutexes are frowned upon, so maybe redesign around it
 	 * see: http://www.codingstandard.com/rule/18-3-3-do-not-use-stdrecursive_mutex/
 	 * However a recursive_mutex allows us to maintain the original class
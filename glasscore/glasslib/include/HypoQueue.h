@@ -0,0 +1,210 @@
+/*****************************************
+ * This file is documented for Doxygen.
+ * If you modify this file please update
+ * the comments so that Doxygen will still
+ * be able to work.
+ ****************************************/
+#ifndef HYPOQUEUE_H
+#define HYPOQUEUE_H
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace glasscore {
+
+/**
+ * \brief glasscore hypocenter processing queue class
+ *
+ * The CHypoQueue class is the queue of hypocenter ids waiting to be
+ * processed by CHypoList. It is an indexed binary heap, so pushing and
+ * popping are O(log n) and checking whether a hypo is already queued is
+ * O(1).
+ *
+ * Each queued hypo has a key made of:
+ * - the priority given when it was last pushed,
+ * - plus the data weight for each push after the first, since a hypo is
+ *   pushed again whenever new data is added to it,
+ * - minus the aging weight times the time it was first queued, so hypos
+ *   that have waited longer move ahead and none are starved.
+ *
+ * The hypo with the highest key is popped first. Ties go to the hypo queued
+ * first, so with all weights and priorities zero the queue is a plain FIFO.
+ *
+ * CHypoQueue is not thread safe, CHypoList guards it with its queue mutex.
+ */
+class CHypoQueue {
+ public:
+	/**
+	 * \brief CHypoQueue constructor
+	 */
+	CHypoQueue();
+
+	/**
+	 * \brief CHypoQueue destructor
+	 */
+	~CHypoQueue();
+
+	/**
+	 * \brief CHypoQueue clear function
+	 *
+	 * Removes every hypo from the queue, keeping the weights
+	 */
+	void clear();
+
+	/**
+	 * \brief Push a hypo onto the queue
+	 *
+	 * Adds a hypo to the queue, or if it is already queued, updates its
+	 * priority and counts the push as new data, keeping its place in line
+	 * otherwise.
+	 *
+	 * \param pid - A std::string containing the id of the hypo to push
+	 * \param priority - A double value containing the hypo's current
+	 * priority
+	 * \param tNow - A double value containing the current time in epoch
+	 * seconds, used for aging
+	 * \return Returns true if the hypo was added, false if it was already
+	 * queued
+	 */
+	bool push(const std::string &pid, double priority, double tNow);
+
+	/**
+	 * \brief Pop the highest priority hypo off the queue
+	 *
+	 * \return Returns a std::string containing the id of the hypo, or an
+	 * empty string if the queue is empty
+	 */
+	std::string pop();
+
+	/**
+	 * \brief Remove a hypo from the queue
+	 *
+	 * \param pid - A std::string containing the id of the hypo to remove
+	 * \return Returns true if the hypo was queued and removed, false
+	 * otherwise
+	 */
+	bool remove(const std::string &pid);
+
+	/**
+	 * \brief Check whether a hypo is queued
+	 *
+	 * \param pid - A std::string containing the id of the hypo to check
+	 * \return Returns true if the hypo is queued, false otherwise
+	 */
+	bool contains(const std::string &pid) const;
+
+	/**
+	 * \brief Get the queue size
+	 *
+	 * \return Returns the number of hypos in the queue
+	 */
+	int size() const;
+
+	/**
+	 * \brief Set the weights used to build the keys
+	 *
+	 * \param dataWeight - A double value containing the amount added to a
+	 * hypo's key for each push after the first
+	 * \param agingWeight - A double value containing the amount added to a
+	 * hypo's key for each second it has waited
+	 */
+	void setWeights(double dataWeight, double agingWeight);
+
+	/**
+	 * \brief Estimate memory usage
+	 *
+	 * \return Returns the approximate number of bytes used by the queue
+	 */
+	size_t getMemoryUsage() const;
+
+ private:
+	/**
+	 * \brief A queued hypo
+	 */
+	struct QueueEntry {
+		/**
+		 * \brief The id of the hypo
+		 */
+		std::string sPid;
+
+		/**
+		 * \brief The priority given when the hypo was last pushed
+		 */
+		double dPriority;
+
+		/**
+		 * \brief The time the hypo was first queued in epoch seconds
+		 */
+		double tQueued;
+
+		/**
+		 * \brief The number of times the hypo was pushed while queued
+		 */
+		int nPush;
+
+		/**
+		 * \brief The order in which the hypo was queued, for ties
+		 */
+		uint64_t iSequence;
+
+		/**
+		 * \brief The heap key built from the above
+		 */
+		double dKey;
+	};
+
+	/**
+	 * \brief Compute the key of an entry from the current weights
+	 */
+	double key(const QueueEntry &entry) const;
+
+	/**
+	 * \brief Check whether the entry at index a should pop before the entry
+	 * at index b
+	 */
+	bool before(int a, int b) const;
+
+	/**
+	 * \brief Swap two entries in the heap, updating the index
+	 */
+	void swapEntries(int a, int b);
+
+	/**
+	 * \brief Move an entry up the heap to its place
+	 */
+	void siftUp(int index);
+
+	/**
+	 * \brief Move an entry down the heap to its place
+	 */
+	void siftDown(int index);
+
+	/**
+	 * \brief The heap of queued hypos
+	 */
+	std::vector<QueueEntry> vHeap;
+
+	/**
+	 * \brief The index of each queued hypo id in vHeap
+	 */
+	std::unordered_map<std::string, int> mIndex;
+
+	/**
+	 * \brief The sequence number for the next new entry
+	 */
+	uint64_t iNextSequence;
+
+	/**
+	 * \brief The amount added to a key for each push after the first
+	 */
+	double dDataWeight;
+
+	/**
+	 * \brief The amount added to a key for each second waited
+	 */
+	double dAgingWeight;
+};
+}  // namespace glasscore
+#endif  // HYPOQUEUE_H
@@ -0,0 +1,172 @@
+/*****************************************
+ * This file is documented for Doxygen.
+ * If you modify this file please update
+ * the comments so that Doxygen will still
+ * be able to work.
+ ****************************************/
+#ifndef HYPORECORD_H
+#define HYPORECORD_H
+
+#include <json.h>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace glasscore {
+
+/**
+ * \brief glasscore associated data record structure
+ *
+ * The AssociatedDataRecord structure holds the association information
+ * computed by glasscore for a single pick or correlation supporting a
+ * hypocenter, along with a shared pointer to the original input message
+ * for that data. The input message is shared, not copied.
+ */
+struct AssociatedDataRecord {
+	/**
+	 * \brief An enumeration identifying the kind of supporting data
+	 */
+	enum class DataType {
+		Pick,
+		Correlation
+	};
+
+	/**
+	 * \brief The kind of supporting data in this record
+	 */
+	DataType eType;
+
+	/**
+	 * \brief A std::string containing the glasscore id of the data
+	 */
+	std::string sPid;
+
+	/**
+	 * \brief A std::string containing the scnl of the data's site
+	 */
+	std::string sSite;
+
+	/**
+	 * \brief A double containing the arrival time of the data in
+	 * julian seconds
+	 */
+	double tArrival;
+
+	/**
+	 * \brief A std::string containing the associated phase name
+	 */
+	std::string sPhase;
+
+	/**
+	 * \brief A double containing the distance from the hypocenter to the
+	 * data's site in degrees
+	 */
+	double dDistance;
+
+	/**
+	 * \brief A double containing the azimuth from the hypocenter to the
+	 * data's site in degrees
+	 */
+	double dAzimuth;
+
+	/**
+	 * \brief A double containing the travel time residual in seconds
+	 */
+	double dResidual;
+
+	/**
+	 * \brief A double containing the significance of the residual
+	 */
+	double dSigma;
+
+	/**
+	 * \brief A shared pointer to the (immutable) input json message that
+	 * created this data, NULL if the data was not created from a message
+	 */
+	std::shared_ptr<const json::Object> jSource;
+};
+
+/**
+ * \brief glasscore hypocenter record structure
+ *
+ * The HypoRecord structure is an immutable snapshot of a CHypo generated
+ * when a hypocenter is reported. It is passed by shared pointer from
+ * glasscore to output, where it is serialized directly to a detection
+ * message without building an intermediate json::Object tree.
+ */
+struct HypoRecord {
+	/**
+	 * \brief A std::string containing the hypocenter id
+	 */
+	std::string sPid;
+
+	/**
+	 * \brief A std::string containing the name of the web that nucleated
+	 * the hypocenter
+	 */
+	std::string sWebName;
+
+	/**
+	 * \brief An integer containing the reported version of the hypocenter
+	 */
+	int iVersion;
+
+	/**
+	 * \brief A boolean flag indicating whether a full snapshot of the
+	 * hypocenter was requested, rather than allowing an incremental update
+	 */
+	bool bSnapshot;
+
+	/**
+	 * \brief A double containing the origin time in julian seconds
+	 */
+	double tOrg;
+
+	/**
+	 * \brief A std::string containing the origin time as an ISO8601 string
+	 */
+	std::string sOrgTime;
+
+	/**
+	 * \brief A double containing the latitude in degrees
+	 */
+	double dLat;
+
+	/**
+	 * \brief A double containing the longitude in degrees
+	 */
+	double dLon;
+
+	/**
+	 * \brief A double containing the depth in kilometers
+	 */
+	double dZ;
+
+	/**
+	 * \brief A double containing the minimum distance in degrees
+	 */
+	double dMin;
+
+	/**
+	 * \brief A double containing the azimuthal gap in degrees
+	 */
+	double dGap;
+
+	/**
+	 * \brief A double containing the bayesian statistic
+	 */
+	double dBayes;
+
+	/**
+	 * \brief A double containing the initial bayesian statistic
+	 */
+	double dBayesInitial;
+
+	/**
+	 * \brief A vector of the picks and correlations supporting the
+	 * hypocenter
+	 */
+	std::vector<AssociatedDataRecord> vData;
+};
+}  // namespace glasscore
+#endif  // HYPORECORD_H
@@ -9,6 +9,7 @@
 
 #include <json.h>
 #include <memory>
+#include "HypoRecord.h"
 
 namespace glasscore {
 
@@ -32,6 +33,16 @@ struct IGlassSend {
 	 * to send to glasscore.
 	 */
 	virtual void Send(std::shared_ptr<json::Object> com) = 0;
+
+	/**
+	 * \brief Send a hypocenter record from glasscore
+	 *
+	 * This pure virtual function is implemented by a concrete class to
+	 * receive typed hypocenter records from glasscore.
+	 *
+	 * \param hypo - A shared pointer to the immutable HypoRecord to send
+	 */
+	virtual void Send(std::shared_ptr<const HypoRecord> hypo) = 0;
 };
 }  // namespace glasscore
 #endif  // IGLASSSEND_H
@@ -7,8 +7,7 @@
 #ifndef LINK_H
 #define LINK_H
 
-#include <tuple>
-#include <memory>
+#include <mutex>
 
 namespace glasscore {
 
@@ -16,20 +15,92 @@ namespace glasscore {
 class CNode;
 class CSite;
 
-// defines indexes for links
-#define LINK_PTR 0  // Node or site pointer
-#define LINK_TT1 1  // First travel time
-#define LINK_TT2 2  // Second travel time
+/**
+ * \brief The mutex serializing node-site link teardown
+ *
+ * Clearing a node or a site calls back into each linked peer through a plain
+ * pointer. Both hold this mutex for the whole teardown, so a peer being
+ * cleared at the same time, such as a site dropped while its web is removed,
+ * waits until the calls into it are done rather than being freed under them.
+ * \return Returns a reference to the teardown mutex
+ */
+inline std::mutex &getLinkTeardownMutex() {
+	static std::mutex teardownMutex;
+	return (teardownMutex);
+}
 
 /**
- * \brief Typedef to simplify use of a site-node link uses weak_ptr to
- * prevent a cyclical reference
+ * \brief A site-node link, stored by value in the site's link array.
+ *
+ * The node is referenced by a plain pointer rather than a smart pointer so
+ * that scanning the links during nucleation does no reference counting.
+ * The link lifetime is managed explicitly, a node and a site always unlink
+ * each other when either one is cleared, under getLinkTeardownMutex().
  */
-typedef std::tuple<std::weak_ptr<CNode>, double, double> NodeLink;
+struct NodeLink {
+	/**
+	 * \brief A pointer to the linked node
+	 */
+	CNode *pNode;
+
+	/**
+	 * \brief A double value containing the first travel time
+	 */
+	double dTravelTime1;
+
+	/**
+	 * \brief A double value containing the second travel time
+	 */
+	double dTravelTime2;
+};
 
 /**
- * \brief Typedef to simplify use of a node-site link
+ * \brief A node-site link, stored by value in the node's link array.
+ *
+ * Along with the travel times the link carries the precomputed azimuth and
+ * distance from the site to the node used for beam matching. As with
+ * NodeLink, the site is referenced by a plain pointer with explicitly managed
+ * lifetime.
  */
-typedef std::tuple<std::shared_ptr<CSite>, double, double> SiteLink;
+struct SiteLink {
+	/**
+	 * \brief A pointer to the linked site
+	 */
+	CSite *pSite;
+
+	/**
+	 * \brief A double value containing the first travel time
+	 */
+	double dTravelTime1;
+
+	/**
+	 * \brief A double value containing the second travel time
+	 */
+	double dTravelTime2;
+
+	/**
+	 * \brief A float value containing the azimuth from the site to the node
+	 * in degrees
+	 */
+	float fAzimuth;
+
+	/**
+	 * \brief A float value containing the distance from the site to the node
+	 * in degrees
+	 */
+	float fDistance;
+
+	/**
+	 * \brief A float value containing the predicted slowness of the first
+	 * phase at the site in seconds per degree, -1 if not known
+	 */
+	float fSlowness1;
+
+	/**
+	 * \brief A float value containing the predicted slowness of the second
+	 * phase at the site in seconds per degree, -1 if not known
+	 */
+	float fSlowness2;
+};
 }  // namespace glasscore
 #endif  // LINK_H
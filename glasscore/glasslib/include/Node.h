@@ -12,8 +12,8 @@
 #include <string>
 #include <utility>
 #include <mutex>
-#include <tuple>
 #include "Geo.h"
+#include "GeoPoint.h"
 #include "Link.h"
 
 namespace glasscore {
@@ -80,6 +80,9 @@ class CNode {
 
 	/**
 	 * \brief Delink all sites to/from this node.
+	 *
+	 * Must be called before the node is destroyed, since the sites refer back
+	 * to this node by plain pointer. The destructor and clear() do so.
 	 */
 	void clearSiteLinks();
 
@@ -108,28 +111,38 @@ class CNode {
 	 * \brief CNode node-site and site-node linker
 	 *
 	 * Add a link to/from this node to the provided site
-	 * using the provided travel time
+	 * using the provided travel time. The azimuth and distance from the
+	 * site to this node are computed once here and stored in the link for
+	 * beam matching during nucleation.
 	 *
 	 * \param travelTime1 - A double value containing the first travel time to
 	 * use for the link
 	 * \param travelTime2 - A double value containing the optional second travel
 	 * time to use for the link, defaults to -1 (no travel time)
+	 * \param slowness1 - A double value containing the optional slowness of
+	 * the first phase at the site in seconds per degree, defaults to -1 (no
+	 * slowness)
+	 * \param slowness2 - A double value containing the optional slowness of
+	 * the second phase at the site in seconds per degree, defaults to -1 (no
+	 * slowness)
 	 * \param site - A shared_ptr<CSite> to the site to link
 	 * \param node - A shared_ptr<CNode> to the node to link (should be itself)
 	 * \return - Returns true if successful, false otherwise
 	 */
 	bool linkSite(std::shared_ptr<CSite> site, std::shared_ptr<CNode> node,
-					double travelTime1, double travelTime2 = -1);
+					double travelTime1, double travelTime2 = -1,
+					double slowness1 = -1, double slowness2 = -1);
 
 	/**
 	 * \brief CNode node-site and site-node unlinker
 	 *
 	 * Remove the given site to/from this node
 	 *
-	 * \param site - A std::shared_ptr<CSite> to the site to remove
+	 * \param site - A pointer to the linked CSite to remove, as returned by
+	 * getSite()
 	 * \return - Returns true if successful, false otherwise
 	 */
-	bool unlinkSite(std::shared_ptr<CSite> site);
+	bool unlinkSite(CSite *site);
 
 	/**
 	 * \brief CNode unlink last site from node
@@ -165,28 +178,29 @@ class CNode {
 	 * \return Returns best significance if there is at least one valid travel
 	 * time, -1.0 otherwise
 	 */
-	double getBestSig(double tObservedTT, SiteLink link);
+	double getBestSig(double tObservedTT, const SiteLink &link);
 
 	/**
 	 * \brief CNode get site function
 	 *
-	 * Given a site id, get the site if it is used by the node
+	 * Given a site, get the node's link to the same site if it is used by
+	 * the node, compared by interned site id
 	 *
-	 * \param sScnl - A string containing the id of the site to get
-	 * \return Returns a shared pointer to the CSite object if found, null
+	 * \param site - A pointer to the CSite to look for
+	 * \return Returns a pointer to the linked CSite object if found, null
 	 * otherwise
 	 */
-	std::shared_ptr<CSite> getSite(std::string sScnl);
+	CSite * getSite(const CSite *site);
 
 	/**
 	 * \brief CNode get last site function
 	 *
 	 * Get the last site linked to the node
 	 *
-	 * \return Returns a shared pointer to the last CSite object if found, null
+	 * \return Returns a pointer to the last CSite object if found, null
 	 * otherwise
 	 */
-	std::shared_ptr<CSite> getLastSite();
+	CSite * getLastSite();
 
 	/**
 	 * \brief CNode site link sort function
@@ -273,6 +287,14 @@ class CNode {
 	 */
 	const std::string& getPid() const;
 
+
+	/**
+	 * \brief Estimate memory usage
+	 * \return the approximate number of bytes used by this node and its
+	 * links to sites
+	 */
+	size_t getMemoryUsage() const;
+
  private:
 	/**
 	 * \brief A pointer to the parent CWeb class, used get configuration,
@@ -320,8 +342,8 @@ class CNode {
 	bool bEnabled;
 
 	/**
-	 * \brief A std::vector of tuples linking node to site
-	 * {shared site pointer, travel time 1, travel time 2}
+	 * \brief A std::vector of SiteLink records linking node to site, stored
+	 * contiguously by value and sorted by travel time
 	 */
 	std::vector<SiteLink> vSite;
 
@@ -19,6 +19,8 @@ namespace glasscore {
 class CSite;
 class CHypo;
 class CSiteList;
+class CTrigger;
+class CGlass;
 
 /**
  * \brief glasscore pick class
@@ -125,6 +127,24 @@ class CPick {
 	void addHypo(std::shared_ptr<CHypo> hyp, std::string ass = "", bool force =
 							false);
 
+	/**
+	 * \brief Move this pick from one hypo to another
+	 *
+	 * Links this pick to the given hypo only if it is still linked to the
+	 * hypo the caller expects, so hypos competing for the pick can decide
+	 * without holding each other's locks. The loser sees the change and
+	 * tries again later.
+	 *
+	 * \param oldHyp - A std::shared_ptr to the hypocenter the pick is
+	 * expected to be linked to, NULL if it is expected to be unlinked
+	 * \param newHyp - A std::shared_ptr to the hypocenter to link
+	 * \param ass - A std::string containing a note about the association reason
+	 * \return Returns true if the link was changed, false if the pick was
+	 * no longer linked to oldHyp
+	 */
+	bool replaceHypo(std::shared_ptr<CHypo> oldHyp,
+						std::shared_ptr<CHypo> newHyp, std::string ass = "");
+
 	/**
 	 * \brief Remove hypo reference to this pick
 	 *
@@ -213,6 +233,13 @@ class CPick {
 	 */
 	const std::shared_ptr<CSite> getSite() const;
 
+	/**
+	 * \brief Site id getter
+	 * \return the interned id of the site, or -1 if the site is not in a
+	 * site list
+	 */
+	int getSiteId() const;
+
 	/**
 	 * \brief Association string getter
 	 * \return the association string
@@ -243,7 +270,32 @@ class CPick {
 	 */
 	double getTPick() const;
 
+
+	/**
+	 * \brief Estimate memory usage
+	 * \return the approximate number of bytes used by this pick, including
+	 * its input json
+	 */
+	size_t getMemoryUsage() const;
+
  private:
+	/**
+	 * \brief Screen a trigger before building a hypo from it
+	 *
+	 * Building and annealing a hypo is the most expensive part of
+	 * nucleation, so check first whether the trigger can possibly make a
+	 * new hypo. The trigger is dropped if a coarse locate from the node
+	 * travel times, which errs on the high side, can't reach the web's
+	 * nucleation cut and threshold, or if too few of its picks are free of
+	 * a nearby existing hypo that it can't outweigh.
+	 *
+	 * \param trigger - A std::shared_ptr to the trigger to screen
+	 * \param glass - A pointer to the CGlass
+	 * \return Returns true if a hypo should be built from the trigger, false
+	 * otherwise
+	 */
+	bool screen(std::shared_ptr<CTrigger> trigger, CGlass *glass);
+
 	/**
 	 * \brief A std::weak_ptr to a CSite object
 	 * representing the link between this pick and the site it was
@@ -253,6 +305,13 @@ class CPick {
 	 */
 	std::weak_ptr<CSite> wpSite;
 
+	/**
+	 * \brief An integer containing the interned id of the site this pick was
+	 * picked at, so that picks can be compared by site without locking the
+	 * site pointer
+	 */
+	int iSiteId;
+
 	/**
 	 * \brief A std::weak_ptr to a CHypo object
 	 * representing the links between this pick and associated hypocenter.
@@ -163,8 +163,10 @@ class CPickList {
 	/**
 	 * \brief Search for any associable picks that match hypo
 	 *
-	 * Search through all picks within a provided number seconds from the origin
-	 * time of the given hypocenter, adding any picks that meet association
+	 * Search through the picks within a provided number seconds from the origin
+	 * time of the given hypocenter that fall near a predicted arrival time at
+	 * a site within the hypocenter's distance cutoff (see
+	 * CHypo::getCandidatePicks()), adding any picks that meet association
 	 * criteria to the given hypocenter.
 	 *
 	 * \param hyp - A shared_ptr to a CHypo object containing the hypocenter
@@ -176,23 +178,6 @@ class CPickList {
 	 */
 	bool scavenge(std::shared_ptr<CHypo> hyp, double tDuration = 2400.0);
 
-	/**
-	 * \brief Generate rogue list for tuning process
-	 *
-	 * Search through all picks within a provided number of seconds from the
-	 * given origin time, creating a vector of all picks that could be
-	 * associated with given hypocenter ID, but are actually either unassociated
-	 * or associated with another hypocenter
-	 *
-	 * \param pidHyp - A std::string containing the id of the hypocenter to use
-	 * \param tOrg - A double value containing the origin time in julian seconds
-	 * of the hypocenter to use.
-	 * \param tDuration - A double value containing the duration to search picks
-	 * from origin time in seconds, defaults to 2400.0
-	 */
-	std::vector<std::shared_ptr<CPick>> rogues(std::string pidHyp, double tOrg,
-												double tDuration = 2400.0);
-
 	/**
 	 * \brief check to see if each thread is still functional
 	 *
@@ -224,6 +209,16 @@ class CPickList {
 	 */
 	void setSiteList(CSiteList* siteList);
 
+	/**
+	 * \brief CExecutor setter
+	 *
+	 * When an executor is set, new picks are processed by its nucleation
+	 * tasks instead of by the pick list's own threads.
+	 * \param executor - the CExecutor pointer, NULL to use the pick list's
+	 * own threads
+	 */
+	void setExecutor(glassutil::CExecutor* executor);
+
 	/**
 	 * \brief nPick getter
 	 * \return the nPick
@@ -253,6 +248,14 @@ class CPickList {
 	 */
 	int getVPickSize() const;
 
+
+	/**
+	 * \brief Estimate memory usage
+	 * \return the approximate number of bytes used by the pick list and the
+	 * picks in it
+	 */
+	size_t getMemoryUsage();
+
  private:
 	/**
 	 * \brief Process the next pick on the queue
@@ -261,6 +264,14 @@ class CPickList {
 	 */
 	void processPick();
 
+	/**
+	 * \brief Process a pick
+	 *
+	 * Attempts to associate and nuclate the given pick.
+	 * \param pck - A std::shared_ptr to the pick to process
+	 */
+	void process(std::shared_ptr<CPick> pck);
+
 	/**
 	 * \brief the job sleep
 	 *
@@ -289,6 +300,12 @@ class CPickList {
 	 */
 	CSiteList *pSiteList;
 
+	/**
+	 * \brief A pointer to the CExecutor that runs the nucleation tasks, or
+	 * NULL if the pick list runs its own threads
+	 */
+	glassutil::CExecutor *pExecutor;
+
 	/**
 	 * \brief An integer containing the total number of picks ever added to
 	 * CPickList
@@ -14,7 +14,9 @@
 #include <utility>
 #include <tuple>
 #include <mutex>
+#include <atomic>
 #include "Geo.h"
+#include "GeoPoint.h"
 #include "Link.h"
 
 namespace glasscore {
@@ -26,6 +28,92 @@ class CGlass;
 class CTrigger;
 class CHypo;
 
+/**
+ * \brief glasscore site pick record
+ *
+ * A compact copy of the pick values needed to scan a site's picks during
+ * nucleation, stored in the CSite pick ring so that readers can search a
+ * time window without locking or touching the CPick objects.
+ */
+struct PickRecord {
+	/**
+	 * \brief A double value containing the arrival time of the pick in
+	 * julian seconds
+	 */
+	double tPick;
+
+	/**
+	 * \brief A double value containing the back azimuth of the pick, or -1
+	 * if not present
+	 */
+	double dBackAzimuth;
+
+	/**
+	 * \brief A double value containing the slowness of the pick, or -1 if
+	 * not present
+	 */
+	double dSlowness;
+
+	/**
+	 * \brief An integer value containing the id of the pick
+	 */
+	int idPick;
+
+	/**
+	 * \brief A boolean flag indicating that the pick has been removed from
+	 * the site, and the record is waiting to be reclaimed
+	 */
+	bool bRemoved;
+};
+
+/**
+ * \brief glasscore site pick ring slot
+ *
+ * The storage for one PickRecord in the CSite pick ring. The values are
+ * atomic so that a reader can copy them while a pick is being added or
+ * removed, the sequence lock tells the reader to retry if that happened.
+ */
+struct PickSlot {
+	/**
+	 * \brief Copy the record out of the slot, using relaxed loads
+	 *
+	 * \return Returns the PickRecord held in the slot
+	 */
+	PickRecord load() const;
+
+	/**
+	 * \brief Copy a record into the slot, using relaxed stores
+	 *
+	 * \param record - The PickRecord to hold in the slot
+	 */
+	void store(const PickRecord &record);
+
+	/**
+	 * \brief The arrival time of the pick, see PickRecord::tPick
+	 */
+	std::atomic<double> tPick;
+
+	/**
+	 * \brief The back azimuth of the pick, see PickRecord::dBackAzimuth
+	 */
+	std::atomic<double> dBackAzimuth;
+
+	/**
+	 * \brief The slowness of the pick, see PickRecord::dSlowness
+	 */
+	std::atomic<double> dSlowness;
+
+	/**
+	 * \brief The id of the pick, see PickRecord::idPick
+	 */
+	std::atomic<int> idPick;
+
+	/**
+	 * \brief The removed flag of the pick, see PickRecord::bRemoved
+	 */
+	std::atomic<bool> bRemoved;
+};
+
 /**
  * \brief glasscore site (station) class
  *
@@ -37,7 +125,10 @@ class CHypo;
  * CSite maintains graph database links between it and one or more detection
  * nodes
  *
- * CSite maintains a list of picks made at the site
+ * CSite maintains a list of picks made at the site, as a fixed capacity,
+ * time sorted ring. Compact PickRecords are kept alongside the picks, and
+ * are guarded by a sequence lock so that nucleation can read a time window
+ * of records without locking or copying the picks.
  *
  * CSite contains function to support nucleation of a new event based
  * on a potential origin time and each of the detection nodes linked to the site.
@@ -97,6 +188,13 @@ class CSite {
 	 */
 	void clear();
 
+	/**
+	 * \brief Remove all picks from this site
+	 *
+	 * Removes all the picks from the pick ring, sizing the ring to the
+	 * maximum number of picks for this site if needed. The ring is only
+	 * resized while the site is being set up, before any readers.
+	 */
 	void clearVPick();
 
 	/**
@@ -127,6 +225,9 @@ class CSite {
 	 * for teleseismic or not
 	 * \param glassPtr - A pointer to the CGlass class
 	 * \return Returns true if successful, false otherwise
+	 *
+	 * This allocates the pick ring, so it must not be called once the site
+	 * has been linked to any nodes.
 	 */
 	bool initialize(std::string sta, std::string comp, std::string net,
 					std::string loc, double lat, double lon, double elv,
@@ -165,7 +266,7 @@ class CSite {
 	/**
 	 * \brief Add pick to this site
 	 * This function adds the given pick to the list of picks made at this
-	 * site
+	 * site, keeping the list sorted by pick time
 	 *
 	 * \param pck - A shared_ptr to a CPick object containing the pick to add
 	 */
@@ -180,10 +281,53 @@ class CSite {
 	 */
 	void remPick(std::shared_ptr<CPick> pck);
 
+	/**
+	 * \brief Get picks within a time window
+	 * This function returns the picks made at this site with pick times
+	 * between the given start and end times, inclusive, in time order
+	 *
+	 * \param tStart - A double containing the window start time in julian
+	 * seconds
+	 * \param tEnd - A double containing the window end time in julian
+	 * seconds
+	 * \param picks - A pointer to a std::vector to append the picks to
+	 */
+	void getPicks(double tStart, double tEnd,
+					std::vector<std::shared_ptr<CPick>> *picks) const;
+
+	/**
+	 * \brief Get pick records within a time window
+	 * This function copies the records of the picks made at this site with
+	 * pick times between the given start and end times, inclusive, in time
+	 * order. It does not lock; if a pick is added or removed during the
+	 * read, the read is retried.
+	 *
+	 * \param tStart - A double containing the window start time in julian
+	 * seconds
+	 * \param tEnd - A double containing the window end time in julian
+	 * seconds
+	 * \param records - A pointer to a std::vector to hold the records,
+	 * cleared first
+	 */
+	void getPickRecords(double tStart, double tEnd,
+						std::vector<PickRecord> *records) const;
+
+	/**
+	 * \brief Get the pick for a record
+	 * This function looks up the pick for a record returned by
+	 * getPickRecords()
+	 *
+	 * \param record - The PickRecord to look up
+	 * \return Returns a shared_ptr to the CPick, or NULL if the pick has
+	 * since been removed from this site
+	 */
+	std::shared_ptr<CPick> getPick(const PickRecord &record) const;
+
 	/**
 	 * \brief Add node to this site
 	 * This function adds the given pick to the list of nodes serviced by this
-	 * site
+	 * site. Called by CNode::linkSite(), which also links the node to this
+	 * site so that the two can unlink each other.
 	 *
 	 * \param node - A shared_ptr to a CNode object containing the node to add
 	 * \param travelTime1 - A double value containing the first travel time
@@ -195,12 +339,21 @@ class CSite {
 					double travelTime2 = -1);
 
 	/**
-	 * \brief Remove pick from this site
+	 * \brief Remove node from this site
 	 * This function removes the given node from the list of nodes linked to this
+	 * site
+	 *
+	 * \param node - A pointer to the CNode to remove
+	 */
+	void remNode(const CNode *node);
+
+	/**
+	 * \brief Delink all nodes to/from this site.
 	 *
-	 * \param nodeID - A string with the id of the node to remove
+	 * Must be called before the site is destroyed, since the nodes refer back
+	 * to this site by plain pointer. The destructor and clear() do so.
 	 */
-	void remNode(std::string nodeID);
+	void clearNodeLinks();
 
 	/**
 	 * \brief Try to nucleate a new event at nodes linked to site
@@ -269,6 +422,13 @@ class CSite {
 	 */
 	glassutil::CGeo &getGeo();
 
+	/**
+	 * \brief CGeoPoint getter
+	 * \return the precomputed geographic point for this site, used for fast
+	 * distance and azimuth calculations
+	 */
+	const glassutil::CGeoPoint &getGeoPoint() const;
+
 	/**
 	 * \brief Max picks for site getter
 	 * \return the max picks for site
@@ -287,6 +447,30 @@ class CSite {
 	 */
 	const std::string& getScnl() const;
 
+	/**
+	 * \brief Site id getter
+	 * \return the dense integer id interned for this site by CSiteList, or -1
+	 * if the site is not in a site list
+	 */
+	int getSiteId() const;
+
+	/**
+	 * \brief Site id setter, used by CSiteList when interning the site
+	 * \param id - the dense integer id for this site
+	 */
+	void setSiteId(int id);
+
+	/**
+	 * \brief Check whether a site is the same station as this site
+	 *
+	 * Compares the interned site ids when both sites have one, sites that
+	 * are not in a site list fall back to comparing the SCNL.
+	 *
+	 * \param site - A pointer to the CSite to compare with
+	 * \return Returns true if the sites are the same station
+	 */
+	bool isSameSite(const CSite *site) const;
+
 	/**
 	 * \brief Site getter
 	 * \return the site
@@ -313,7 +497,7 @@ class CSite {
 
 	/**
 	 * \brief vPick getter
-	 * \return the vPick
+	 * \return a copy of the picks at this site, in time order
 	 */
 	const std::vector<std::shared_ptr<CPick>> getVPick() const;
 
@@ -321,19 +505,86 @@ class CSite {
 
 	double * getVec(double * vec);
 
+
+	/**
+	 * \brief Estimate memory usage
+	 * \return the approximate number of bytes used by this site, including
+	 * its pick ring and its links to nodes, but not the picks themselves
+	 */
+	size_t getMemoryUsage() const;
+
  private:
 	/**
 	 * \brief A mutex to control threading access to vPick.
 	 */
 	mutable std::mutex vPickMutex;
 
+	/**
+	 * \brief Find the first pick in the ring at or after a time. Callers
+	 * must hold vPickMutex.
+	 *
+	 * \param tPick - A double containing the time in julian seconds
+	 * \return Returns the ring position (0 is the oldest pick)
+	 */
+	int findPick(double tPick) const;
+
+	/**
+	 * \brief Remove the removed records from the ring, keeping the time
+	 * order. Callers must hold vPickMutex and be within a write.
+	 */
+	void compactPicks();
+
+	/**
+	 * \brief Start a write to the pick ring. Callers must hold vPickMutex.
+	 */
+	void beginPickWrite();
+
+	/**
+	 * \brief Finish a write to the pick ring. Callers must hold vPickMutex.
+	 */
+	void endPickWrite();
+
 	/**
 	 * \brief A std::vector of std::shared_ptr to the picks made at this this
-	 * CSite. A shared_ptr is used here instead of a weak_ptr (to prevent a
-	 * cyclical reference between CPick and CSite) to improve performance
+	 * CSite, used as a ring parallel to vPickRecord. A shared_ptr is used
+	 * here instead of a weak_ptr (to prevent a cyclical reference between
+	 * CPick and CSite) to improve performance
 	 */
 	std::vector<std::shared_ptr<CPick>> vPick;
 
+	/**
+	 * \brief A std::vector of the PickRecords for the picks made at this
+	 * CSite, used as a time sorted ring starting at iPickHead. Allocated
+	 * only by initialize(), before the site is linked to any nodes, so that
+	 * it can be read under nPickSequence without locking.
+	 */
+	std::vector<PickSlot> vPickRecord;
+
+	/**
+	 * \brief An integer containing the index of the oldest pick in the
+	 * ring, atomic so that it can be read under nPickSequence
+	 */
+	std::atomic<int> iPickHead;
+
+	/**
+	 * \brief An integer containing the number of entries in the ring,
+	 * including removed records, atomic so that it can be read under
+	 * nPickSequence
+	 */
+	std::atomic<int> nPick;
+
+	/**
+	 * \brief An integer containing the number of removed records in the
+	 * ring
+	 */
+	int nPickRemoved;
+
+	/**
+	 * \brief The pick ring sequence lock counter, odd while a write is in
+	 * progress
+	 */
+	std::atomic<unsigned int> nPickSequence;
+
 	/**
 	 * \brief A pointer to the main CGlass class used encode/decode time and
 	 * get debugging flags
@@ -346,6 +597,13 @@ class CSite {
 	 */
 	std::string sScnl;
 
+	/**
+	 * \brief An integer containing the dense id CSiteList interned this site
+	 * as, the site's index in the site list, or -1 if not interned. Set once
+	 * before the site is shared, so it is read without locking.
+	 */
+	int iSiteId;
+
 	/**
 	 * \brief A std::string containing the Site (station) name for this site.
 	 */
@@ -371,6 +629,12 @@ class CSite {
 	 */
 	glassutil::CGeo geo;
 
+	/**
+	 * \brief A CGeoPoint containing the precomputed unit vector and sines and
+	 * cosines of the location of this site, kept in step with geo
+	 */
+	glassutil::CGeoPoint geoPoint;
+
 	/**
 	 * \brief A unit vector in Cartesian earth coordinates used to do a quick
 	 * and dirty distance calculation during detection grid formation
@@ -405,8 +669,8 @@ class CSite {
 	mutable std::mutex vNodeMutex;
 
 	/**
-	 * \brief A std::vector of tuples linking site to node
-	 * {shared node pointer, travel-time 1, travel-time 2}
+	 * \brief A std::vector of NodeLink records linking site to node, stored
+	 * contiguously by value
 	 */
 	std::vector<NodeLink> vNode;
 
@@ -11,7 +11,7 @@
 #include <string>
 #include <vector>
 #include <memory>
-#include <map>
+#include <unordered_map>
 #include <mutex>
 #include <thread>
 
@@ -24,11 +24,13 @@ class CGlass;
 /**
  * \brief glasscore site list class
  *
- * The CSiteList class is the class that maintains a std::map of all the seismic
- * stations used by glasscore.
+ * The CSiteList class is the class that maintains a std::vector of all the
+ * seismic stations used by glasscore.
  *
- * CSiteList also maintains a std::vector mapping the string SCNL id
- * to CSite objects
+ * CSiteList interns each new site as a dense integer id, its index in the
+ * std::vector, and maintains a hash index from the string SCNL id to the
+ * site id. Nodes, picks, and correlations compare sites by id, the SCNL is
+ * only needed for input, output, and logging.
  *
  * CSiteList contains functions to support new data input and
  * clearing the list
@@ -127,11 +129,12 @@ class CSiteList {
 
 	/**
 	 * \brief Get site by index
-	 * Gets a specific site using the given index.
+	 * Gets a specific site using the given index, which is also the site id
+	 * interned for the site by addSite()
 	 *
 	 * \param ix - An integer variable containing the index
 	 * \return Returns a shared_ptr to the CSite object containing the desired
-	 * site.
+	 * site, or NULL if the index is out of range
 	 */
 	std::shared_ptr<CSite> getSite(int ix);
 
@@ -198,6 +201,14 @@ class CSiteList {
 	void setHoursBeforeLookingUp(int hoursBeforeLookingUp);
 	int getHoursBeforeLookingUp() const;
 
+
+	/**
+	 * \brief Estimate memory usage
+	 * \return the approximate number of bytes used by the site list and the
+	 * sites in it
+	 */
+	size_t getMemoryUsage() const;
+
  private:
 	void checkSites();
 
@@ -231,16 +242,17 @@ class CSiteList {
 	std::vector<std::shared_ptr<CSite>> vSite;
 
 	/**
-	 * \brief A std::map containing a std::shared_ptr to each site
-	 * in CSiteList indexed by the std::string scnl id.
+	 * \brief A std::unordered_map from the std::string scnl of each site in
+	 * CSiteList to its interned site id, the site's index in vSite. Sites
+	 * are only removed all at once, so the ids stay dense.
 	 */
-	std::map<std::string, std::shared_ptr<CSite>> mSite;
+	std::unordered_map<std::string, int> mSite;
 
 	/**
-	 * \brief A std::map containing a std::shared_ptr to each site
-	 * in CSiteList indexed by the std::string scnl id.
+	 * \brief A std::unordered_map containing the time each site was last
+	 * looked up, indexed by the std::string scnl id.
 	 */
-	std::map<std::string, int> mLookup;
+	std::unordered_map<std::string, int> mLookup;
 
 	/**
 	 * \brief A recursive_mutex to control threading access to CSiteList.
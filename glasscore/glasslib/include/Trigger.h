@@ -21,6 +21,7 @@ namespace glasscore {
 // forward declarations
 class CPick;
 class CWeb;
+class CGlass;
 
 /**
  * \brief glasscore detection trigger class
@@ -60,10 +61,14 @@ class CTrigger {
 	 * \param picks - A std::vector<std::shared_ptr<CPick> containing the picks
 	 * for this trigger
 	 * \param web - A pointer to the creating node's CWeb
+	 * \param links - A std::vector<SiteLink> containing the node's link to
+	 * the site of each pick, in the same order as picks, or empty if the
+	 * travel times are not known
 	 */
 	CTrigger(double lat, double lon, double z, double ot, double resolution,
 				double sum, int count,
-				std::vector<std::shared_ptr<CPick>> picks, CWeb *web);
+				std::vector<std::shared_ptr<CPick>> picks, CWeb *web,
+				std::vector<SiteLink> links = std::vector<SiteLink>());
 
 	/**
 	 * \brief CTrigger destructor
@@ -91,10 +96,14 @@ class CTrigger {
 	 * \param picks - A std::vector<std::shared_ptr<CPick> containing the picks
 	 * for this trigger
 	 * \param web - A pointer to the creating node's web
+	 * \param links - A std::vector<SiteLink> containing the node's link to
+	 * the site of each pick, in the same order as picks, or empty if the
+	 * travel times are not known
 	 */
 	bool initialize(double lat, double lon, double z, double ot,
 					double resolution, double sum, int count,
-					std::vector<std::shared_ptr<CPick>> picks, CWeb *web);
+					std::vector<std::shared_ptr<CPick>> picks, CWeb *web,
+					std::vector<SiteLink> links = std::vector<SiteLink>());
 
 	/**
 	 * \brief CTrigger clear function
@@ -157,6 +166,30 @@ class CTrigger {
 	 */
 	const std::vector<std::shared_ptr<CPick>> getVPick() const;
 
+	/**
+	 * \brief Estimate the bayesian sum of a hypo built from this trigger
+	 *
+	 * Does a coarse locate of the trigger picks using the travel times from
+	 * the node's links instead of building a hypo, only adjusting the origin
+	 * time. The location of the hypo is allowed for by forgiving each pick
+	 * residual by the given slack before it is weighted, and each residual is
+	 * weighted with the widest sigma the hypo uses, so the estimate errs on
+	 * the high side. Picks without a link are counted as fitting perfectly.
+	 *
+	 * \param glass - A pointer to the CGlass to get the association limit
+	 * and significance function from
+	 * \param slack - A double value containing the residual in seconds to
+	 * forgive each pick for the hypo moving away from the node
+	 * \param count - A pointer to an integer to hold the number of picks
+	 * that would survive association pruning at the estimated origin time,
+	 * may be NULL
+	 * \param origin - A pointer to a double to hold the estimated origin
+	 * time, may be NULL
+	 * \return Returns the estimated bayesian sum
+	 */
+	double estimateBayes(CGlass *glass, double slack, int *count,
+						double *origin) const;
+
  private:
 	/**
 	 * \brief A double value containing latitude of this triggerin degrees.
@@ -202,6 +235,12 @@ class CTrigger {
 	 */
 	std::vector<std::shared_ptr<CPick>> vPick;
 
+	/**
+	 * \brief A std::vector of the node's links to the site of each pick in
+	 * vPick, holding the node travel times used to make this trigger
+	 */
+	std::vector<SiteLink> vLink;
+
 	/**
 	 * \brief A pointer to the node CWeb class, used get travel times
 	 */
@@ -17,7 +17,9 @@
 #include <thread>
 #include <queue>
 #include <map>
+#include <functional>
 #include "TravelTime.h"
+#include "Executor.h"
 
 namespace glasscore {
 
@@ -34,9 +36,11 @@ class CPick;
  * The CWeb class represents a detection graph database.  CWeb contains
  * the list of all the detection nodes.
  *
- * CWeb uses smart pointers (std::shared_ptr).
+ * CWeb uses smart pointers (std::shared_ptr).  When run on an executor, a
+ * CWeb must be owned by a std::shared_ptr, so that the executor tasks can
+ * hold a std::weak_ptr to it.
  */
-class CWeb {
+class CWeb : public std::enable_shared_from_this<CWeb> {
  public:
 	/**
 	 * \brief CWeb constructor
@@ -334,7 +338,7 @@ class CWeb {
 	 * \brief add a job
 	 *
 	 * Adds a job to the queue of jobs to be run by the background
-	 * thread
+	 * thread, or by the executor if one is set
 	 * \param newjob - A std::function<void()> bound to the function
 	 * containing the job to run
 	 */
@@ -370,6 +374,18 @@ class CWeb {
 	 */
 	void setSiteList(CSiteList* siteList);
 
+	/**
+	 * \brief CExecutor setter
+	 *
+	 * When an executor is set, the web's jobs are run by its maintenance
+	 * tasks, still one at a time and in the order they were added.  Each
+	 * job must hold a std::shared_ptr to the web, so that the web outlives
+	 * its queued jobs.
+	 * \param executor - the CExecutor pointer, NULL to use the web's own
+	 * threads
+	 */
+	void setExecutor(glassutil::CExecutor* executor);
+
 	/**
 	 * \brief Update getter
 	 * \return a flag indicating whether this web supports updates
@@ -460,6 +476,14 @@ class CWeb {
 	 */
 	int getVNodeSize() const;
 
+
+	/**
+	 * \brief Estimate memory usage
+	 * \return the approximate number of bytes used by the web, its nodes
+	 * and their links to sites, and its travel times
+	 */
+	size_t getMemoryUsage();
+
  private:
 	/**
 	 * \brief the job sleep
@@ -476,6 +500,26 @@ class CWeb {
 	 */
 	void setStatus(bool status);
 
+	/**
+	 * \brief run the next queued job
+	 *
+	 * Runs the next job on the queue as a task of the executor, and
+	 * schedules another task if more jobs are queued.
+	 * \param generation - The job generation the task was scheduled in, the
+	 * task does nothing if the jobs have been cleared since
+	 */
+	void runJob(unsigned int generation);
+
+	/**
+	 * \brief schedule a task to run the next queued job
+	 *
+	 * Submits a task to the executor that runs the next job.  The task holds
+	 * only a std::weak_ptr to this web, so a removed web is neither kept
+	 * alive nor touched once it is destroyed.  Must be called with
+	 * m_QueueMutex locked.
+	 */
+	void scheduleJob();
+
 	/**
 	 * \brief A pointer to the main CGlass class, used to send output,
 	 * get default values, encode/decode time, and get debug flags
@@ -622,6 +666,25 @@ class CWeb {
 	 */
 	std::mutex m_QueueMutex;
 
+	/**
+	 * \brief A pointer to the CExecutor that runs the jobs, or NULL if the
+	 * web runs its own threads
+	 */
+	glassutil::CExecutor *pExecutor;
+
+	/**
+	 * \brief A boolean flag indicating that an executor task is scheduled
+	 * to run the next job, guarded by m_QueueMutex
+	 */
+	bool m_bJobScheduled;
+
+	/**
+	 * \brief The job generation, incremented whenever the queued jobs are
+	 * cleared so that tasks scheduled before then are ignored, guarded by
+	 * m_QueueMutex
+	 */
+	unsigned int m_iJobGeneration;
+
 	/**
 	 * \brief the std::vector of std::threads
 	 */
@@ -11,6 +11,7 @@
 #include <vector>
 #include <memory>
 #include <mutex>
+#include "Executor.h"
 
 namespace glasscore {
 
@@ -155,11 +156,28 @@ class CWebList {
 	 */
 	void setSiteList(CSiteList* siteList);
 
+	/**
+	 * \brief CExecutor setter
+	 *
+	 * Sets the executor each web runs its site updates on, see
+	 * CWeb::setExecutor().
+	 * \param executor - the CExecutor pointer, NULL for each web to run its
+	 * own threads
+	 */
+	void setExecutor(glassutil::CExecutor* executor);
+
 	/**
 	 * \brief Get the current size of the web list
 	 */
 	int getVWebSize() const;
 
+
+	/**
+	 * \brief Estimate memory usage
+	 * \return the approximate number of bytes used by all the webs
+	 */
+	size_t getMemoryUsage() const;
+
  private:
 	/**
 	 * \brief A pointer to the main CGlass class, used to send output,
@@ -172,6 +190,12 @@ class CWebList {
 	 */
 	CSiteList *pSiteList;
 
+	/**
+	 * \brief A pointer to the CExecutor the webs run their site updates on,
+	 * or NULL if each web runs its own threads
+	 */
+	glassutil::CExecutor *pExecutor;
+
 	/**
 	 * \brief A vector of shared pointers to all currently defined
 	 * web detection arrays.
@@ -14,6 +14,7 @@
 #include "SiteList.h"
 #include "Glass.h"
 #include "Logit.h"
+#include "Memory.h"
 
 namespace glasscore {
 
@@ -177,8 +178,7 @@ CCorrelation::CCorrelation(std::shared_ptr<json::Object> correlation,
 			&& ((*correlation)["Time"].GetType() == json::ValueType::StringVal)) {
 		// Time is formatted in iso8601, convert to julian seconds
 		ttt = (*correlation)["Time"].ToString();
-		glassutil::CDate dt = glassutil::CDate();
-		tcorr = dt.decodeISO8601Time(ttt);
+		tcorr = glassutil::CDate::parseISO8601(ttt.c_str(), ttt.length());
 	} else {
 		glassutil::CLogit::log(
 				glassutil::log_level::error,
@@ -265,8 +265,7 @@ CCorrelation::CCorrelation(std::shared_ptr<json::Object> correlation,
 				&& (hypoobj["Time"].GetType() == json::ValueType::StringVal)) {
 			// Time is formatted in iso8601, convert to julian seconds
 			ttt = hypoobj["Time"].ToString();
-			glassutil::CDate dt = glassutil::CDate();
-			tori = dt.decodeISO8601Time(ttt);
+			tori = glassutil::CDate::parseISO8601(ttt.c_str(), ttt.length());
 		} else {
 			glassutil::CLogit::log(
 					glassutil::log_level::error,
@@ -326,6 +325,7 @@ void CCorrelation::clear() {
 	std::lock_guard<std::recursive_mutex> guard(correlationMutex);
 
 	pSite.reset();
+	iSiteId = -1;
 	wpHypo.reset();
 	jCorrelation.reset();
 
@@ -359,6 +359,7 @@ bool CCorrelation::initialize(std::shared_ptr<CSite> correlationSite,
 	std::lock_guard<std::recursive_mutex> guard(correlationMutex);
 
 	pSite = correlationSite;
+	iSiteId = correlationSite->getSiteId();
 	sPhs = phase;
 	sPid = correlationIdString;
 	idCorrelation = correlationId;
@@ -409,6 +410,22 @@ void CCorrelation::addHypo(std::shared_ptr<CHypo> hyp, std::string ass,
 	}
 }
 
+// ---------------------------------------------------------replaceHypo
+bool CCorrelation::replaceHypo(std::shared_ptr<CHypo> oldHyp,
+							std::shared_ptr<CHypo> newHyp, std::string ass) {
+	std::lock_guard<std::recursive_mutex> guard(correlationMutex);
+
+	// only move the link if nobody else has since
+	if (wpHypo.lock() != oldHyp) {
+		return (false);
+	}
+
+	wpHypo = newHyp;
+	sAss = ass;
+
+	return (true);
+}
+
 // ---------------------------------------------------------remHypo
 void CCorrelation::remHypo(std::shared_ptr<CHypo> hyp) {
 	// nullcheck
@@ -422,17 +439,18 @@ void CCorrelation::remHypo(std::shared_ptr<CHypo> hyp) {
 }
 
 void CCorrelation::remHypo(std::string pid) {
-	std::lock_guard<std::recursive_mutex> guard(correlationMutex);
+	// check the linked hypo's id without holding the correlation lock, a correlation
+	// never locks a hypo while it is locked itself
+	std::shared_ptr<CHypo> pHypo = getHypo();
+	if ((pHypo != NULL) && (pHypo->getPid() != pid)) {
+		return;
+	}
 
-	// is the pointer still valid
-	if (auto pHypo = wpHypo.lock()) {
-		// Remove hypo reference from this pick
-		if (pHypo->getPid() == pid) {
-			clearHypo();
-		}
-	} else {
-		// remove invalid pointer
-		clearHypo();
+	// Remove hypo reference (or invalid pointer) from this correlation, unless
+	// it was relinked in the meantime
+	std::lock_guard<std::recursive_mutex> guard(correlationMutex);
+	if (wpHypo.lock() == pHypo) {
+		wpHypo.reset();
 	}
 }
 
@@ -471,15 +489,9 @@ const std::shared_ptr<CHypo> CCorrelation::getHypo() const {
 }
 
 const std::string CCorrelation::getHypoPid() const {
-	std::lock_guard<std::recursive_mutex> pickGuard(correlationMutex);
 	std::string hypoPid = "";
 
-	// make sure we have a hypo
-	if (wpHypo.expired() == true) {
-		return (hypoPid);
-	}
-
-	// get the hypo
+	// get the hypo, without holding our lock while the hypo is locked
 	std::shared_ptr<CHypo> pHypo = getHypo();
 	if (pHypo != NULL) {
 		// get the hypo pid
@@ -493,6 +505,10 @@ const std::shared_ptr<CSite>& CCorrelation::getSite() const {
 	return (pSite);
 }
 
+int CCorrelation::getSiteId() const {
+	return (iSiteId);
+}
+
 const std::string& CCorrelation::getAss() const {
 	std::lock_guard<std::recursive_mutex> guard(correlationMutex);
 	return (sAss);
@@ -523,6 +539,21 @@ double CCorrelation::getTOrg() const {
 	return (tOrg);
 }
 
+// ---------------------------------------------------------getMemoryUsage
+size_t CCorrelation::getMemoryUsage() const {
+	std::lock_guard<std::recursive_mutex> guard(correlationMutex);
+
+	size_t bytes = sizeof(CCorrelation)
+			+ glassutil::CMemory::stringBytes(sAss)
+			+ glassutil::CMemory::stringBytes(sPhs)
+			+ glassutil::CMemory::stringBytes(sPid);
+
+	if (jCorrelation != NULL) {
+		bytes += glassutil::CMemory::jsonBytes(*jCorrelation);
+	}
+
+	return (bytes);
+}
 }  // namespace glasscore
 /*
 
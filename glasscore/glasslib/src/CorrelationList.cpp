@@ -1,4 +1,5 @@
 #include <json.h>
+#include <algorithm>
 #include <string>
 #include <utility>
 #include <memory>
@@ -16,8 +17,17 @@
 #include "Site.h"
 #include "Glass.h"
 #include "Logit.h"
+#include "Memory.h"
+#include "Pool.h"
 
 #define RAD2DEG  57.29577951308
+
+// the windows to size the index for when there is no pGlass
+#define INDEXTWINDOW 2.5
+#define INDEXXWINDOW 0.5
+
+// the smallest index cell, as a unit sphere chord, about 0.6 km
+#define MININDEXCELL 1.0e-4
 namespace glasscore {
 
 // ---------------------------------------------------------CCorrelationList
@@ -45,9 +55,13 @@ void CCorrelationList::clear() {
 void CCorrelationList::clearCorrelations() {
 	std::lock_guard<std::recursive_mutex> listGuard(m_vCorrelationMutex);
 
-	// clear the vector and map
+	// clear the vector, map, and index
 	vCorrelation.clear();
 	mCorrelation.clear();
+	mIndex.clear();
+	dIndexTWindow = 0;
+	dIndexXWindow = 0;
+	resizeIndex(INDEXTWINDOW, INDEXXWINDOW);
 
 	// reset nCorrelation
 	nCorrelation = 0;
@@ -99,7 +113,7 @@ bool CCorrelationList::dispatch(std::shared_ptr<json::Object> com) {
 // ---------------------------------------------------------addCorrelation
 bool CCorrelationList::addCorrelation(
 		std::shared_ptr<json::Object> correlation) {
-	std::lock_guard<std::recursive_mutex> listGuard(m_vCorrelationMutex);
+	std::unique_lock<std::recursive_mutex> listGuard(m_vCorrelationMutex);
 
 	// null check json
 	if (correlation == NULL) {
@@ -137,25 +151,27 @@ bool CCorrelationList::addCorrelation(
 		return (false);
 	}
 
-	// create new correlation from json message
-	CCorrelation * newCorrelation = new CCorrelation(correlation,
-														nCorrelation + 1,
-														pSiteList);
+	// create new correlation from json message, the correlation and its
+	// shared pointer control block come from the correlation pool
+	std::shared_ptr<CCorrelation> corr = std::allocate_shared<CCorrelation>(
+			glassutil::CPoolAllocator<CCorrelation>(), correlation,
+			nCorrelation + 1, pSiteList);
 
 	// check to see if we got a valid correlation
-	if ((newCorrelation->getSite() == NULL)
-			|| (newCorrelation->getTCorrelation() == 0)
-			|| (newCorrelation->getPid() == "")) {
-		// cleanup
-		delete (newCorrelation);
+	if ((corr->getSite() == NULL) || (corr->getTCorrelation() == 0)
+			|| (corr->getPid() == "")) {
 		// message was processed
 		return (true);
 	}
 
 	// check if correlation is duplicate, if pGlass exists
 	if (pGlass) {
+		// keep the index buckets matched to the matching windows
+		resizeIndex(pGlass->getCorrelationMatchingTWindow(),
+					pGlass->getCorrelationMatchingXWindow());
+
 		bool duplicate = checkDuplicate(
-				newCorrelation, pGlass->getCorrelationMatchingTWindow(),
+				corr.get(), pGlass->getCorrelationMatchingTWindow(),
 				pGlass->getCorrelationMatchingXWindow());
 
 		// it is a duplicate, log and don't add correlation
@@ -164,15 +180,11 @@ bool CCorrelationList::addCorrelation(
 					glassutil::log_level::warn,
 					"CCorrelationList::addCorrelation: Duplicate correlation "
 					"not passed in.");
-			delete (newCorrelation);
 			// message was processed
 			return (true);
 		}
 	}
 
-	// create new shared pointer to this correlation
-	std::shared_ptr<CCorrelation> corr(newCorrelation);
-
 	// Add correlation to cache (mCorrelation) and time sorted
 	// index (vCorrelation). If vCorrelation has reached its
 	// maximum capacity (nCorrelationMax), then the
@@ -196,17 +208,18 @@ bool CCorrelationList::addCorrelation(
 	std::pair<double, int> p(corr->getTCorrelation(), nCorrelation);
 
 	// check to see if we're at the correlation limit
-	if (vCorrelation.size() == nCorrelationMax) {
+	if (static_cast<int>(vCorrelation.size()) == nCorrelationMax) {
 		// find first correlation in vector
 		std::pair<double, int> pdx;
 		pdx = vCorrelation[0];
 		auto pos = mCorrelation.find(pdx.second);
 
-		// erase from map
+		// erase from index and map
+		eraseIndex(pos->first, pos->second);
 		mCorrelation.erase(pos);
 
 		// erase from vector
-		vCorrelation.erase(vCorrelation.begin());
+		vCorrelation.pop_front();
 	}
 
 	// Insert new correlation in proper time sequence into correlation vector
@@ -223,7 +236,7 @@ bool CCorrelationList::addCorrelation(
 			break;
 		default:
 			// correlation is somewhere in vector
-			if (iCorrelation == vCorrelation.size() - 1) {
+			if (iCorrelation == static_cast<int>(vCorrelation.size()) - 1) {
 				// correlation is after all correlations, add to end
 				vCorrelation.push_back(p);
 			} else {
@@ -236,8 +249,13 @@ bool CCorrelationList::addCorrelation(
 			break;
 	}
 
-	// add to correlation map
+	// add to correlation map and index
 	mCorrelation[nCorrelation] = corr;
+	insertIndex(nCorrelation, corr);
+
+	// the correlation is in the list, the rest is done unlocked so that
+	// other correlations can be checked and scavenged meanwhile
+	listGuard.unlock();
 
 	// make sure we have a pGlass and pGlass->pHypoList
 	if ((pGlass) && (pGlass->getHypoList())) {
@@ -251,8 +269,9 @@ bool CCorrelationList::addCorrelation(
 			std::shared_ptr<traveltime::CTravelTime> nullTrav;
 
 			// create new hypo
-			std::shared_ptr<CHypo> hypo = std::make_shared<CHypo>(
-					corr, pGlass->getTrvDefault(), nullTrav,
+			std::shared_ptr<CHypo> hypo = std::allocate_shared<CHypo>(
+					glassutil::CPoolAllocator<CHypo>(), corr,
+					pGlass->getTrvDefault(), nullTrav,
 					pGlass->getTTT());
 
 			// set hypo glass pointer and such
@@ -386,37 +405,18 @@ bool CCorrelationList::checkDuplicate(CCorrelation * newCorrelation,
 		return (false);
 	}
 
-	// get the index of the earliest possible match
-	int it1 = indexCorrelation(newCorrelation->getTCorrelation() - tWindow);
-
-	// get index of the latest possible correlation
-	int it2 = indexCorrelation(newCorrelation->getTCorrelation() + tWindow);
-
-	// index can't be negative, it1/2 negative if correlation before first in
-	// list
-	if (it1 < 0) {
-		it1 = 0;
-	}
-	if (it2 < 0) {
-		it2 = 0;
-	}
-
-	// don't bother if there's no correlatinos
-	if (it1 == it2) {
-		return (false);
-	}
+	// get the possible matches from the index
+	std::vector<std::shared_ptr<CCorrelation>> candidates = getCorrelations(
+			newCorrelation->getTCorrelation(), newCorrelation->getLat(),
+			newCorrelation->getLon(), tWindow, xWindow);
 
 	// loop through possible matching correlations
-	for (int it = it1; it <= it2; it++) {
-		auto q = vCorrelation[it];
-		std::shared_ptr<CCorrelation> cor = mCorrelation[q.second];
-
+	for (auto cor : candidates) {
 		// check if time difference is within window
 		if (std::abs(newCorrelation->getTCorrelation() - cor->getTCorrelation())
 				< tWindow) {
 			// check if sites match
-			if (newCorrelation->getSite()->getScnl()
-					== cor->getSite()->getScnl()) {
+			if (newCorrelation->getSite()->isSameSite(cor->getSite().get())) {
 				glassutil::CGeo geo1;
 				geo1.setGeographic(newCorrelation->getLat(),
 									newCorrelation->getLon(),
@@ -452,8 +452,6 @@ bool CCorrelationList::checkDuplicate(CCorrelation * newCorrelation,
 
 // ---------------------------------------------------------scavenge
 bool CCorrelationList::scavenge(std::shared_ptr<CHypo> hyp, double tDuration) {
-	std::lock_guard<std::recursive_mutex> listGuard(m_vCorrelationMutex);
-
 	// Scan all correlations within specified time range, adding any
 	// that meet association criteria to hypo object provided.
 	// Returns true if any associated.
@@ -476,36 +474,32 @@ bool CCorrelationList::scavenge(std::shared_ptr<CHypo> hyp, double tDuration) {
 	glassutil::CLogit::log(glassutil::log_level::debug,
 							"CCorrelationList::scavenge. " + hyp->getPid());
 
-	// get the index of the correlation to start with
-	// based on the hypo origin time
-	int it1 = indexCorrelation(hyp->getTOrg() - tDuration);
+	// a correlation can only associate if it is within the matching time
+	// window of the hypo, so there is no need to search any further
+	double tWindow = pGlass->getCorrelationMatchingTWindow();
+	if (tDuration > tWindow) {
+		tDuration = tWindow;
+	}
 
-	// get the index of the correlation to end with by using the hypo
-	// origin time plus the provided duration
-	int it2 = indexCorrelation(hyp->getTOrg() + tDuration);
+	// get the hypocenter before locking the list, a hypo is never locked
+	// while the list is
+	double tOrg = hyp->getTOrg();
+	double lat = hyp->getLat();
+	double lon = hyp->getLon();
 
-	// index can't be negative
-	// Primarily occurs if origin time is before first correlation
-	if (it1 < 0) {
-		it1 = 0;
-	}
-	if (it2 < 0) {
-		it2 = 0;
-	}
+	// get the correlations near the hypo from the index, the list isn't
+	// locked while we work through them
+	std::vector<std::shared_ptr<CCorrelation>> candidates = getCorrelations(
+			tOrg, lat, lon, tDuration, pGlass->getCorrelationMatchingXWindow());
 
 	// don't bother if there's no correlations
-	if (it1 == it2) {
+	if (candidates.size() == 0) {
 		return (false);
 	}
 
-	// for each correlation index between it1 and it2
+	// for each correlation in the time range
 	bool bAss = false;
-	for (int it = it1; it < it2; it++) {
-		// get the correlation from the vector
-		auto q = vCorrelation[it];
-		std::shared_ptr<CCorrelation> corr = mCorrelation[q.second];
-		std::shared_ptr<CHypo> corrHyp = corr->getHypo();
-
+	for (auto corr : candidates) {
 		// check to see if this correlation is already in this hypo
 		if (hyp->hasCorrelation(corr)) {
 			// it is, skip it
@@ -519,26 +513,17 @@ bool CCorrelationList::scavenge(std::shared_ptr<CHypo> hyp, double tDuration) {
 			continue;
 		}
 
-		// check to see if this correlation is part of ANY hypo
-		if (corrHyp == NULL) {
-			// unassociated with any existing hypo
-			// link correlation to the hypo we're working on
-			corr->addHypo(hyp, "W", true);
-
-			// add correlation to this hypo
-			hyp->addCorrelation(corr);
-
-			// we've associated a correlation
-			bAss = true;
-		} else {
-			// associated with an existing hypo
-			// Add it to this hypo, but don't change the correlation's hypo link
-			// Let resolve() sort out which hypo the correlation fits best with
-			hyp->addCorrelation(corr);
-
-			// we've associated a correlation
-			bAss = true;
-		}
+		// link correlation to the hypo we're working on if it is
+		// unassociated with any existing hypo. If it is, don't change the
+		// correlation's hypo link, let resolve() sort out which hypo the
+		// correlation fits best with
+		corr->addHypo(hyp, "W");
+
+		// add correlation to this hypo
+		hyp->addCorrelation(corr);
+
+		// we've associated a correlation
+		bAss = true;
 	}
 
 	// return whether we've associated at least one correlation
@@ -608,6 +593,180 @@ std::vector<std::shared_ptr<CCorrelation>> CCorrelationList::rogues(
 	return (vRogue);
 }
 
+// ---------------------------------------------------------getCorrelations
+std::vector<std::shared_ptr<CCorrelation>> CCorrelationList::getCorrelations(
+		double tCorrelation, double lat, double lon, double tWindow,
+		double xWindow) {
+	std::lock_guard<std::recursive_mutex> listGuard(m_vCorrelationMutex);
+
+	std::vector<std::shared_ptr<CCorrelation>> found;
+	if ((mIndex.size() == 0) || (tWindow < 0) || (xWindow < 0)) {
+		return (found);
+	}
+
+	glassutil::CGeoPoint point;
+	point.setGeographic(lat, lon);
+
+	// the distance window as a chord of the unit sphere, every correlation
+	// within the window is inside the box this far around the point
+	double chord = 2.0;
+	if (xWindow < 180.0) {
+		chord = 2.0 * sin(DEG2RAD * xWindow / 2.0);
+	}
+
+	IndexKey first = indexKey(tCorrelation - tWindow, point);
+	IndexKey last = indexKey(tCorrelation + tWindow, point);
+	first.iX = static_cast<int>(floor((point.uX - chord) / dIndexCell));
+	first.iY = static_cast<int>(floor((point.uY - chord) / dIndexCell));
+	first.iZ = static_cast<int>(floor((point.uZ - chord) / dIndexCell));
+	last.iX = static_cast<int>(floor((point.uX + chord) / dIndexCell));
+	last.iY = static_cast<int>(floor((point.uY + chord) / dIndexCell));
+	last.iZ = static_cast<int>(floor((point.uZ + chord) / dIndexCell));
+
+	std::vector<const IndexEntry *> entries;
+	auto addBucket = [&](const std::vector<IndexEntry> &bucket) {
+		for (const auto &entry : bucket) {
+			if (std::abs(entry.tCorrelation - tCorrelation) <= tWindow) {
+				entries.push_back(&entry);
+			}
+		}
+	};
+
+	double lookups = static_cast<double>(last.iTime - first.iTime + 1)
+			* (last.iX - first.iX + 1) * (last.iY - first.iY + 1)
+			* (last.iZ - first.iZ + 1);
+	if (lookups > mIndex.size()) {
+		// the windows are large compared to the buckets, it is cheaper to
+		// look at every bucket
+		for (const auto &bucket : mIndex) {
+			const IndexKey &key = bucket.first;
+			if ((key.iTime >= first.iTime) && (key.iTime <= last.iTime)
+					&& (key.iX >= first.iX) && (key.iX <= last.iX)
+					&& (key.iY >= first.iY) && (key.iY <= last.iY)
+					&& (key.iZ >= first.iZ) && (key.iZ <= last.iZ)) {
+				addBucket(bucket.second);
+			}
+		}
+	} else {
+		IndexKey key;
+		for (key.iTime = first.iTime; key.iTime <= last.iTime; key.iTime++) {
+			for (key.iX = first.iX; key.iX <= last.iX; key.iX++) {
+				for (key.iY = first.iY; key.iY <= last.iY; key.iY++) {
+					for (key.iZ = first.iZ; key.iZ <= last.iZ; key.iZ++) {
+						auto bucket = mIndex.find(key);
+						if (bucket != mIndex.end()) {
+							addBucket(bucket->second);
+						}
+					}
+				}
+			}
+		}
+	}
+
+	// bucket order is arbitrary, keep the results in the order the
+	// correlations were added
+	std::sort(entries.begin(), entries.end(),
+				[](const IndexEntry *a, const IndexEntry *b) {
+					return (a->iCorrelation < b->iCorrelation);
+				});
+
+	found.reserve(entries.size());
+	for (const auto entry : entries) {
+		found.push_back(entry->corr);
+	}
+
+	return (found);
+}
+
+// ---------------------------------------------------------IndexKeyHash
+size_t CCorrelationList::IndexKeyHash::operator()(const IndexKey &key) const {
+	uint64_t hash = static_cast<uint64_t>(key.iTime) * 0x9E3779B97F4A7C15ULL;
+	hash ^= static_cast<uint64_t>(static_cast<uint32_t>(key.iX)) * 73856093ULL;
+	hash ^= static_cast<uint64_t>(static_cast<uint32_t>(key.iY)) * 19349663ULL;
+	hash ^= static_cast<uint64_t>(static_cast<uint32_t>(key.iZ)) * 83492791ULL;
+	return (static_cast<size_t>(hash ^ (hash >> 29)));
+}
+
+// ---------------------------------------------------------indexKey
+CCorrelationList::IndexKey CCorrelationList::indexKey(
+		double tCorrelation, const glassutil::CGeoPoint &point) const {
+	IndexKey key;
+	key.iTime = static_cast<int64_t>(floor(tCorrelation / dIndexTime));
+	key.iX = static_cast<int>(floor(point.uX / dIndexCell));
+	key.iY = static_cast<int>(floor(point.uY / dIndexCell));
+	key.iZ = static_cast<int>(floor(point.uZ / dIndexCell));
+
+	return (key);
+}
+
+// ---------------------------------------------------------resizeIndex
+void CCorrelationList::resizeIndex(double tWindow, double xWindow) {
+	std::lock_guard<std::recursive_mutex> listGuard(m_vCorrelationMutex);
+
+	if ((tWindow <= 0) || (xWindow <= 0)) {
+		return;
+	}
+	if ((tWindow == dIndexTWindow) && (xWindow == dIndexXWindow)) {
+		return;
+	}
+
+	dIndexTWindow = tWindow;
+	dIndexXWindow = xWindow;
+
+	// a bucket as wide as the windows means a lookup only needs the
+	// neighboring buckets
+	dIndexTime = tWindow;
+	dIndexCell = 2.0;
+	if (xWindow < 180.0) {
+		dIndexCell = std::max(2.0 * sin(DEG2RAD * xWindow / 2.0),
+								MININDEXCELL);
+	}
+
+	// rebuild the index with the new buckets
+	mIndex.clear();
+	for (const auto &entry : mCorrelation) {
+		insertIndex(entry.first, entry.second);
+	}
+}
+
+// ---------------------------------------------------------insertIndex
+void CCorrelationList::insertIndex(int idCorrelation,
+									std::shared_ptr<CCorrelation> corr) {
+	glassutil::CGeoPoint point;
+	point.setGeographic(corr->getLat(), corr->getLon());
+
+	IndexEntry entry;
+	entry.iCorrelation = idCorrelation;
+	entry.tCorrelation = corr->getTCorrelation();
+	entry.corr = corr;
+
+	mIndex[indexKey(entry.tCorrelation, point)].push_back(entry);
+}
+
+// ---------------------------------------------------------eraseIndex
+void CCorrelationList::eraseIndex(int idCorrelation,
+									std::shared_ptr<CCorrelation> corr) {
+	glassutil::CGeoPoint point;
+	point.setGeographic(corr->getLat(), corr->getLon());
+
+	auto bucket = mIndex.find(indexKey(corr->getTCorrelation(), point));
+	if (bucket == mIndex.end()) {
+		return;
+	}
+
+	std::vector<IndexEntry> &entries = bucket->second;
+	for (auto it = entries.begin(); it != entries.end(); ++it) {
+		if (it->iCorrelation == idCorrelation) {
+			entries.erase(it);
+			break;
+		}
+	}
+
+	if (entries.size() == 0) {
+		mIndex.erase(bucket);
+	}
+}
+
 const CSiteList* CCorrelationList::getSiteList() const {
 	std::lock_guard<std::recursive_mutex> corrListGuard(m_CorrelationListMutex);
 	return (pSiteList);
@@ -656,4 +815,28 @@ int CCorrelationList::getVCorrelationSize() const {
 	return (vCorrelation.size());
 }
 
+// ---------------------------------------------------------getMemoryUsage
+size_t CCorrelationList::getMemoryUsage() const {
+	std::lock_guard<std::recursive_mutex> guard(m_vCorrelationMutex);
+
+	size_t bytes = sizeof(CCorrelationList)
+			+ vCorrelation.size() * sizeof(std::pair<double, int>)
+			+ mCorrelation.size()
+					* (glassutil::CMemory::mapNodeBytes()
+							+ sizeof(std::pair<int,
+									std::shared_ptr<CCorrelation>>))
+			+ mIndex.bucket_count() * sizeof(void *)
+			+ mIndex.size()
+					* (2 * sizeof(void *)
+							+ sizeof(std::pair<IndexKey,
+									std::vector<IndexEntry>>));
+	for (const auto &bucket : mIndex) {
+		bytes += bucket.second.capacity() * sizeof(IndexEntry);
+	}
+	for (const auto &entry : mCorrelation) {
+		bytes += entry.second->getMemoryUsage();
+	}
+
+	return (bytes);
+}
 }  // namespace glasscore
@@ -13,6 +13,15 @@
 #include "Site.h"
 #include "Glass.h"
 #include "Logit.h"
+#include "Pool.h"
+
+// the window around a detection's origin time to look for a matching hypo in
+// NOTE: Hard coded.
+#define DETECTIONTWINDOW 90.0
+
+// the distance in degrees a matching hypo must be within
+// NOTE: Hard coded.
+#define DETECTIONXWINDOW 5.0
 
 namespace glasscore {
 
@@ -82,145 +91,145 @@ bool CDetection::process(std::shared_ptr<json::Object> com) {
 				"CDetection::process: NULL json communication.");
 		return (false);
 	}
-	if (pGlass == NULL) {
+
+	// decode the detection, then take the typed path
+	DetectionRecord detection;
+	if (!decode(*com, &detection)) {
+		return (false);
+	}
+
+	return (process(detection));
+}
+
+// ---------------------------------------------------------process
+bool CDetection::process(const DetectionRecord &detection) {
+	// get the glass pointer, detections are otherwise independent of each
+	// other, so the mutex isn't held while processing
+	CGlass *glass = NULL;
+	{
+		std::lock_guard<std::recursive_mutex> detectionGuard(detectionMutex);
+		glass = pGlass;
+	}
+
+	if (glass == NULL) {
 		glassutil::CLogit::log(glassutil::log_level::error,
 								"CDetection::process: NULL pGlass.");
 
 		return (false);
 	}
 
-	std::lock_guard<std::recursive_mutex> detectionGuard(detectionMutex);
+	// Check to see if hypo already exists, by looking for the closest hypo
+	// within the matching windows
+	std::shared_ptr<CHypo> hypo = glass->getHypoList()->findHypo(
+			detection.tOrg - DETECTIONTWINDOW, detection.tOrg + DETECTIONTWINDOW,
+			detection.dLat, detection.dLon, DETECTIONXWINDOW);
 
-	// detection definition variables
-	double torg = 0;
-	double lat = 0;
-	double lon = 0;
-	double z = 0;
-
-	// Get information from hypocenter
-	if (com->HasKey("Hypocenter")
-			&& ((*com)["Hypocenter"].GetType() == json::ValueType::ObjectVal)) {
-		json::Object hypocenter = (*com)["Hypocenter"].ToObject();
-
-		// get time from hypocenter
-		if (hypocenter.HasKey("Time")
-				&& (hypocenter["Time"].GetType() == json::ValueType::StringVal)) {
-			// get time string
-			std::string tiso = hypocenter["Time"].ToString();
-
-			// convert time
-			glassutil::CDate dt = glassutil::CDate();
-			torg = dt.decodeISO8601Time(tiso);
-		} else {
-			glassutil::CLogit::log(
-					glassutil::log_level::error,
-					"CDetection::process: Missing required Hypocenter Time Key.");
+	// check to see if we found a hypo
+	if (hypo != NULL) {
+		// existing hypo, now hwat?
+		// schedule hypo for processing?
+		glass->getHypoList()->pushFifo(hypo);
 
-			return (false);
-		}
+		return (true);
+	}
 
-		// get latitude from hypocenter
-		if (hypocenter.HasKey("Latitude")
-				&& (hypocenter["Latitude"].GetType()
-						== json::ValueType::DoubleVal)) {
-			lat = hypocenter["Latitude"].ToDouble();
+	// no match, detections don't have a second travel time
+	std::shared_ptr<traveltime::CTravelTime> nullTrav;
+
+	// create new hypo
+	hypo = std::allocate_shared<CHypo>(
+			glassutil::CPoolAllocator<CHypo>(), detection.dLat, detection.dLon,
+			detection.dZ, detection.tOrg, glassutil::CPid::pid(), "Detection",
+			0.0, 0.0, 0, glass->getTrvDefault(), nullTrav, glass->getTTT());
+
+	// set hypo glass pointer and such
+	hypo->setGlass(glass);
+	hypo->setCutFactor(glass->getCutFactor());
+	hypo->setCutPercentage(glass->getCutPercentage());
+	hypo->setCutMin(glass->getCutMin());
+
+	// process hypo using evolve
+	if (glass->getHypoList()->evolve(hypo)) {
+		// add to hypo list
+		glass->getHypoList()->addHypo(hypo);
+	}
 
-		} else {
-			glassutil::CLogit::log(
-					glassutil::log_level::error,
-					"CDetection::process: Missing required Hypocenter Latitude"
-					" Key.");
+	// done
+	return (true);
+}
 
-			return (false);
-		}
+// ---------------------------------------------------------decode
+bool CDetection::decode(const json::Object &com, DetectionRecord *detection) {
+	if (detection == NULL) {
+		return (false);
+	}
 
-		// get longitude from hypocenter
-		if (hypocenter.HasKey("Longitude")
-				&& (hypocenter["Longitude"].GetType()
-						== json::ValueType::DoubleVal)) {
-			lon = hypocenter["Longitude"].ToDouble();
-		} else {
-			glassutil::CLogit::log(
-					glassutil::log_level::error,
-					"CDetection::process: Missing required Hypocenter Longitude"
-					" Key.");
+	// Get information from hypocenter, by reference so that it isn't copied
+	if (!com.HasKey("Hypocenter")
+			|| (com["Hypocenter"].GetType() != json::ValueType::ObjectVal)) {
+		glassutil::CLogit::log(
+				glassutil::log_level::error,
+				"CDetection::decode: Missing required Hypocenter Key.");
 
-			return (false);
-		}
+		return (false);
+	}
+	const json::Value &hypocenter = com["Hypocenter"];
+
+	// get time from hypocenter
+	if (hypocenter.HasKey("Time")
+			&& (hypocenter["Time"].GetType() == json::ValueType::StringVal)) {
+		// convert time
+		std::string tiso = hypocenter["Time"].ToString();
+		detection->tOrg = glassutil::CDate::parseISO8601(tiso.c_str(),
+														tiso.length());
+	} else {
+		glassutil::CLogit::log(
+				glassutil::log_level::error,
+				"CDetection::decode: Missing required Hypocenter Time Key.");
 
-		// get depth from hypocenter
-		if (hypocenter.HasKey("Depth")
-				&& (hypocenter["Depth"].GetType() == json::ValueType::DoubleVal)) {
-			z = hypocenter["Depth"].ToDouble();
-		} else {
-			glassutil::CLogit::log(
-					glassutil::log_level::error,
-					"CDetection::process: Missing required Hypocenter Depth"
-					" Key.");
+		return (false);
+	}
 
-			return (false);
-		}
+	// get latitude from hypocenter
+	if (hypocenter.HasKey("Latitude")
+			&& (hypocenter["Latitude"].GetType() == json::ValueType::DoubleVal)) {
+		detection->dLat = hypocenter["Latitude"].ToDouble();
 	} else {
 		glassutil::CLogit::log(
 				glassutil::log_level::error,
-				"CDetection::process: Missing required Hypocenter Key.");
+				"CDetection::decode: Missing required Hypocenter Latitude"
+				" Key.");
 
 		return (false);
 	}
 
-	// Check to see if hypo already exists. We could also
-	// check location at this point, but it seems unlikely
-	// that would add much value
-	// define a three minute search window
-	// NOTE: Hard coded.
-	double t1 = torg - 90.0;
-	double t2 = torg + 90.0;
+	// get longitude from hypocenter
+	if (hypocenter.HasKey("Longitude")
+			&& (hypocenter["Longitude"].GetType()
+					== json::ValueType::DoubleVal)) {
+		detection->dLon = hypocenter["Longitude"].ToDouble();
+	} else {
+		glassutil::CLogit::log(
+				glassutil::log_level::error,
+				"CDetection::decode: Missing required Hypocenter Longitude"
+				" Key.");
+
+		return (false);
+	}
 
-	// search for the first hypocenter in the window
-	std::shared_ptr<CHypo> hypo = pGlass->getHypoList()->findHypo(t1, t2);
+	// get depth from hypocenter
+	if (hypocenter.HasKey("Depth")
+			&& (hypocenter["Depth"].GetType() == json::ValueType::DoubleVal)) {
+		detection->dZ = hypocenter["Depth"].ToDouble();
+	} else {
+		glassutil::CLogit::log(
+				glassutil::log_level::error,
+				"CDetection::decode: Missing required Hypocenter Depth"
+				" Key.");
 
-	// check to see if we found a hypo
-	if (hypo != NULL) {
-		// found a hypo
-		// calculate distance
-		glassutil::CGeo geo1;
-		geo1.setGeographic(lat, lon, z);
-		glassutil::CGeo geo2;
-		geo2.setGeographic(hypo->getLat(), hypo->getLon(), hypo->getZ());
-		double delta = RAD2DEG * geo1.delta(&geo2);
-
-		// if the detection is more than 5 degrees away, it isn't a match
-		// NOTE: Hard coded.
-		if (delta > 5.0) {
-			// detections don't have a second travel time
-			std::shared_ptr<traveltime::CTravelTime> nullTrav;
-
-			// create new hypo
-			hypo = std::make_shared<CHypo>(lat, lon, z, torg,
-											glassutil::CPid::pid(), "Detection",
-											0.0, 0.0, 0,
-											pGlass->getTrvDefault(),
-											nullTrav, pGlass->getTTT());
-
-			// set hypo glass pointer and such
-			hypo->setGlass(pGlass);
-			hypo->setCutFactor(pGlass->getCutFactor());
-			hypo->setCutPercentage(pGlass->getCutPercentage());
-			hypo->setCutMin(pGlass->getCutMin());
-
-			// process hypo using evolve
-			if (pGlass->getHypoList()->evolve(hypo)) {
-				// add to hypo list
-				pGlass->getHypoList()->addHypo(hypo);
-			}
-		} else {
-			// existing hypo, now hwat?
-			// schedule hypo for processing?
-			pGlass->getHypoList()->pushFifo(hypo);
-		}
+		return (false);
 	}
 
-	// done
 	return (true);
 }
 
@@ -1,6 +1,7 @@
 #include <json.h>
 #include <cmath>
 #include <string>
+#include <vector>
 #include "IGlassSend.h"
 #include "Date.h"
 #include "Geo.h"
@@ -18,6 +19,9 @@
 #include "TTT.h"
 #include "TravelTime.h"
 #include "Logit.h"
+#include "Memory.h"
+#include "Pool.h"
+#include "Executor.h"
 #include <memory>
 
 namespace glasscore {
@@ -32,6 +36,7 @@ CGlass::CGlass() {
 	pHypoList = NULL;
 	pCorrelationList = NULL;
 	pDetection = NULL;
+	pExecutor = NULL;
 	pTrvDefault = NULL;
 
 	nPickMax = 10000;
@@ -51,6 +56,11 @@ CGlass::CGlass() {
 CGlass::~CGlass() {
 	clear();
 
+	// stop running tasks before the lists they work on are deleted
+	if (pExecutor) {
+		pExecutor->stop();
+	}
+
 	if (pWebList) {
 		delete (pWebList);
 	}
@@ -69,6 +79,9 @@ CGlass::~CGlass() {
 	if (pDetection) {
 		delete (pDetection);
 	}
+	if (pExecutor) {
+		delete (pExecutor);
+	}
 }
 
 // ---------------------------------------------------------dispatch
@@ -186,6 +199,21 @@ bool CGlass::send(std::shared_ptr<json::Object> com) {
 	return (false);
 }
 
+// ---------------------------------------------------------send
+bool CGlass::send(std::shared_ptr<const HypoRecord> hypo) {
+	// make sure we have something to send to
+	if (piSend) {
+		// send the record
+		piSend->Send(hypo);
+
+		// done
+		return (true);
+	}
+
+	// record not sent
+	return (false);
+}
+
 // ---------------------------------------------------------Clear
 void CGlass::clear() {
 	// reset to defaults
@@ -201,6 +229,7 @@ void CGlass::clear() {
 	dCutPercentage = 0.4;
 	dCutMin = 30.0;
 	iCycleLimit = 25;
+	locatorRefinementPicks = 0;
 	testTimes = false;
 	testLocator = false;
 	graphicsOut = false;
@@ -213,9 +242,14 @@ void CGlass::clear() {
 	correlationMatchingXWindow = .5;
 	correlationCancelAge = 900;
 	beamMatchingAzimuthWindow = 22.5;
-	beamMatchingDistanceWindow = 5;
+	beamMatchingSlownessWindow = 2.0;
 	nReportCut = 0;
 	dReportThresh = 2.5;
+	hypoPriorityBayesWeight = 1.0;
+	hypoPriorityDataWeight = 0.5;
+	hypoPriorityReportWeight = 2.0;
+	hypoPriorityCycleWeight = 1.0;
+	hypoPriorityAgingWeight = 1.0;
 }
 
 // ---------------------------------------------------------Initialize
@@ -689,6 +723,23 @@ bool CGlass::initialize(std::shared_ptr<json::Object> com) {
 							+ std::to_string(iCycleLimit));
 		}
 
+		// locatorRefinementPicks
+		if ((params.HasKey("LocatorRefinementPicks"))
+				&& (params["LocatorRefinementPicks"].GetType()
+						== json::ValueType::IntVal)) {
+			locatorRefinementPicks = params["LocatorRefinementPicks"].ToInt();
+
+			glassutil::CLogit::log(
+					glassutil::log_level::info,
+					"CGlass::initialize: Using LocatorRefinementPicks: "
+							+ std::to_string(locatorRefinementPicks));
+		} else {
+			glassutil::CLogit::log(
+					glassutil::log_level::info,
+					"CGlass::initialize: Using default LocatorRefinementPicks: "
+							+ std::to_string(locatorRefinementPicks));
+		}
+
 		// correlationMatchingTWindow
 		if ((params.HasKey("CorrelationTimeWindow"))
 				&& (params["CorrelationTimeWindow"].GetType()
@@ -763,26 +814,24 @@ bool CGlass::initialize(std::shared_ptr<json::Object> com) {
 							+ std::to_string(beamMatchingAzimuthWindow));
 		}
 
-		/*
-		 // beamMatchingDistanceWindow
-		 if ((params.HasKey("dBeamMatchingDistanceWindow"))
-		 && (params["dBeamMatchingDistanceWindow"].GetType()
-		 == json::ValueType::DoubleVal)) {
-		 beamMatchingDistanceWindow = params["dBeamMatchingDistanceWindow"]
-		 .ToDouble();
-
-		 glassutil::CLogit::log(
-		 glassutil::log_level::info,
-		 "CGlass::initialize: Using dBeamMatchingDistanceWindow: "
-		 + std::to_string(beamMatchingDistanceWindow));
-		 } else {
-		 glassutil::CLogit::log(
-		 glassutil::log_level::info,
-		 "CGlass::initialize: Using default "
-		 "dBeamMatchingDistanceWindow: "
-		 + std::to_string(beamMatchingDistanceWindow));
-		 }
-		 */
+		// beamMatchingSlownessWindow
+		if ((params.HasKey("BeamMatchingSlownessWindow"))
+				&& (params["BeamMatchingSlownessWindow"].GetType()
+						== json::ValueType::DoubleVal)) {
+			beamMatchingSlownessWindow = params["BeamMatchingSlownessWindow"]
+					.ToDouble();
+
+			glassutil::CLogit::log(
+					glassutil::log_level::info,
+					"CGlass::initialize: Using BeamMatchingSlownessWindow: "
+							+ std::to_string(beamMatchingSlownessWindow));
+		} else {
+			glassutil::CLogit::log(
+					glassutil::log_level::info,
+					"CGlass::initialize: Using default "
+							"BeamMatchingSlownessWindow: "
+							+ std::to_string(beamMatchingSlownessWindow));
+		}
 
 		// dReportThresh
 		if ((params.HasKey("ReportThresh"))
@@ -820,6 +869,91 @@ bool CGlass::initialize(std::shared_ptr<json::Object> com) {
 					"CGlass::initialize: Using default ReportCut: "
 							+ std::to_string(nReportCut));
 		}
+
+		// hypoPriorityBayesWeight
+		if ((params.HasKey("HypoPriorityBayesWeight"))
+				&& (params["HypoPriorityBayesWeight"].GetType()
+						== json::ValueType::DoubleVal)) {
+			hypoPriorityBayesWeight = params["HypoPriorityBayesWeight"].ToDouble();
+
+			glassutil::CLogit::log(
+					glassutil::log_level::info,
+					"CGlass::initialize: Using HypoPriorityBayesWeight: "
+							+ std::to_string(hypoPriorityBayesWeight));
+		} else {
+			glassutil::CLogit::log(
+					glassutil::log_level::info,
+					"CGlass::initialize: Using default HypoPriorityBayesWeight: "
+							+ std::to_string(hypoPriorityBayesWeight));
+		}
+
+		// hypoPriorityDataWeight
+		if ((params.HasKey("HypoPriorityDataWeight"))
+				&& (params["HypoPriorityDataWeight"].GetType()
+						== json::ValueType::DoubleVal)) {
+			hypoPriorityDataWeight = params["HypoPriorityDataWeight"].ToDouble();
+
+			glassutil::CLogit::log(
+					glassutil::log_level::info,
+					"CGlass::initialize: Using HypoPriorityDataWeight: "
+							+ std::to_string(hypoPriorityDataWeight));
+		} else {
+			glassutil::CLogit::log(
+					glassutil::log_level::info,
+					"CGlass::initialize: Using default HypoPriorityDataWeight: "
+							+ std::to_string(hypoPriorityDataWeight));
+		}
+
+		// hypoPriorityReportWeight
+		if ((params.HasKey("HypoPriorityReportWeight"))
+				&& (params["HypoPriorityReportWeight"].GetType()
+						== json::ValueType::DoubleVal)) {
+			hypoPriorityReportWeight = params["HypoPriorityReportWeight"].ToDouble();
+
+			glassutil::CLogit::log(
+					glassutil::log_level::info,
+					"CGlass::initialize: Using HypoPriorityReportWeight: "
+							+ std::to_string(hypoPriorityReportWeight));
+		} else {
+			glassutil::CLogit::log(
+					glassutil::log_level::info,
+					"CGlass::initialize: Using default HypoPriorityReportWeight: "
+							+ std::to_string(hypoPriorityReportWeight));
+		}
+
+		// hypoPriorityCycleWeight
+		if ((params.HasKey("HypoPriorityCycleWeight"))
+				&& (params["HypoPriorityCycleWeight"].GetType()
+						== json::ValueType::DoubleVal)) {
+			hypoPriorityCycleWeight = params["HypoPriorityCycleWeight"].ToDouble();
+
+			glassutil::CLogit::log(
+					glassutil::log_level::info,
+					"CGlass::initialize: Using HypoPriorityCycleWeight: "
+							+ std::to_string(hypoPriorityCycleWeight));
+		} else {
+			glassutil::CLogit::log(
+					glassutil::log_level::info,
+					"CGlass::initialize: Using default HypoPriorityCycleWeight: "
+							+ std::to_string(hypoPriorityCycleWeight));
+		}
+
+		// hypoPriorityAgingWeight
+		if ((params.HasKey("HypoPriorityAgingWeight"))
+				&& (params["HypoPriorityAgingWeight"].GetType()
+						== json::ValueType::DoubleVal)) {
+			hypoPriorityAgingWeight = params["HypoPriorityAgingWeight"].ToDouble();
+
+			glassutil::CLogit::log(
+					glassutil::log_level::info,
+					"CGlass::initialize: Using HypoPriorityAgingWeight: "
+							+ std::to_string(hypoPriorityAgingWeight));
+		} else {
+			glassutil::CLogit::log(
+					glassutil::log_level::info,
+					"CGlass::initialize: Using default HypoPriorityAgingWeight: "
+							+ std::to_string(hypoPriorityAgingWeight));
+		}
 	} else {
 		glassutil::CLogit::log(
 				glassutil::log_level::info,
@@ -980,6 +1114,24 @@ bool CGlass::initialize(std::shared_ptr<json::Object> com) {
 						+ std::to_string(numWebThreads));
 	}
 
+	// set the number of threads shared by nucleation, hypo, and web
+	// processing, 0 gives each its own threads
+	int numThreads = 0;
+	if ((com->HasKey("NumThreads"))
+			&& ((*com)["NumThreads"].GetType() == json::ValueType::IntVal)) {
+		numThreads = (*com)["NumThreads"].ToInt();
+
+		glassutil::CLogit::log(
+				glassutil::log_level::info,
+				"CGlass::initialize: Using NumThreads: "
+						+ std::to_string(numThreads));
+	} else {
+		glassutil::CLogit::log(
+				glassutil::log_level::info,
+				"CGlass::initialize: Using default NumThreads: "
+						+ std::to_string(numThreads));
+	}
+
 	int iHoursWithoutPicking = -1;
 	if ((com->HasKey("SiteHoursWithoutPicking"))
 			&& ((*com)["SiteHoursWithoutPicking"].GetType()
@@ -1020,6 +1172,27 @@ bool CGlass::initialize(std::shared_ptr<json::Object> com) {
 	// printf("%.2f %.4f %.4f\n", sg, Gaus(sg, 1.0), Sig(sg, 1.0));
 	// }
 
+	// stop the old executor so that none of its tasks run while the lists
+	// they work on are replaced, it is deleted once the old lists are gone
+	glassutil::CExecutor *oldExecutor = pExecutor;
+	if (oldExecutor) {
+		oldExecutor->stop();
+	}
+	pExecutor = NULL;
+
+	// create the shared executor, the per list thread counts become caps
+	// on how many of its threads each kind of work may use at once.  Hypos
+	// already being worked on come first, then new picks, then web updates
+	if (numThreads > 0) {
+		std::vector<glassutil::CExecutor::TaskClass> taskClasses(3);
+		taskClasses[task_class::nucleation] = { "Nucleation", 2,
+				numNucleationThreads };
+		taskClasses[task_class::evolution] = { "Evolution", 3, numHypoThreads };
+		taskClasses[task_class::maintenance] = { "Maintenance", 1,
+				numWebThreads };
+		pExecutor = new glassutil::CExecutor(taskClasses, numThreads);
+	}
+
 	// clean out old site list if any
 	if (pSiteList) {
 		delete (pSiteList);
@@ -1037,7 +1210,13 @@ bool CGlass::initialize(std::shared_ptr<json::Object> com) {
 	}
 
 	// create detection web list
-	pWebList = new CWebList(numWebThreads);
+	// without web threads, webs are updated as sites change
+	if ((pExecutor) && (numWebThreads > 0)) {
+		pWebList = new CWebList(0);
+		pWebList->setExecutor(pExecutor);
+	} else {
+		pWebList = new CWebList(numWebThreads);
+	}
 	pWebList->setGlass(this);
 	pWebList->setSiteList(pSiteList);
 
@@ -1047,7 +1226,12 @@ bool CGlass::initialize(std::shared_ptr<json::Object> com) {
 	}
 
 	// create pick list
-	pPickList = new CPickList(numNucleationThreads);
+	if (pExecutor) {
+		pPickList = new CPickList(0);
+		pPickList->setExecutor(pExecutor);
+	} else {
+		pPickList = new CPickList(numNucleationThreads);
+	}
 	pPickList->setGlass(this);
 	pPickList->setSiteList(pSiteList);
 
@@ -1067,13 +1251,23 @@ bool CGlass::initialize(std::shared_ptr<json::Object> com) {
 	}
 
 	// create hypo list
-	pHypoList = new CHypoList(numHypoThreads);
+	if (pExecutor) {
+		pHypoList = new CHypoList(0);
+		pHypoList->setExecutor(pExecutor);
+	} else {
+		pHypoList = new CHypoList(numHypoThreads);
+	}
 	pHypoList->setGlass(this);
 
 	// create detection processor
 	pDetection = new CDetection();
 	pDetection->setGlass(this);
 
+	// done with the old executor
+	if (oldExecutor) {
+		delete (oldExecutor);
+	}
+
 	return (true);
 }
 
@@ -1198,6 +1392,11 @@ bool CGlass::statusCheck() {
 		return (false);
 	}
 
+	// shared executor
+	if ((pExecutor) && (pExecutor->statusCheck() == false)) {
+		return (false);
+	}
+
 	// hypo list
 	if (pHypoList->statusCheck() == false) {
 		return (false);
@@ -1217,6 +1416,54 @@ bool CGlass::statusCheck() {
 	return (true);
 }
 
+// ---------------------------------------------------------getMemoryReport
+std::string CGlass::getMemoryReport() {
+	size_t webBytes = 0;
+	size_t siteBytes = 0;
+	size_t pickBytes = 0;
+	size_t correlationBytes = 0;
+	size_t hypoBytes = 0;
+	size_t tttBytes = 0;
+
+	if (pWebList != NULL) {
+		webBytes = pWebList->getMemoryUsage();
+	}
+	if (pSiteList != NULL) {
+		siteBytes = pSiteList->getMemoryUsage();
+	}
+	if (pPickList != NULL) {
+		pickBytes = pPickList->getMemoryUsage();
+	}
+	if (pCorrelationList != NULL) {
+		correlationBytes = pCorrelationList->getMemoryUsage();
+	}
+	if (pHypoList != NULL) {
+		hypoBytes = pHypoList->getMemoryUsage();
+	}
+
+	m_TTTMutex.lock();
+	if (pTrvDefault != NULL) {
+		tttBytes += pTrvDefault->getMemoryUsage();
+	}
+	if (pTTT != NULL) {
+		tttBytes += pTTT->getMemoryUsage();
+	}
+	m_TTTMutex.unlock();
+
+	size_t totalBytes = sizeof(CGlass) + webBytes + siteBytes + pickBytes
+			+ correlationBytes + hypoBytes + tttBytes;
+
+	return ("total: " + glassutil::CMemory::toString(totalBytes) + "; webs: "
+			+ glassutil::CMemory::toString(webBytes) + "; sites: "
+			+ glassutil::CMemory::toString(siteBytes) + "; picks: "
+			+ glassutil::CMemory::toString(pickBytes) + "; correlations: "
+			+ glassutil::CMemory::toString(correlationBytes) + "; hypos: "
+			+ glassutil::CMemory::toString(hypoBytes) + "; travel times: "
+			+ glassutil::CMemory::toString(tttBytes) + "; object pools: "
+			+ glassutil::CMemory::toString(
+					glassutil::CSlabPool::getTotalMemoryUsage()));
+}
+
 double CGlass::getAvgDelta() const {
 	return (avgDelta);
 }
@@ -1229,8 +1476,8 @@ double CGlass::getBeamMatchingAzimuthWindow() const {
 	return (beamMatchingAzimuthWindow);
 }
 
-double CGlass::getBeamMatchingDistanceWindow() const {
-	return (beamMatchingDistanceWindow);
+double CGlass::getBeamMatchingSlownessWindow() const {
+	return (beamMatchingSlownessWindow);
 }
 
 int CGlass::getCorrelationCancelAge() const {
@@ -1289,6 +1536,10 @@ int CGlass::getCycleLimit() const {
 	return (iCycleLimit);
 }
 
+int CGlass::getLocatorRefinementPicks() const {
+	return (locatorRefinementPicks);
+}
+
 bool CGlass::getMinimizeTtLocator() const {
 	return (minimizeTTLocator);
 }
@@ -1317,6 +1568,26 @@ double CGlass::getReportCut() const {
 	return (nReportCut);
 }
 
+double CGlass::getHypoPriorityBayesWeight() const {
+	return (hypoPriorityBayesWeight);
+}
+
+double CGlass::getHypoPriorityDataWeight() const {
+	return (hypoPriorityDataWeight);
+}
+
+double CGlass::getHypoPriorityReportWeight() const {
+	return (hypoPriorityReportWeight);
+}
+
+double CGlass::getHypoPriorityCycleWeight() const {
+	return (hypoPriorityCycleWeight);
+}
+
+double CGlass::getHypoPriorityAgingWeight() const {
+	return (hypoPriorityAgingWeight);
+}
+
 int CGlass::getSitePickMax() const {
 	return (nSitePickMax);
 }
@@ -1329,6 +1600,10 @@ CDetection*& CGlass::getDetection() {
 	return (pDetection);
 }
 
+glassutil::CExecutor* CGlass::getExecutor() {
+	return (pExecutor);
+}
+
 CHypoList*& CGlass::getHypoList() {
 	return (pHypoList);
 }
@@ -1,4 +1,5 @@
 #include <json.h>
+#include <cmath>
 #include <string>
 #include <algorithm>
 #include <memory>
@@ -11,6 +12,7 @@
 #include "Brent.h"
 #include "Hypo.h"
 #include "Site.h"
+#include "SiteList.h"
 #include "PickList.h"
 #include "HypoList.h"
 #include "Pick.h"
@@ -19,6 +21,7 @@
 #include "Web.h"
 #include "Glass.h"
 #include "Logit.h"
+#include "Memory.h"
 #include "Taper.h"
 #include <fstream>
 #include <limits>
@@ -26,6 +29,7 @@
 namespace glasscore {
 
 #define MAXLOCDEPTH 800.0  // The maximum allowed locator depth
+#define STATSTOLERANCE 0.01  // Degrees a hypo moves before stats are rebuilt
 
 /**
  * \brief Pick sorting function used by CHypo, sorts by pick time
@@ -38,6 +42,79 @@ static bool sortPick(std::shared_ptr<CPick> pck1, std::shared_ptr<CPick> pck2) {
 	return (false);
 }
 
+/**
+ * \brief Inserts a value into a sorted vector, used by CHypo::addStatsPick
+ */
+static void insertSorted(std::vector<double> *values, double value) {
+	values->insert(std::upper_bound(values->begin(), values->end(), value),
+					value);
+}
+
+/**
+ * \brief Removes the value closest to the given value from a sorted vector,
+ * used by CHypo::remStatsPick
+ * \return Returns false if no value was close enough to be the same one
+ */
+static bool eraseSorted(std::vector<double> *values, double value) {
+	auto it = std::lower_bound(values->begin(), values->end(), value);
+
+	// the stored value may differ in the last bits
+	if ((it != values->begin())
+			&& ((it == values->end()) || ((*it - value) > (value - *(it - 1))))) {
+		--it;
+	}
+	if ((it == values->end()) || (std::fabs(*it - value) > 1.0e-9)) {
+		return (false);
+	}
+
+	values->erase(it);
+	return (true);
+}
+
+/**
+ * \brief Solves a 4 by 4 linear system by gaussian elimination with partial
+ * pivoting, used by CHypo::refineLocate
+ */
+static bool solve4(double a[4][4], double b[4], double x[4]) {
+	for (int col = 0; col < 4; col++) {
+		// find the pivot
+		int pivot = col;
+		for (int row = col + 1; row < 4; row++) {
+			if (std::fabs(a[row][col]) > std::fabs(a[pivot][col])) {
+				pivot = row;
+			}
+		}
+		if (std::fabs(a[pivot][col]) < 1.0e-12) {
+			return (false);
+		}
+		if (pivot != col) {
+			for (int k = 0; k < 4; k++) {
+				std::swap(a[col][k], a[pivot][k]);
+			}
+			std::swap(b[col], b[pivot]);
+		}
+
+		// eliminate below the pivot
+		for (int row = col + 1; row < 4; row++) {
+			double f = a[row][col] / a[col][col];
+			for (int k = col; k < 4; k++) {
+				a[row][k] -= f * a[col][k];
+			}
+			b[row] -= f * b[col];
+		}
+	}
+
+	// back substitute
+	for (int row = 3; row >= 0; row--) {
+		double sum = b[row];
+		for (int k = row + 1; k < 4; k++) {
+			sum -= a[row][k] * x[k];
+		}
+		x[row] = sum / a[row][row];
+	}
+	return (true);
+}
+
 // ---------------------------------------------------------CHypo
 CHypo::CHypo() {
 	// seed the random number generator
@@ -189,6 +266,8 @@ void CHypo::addPick(std::shared_ptr<CPick> pck) {
 
 	// add the pick to the vector.
 	vPick.push_back(pck);
+	iPickVersion++;
+	addStatsPick(pck);
 }
 
 // ---------------------------------------------------------affinity
@@ -682,6 +761,209 @@ void CHypo::annealingLocateResidual(int nIter, double dStart, double dStop,
 	return;
 }
 
+// ---------------------------------------------------------refineLocate
+void CHypo::refineLocate(int nIter, bool residual) {
+	// lock mutex for this scope
+	std::lock_guard < std::recursive_mutex > guard(hypoMutex);
+
+	if (pTTT == NULL) {
+		glassutil::CLogit::log(glassutil::log_level::error,
+								"CHypo::refineLocate: NULL pTTT.");
+		return;
+	}
+
+	// don't locate if the location is fixed
+	if (bFixed) {
+		return;
+	}
+
+	// taper to lower val if large azimuthal gap, as in annealingLocate
+	glassutil::CTaper taperGap;
+	taperGap = glassutil::CTaper(0., 0., aziTaper, 360.);
+
+	// the same sigma taper as getBayes
+	glassutil::CTaper tap;
+	tap = glassutil::CTaper(-0.0001, 2.0, 999.0, 999.0);
+
+	// the objective to maximize at a trial location
+	auto objective = [&](double lat, double lon, double z, double t) {
+		if (residual) {
+			return (-getSumAbsResidual(lat, lon, z, t, 0));
+		}
+		return (getBayes(lat, lon, z, t, 0) * taperGap.Val(gap(lat, lon, z)));
+	};
+
+	double valStart = objective(dLat, dLon, dZ, tOrg);
+	double valBest = valStart;
+	int nEval = 1;
+
+	// Save total movement
+	double ddx = 0.0;
+	double ddy = 0.0;
+	double ddz = 0.0;
+	double ddt = 0.0;
+
+	// levenberg-marquardt damping
+	double lambda = 0.01;
+
+	std::vector<glassutil::CGeoPoint> sitePoints;
+	getSitePoints(&sitePoints);
+	std::vector<double> deltas;
+	std::vector<double> azimuths;
+	int npick = vPick.size();
+
+	while (nEval < nIter) {
+		// build the normal equations at the current location, the parameters
+		// are the east, north, and down steps in km and the time step in
+		// seconds
+		double jtj[4][4] = { { 0 } };
+		double jtr[4] = { 0 };
+		int nUsed = 0;
+
+		glassutil::CGeoPoint point;
+		point.setGeographic(dLat, dLon);
+		point.deltas(sitePoints, &deltas);
+		point.azimuths(sitePoints, &azimuths);
+		pTTT->setOrigin(dLat, dLon, dZ);
+
+		for (int ipick = 0; ipick < npick; ipick++) {
+			double tobs = vPick[ipick]->getTPick() - tOrg;
+			double dTdDelta = 0;
+			double dTdDepth = 0;
+			double tcal = pTTT->T(&vPick[ipick]->getSite()->getGeo(), tobs,
+									&dTdDelta, &dTdDepth);
+			if (tcal < 0.0) {
+				continue;
+			}
+
+			// the residual scale and weight for this pick, matching the
+			// objective
+			double scale;
+			double weight;
+			if (residual) {
+				// getSumAbsResidual only counts P and S, clipped at 10 s
+				double res = std::fabs(tobs - tcal);
+				if (((pTTT->sPhase != "P") && (pTTT->sPhase != "S"))
+						|| (res >= 10.0)) {
+					continue;
+				}
+				scale = 1.0;
+				weight = 1.0 / std::max(res, 0.01);
+			} else {
+				double delta = RAD2DEG * deltas[ipick];
+				double sigma = (tap.Val(delta) * 2.25) + 0.75;
+				scale = getWeightedResidual(pTTT->sPhase, 1.0, 0.0) / sigma;
+				weight = pGlass->sig(scale * (tobs - tcal), 1.0);
+			}
+
+			// the scaled residual and its derivatives, moving the hypo
+			// toward the site shortens the distance
+			double res = scale * (tobs - tcal);
+			double dRes[4];
+			dRes[0] = scale * dTdDelta * sin(azimuths[ipick]) / DEG2KM;
+			dRes[1] = scale * dTdDelta * cos(azimuths[ipick]) / DEG2KM;
+			dRes[2] = -scale * dTdDepth;
+			dRes[3] = -scale;
+
+			for (int i = 0; i < 4; i++) {
+				for (int j = 0; j < 4; j++) {
+					jtj[i][j] += weight * dRes[i] * dRes[j];
+				}
+				jtr[i] -= weight * dRes[i] * res;
+			}
+			nUsed++;
+		}
+
+		// need more picks than parameters
+		if (nUsed < 5) {
+			break;
+		}
+
+		// try damped steps until one improves the objective
+		bool improved = false;
+		bool converged = false;
+		while (nEval < nIter) {
+			double a[4][4];
+			double b[4];
+			double step[4];
+			for (int i = 0; i < 4; i++) {
+				for (int j = 0; j < 4; j++) {
+					a[i][j] = jtj[i][j];
+				}
+				a[i][i] += lambda * jtj[i][i];
+				b[i] = jtr[i];
+			}
+			if (!solve4(a, b, step)) {
+				break;
+			}
+
+			// compute the trial location, limiting the depth as the
+			// annealing locators do
+			double cosLat = std::max(cos(DEG2RAD * dLat), 0.01);
+			double xlon = dLon + step[0] / (DEG2KM * cosLat);
+			double xlat = dLat + step[1] / DEG2KM;
+			double xz = std::min(std::max(dZ + step[2], 1.0), MAXLOCDEPTH);
+			double oT = tOrg + step[3];
+
+			double val = objective(xlat, xlon, xz, oT);
+			nEval++;
+
+			if (val > valBest) {
+				valBest = val;
+				setLat(xlat);
+				setLon(xlon);
+				setZ(xz);
+				setTOrg(oT);
+
+				ddx += step[0];
+				ddy += step[1];
+				ddz += step[2];
+				ddt += step[3];
+
+				lambda = std::max(lambda / 10.0, 1.0e-6);
+				improved = true;
+
+				// done once the steps are well below the location precision
+				converged = (std::fabs(step[0]) < 0.01)
+						&& (std::fabs(step[1]) < 0.01)
+						&& (std::fabs(step[2]) < 0.01)
+						&& (std::fabs(step[3]) < 0.001);
+				break;
+			}
+
+			lambda *= 10.0;
+			if (lambda > 1.0e6) {
+				break;
+			}
+		}
+
+		if (!improved || converged) {
+			break;
+		}
+	}
+
+	// set dBayes to current value
+	if (residual) {
+		dBayes = getBayes(dLat, dLon, dZ, tOrg, 0);
+	} else {
+		dBayes = valBest;
+	}
+
+	char sLog[1024];
+	snprintf(
+			sLog, sizeof(sLog),
+			"CHypo::refineLocate: total movement (%.4f,%.4f,%.4f,%.4f)"
+			" (%.4f,%.4f,%.4f,%.4f) sPid:%s; %d evaluations; new value:%.4f;"
+			" old value:%.4f",
+			dLat, dLon, dZ, tOrg, ddx, ddy, ddz, ddt, sPid.c_str(), nEval,
+			valBest, valStart);
+	glassutil::CLogit::log(sLog);
+
+	if (pGlass->getGraphicsOut() == true) {
+		graphicsOutput();
+	}
+}
+
 // ---------------------------------------------------------associate
 bool CHypo::associate(std::shared_ptr<CPick> pick, double sigma,
 						double sdassoc) {
@@ -711,19 +993,22 @@ bool CHypo::associate(std::shared_ptr<CPick> pick, double sigma,
 	// get site
 	std::shared_ptr<CSite> site = pick->getSite();
 
-	// set up a geographic object for this hypo
-	glassutil::CGeo hypoGeo;
-	hypoGeo.setGeographic(dLat, dLon, EARTHRADIUSKM - dZ);
+	// set up a geographic point for this hypo
+	glassutil::CGeoPoint hypoPoint;
+	hypoPoint.setGeographic(dLat, dLon);
 
 	// check backazimuth if present
 	if (pick->getBackAzimuth() > 0) {
-		// compute azimith from the site to the node
-		double siteAzimuth = site->getGeo().azimuth(&hypoGeo);
+		// compute azimith from the site to the node in degrees
+		double siteAzimuth = RAD2DEG * site->getGeoPoint().azimuth(hypoPoint);
 
 		// check to see if pick's backazimuth is within the
-		// valid range
-		if ((pick->getBackAzimuth() < (siteAzimuth - dAzimuthRange))
-				|| (pick->getBackAzimuth() > (siteAzimuth + dAzimuthRange))) {
+		// valid range, allowing for wrap around north
+		double azimuthDiff = std::fabs(pick->getBackAzimuth() - siteAzimuth);
+		if (azimuthDiff > 180.0) {
+			azimuthDiff = 360.0 - azimuthDiff;
+		}
+		if (azimuthDiff > dAzimuthRange) {
 			// it is not, do not associate
 			return (false);
 		}
@@ -748,7 +1033,7 @@ bool CHypo::associate(std::shared_ptr<CPick> pick, double sigma,
 	 } */
 
 	// compute distance
-	double siteDistance = hypoGeo.delta(&site->getGeo()) / DEG2RAD;
+	double siteDistance = hypoPoint.delta(site->getGeoPoint()) / DEG2RAD;
 
 	// check if distance is beyond cutoff
 	if (siteDistance > dCut) {
@@ -840,6 +1125,8 @@ bool CHypo::associate(std::shared_ptr<CCorrelation> corr, double tWindow,
 
 		// check if distance difference is within window
 		if (xDist < xWindow) {
+			char sTime[DATETIMELENGTH + 1];
+			glassutil::CDate::formatDateTime(corr->getTCorrelation(), sTime);
 			snprintf(
 					sLog,
 					sizeof(sLog),
@@ -847,8 +1134,7 @@ bool CHypo::associate(std::shared_ptr<CCorrelation> corr, double tWindow,
 					" Corr:%s tDist:%.2f<tWindow:%.2f"
 					" xDist:%.2f>xWindow:%.2f)",
 					sPid.c_str(),
-					glassutil::CDate::encodeDateTime(corr->getTCorrelation())
-							.c_str(),
+					sTime,
 					corr->getSite()->getScnl().c_str(), corr->getPid().c_str(),
 					tDist, tWindow, xDist, xWindow);
 			glassutil::CLogit::log(sLog);
@@ -858,23 +1144,27 @@ bool CHypo::associate(std::shared_ptr<CCorrelation> corr, double tWindow,
 	}
 
 	if (xDist == 0) {
+		char sTime[DATETIMELENGTH + 1];
+		glassutil::CDate::formatDateTime(corr->getTCorrelation(), sTime);
 		snprintf(
 				sLog,
 				sizeof(sLog),
 				"CHypo::associate: C-NOASSOC Hypo:%s Time:%s Station:%s Corr:%s"
 				" tDist:%.2f>tWindow:%.2f",
 				sPid.c_str(),
-				glassutil::CDate::encodeDateTime(corr->getTCorrelation()).c_str(),
+				sTime,
 				corr->getSite()->getScnl().c_str(), corr->getPid().c_str(),
 				tDist, tWindow);
 	} else {
+		char sTime[DATETIMELENGTH + 1];
+		glassutil::CDate::formatDateTime(corr->getTCorrelation(), sTime);
 		snprintf(
 				sLog,
 				sizeof(sLog),
 				"CHypo::associate: C-NOASSOC Hypo:%s Time:%s Station:%s Corr:%s"
 				" tDist:%.2f<tWindow:%.2f xDist:%.2f>xWindow:%.2f)",
 				sPid.c_str(),
-				glassutil::CDate::encodeDateTime(corr->getTCorrelation()).c_str(),
+				sTime,
 				corr->getSite()->getScnl().c_str(), corr->getPid().c_str(),
 				tDist, tWindow, xDist, xWindow);
 	}
@@ -931,10 +1221,11 @@ bool CHypo::cancelCheck() {
 	char sLog[2048];
 	char sHypo[1024];
 
-	glassutil::CDate dt = glassutil::CDate(tOrg);
+	char sTime[DATETIMELENGTH + 1];
+	glassutil::CDate::formatDateTime(tOrg, sTime);
 	snprintf(sHypo, sizeof(sHypo), "CHypo::cancel: %s tOrg:%s; dLat:%9.4f; "
 				"dLon:%10.4f; dZ:%6.1f; bayes:%.2f; nPick:%d; nCorr:%d",
-				sPid.c_str(), dt.dateTime().c_str(), dLat, dLon, dZ, dBayes,
+				sPid.c_str(), sTime, dLat, dLon, dZ, dBayes,
 				static_cast<int>(vPick.size()), static_cast<int>(vCorr.size()));
 
 	// check to see if there is enough supporting data for this hypocenter
@@ -1038,6 +1329,9 @@ void CHypo::clear() {
 	// lock mutex for this scope
 	std::lock_guard < std::recursive_mutex > guard(hypoMutex);
 
+	// first, so setTOrg doesn't look for a hypo list
+	pGlass = NULL;
+
 	setLat(0.0);
 	setLon(0.0);
 	setZ(0.0);
@@ -1064,14 +1358,22 @@ void CHypo::clear() {
 	bFixed = false;
 	bEvent = false;
 
-	pGlass = NULL;
-
 	pTTT.reset();
 	pTrv1.reset();
 	pTrv2.reset();
 
 	bCorrAdded = false;
 
+	bStatsValid = false;
+	dStatsLat = 0.0;
+	dStatsLon = 0.0;
+	dStatsSum2 = 0.0;
+	dStatsSum4 = 0.0;
+	iPickVersion = 0;
+	iWtsVersion = -1;
+	dWtsLat = 0.0;
+	dWtsLon = 0.0;
+
 	clearPicks();
 	clearCorrelations();
 	vWts.clear();
@@ -1120,6 +1422,12 @@ void CHypo::clearPicks() {
 
 	// remove all pick links to this hypo
 	vPick.clear();
+	iPickVersion++;
+
+	// nothing to keep statistics on
+	bStatsValid = false;
+	vStatsDistance.clear();
+	vStatsAzimuth.clear();
 }
 
 // ---------------------------------------------------------event
@@ -1188,28 +1496,30 @@ std::shared_ptr<json::Object> CHypo::expire(bool send) {
 	return (expire);
 }
 
+// ---------------------------------------------------------getSitePoints
+void CHypo::getSitePoints(std::vector<glassutil::CGeoPoint> *points) const {
+	points->resize(vPick.size());
+	for (int i = 0; i < static_cast<int>(vPick.size()); i++) {
+		(*points)[i] = vPick[i]->getSite()->getGeoPoint();
+	}
+}
+
 // ---------------------------------------------------------Gap
 double CHypo::gap(double lat, double lon, double z) {
 	// lock mutex for this scope
 	std::lock_guard < std::recursive_mutex > guard(hypoMutex);
 
-	// set up a geographic object for this hypo
-	glassutil::CGeo geo;
-	geo.setGeographic(lat, lon, EARTHRADIUSKM - z);
+	// set up a geographic point for this hypo
+	glassutil::CGeoPoint point;
+	point.setGeographic(lat, lon);
 
-	// create and populate vectors containing the
-	// pick distances and azimuths
+	// compute the pick azimuths
+	std::vector<glassutil::CGeoPoint> sitePoints;
+	getSitePoints(&sitePoints);
 	std::vector<double> azm;
-
-	for (auto pick : vPick) {
-		// get the site
-		std::shared_ptr<CSite> site = pick->getSite();
-
-		// compute the azimuth
-		double azimuth = geo.azimuth(&site->getGeo()) / DEG2RAD;
-
-		// add to azimuth vector
-		azm.push_back(azimuth);
+	point.azimuths(sitePoints, &azm);
+	for (auto &azimuth : azm) {
+		azimuth /= DEG2RAD;
 	}
 
 	int nazm = azm.size();
@@ -1285,6 +1595,89 @@ double CHypo::getResidual(std::shared_ptr<CPick> pick) {
 	return tRes;
 }
 
+// ---------------------------------------------------------getCandidatePicks
+std::vector<std::shared_ptr<CPick>> CHypo::getCandidatePicks(double tWindow,
+		double tDuration) {
+	std::vector<std::shared_ptr<CPick>> candidates;
+
+	// null check
+	if ((pGlass == NULL) || (pGlass->getSiteList() == NULL)) {
+		glassutil::CLogit::log(glassutil::log_level::error,
+								"CHypo::getCandidatePicks: NULL pGlass.");
+		return (candidates);
+	}
+	if (pTTT == NULL) {
+		glassutil::CLogit::log(glassutil::log_level::error,
+								"CHypo::getCandidatePicks: NULL pTTT.");
+		return (candidates);
+	}
+
+	std::vector<std::shared_ptr<CSite>> sites =
+			pGlass->getSiteList()->getSiteList();
+
+	// lock mutex for this scope
+	std::lock_guard < std::recursive_mutex > guard(hypoMutex);
+
+	// setup traveltime interface for this hypo
+	pTTT->setOrigin(dLat, dLon, dZ);
+
+	// set up a geographic point for this hypo
+	glassutil::CGeoPoint hypoPoint;
+	hypoPoint.setGeographic(dLat, dLon);
+
+	double tStart = tOrg;
+	double tEnd = tOrg + tDuration;
+	double travelTimes[MAX_TRAV];
+	std::vector<std::pair<double, double>> windows;
+
+	for (const auto &site : sites) {
+		// compute distance, and check if it is beyond cutoff
+		double siteDistance = hypoPoint.delta(site->getGeoPoint()) / DEG2RAD;
+		if (siteDistance > dCut) {
+			continue;
+		}
+
+		// build the arrival windows for each phase
+		windows.clear();
+		int nPhase = pTTT->Tall(siteDistance, travelTimes);
+		for (int i = 0; i < nPhase; i++) {
+			if (travelTimes[i] < 0.0) {
+				continue;
+			}
+
+			double t1 = std::max(tOrg + travelTimes[i] - tWindow, tStart);
+			double t2 = std::min(tOrg + travelTimes[i] + tWindow, tEnd);
+			if (t1 <= t2) {
+				windows.push_back(std::make_pair(t1, t2));
+			}
+		}
+
+		if (windows.size() == 0) {
+			continue;
+		}
+
+		// merge overlapping windows so each pick is only collected once
+		std::sort(windows.begin(), windows.end());
+		double t1 = windows[0].first;
+		double t2 = windows[0].second;
+		for (int i = 1; i < static_cast<int>(windows.size()); i++) {
+			if (windows[i].first <= t2) {
+				t2 = std::max(t2, windows[i].second);
+				continue;
+			}
+			site->getPicks(t1, t2, &candidates);
+			t1 = windows[i].first;
+			t2 = windows[i].second;
+		}
+		site->getPicks(t1, t2, &candidates);
+	}
+
+	// return in time order
+	std::sort(candidates.begin(), candidates.end(), sortPick);
+
+	return (candidates);
+}
+
 double CHypo::getAziTaper() const {
 	std::lock_guard < std::recursive_mutex > hypoGuard(hypoMutex);
 	return (aziTaper);
@@ -1313,7 +1706,7 @@ double CHypo::getBayes(double xlat, double xlon, double xZ, double oT,
 		return (0);
 	}
 
-	glassutil::CGeo geo;
+	glassutil::CGeoPoint point;
 	double value = 0.;
 	double tcal;
 	char sLog[1024];
@@ -1323,8 +1716,9 @@ double CHypo::getBayes(double xlat, double xlon, double xZ, double oT,
 	glassutil::CTaper tap;
 	tap = glassutil::CTaper(-0.0001, 2.0, 999.0, 999.0);
 
-	// geo is used for calculating distances to stations for determining sigma
-	geo.setGeographic(xlat, xlon, EARTHRADIUSKM - xZ);
+	// point is used for calculating distances to stations for determining
+	// sigma
+	point.setGeographic(xlat, xlon);
 
 	// This sets the travel-time look up location
 	if (pTrv1) {
@@ -1339,6 +1733,12 @@ double CHypo::getBayes(double xlat, double xlon, double xZ, double oT,
 	// The number of picks associated with the hypocenter
 	int npick = vPick.size();
 
+	// compute the distances to the stations in one pass
+	std::vector<glassutil::CGeoPoint> sitePoints;
+	getSitePoints(&sitePoints);
+	std::vector<double> deltas;
+	point.deltas(sitePoints, &deltas);
+
 	// Loop through each pick and find the residual, calculate
 	// the significance, and add to the stacks.
 	// Currently only P, S, and nucleation phases added to stack.
@@ -1349,7 +1749,7 @@ double CHypo::getBayes(double xlat, double xlon, double xZ, double oT,
 		// calculate residual
 		double tobs = pick->getTPick() - oT;
 		std::shared_ptr<CSite> site = pick->getSite();
-		glassutil::CGeo siteGeo = site->getGeo();
+		glassutil::CGeo &siteGeo = site->getGeo();
 
 		// only use nucleation phases if on nucleation branch
 		if (nucleate == 1) {
@@ -1392,7 +1792,7 @@ double CHypo::getBayes(double xlat, double xlon, double xZ, double oT,
 		}
 
 		// calculate distance to station to get sigma
-		double delta = RAD2DEG * geo.delta(&site->getGeo());
+		double delta = RAD2DEG * deltas[ipick];
 		double sigma = (tap.Val(delta) * 2.25) + 0.75;
 
 		// calculate and add to the stack
@@ -1845,8 +2245,8 @@ std::shared_ptr<json::Object> CHypo::hypo(bool send) {
 	pTTT->setOrigin(dLat, dLon, dZ);
 
 	// set up geo for distance calculations
-	glassutil::CGeo geo;
-	geo.setGeographic(dLat, dLon, EARTHRADIUSKM - dZ);
+	glassutil::CGeoPoint point;
+	point.setGeographic(dLat, dLon);
 
 	// array to hold data
 	json::Array data;
@@ -1872,8 +2272,8 @@ std::shared_ptr<json::Object> CHypo::hypo(bool send) {
 			// add the association info
 			json::Object assocobj;
 			assocobj["Phase"] = pTTT->sPhase;
-			assocobj["Distance"] = geo.delta(&site->getGeo()) / DEG2RAD;
-			assocobj["Azimuth"] = geo.azimuth(&site->getGeo()) / DEG2RAD;
+			assocobj["Distance"] = point.delta(site->getGeoPoint()) / DEG2RAD;
+			assocobj["Azimuth"] = point.azimuth(site->getGeoPoint()) / DEG2RAD;
 			assocobj["Residual"] = tres;
 			assocobj["Sigma"] = sig;
 			pickObj["AssociationInfo"] = assocobj;
@@ -1884,8 +2284,8 @@ std::shared_ptr<json::Object> CHypo::hypo(bool send) {
 			pickObj["T"] = glassutil::CDate::encodeDateTime(pick->getTPick());
 			pickObj["Time"] = glassutil::CDate::encodeISO8601Time(
 					pick->getTPick());
-			pickObj["Distance"] = geo.delta(&site->getGeo()) / DEG2RAD;
-			pickObj["Azimuth"] = geo.azimuth(&site->getGeo()) / DEG2RAD;
+			pickObj["Distance"] = point.delta(site->getGeoPoint()) / DEG2RAD;
+			pickObj["Azimuth"] = point.azimuth(site->getGeoPoint()) / DEG2RAD;
 			pickObj["Residual"] = tres;
 		}
 
@@ -1915,8 +2315,8 @@ std::shared_ptr<json::Object> CHypo::hypo(bool send) {
 			// add the association info
 			json::Object assocobj;
 			assocobj["Phase"] = pTTT->sPhase;
-			assocobj["Distance"] = geo.delta(&site->getGeo()) / DEG2RAD;
-			assocobj["Azimuth"] = geo.azimuth(&site->getGeo()) / DEG2RAD;
+			assocobj["Distance"] = point.delta(site->getGeoPoint()) / DEG2RAD;
+			assocobj["Azimuth"] = point.azimuth(site->getGeoPoint()) / DEG2RAD;
 			assocobj["Residual"] = tres;
 			assocobj["Sigma"] = sig;
 			correlationObj["AssociationInfo"] = assocobj;
@@ -1929,8 +2329,8 @@ std::shared_ptr<json::Object> CHypo::hypo(bool send) {
 			correlationObj["Latitude"] = correlation->getLat();
 			correlationObj["Longitude"] = correlation->getLon();
 			correlationObj["Depth"] = correlation->getZ();
-			correlationObj["Distance"] = geo.delta(&site->getGeo()) / DEG2RAD;
-			correlationObj["Azimuth"] = geo.azimuth(&site->getGeo()) / DEG2RAD;
+			correlationObj["Distance"] = point.delta(site->getGeoPoint()) / DEG2RAD;
+			correlationObj["Azimuth"] = point.azimuth(site->getGeoPoint()) / DEG2RAD;
 			correlationObj["Residual"] = tres;
 			correlationObj["Correlation"] = correlation->getCorrelation();
 		}
@@ -1950,6 +2350,115 @@ std::shared_ptr<json::Object> CHypo::hypo(bool send) {
 	return (hypo);
 }
 
+std::shared_ptr<const HypoRecord> CHypo::hypoRecord(bool send,
+														bool snapshot) {
+	// null check
+	if (pGlass == NULL) {
+		glassutil::CLogit::log(glassutil::log_level::warn,
+								"CHypo::hypoRecord: NULL pGlass.");
+		return (NULL);
+	}
+	if (pTTT == NULL) {
+		glassutil::CLogit::log(glassutil::log_level::warn,
+								"CHypo::hypoRecord: NULL pTTT.");
+		return (NULL);
+	}
+
+	// make sure this event is still reportable
+	if (reportCheck() == false) {
+		glassutil::CLogit::log(
+				glassutil::log_level::debug,
+				"CHypo::hypoRecord: hypo:" + sPid + " is not reportable.");
+		return (NULL);
+	}
+
+	// lock mutex for this scope
+	std::lock_guard < std::recursive_mutex > guard(hypoMutex);
+
+	std::shared_ptr<HypoRecord> record = std::make_shared<HypoRecord>();
+
+	// basic info
+	record->sPid = sPid;
+	record->sWebName = sWebName;
+	record->iVersion = reportCount;
+	record->bSnapshot = snapshot;
+
+	// time
+	record->tOrg = tOrg;
+	record->sOrgTime = glassutil::CDate::encodeISO8601Time(tOrg);
+
+	// location
+	record->dLat = dLat;
+	record->dLon = dLon;
+	record->dZ = dZ;
+
+	// supplementary info
+	record->dMin = dMin;
+	record->dGap = dGap;
+	record->dBayes = dBayes;
+	record->dBayesInitial = dBayesInitial;
+
+	// set up traveltime object
+	pTTT->setOrigin(dLat, dLon, dZ);
+
+	// set up geo for distance calculations
+	glassutil::CGeoPoint point;
+	point.setGeographic(dLat, dLon);
+
+	record->vData.reserve(vPick.size() + vCorr.size());
+
+	// for each pick
+	for (auto pick : vPick) {
+		std::shared_ptr<CSite> site = pick->getSite();
+		double tobs = pick->getTPick() - tOrg;
+		double tcal = pTTT->T(&site->getGeo(), tobs);
+		double tres = tobs - tcal;
+
+		AssociatedDataRecord data;
+		data.eType = AssociatedDataRecord::DataType::Pick;
+		data.sPid = pick->getPid();
+		data.sSite = site->getScnl();
+		data.tArrival = pick->getTPick();
+		data.sPhase = pTTT->sPhase;
+		data.dDistance = point.delta(site->getGeoPoint()) / DEG2RAD;
+		data.dAzimuth = point.azimuth(site->getGeoPoint()) / DEG2RAD;
+		data.dResidual = tres;
+		data.dSigma = pGlass->sig(tres, 1.0);
+		data.jSource = pick->getJPick();
+
+		record->vData.push_back(data);
+	}
+
+	// for each correlation
+	for (auto correlation : vCorr) {
+		std::shared_ptr<CSite> site = correlation->getSite();
+		double tobs = correlation->getTCorrelation() - tOrg;
+		double tcal = pTTT->T(&site->getGeo(), tobs);
+		double tres = tobs - tcal;
+
+		AssociatedDataRecord data;
+		data.eType = AssociatedDataRecord::DataType::Correlation;
+		data.sPid = correlation->getPid();
+		data.sSite = site->getScnl();
+		data.tArrival = correlation->getTCorrelation();
+		data.sPhase = pTTT->sPhase;
+		data.dDistance = point.delta(site->getGeoPoint()) / DEG2RAD;
+		data.dAzimuth = point.azimuth(site->getGeoPoint()) / DEG2RAD;
+		data.dResidual = tres;
+		data.dSigma = pGlass->sig(tres, 1.0);
+		data.jSource = correlation->getJCorrelation();
+
+		record->vData.push_back(data);
+	}
+
+	if (send == true) {
+		pGlass->send(std::shared_ptr<const HypoRecord>(record));
+	}
+
+	// done
+	return (record);
+}
+
 int CHypo::incrementProcessCount() {
 	// lock mutex for this scope
 	std::lock_guard < std::recursive_mutex > guard(hypoMutex);
@@ -1999,19 +2508,18 @@ bool CHypo::initialize(double lat, double lon, double z, double time,
 					+ std::to_string(dRes));
 
 	// make local copies of the travel times so that we don't
-	// have cross-thread contention for them between hypos
+	// have cross-thread contention for them between hypos, the copies
+	// share the immutable tables and only hold their own query state
 	if (firstTrav != NULL) {
-		pTrv1 = std::make_shared < traveltime::CTravelTime
-				> (traveltime::CTravelTime(*firstTrav));
+		pTrv1 = std::make_shared<traveltime::CTravelTime>(*firstTrav);
 	}
 
 	if (secondTrav != NULL) {
-		pTrv2 = std::make_shared < traveltime::CTravelTime
-				> (traveltime::CTravelTime(*secondTrav));
+		pTrv2 = std::make_shared<traveltime::CTravelTime>(*secondTrav);
 	}
 
 	if (ttt != NULL) {
-		pTTT = std::make_shared < traveltime::CTTT > (traveltime::CTTT(*ttt));
+		pTTT = std::make_shared<traveltime::CTTT>(*ttt);
 	}
 	tCreate = glassutil::CDate::now();
 
@@ -2051,12 +2559,12 @@ void CHypo::list(std::string src) {
 	char sLog[1024];
 
 	// generate time string
-	glassutil::CDate dt = glassutil::CDate(tOrg);
-	std::string sorg = dt.dateTime();
+	char sorg[DATETIMELENGTH + 1];
+	glassutil::CDate::formatDateTime(tOrg, sorg);
 
 	snprintf(sLog, sizeof(sLog),
 				"CHypo::list: ** %s **\nPid:%s\n%s %.2f %.2f %.2f (%.2f)",
-				sorg.c_str(), sPid.c_str(), sorg.c_str(), dLat, dLon, dZ,
+				sorg, sPid.c_str(), sorg, dLat, dLon, dZ,
 				dBayes);
 	glassutil::CLogit::log(sLog);
 
@@ -2067,16 +2575,16 @@ void CHypo::list(std::string src) {
 			sLog, sizeof(sLog),
 			"CHypo::list: ** %s **\\nPid:%s\nGap:%.1f Dmin:%.1f Dmedian:%.1f"
 			"\nSigma:%.2f Kurtosis:%.2f\nWeb:%s",
-			sorg.c_str(), sPid.c_str(), dGap, dMin, dMed, dSig, dKrt,
+			sorg, sPid.c_str(), dGap, dMin, dMed, dSig, dKrt,
 			sWebName.c_str());
 	glassutil::CLogit::log(sLog);
 
 	// setup traveltime interface for this hypo
 	pTTT->setOrigin(dLat, dLon, dZ);
 
-	// set up a geographic object for this hypo
-	glassutil::CGeo geo;
-	geo.setGeographic(dLat, dLon, EARTHRADIUSKM - dZ);
+	// set up a geographic point for this hypo
+	glassutil::CGeoPoint point;
+	point.setGeographic(dLat, dLon);
 
 	// create local pick vector
 	std::vector < std::shared_ptr < CPick >> vpick;
@@ -2086,12 +2594,17 @@ void CHypo::list(std::string src) {
 		vpick.push_back(pick);
 	}
 
-	// generate list of rogue picks
-	std::vector < std::shared_ptr < CPick >> pickRogues = pGlass->getPickList()
-			->rogues(sPid, tOrg);
+	// generate list of rogue picks, those that could be associated with
+	// this hypo but are not
+	std::vector < std::shared_ptr < CPick >> pickRogues = getCandidatePicks(
+			pGlass->getSdAssociate(), 2400.0);
 
 	// add rogue picks to the local pick vector
 	for (auto pick : pickRogues) {
+		std::shared_ptr<CHypo> pickHyp = pick->getHypo();
+		if ((pickHyp != NULL) && (pickHyp->getPid() == sPid)) {
+			continue;
+		}
 		vpick.push_back(pick);
 	}
 
@@ -2122,10 +2635,10 @@ void CHypo::list(std::string src) {
 		}
 
 		// compute distance
-		double dis = geo.delta(&site->getGeo()) / DEG2RAD;
+		double dis = point.delta(site->getGeoPoint()) / DEG2RAD;
 
 		// compute azimuth
-		double azm = geo.azimuth(&site->getGeo()) / DEG2RAD;
+		double azm = point.azimuth(site->getGeoPoint()) / DEG2RAD;
 
 		// get the association string
 		std::string sass = pick->getAss();
@@ -2143,7 +2656,7 @@ void CHypo::list(std::string src) {
 			snprintf(sLog, sizeof(sLog),
 						"CHypo::list: ** %s **\nPid:%s\n%s  %s %s %.2f Dis:%.1f"
 						" Azm:%.1f Wt:NA",
-						sorg.c_str(), sPid.c_str(), sass.c_str(),
+						sorg, sPid.c_str(), sass.c_str(),
 						site->getScnl().c_str(), pTTT->sPhase.c_str(), tres,
 						dis, azm);
 			glassutil::CLogit::log(sLog);
@@ -2152,7 +2665,7 @@ void CHypo::list(std::string src) {
 			snprintf(sLog, sizeof(sLog),
 						"CHypo::list: ** %s **\nPid:%s\n%s  %s %s %.2f Dis:%.1f"
 						" Azm:%.1f Wt:%.2f",
-						sorg.c_str(), sPid.c_str(), sass.c_str(),
+						sorg, sPid.c_str(), sass.c_str(),
 						site->getScnl().c_str(), pTTT->sPhase.c_str(), tres,
 						dis, azm, vWts[ipk]);
 			glassutil::CLogit::log(sLog);
@@ -2202,6 +2715,12 @@ double CHypo::localize() {
 	taper = glassutil::CTaper(-0.0001, -0.0001, -0.0001, 30 + 0.0001);
 	double searchR = (dRes / 4. + taper.Val(vPick.size()) * .75 * dRes) / 4.;
 
+	// once a hypo has enough picks, refine its location with a few
+	// Levenberg-Marquardt steps every time, annealing still runs on its
+	// schedule to search beyond the local maximum
+	int refinePicks = pGlass->getLocatorRefinementPicks();
+	bool refine = (refinePicks > 0) && (npick >= refinePicks);
+
 	// This should be the default
 	if (pGlass->getMinimizeTtLocator() == false) {
 		if (npick < 50) {
@@ -2210,12 +2729,16 @@ double CHypo::localize() {
 			annealingLocate(1250, searchR, 1., searchR / 30.0, .1);
 		} else if ((npick % 25) == 0) {
 			annealingLocate(500, searchR, 1., searchR / 30.0, .1);
-		} else {
+		} else if (!refine) {
 			snprintf(sLog, sizeof(sLog),
 						"CHypo::localize: Skipping localize with %d picks",
 						npick);
 			glassutil::CLogit::log(sLog);
 		}
+
+		if (refine) {
+			refineLocate(25);
+		}
 	} else {
 		if (npick < 25) {
 			annealingLocateResidual(10000, searchR, 1., searchR / 10.0, .1);
@@ -2225,19 +2748,24 @@ double CHypo::localize() {
 			annealingLocateResidual(1000, searchR / 2., 1., searchR / 10.0, .1);
 		} else if ((npick % 25) == 0) {
 			annealingLocateResidual(500, searchR / 2., 1., searchR / 10.0, .1);
-		} else {
+		} else if (!refine) {
 			snprintf(sLog, sizeof(sLog),
 						"CHypo::localize: Skipping localize with %d picks",
 						npick);
 			glassutil::CLogit::log(sLog);
 		}
+
+		if (refine) {
+			refineLocate(25, true);
+		}
 	}
 
 	// log
-	glassutil::CDate dt = glassutil::CDate(tOrg);
+	char sTime[DATETIMELENGTH + 1];
+	glassutil::CDate::formatDateTime(tOrg, sTime);
 	snprintf(sLog, sizeof(sLog),
 				"CHypo::localize: HYP %s %s%9.4f%10.4f%6.1f %d", sPid.c_str(),
-				dt.dateTime().c_str(), dLat, dLon, dZ,
+				sTime, dLat, dLon, dZ,
 				static_cast<int>(vPick.size()));
 	glassutil::CLogit::log(sLog);
 
@@ -2266,9 +2794,9 @@ bool CHypo::prune() {
 	// set up local vector to track picks to remove
 	std::vector < std::shared_ptr < CPick >> vremove;
 
-	// set up a geographic object for this hypo
-	glassutil::CGeo geo;
-	geo.setGeographic(dLat, dLon, EARTHRADIUSKM);
+	// set up a geographic point for this hypo
+	glassutil::CGeoPoint point;
+	point.setGeographic(dLat, dLon);
 
 	// get the standard deviation allowed for pruning
 	double sdprune = pGlass->getSdPrune();
@@ -2283,9 +2811,11 @@ bool CHypo::prune() {
 			// pick no longer associates, add to remove list
 			vremove.push_back(pck);
 
+			char sTime[DATETIMELENGTH + 1];
+			glassutil::CDate::formatDateTime(pck->getTPick(), sTime);
 			snprintf(
 					sLog, sizeof(sLog), "CHypo::prune: CUL %s %s (%.2f)",
-					glassutil::CDate::encodeDateTime(pck->getTPick()).c_str(),
+					sTime,
 					pck->getSite()->getScnl().c_str(), sdprune);
 			glassutil::CLogit::log(sLog);
 
@@ -2296,12 +2826,14 @@ bool CHypo::prune() {
 		// Trim whiskers
 		// compute delta between site and hypo
 		// THIS NEEDS TO BE CONVERTER DO DEG BUT NEED TO TEST LATER - WY
-		double delta = geo.delta(&pck->getSite()->getGeo());
+		double delta = point.delta(pck->getSite()->getGeoPoint());
 		// check if delta is beyond distance limit
 		if (delta > dCut) {
+			char sTime[DATETIMELENGTH + 1];
+			glassutil::CDate::formatDateTime(pck->getTPick(), sTime);
 			snprintf(
 					sLog, sizeof(sLog), "CHypo::prune: CUL %s %s (%.2f > %.2f)",
-					glassutil::CDate::encodeDateTime(pck->getTPick()).c_str(),
+					sTime,
 					pck->getSite()->getScnl().c_str(), delta, dCut);
 			glassutil::CLogit::log(sLog);
 
@@ -2338,12 +2870,13 @@ bool CHypo::prune() {
 			// correlation no longer associates, add to remove list
 			vcremove.push_back(cor);
 
+			char sTime[DATETIMELENGTH + 1];
+			glassutil::CDate::formatDateTime(cor->getTCorrelation(), sTime);
 			snprintf(
 					sLog,
 					sizeof(sLog),
 					"CHypo::prune: C-CUL %s %s",
-					glassutil::CDate::encodeDateTime(cor->getTCorrelation())
-							.c_str(),
+					sTime,
 					cor->getSite()->getScnl().c_str());
 			glassutil::CLogit::log(sLog);
 
@@ -2430,6 +2963,8 @@ void CHypo::remPick(std::shared_ptr<CPick> pck) {
 		if (pick->getPid() == pid) {
 			// remove pick from vector
 			vPick.erase(vPick.cbegin() + i);
+			iPickVersion++;
+			remStatsPick(pick);
 
 			return;
 		}
@@ -2451,9 +2986,10 @@ bool CHypo::reportCheck() {
 	char sLog[2048];
 	char sHypo[1024];
 
-	glassutil::CDate dt = glassutil::CDate(tOrg);
+	char sTime[DATETIMELENGTH + 1];
+	glassutil::CDate::formatDateTime(tOrg, sTime);
 	snprintf(sHypo, sizeof(sHypo), "%s %s%9.4f%10.4f%6.1f %d", sPid.c_str(),
-				dt.dateTime().c_str(), dLat, dLon, dZ,
+				sTime, dLat, dLon, dZ,
 				static_cast<int>(vPick.size()));
 
 	int nReportCut = pGlass->getReportCut();
@@ -2509,23 +3045,25 @@ bool CHypo::resolve(std::shared_ptr<CHypo> hyp) {
 	glassutil::CLogit::log(glassutil::log_level::debug,
 							"CHypo::resolve. " + sPid);
 
-	// lock the hypo since we're iterating through it's lists
-	std::lock_guard < std::recursive_mutex > hypoGuard(hypoMutex);
+	// work on copies of this hypo's lists, so this hypo is never locked
+	// while another hypo is. Links are only moved with replaceHypo, so if
+	// another hypo claims a pick first we leave it for the next cycle.
+	hypoMutex.lock();
+	std::vector<std::shared_ptr<CPick>> picks = vPick;
+	std::vector<std::shared_ptr<CCorrelation>> correlations = vCorr;
+	hypoMutex.unlock();
 
 	bool bAss = false;
 	char sLog[1024];
 
-	// handle picks
-	// for each pick in this hypo
-	int nPck = vPick.size();
-
 	int keptCount = 0;
 	int removeCount = 0;
 
-	// NOTE: Why are we moving backwards through the list?
-	for (int iPck = nPck - 1; iPck >= 0; iPck--) {
+	// handle picks
+	// for each pick in this hypo
+	for (auto it = picks.rbegin(); it != picks.rend(); ++it) {
 		// get the pick
-		std::shared_ptr<CPick> pck = vPick[iPck];
+		std::shared_ptr<CPick> pck = *it;
 
 		// get the pick's hypo pointer
 		std::shared_ptr<CHypo> pickHyp = pck->getHypo();
@@ -2538,36 +3076,41 @@ bool CHypo::resolve(std::shared_ptr<CHypo> hyp) {
 			continue;
 		}
 
-		std::string sOtherPid = pickHyp->getPid();
-
 		// if this pick is linked to this hypo
-		if (sOtherPid == sPid) {
+		if (pickHyp.get() == this) {
 			// nothing else to do
 			continue;
 		}
 
+		std::string sOtherPid = pickHyp->getPid();
+
 		// get the current pick's affinity to the provided hypo
 		double aff1 = affinity(pck);
 
 		// get the current pick's affinity to the hypo it's linked to
 		double aff2 = pickHyp->affinity(pck);
 
+		char sTime[DATETIMELENGTH + 1];
+		glassutil::CDate::formatDateTime(pck->getTPick(), sTime);
 		snprintf(sLog, sizeof(sLog),
 					"CHypo::resolve: SCV COMPARE %s %s %s %s (%.2f, %.2f)",
 					sPid.c_str(), sOtherPid.c_str(),
-					glassutil::CDate::encodeDateTime(pck->getTPick()).c_str(),
+					sTime,
 					pck->getSite()->getScnl().c_str(), aff1, aff2);
 		glassutil::CLogit::log(sLog);
 
 		// check which affinity is better
 		if (aff1 > aff2) {
 			// this pick has a higher affinity with the provided hypo
+			// link pick to the provided hypo, if the original hypo
+			// still has it
+			if (!pck->replaceHypo(pickHyp, hyp, "S")) {
+				continue;
+			}
+
 			// remove the pick from it's original hypo
 			pickHyp->remPick(pck);
 
-			// link pick to the provided hypo
-			pck->addHypo(hyp, "S", true);
-
 			// add provided hypo to the processing queue
 			// NOTE: this puts provided hypo before original hypo in FIFO,
 			// we want this hypo to keep this pick, rather than the original
@@ -2600,12 +3143,9 @@ bool CHypo::resolve(std::shared_ptr<CHypo> hyp) {
 
 	// handle correlations
 	// for each correlation in this hypo
-	int nCorr = vCorr.size();
-
-	// NOTE: Why are we moving backwards through the list?
-	for (int iCorr = nCorr - 1; iCorr >= 0; iCorr--) {
+	for (auto it = correlations.rbegin(); it != correlations.rend(); ++it) {
 		// get the correlation
-		auto corr = vCorr[iCorr];
+		std::shared_ptr<CCorrelation> corr = *it;
 
 		// get the correlation's hypo pointer
 		std::shared_ptr<CHypo> corrHyp = corr->getHypo();
@@ -2617,37 +3157,42 @@ bool CHypo::resolve(std::shared_ptr<CHypo> hyp) {
 			continue;
 		}
 
-		std::string sOtherPid = corrHyp->getPid();
-
 		// if this corr is linked to this hypo
-		if (sOtherPid == sPid) {
+		if (corrHyp.get() == this) {
 			// nothing else to do
 			continue;
 		}
 
+		std::string sOtherPid = corrHyp->getPid();
+
 		// get the current correlation's affinity to the provided hypo
 		double aff1 = affinity(corr);
 		double aff2 = corrHyp->affinity(corr);
 
+		char sTime[DATETIMELENGTH + 1];
+		glassutil::CDate::formatDateTime(corr->getTCorrelation(), sTime);
 		snprintf(
 				sLog,
 				sizeof(sLog),
 				"CHypo::resolve: C SCV COMPARE %s %s %s %s (%.2f, %.2f )",
 				sPid.c_str(),
 				sOtherPid.c_str(),
-				glassutil::CDate::encodeDateTime(corr->getTCorrelation()).c_str(),
+				sTime,
 				corr->getSite()->getScnl().c_str(), aff1, aff2);
 		glassutil::CLogit::log(sLog);
 
 		// check which affinity is better
 		if (aff1 > aff2) {
 			// this correlation has a higher affinity with the provided hypo
+			// link correlation to the provided hypo, if the original hypo
+			// still has it
+			if (!corr->replaceHypo(corrHyp, hyp, "C-S")) {
+				continue;
+			}
+
 			// remove the correlation from it's original hypo
 			corrHyp->remCorrelation(corr);
 
-			// link pick to the provided hypo
-			corr->addHypo(hyp, "C-S", true);
-
 			// add provided hypo to the processing queue
 			// NOTE: this puts provided hypo before original hypo in FIFO,
 			// we want this hypo to keep this pick, rather than the original
@@ -2693,60 +3238,33 @@ void CHypo::stats() {
 		return;
 	}
 
-	// set up a geographic object for this hypo
-	glassutil::CGeo geo;
-	geo.setGeographic(dLat, dLon, EARTHRADIUSKM - dZ);
-
-	// create and populate vectors containing the
-	// pick distances and azimuths
-	std::vector<double> dis;
-	std::vector<double> azm;
-	for (auto pick : vPick) {
-		// get the site
-		std::shared_ptr<CSite> site = pick->getSite();
-
-		// compute the distance delta
-		double delta = geo.delta(&site->getGeo()) / DEG2RAD;
-
-		// add to distance vactor
-		dis.push_back(delta);
-
-		// compute the azimuth
-		double azimuth = geo.azimuth(&site->getGeo()) / DEG2RAD;
-
-		// add to azimuth vector
-		azm.push_back(azimuth);
+	// rebuild the sorted distances and azimuths if the hypo has moved
+	// too far from where they were measured
+	glassutil::CGeoPoint point;
+	point.setGeographic(dLat, dLon);
+	glassutil::CGeoPoint statsPoint;
+	statsPoint.setGeographic(dStatsLat, dStatsLon);
+	if ((bStatsValid == false)
+			|| (point.delta(statsPoint) / DEG2RAD > STATSTOLERANCE)) {
+		rebaseStats();
 	}
 
 	// Calculate distance standard deviation. Note that the denominator is N
 	// and not N-1, since a mean of 0 is pre-ordained.
 	// The skewness is also 0, since the distribution
 	// is exactly symmetric
-	double sum = 0.0;
-	int ndis = dis.size();
-	for (int i = 0; i < ndis; i++) {
-		double d = dis[i];
-		sum += d * d;
-	}
-	double var = sum / ndis;
+	int ndis = vStatsDistance.size();
+	double var = dStatsSum2 / ndis;
 	dSig = sqrt(var);
 
 	// calculate the sample excess kurtosis value
-	sum = 0.0;
-	for (int i = 0; i < ndis; i++) {
-		double arg = dis[i] / dSig;
-		sum += arg * arg * arg * arg;
-	}
-	dKrt = sum / ndis - 3.0;
-
-	// sort the distances
-	sort(dis.begin(), dis.end());
+	dKrt = dStatsSum4 / (var * var) / ndis - 3.0;
 
 	// get minimum distance
-	dMin = dis.front();
+	dMin = vStatsDistance.front();
 
 	// get median distance
-	dMed = dis[ndis / 2];
+	dMed = vStatsDistance[ndis / 2];
 
 	// compute distance cutoff
 	// NOTE: Harley want's both the original .4 and 4.0 values to be
@@ -2754,41 +3272,111 @@ void CHypo::stats() {
 	// In the long term, he wants to replace this with a more statistics
 	// based algorithm
 	int icut = static_cast<int>((dCutPercentage * ndis));
-	dCut = dCutFactor * dis[icut];
+	dCut = dCutFactor * vStatsDistance[icut];
 
 	// make sure our calculated dCut is not below the minimum allowed
 	if (dCut < dCutMin) {
 		dCut = dCutMin;
 	}
 
-	// sort the azimuths
-	sort(azm.begin(), azm.end());
-
-	// add the first (smallest) azimuth to the end by adding 360
-	azm.push_back(azm.front() + 360.0);
-
-	// compute gap
-	dGap = 0.0;
-	for (int i = 0; i < ndis; i++) {
-		double gap = azm[i + 1] - azm[i];
+	// compute gap, including the one from the last azimuth around to the
+	// first
+	dGap = vStatsAzimuth.front() + 360.0 - vStatsAzimuth.back();
+	for (int i = 1; i < ndis; i++) {
+		double gap = vStatsAzimuth[i] - vStatsAzimuth[i - 1];
 		if (gap > dGap) {
 			dGap = gap;
 		}
 	}
 }
 
+// ---------------------------------------------------------rebaseStats
+void CHypo::rebaseStats() {
+	// measure from the current location
+	dStatsLat = dLat;
+	dStatsLon = dLon;
+	glassutil::CGeoPoint point;
+	point.setGeographic(dStatsLat, dStatsLon);
+
+	// create and populate vectors containing the
+	// pick distances and azimuths
+	std::vector<glassutil::CGeoPoint> sitePoints;
+	getSitePoints(&sitePoints);
+	point.deltas(sitePoints, &vStatsDistance);
+	point.azimuths(sitePoints, &vStatsAzimuth);
+
+	dStatsSum2 = 0.0;
+	dStatsSum4 = 0.0;
+	for (size_t i = 0; i < vStatsDistance.size(); i++) {
+		vStatsDistance[i] /= DEG2RAD;
+		vStatsAzimuth[i] /= DEG2RAD;
+
+		double d2 = vStatsDistance[i] * vStatsDistance[i];
+		dStatsSum2 += d2;
+		dStatsSum4 += d2 * d2;
+	}
+
+	// sort them
+	std::sort(vStatsDistance.begin(), vStatsDistance.end());
+	std::sort(vStatsAzimuth.begin(), vStatsAzimuth.end());
+
+	bStatsValid = true;
+}
+
+// ---------------------------------------------------------addStatsPick
+void CHypo::addStatsPick(const std::shared_ptr<CPick> &pck) {
+	if (bStatsValid == false) {
+		return;
+	}
+
+	glassutil::CGeoPoint point;
+	point.setGeographic(dStatsLat, dStatsLon);
+	const glassutil::CGeoPoint &sitePoint = pck->getSite()->getGeoPoint();
+
+	double distance = point.delta(sitePoint) / DEG2RAD;
+	insertSorted(&vStatsDistance, distance);
+	insertSorted(&vStatsAzimuth, point.azimuth(sitePoint) / DEG2RAD);
+
+	double d2 = distance * distance;
+	dStatsSum2 += d2;
+	dStatsSum4 += d2 * d2;
+}
+
+// ---------------------------------------------------------remStatsPick
+void CHypo::remStatsPick(const std::shared_ptr<CPick> &pck) {
+	if (bStatsValid == false) {
+		return;
+	}
+
+	glassutil::CGeoPoint point;
+	point.setGeographic(dStatsLat, dStatsLon);
+	const glassutil::CGeoPoint &sitePoint = pck->getSite()->getGeoPoint();
+
+	double distance = point.delta(sitePoint) / DEG2RAD;
+	if (!eraseSorted(&vStatsDistance, distance)
+			|| !eraseSorted(&vStatsAzimuth, point.azimuth(sitePoint) / DEG2RAD)) {
+		// lost track, start over next time
+		bStatsValid = false;
+		return;
+	}
+
+	double d2 = distance * distance;
+	dStatsSum2 -= d2;
+	dStatsSum4 -= d2 * d2;
+}
+
 // ---------------------------------------------------------summary
 void CHypo::summary() {
 	// get time string
-	glassutil::CDate dt = glassutil::CDate(tOrg);
-	std::string sorg = dt.dateTime();
+	char sorg[DATETIMELENGTH + 1];
+	glassutil::CDate::formatDateTime(tOrg, sorg);
 
 	// compute current stats
 	stats();
 	char sLog[1024];
 	snprintf(sLog, sizeof(sLog),
 				"CHypo::summary: %s%7.2f%8.2f%6.1f%6.1f%6.1f%5d (%5.1f) %s",
-				sorg.c_str(), dLat, dLon, dZ, dMin, dGap,
+				sorg, dLat, dLon, dZ, dMin, dGap,
 				static_cast<int>(vPick.size()), dBayes, sWebName.c_str());
 	glassutil::CLogit::log(sLog);
 }
@@ -2862,41 +3450,51 @@ bool CHypo::weights() {
 		return (false);
 	}
 
+	// set up a geographic point for this hypo
+	glassutil::CGeoPoint point;
+	point.setGeographic(dLat, dLon);
+
+	// reuse the weights if the picks haven't changed and the hypo hasn't
+	// moved far enough to matter
+	glassutil::CGeoPoint wtsPoint;
+	wtsPoint.setGeographic(dWtsLat, dWtsLon);
+	if ((iWtsVersion == iPickVersion)
+			&& (point.delta(wtsPoint) / DEG2RAD <= STATSTOLERANCE)) {
+		return (true);
+	}
+	iWtsVersion = iPickVersion;
+	dWtsLat = dLat;
+	dWtsLon = dLon;
+
 	// setup vWts for newdata
 	vWts.clear();
 	nWts = 0;
 
+	// get the distances between the picks and the hypo
+	std::vector<glassutil::CGeoPoint> sitePoints;
+	getSitePoints(&sitePoints);
+	std::vector<double> deltas;
+	point.deltas(sitePoints, &deltas);
+
 	// for each pick in this hypo
+	std::vector<double> siteDeltas;
 	for (int ipick = 0; ipick < npick; ipick++) {
-		// get the pick
-		auto pick = vPick[ipick];
-
-		// get the site
-		std::shared_ptr<CSite> site = pick->getSite();
-
-		// set up a geo object for this hypo
-		glassutil::CGeo geo;
-		geo.setGeographic(dLat, dLon, EARTHRADIUSKM - dZ);
-
 		// get distance between this pick and the hypo
-		double del = RAD2DEG * geo.delta(&site->getGeo());
+		double del = RAD2DEG * deltas[ipick];
 
 		// compute sigma for this pick-hypo distance from the average sigma and
 		// the distance to this site using the taper
 		double sig = avgSigma * tap.Val(del);
 
+		// get the distances between this pick and the other picks
+		sitePoints[ipick].deltas(sitePoints, &siteDeltas);
+
 		// compute the overall sum by using the distance to each other
 		// station
 		double sum = 0.0;
 		for (int j = 0; j < npick; j++) {
-			// get the pick
-			auto pickj = vPick[j];
-
-			// get the site
-			std::shared_ptr<CSite> sitej = pickj->getSite();
-
 			// get the distance between this pick and the pick being weighted
-			double delj = RAD2DEG * site->getDelta(&sitej->getGeo());
+			double delj = RAD2DEG * siteDeltas[j];
 
 			// if the distance is within 6 sig
 			if (delj < (6.0 * sig)) {
@@ -2985,7 +3583,14 @@ void CHypo::setZ(double z) {
 
 void CHypo::setTOrg(double newTOrg) {
 	std::lock_guard < std::recursive_mutex > hypoGuard(hypoMutex);
+	double oldTOrg = tOrg;
 	tOrg = newTOrg;
+
+	// keep the hypo list's time index in origin time order
+	if ((oldTOrg != newTOrg) && (pGlass != NULL)
+			&& (pGlass->getHypoList() != NULL)) {
+		pGlass->getHypoList()->moveHypo(this, oldTOrg, newTOrg);
+	}
 }
 
 void CHypo::setThresh(double thresh) {
@@ -2997,4 +3602,30 @@ void CHypo::unlockAfterProcessing() {
 	processingMutex.unlock();
 }
 
+// ---------------------------------------------------------getMemoryUsage
+size_t CHypo::getMemoryUsage() const {
+	std::lock_guard<std::recursive_mutex> guard(hypoMutex);
+
+	size_t bytes = sizeof(CHypo) + glassutil::CMemory::stringBytes(sWebName)
+			+ glassutil::CMemory::stringBytes(sPid)
+			+ vWts.capacity() * sizeof(double)
+			+ vStatsDistance.capacity() * sizeof(double)
+			+ vStatsAzimuth.capacity() * sizeof(double)
+			+ vPick.capacity() * sizeof(std::shared_ptr<CPick>)
+			+ vCorr.capacity() * sizeof(std::shared_ptr<CCorrelation>);
+
+	// each hypo has its own travel time objects, but their tables are shared
+	// with every other copy, so only this hypo's share of them is counted
+	if (pTrv1 != NULL) {
+		bytes += pTrv1->getMemoryUsage();
+	}
+	if (pTrv2 != NULL) {
+		bytes += pTrv2->getMemoryUsage();
+	}
+	if (pTTT != NULL) {
+		bytes += pTTT->getMemoryUsage();
+	}
+
+	return (bytes);
+}
 }  // namespace glasscore
@@ -19,19 +19,12 @@
 #include "HypoList.h"
 #include "CorrelationList.h"
 #include "Logit.h"
+#include "Memory.h"
+#include "Pool.h"
 #include "Pid.h"
 
 namespace glasscore {
 
-// sort functions
-bool sortHypo(const std::pair<double, std::string> &lhs,
-				const std::pair<double, std::string> &rhs) {
-	if (lhs.first < rhs.first)
-		return (true);
-
-	return (false);
-}
-
 // ---------------------------------------------------------CHypoList
 CHypoList::CHypoList(int numThreads, int sleepTime, int checkInterval) {
 	// seed the random number generator
@@ -44,6 +37,7 @@ CHypoList::CHypoList(int numThreads, int sleepTime, int checkInterval) {
 	m_iSleepTimeMS = sleepTime;
 	m_iStatusCheckInterval = checkInterval;
 	std::time(&tLastStatusCheck);
+	pExecutor = NULL;
 
 	clear();
 
@@ -101,10 +95,10 @@ bool CHypoList::addHypo(std::shared_ptr<CHypo> hypo, bool scheduleProcessing) {
 	// lock for this scope
 	std::lock_guard<std::recursive_mutex> listGuard(m_vHypoMutex);
 
-	// Add hypo to cache (mHypo) and time sorted
-	// index (vHypo). If vHypo has reached its
+	// Add hypo to cache (mHypo) and time
+	// index (mTimeIndex). If the list has reached its
 	// maximum capacity (nHypoMax), then the
-	// first hypo in the vector is removed and the
+	// earliest hypo is removed and the
 	// corresponding entry in the cache is erased.
 	nHypoTotal++;
 	nHypo++;
@@ -115,16 +109,17 @@ bool CHypoList::addHypo(std::shared_ptr<CHypo> hypo, bool scheduleProcessing) {
 		nHypoMax = pGlass->getHypoMax();
 	}
 
-	// create pair for insertion
-	std::pair<double, std::string> p(hypo->getTOrg(), hypo->getPid());
+	// get the origin time before locking the index, since the hypo can't
+	// be locked while the index is
+	double tOrg = hypo->getTOrg();
 
 	// remove oldest hypo if this new one
 	// pushes us over the limit
-	if (vHypo.size() == nHypoMax) {
-		// get first hypo in vector
-		std::pair<double, std::string> pdx;
-		pdx = vHypo[0];
-		std::shared_ptr<CHypo> firstHypo = mHypo[pdx.second];
+	if (getVHypoSize() == nHypoMax) {
+		// get first hypo in the index
+		m_TimeIndexMutex.lock();
+		std::shared_ptr<CHypo> firstHypo = mTimeIndex.begin()->second;
+		m_TimeIndexMutex.unlock();
 
 		// send expiration message
 		firstHypo->expire();
@@ -135,37 +130,16 @@ bool CHypoList::addHypo(std::shared_ptr<CHypo> hypo, bool scheduleProcessing) {
 		glassutil::CLogit::log(
 				glassutil::log_level::debug,
 				"CHypoList::addHypo: Current: "
-						+ std::to_string(static_cast<int>(vHypo.size()))
+						+ std::to_string(getVHypoSize())
 						+ " Max: " + std::to_string(nHypoMax)
-						+ " Removing Hypo: " + pdx.second);
+						+ " Removing Hypo: " + firstHypo->getPid());
 	}
 
-	// Insert new hypo in proper time sequence into hypo vector
-	// get the index of the new hypo
-	int ihypo = indexHypo(hypo->getTOrg());
-	switch (ihypo) {
-		case -2:
-			// Empty vector, just add it
-			vHypo.push_back(p);
-			break;
-		case -1:
-			// hypo is before any others, insert at beginning
-			vHypo.insert(vHypo.begin(), p);
-			break;
-		default:
-			// hypo is somewhere in vector
-			if (ihypo == vHypo.size() - 1) {
-				// hypo is after all other hypos, add to end
-				vHypo.push_back(p);
-			} else {
-				// find where the hypo should be inserted
-				auto it = std::next(vHypo.begin(), ihypo + 1);
-
-				// insert at that location
-				vHypo.insert(it, p);
-			}
-			break;
-	}
+	// Insert new hypo in proper time sequence into the time index
+	m_TimeIndexMutex.lock();
+	mTimeIndex.insert(std::make_pair(tOrg, hypo));
+	m_TimeIndexMutex.unlock();
+
 	// add to hypo map
 	mHypo[hypo->getPid()] = hypo;
 
@@ -331,13 +305,12 @@ bool CHypoList::associate(std::shared_ptr<CCorrelation> corr) {
 	bool bass = false;
 	std::vector<std::shared_ptr<CHypo>> viper;
 
-	// compute the index range to search for hypos to associate with
-	// (a potential hypo must be before the pick we're associating)
-	// use the correlation time minus correlationMatchingTWindow to compute the
-	// starting index
+	// compute the time range to search for hypos to associate with, a
+	// correlation carries its own origin time, so only hypos within the
+	// correlation matching window of it can associate
 	std::vector<std::weak_ptr<CHypo>> hypoList = getHypos(
 			corr->getTCorrelation() - pGlass->getCorrelationMatchingTWindow(),
-			corr->getTCorrelation() - pGlass->getCorrelationMatchingTWindow());
+			corr->getTCorrelation() + pGlass->getCorrelationMatchingTWindow());
 
 	// make sure we got any hypos
 	if (hypoList.size() == 0) {
@@ -436,11 +409,14 @@ void CHypoList::clear() {
 
 // ---------------------------------------------------------clearHypos
 void CHypoList::clearHypos() {
-	std::lock_guard<std::mutex> queueGuard(m_QueueMutex);
+	m_QueueMutex.lock();
 	qFifo.clear();
+	m_QueueMutex.unlock();
 
 	std::lock_guard<std::recursive_mutex> listGuard(m_vHypoMutex);
-	vHypo.clear();
+	m_TimeIndexMutex.lock();
+	mTimeIndex.clear();
+	m_TimeIndexMutex.unlock();
 	mHypo.clear();
 
 	// reset nHypo
@@ -501,8 +477,6 @@ void CHypoList::darwin() {
 			// remove hypo from the hypo list
 			remHypo(hyp);
 
-			sort();
-
 			// done with processing
 			return;
 		}
@@ -527,10 +501,6 @@ void CHypoList::darwin() {
 		evolve(hyp);
 
 		hyp->unlockAfterProcessing();
-
-		// resort the hypocenter list to maintain
-		// time order
-		sort();
 	} catch (...) {
 		// ensure the hypo is unlocked
 		if (hyp->isLockedForProcessing()) {
@@ -807,49 +777,52 @@ bool CHypoList::evolve(std::shared_ptr<CHypo> hyp) {
 
 // ---------------------------------------------------------findHypo
 std::shared_ptr<CHypo> CHypoList::findHypo(double t1, double t2) {
-	std::lock_guard<std::recursive_mutex> listGuard(m_vHypoMutex);
-
-	// don't bother if the list is empty
-	if (vHypo.size() == 0) {
-		return (NULL);
-	}
-
-	// get the index of the starting time of the selection range
-	int ix1 = indexHypo(t1);
+	std::lock_guard<std::mutex> indexGuard(m_TimeIndexMutex);
 
-	// check starting index
-	if (ix1 < 0) {
-		// start time is before start of list, set to first index
-		ix1 = 0;
-	}
+	// get the first hypo at or after the starting time of the selection range
+	auto it = mTimeIndex.lower_bound(t1);
 
-	if (ix1 >= vHypo.size()) {
-		// starting index is greater than or equal to the size of the list,
-		// no hypos to find
-		return (NULL);
+	// make sure it doesn't exceed the end of the time range
+	if ((it != mTimeIndex.end()) && (it->first < t2)) {
+		return (it->second);
 	}
 
-	// get the index of the ending time of the selection range
-	int ix2 = indexHypo(t2);
+	// no valid hypo found
+	return (NULL);
+}
 
-	// check ending index
-	if (ix2 < 0) {
-		return (NULL);
+// ---------------------------------------------------------findHypo
+std::shared_ptr<CHypo> CHypoList::findHypo(double t1, double t2, double lat,
+											double lon, double xWindow) {
+	// get the hypos in the time range, the index lock is released before
+	// the hypos are locked to get their locations
+	std::vector<std::shared_ptr<CHypo>> candidates;
+	{
+		std::lock_guard<std::mutex> indexGuard(m_TimeIndexMutex);
+		auto last = mTimeIndex.upper_bound(t2);
+		for (auto it = mTimeIndex.lower_bound(t1); it != last; ++it) {
+			candidates.push_back(it->second);
+		}
 	}
 
-	// based on the the next index after the starting index, check for a valid
-	// hypo that doesn't exceed the end of the time range
-	if (vHypo[ix1 + 1].first < t2) {
-		// the hypo is not past the ending time of the selection range
-		// get the id
-		std::string pid = vHypo[ix1 + 1].second;
+	glassutil::CGeoPoint point;
+	point.setGeographic(lat, lon);
 
-		// using the id, return the hypo
-		return (mHypo[pid]);
+	// find the closest hypo within the distance window
+	std::shared_ptr<CHypo> bestHyp;
+	double bestDelta = xWindow;
+	for (const auto &hyp : candidates) {
+		glassutil::CGeoPoint hypPoint;
+		hypPoint.setGeographic(hyp->getLat(), hyp->getLon());
+		double delta = RAD2DEG * point.delta(hypPoint);
+
+		if (delta <= bestDelta) {
+			bestHyp = hyp;
+			bestDelta = delta;
+		}
 	}
 
-	// no valid hypo found
-	return (NULL);
+	return (bestHyp);
 }
 
 // ---------------------------------------------------------getFifoSize
@@ -874,52 +847,13 @@ std::vector<std::weak_ptr<CHypo>> CHypoList::getHypos(double t1, double t2) {
 		return (hypos);
 	}
 
-	std::lock_guard<std::recursive_mutex> listGuard(m_vHypoMutex);
-
-	// don't bother if the list is empty
-	if (vHypo.size() == 0) {
-		return (hypos);
-	}
-
-	// get the index of the starting time of the selection range
-	int ix1 = indexHypo(t1);
+	std::lock_guard<std::mutex> indexGuard(m_TimeIndexMutex);
 
-	// check starting index
-	if (ix1 < 0) {
-		// start time is before start of list, set to first index
-		ix1 = 0;
-	}
-
-	if (ix1 >= vHypo.size()) {
-		// starting index is greater than or equal to the size of the list,
-		// no hypos to find
-		return (hypos);
-	}
-
-	// get the index of the ending time of the selection range
-	int ix2 = indexHypo(t2);
-
-	// check ending index
-	if (ix2 <= 0) {
-		// end time is before the start of the list
-		// no hypos to find
-		return (hypos);
-	}
-
-	// for each hypo in the list within the
-	// time range
-	for (int it = ix1; it <= ix2; it++) {
-		// get this hypo id
-		std::string pid = vHypo[it].second;
-
-		std::shared_ptr<CHypo> aHypo = mHypo[pid];
-
-		if (aHypo != NULL) {
-			std::weak_ptr<CHypo> awHypo = mHypo[pid];
-
-			// add to the list of hypos
-			hypos.push_back(awHypo);
-		}
+	// for each hypo in the index within the time range
+	auto last = mTimeIndex.upper_bound(t2);
+	for (auto it = mTimeIndex.lower_bound(t1); it != last; ++it) {
+		// add to the list of hypos
+		hypos.push_back(it->second);
 	}
 
 	// return the list of hypos we found
@@ -946,59 +880,24 @@ int CHypoList::getNHypoTotal() const {
 
 // ---------------------------------------------------------getVHypoSize
 int CHypoList::getVHypoSize() const {
-	std::lock_guard<std::recursive_mutex> vHypoGuard(m_vHypoMutex);
-	return (vHypo.size());
+	std::lock_guard<std::mutex> indexGuard(m_TimeIndexMutex);
+	return (mTimeIndex.size());
 }
 
 // ---------------------------------------------------------indexHypo
 int CHypoList::indexHypo(double tOrg) {
-	std::lock_guard<std::recursive_mutex> listGuard(m_vHypoMutex);
+	std::lock_guard<std::mutex> indexGuard(m_TimeIndexMutex);
 
-	// handle empty vector case
-	if (vHypo.size() == 0) {
-		// return -2 to indicate empty vector
+	// handle empty index case
+	if (mTimeIndex.size() == 0) {
+		// return -2 to indicate empty index
 		return (-2);
 	}
 
-	double tFirstOrg = vHypo[0].first;
-
-	// handle origin earlier than first element case
-	// time is earlier than first origin
-	if (tOrg < tFirstOrg) {
-		// return -1 to indicate earlier than first element
-		return (-1);
-	}
-
-	// handle case that the origin is later than last element
-	int i1 = 0;
-	int i2 = vHypo.size() - 1;
-	double tLastOrg = vHypo[i2].first;
-	// time is after last origin
-	if (tOrg >= tLastOrg) {
-		return (i2);
-	}
-
-	// search for insertion point within vector
-	// using a binary search
-	// while upper minus lower bounds is greater than one
-	while ((i2 - i1) > 1) {
-		// compute current origin index
-		int ix = (i1 + i2) / 2;
-		double tCurrentOrg = vHypo[ix].first;
-
-		// if time is before current origin
-		if (tCurrentOrg > tOrg) {
-			// new upper bound is this index
-			i2 = ix;
-		} else {  // if (tCurrentOrg <= tOrg)
-			// if time is after or equal to current origin
-			// new lower bound is this index
-			i1 = ix;
-		}
-	}
-
-	// return the last lower bound as the insertion point
-	return (i1);
+	// the position of the last hypo at or before the time, or -1 if the
+	// time is earlier than the first origin
+	auto it = mTimeIndex.upper_bound(tOrg);
+	return (static_cast<int>(std::distance(mTimeIndex.begin(), it)) - 1);
 }
 
 // ---------------------------------------------------------jobSleep
@@ -1016,16 +915,16 @@ void CHypoList::jobSleep() {
 
 // ---------------------------------------------------------listPicks
 void CHypoList::listHypos() {
-	std::lock_guard<std::recursive_mutex> listGuard(m_vHypoMutex);
+	std::lock_guard<std::mutex> indexGuard(m_TimeIndexMutex);
 
 	int n = 0;
 	char sLog[1024];
 
 	// for each hypo
-	for (auto p : vHypo) {
+	for (const auto &p : mTimeIndex) {
 		// list it
 		snprintf(sLog, sizeof(sLog), "%d: %.2f %s", n++, p.first,
-					p.second.c_str());
+					p.second->getPid().c_str());
 		glassutil::CLogit::Out(sLog);
 	}
 }
@@ -1053,9 +952,9 @@ bool CHypoList::mergeCloseEvents(std::shared_ptr<CHypo> hypo) {
 	// this events pick list
 	auto hVPick = hypo->getVPick();
 
-	// set up a geo object for this hypo
-	glassutil::CGeo geo;
-	geo.setGeographic(hypo->getLat(), hypo->getLon(), EARTHRADIUSKM);
+	// set up a geographic point for this hypo
+	glassutil::CGeoPoint point;
+	point.setGeographic(hypo->getLat(), hypo->getLon());
 
 	// compute the list of hypos to try merging with with
 	// (a potential hypo must be within time cut to consider)
@@ -1101,12 +1000,11 @@ bool CHypoList::mergeCloseEvents(std::shared_ptr<CHypo> hypo) {
 			double diff = std::fabs(hypo->getTOrg() - hypo2->getTOrg());
 
 			if (diff < timeCut) {
-				glassutil::CGeo geo2;
-				geo2.setGeographic(hypo2->getLat(), hypo2->getLon(),
-									EARTHRADIUSKM);
+				glassutil::CGeoPoint point2;
+				point2.setGeographic(hypo2->getLat(), hypo2->getLon());
 
 				// check distance between events
-				delta = geo.delta(&geo2) / DEG2RAD;
+				delta = point.delta(point2) / DEG2RAD;
 
 				if (delta < distanceCut) {
 					// Log info on two events
@@ -1125,7 +1023,8 @@ bool CHypoList::mergeCloseEvents(std::shared_ptr<CHypo> hypo) {
 					glassutil::CLogit::log(sLog);
 
 					// create a new merged event hypo3
-					std::shared_ptr<CHypo> hypo3 = std::make_shared<CHypo>(
+					std::shared_ptr<CHypo> hypo3 = std::allocate_shared<CHypo>(
+							glassutil::CPoolAllocator<CHypo>(),
 							(hypo2->getLat() + hypo->getLat()) / 2.,
 							(hypo2->getLon() + hypo->getLon()) / 2.,
 							(hypo2->getZ() + hypo->getZ()) / 2.,
@@ -1247,30 +1146,44 @@ bool CHypoList::mergeCloseEvents(std::shared_ptr<CHypo> hypo) {
 
 // ---------------------------------------------------------pushFifo
 int CHypoList::pushFifo(std::shared_ptr<CHypo> hyp) {
-	std::lock_guard<std::mutex> queueGuard(m_QueueMutex);
 	// nullcheck
 	if (hyp == NULL) {
 		glassutil::CLogit::log(glassutil::log_level::error,
 								"CHypoList::pushFifo: NULL hypo provided.");
 
 		// return the current size of the queue
-		int size = qFifo.size();
-
-		return (size);
+		return (getFifoSize());
 	}
 
-	// get this hypo's id
+	// get this hypo's id and priority before locking the queue, so that the
+	// queue mutex is never held while the hypo is locked
 	std::string pid = hyp->getPid();
+	double priority = getPriority(hyp);
 
-	// is this id already on the queue?
-	if (std::find(qFifo.begin(), qFifo.end(), pid) == qFifo.end()) {
-		// it is not, add it
-		qFifo.push_back(pid);
+	double dataWeight = 0.0;
+	double agingWeight = 0.0;
+	if (pGlass != NULL) {
+		dataWeight = pGlass->getHypoPriorityDataWeight();
+		agingWeight = pGlass->getHypoPriorityAgingWeight();
 	}
 
+	m_QueueMutex.lock();
+
+	// add the id to the queue, or update it if it's already there
+	qFifo.setWeights(dataWeight, agingWeight);
+	bool added = qFifo.push(pid, priority, glassutil::CDate::now());
+
 	// return the current size of the queue
 	int size = qFifo.size();
 
+	m_QueueMutex.unlock();
+
+	// one evolution task per queued hypo, each processes whichever hypo is
+	// first in the queue when it runs
+	if ((added == true) && (pExecutor)) {
+		pExecutor->submit(task_class::evolution, [this]() {darwin();});
+	}
+
 	glassutil::CLogit::log(
 			glassutil::log_level::debug,
 			"CHypoList::pushFifo: sPid:" + pid + " " + std::to_string(size)
@@ -1285,7 +1198,7 @@ std::shared_ptr<CHypo> CHypoList::popFifo() {
 	// to avoid a deadlock when both mutexes are locked
 	m_QueueMutex.lock();
 
-	// Pop first hypocenter off processing fifo
+	// Pop the highest priority hypocenter off the processing queue
 	// is there anything on the queue?
 	if (qFifo.size() < 1) {
 		// nope
@@ -1293,20 +1206,19 @@ std::shared_ptr<CHypo> CHypoList::popFifo() {
 		return (NULL);
 	}
 
-	// get the first id on the queue
-	std::string pid = qFifo.front();
-
-	// remove the first id from the queue now that we have it
-	// Does not throw unless an exception is thrown by the assignment operator
-	// of T.
-	qFifo.erase(qFifo.begin());
+	// get and remove the next id on the queue
+	std::string pid = qFifo.pop();
 
 	m_QueueMutex.unlock();
 
 	m_vHypoMutex.lock();
 
 	// use the map to get the hypo based on the id
-	std::shared_ptr<CHypo> hyp = mHypo[pid];
+	std::shared_ptr<CHypo> hyp;
+	auto found = mHypo.find(pid);
+	if (found != mHypo.end()) {
+		hyp = found->second;
+	}
 
 	m_vHypoMutex.unlock();
 
@@ -1314,6 +1226,39 @@ std::shared_ptr<CHypo> CHypoList::popFifo() {
 	return (hyp);
 }
 
+// ---------------------------------------------------------getPriority
+double CHypoList::getPriority(std::shared_ptr<CHypo> hyp) {
+	if ((hyp == NULL) || (pGlass == NULL)) {
+		return (0.0);
+	}
+
+	double bayes = hyp->getBayes();
+	double priority = 0.0;
+
+	// stronger hypos relative to their threshold first, capped so that one
+	// large event can't hold off the rest beyond what aging makes up for
+	double thresh = hyp->getThresh();
+	if (thresh > 0.0) {
+		priority += pGlass->getHypoPriorityBayesWeight()
+				* std::min(bayes / thresh, 10.0);
+	}
+
+	// hypos that are ready to be reported for the first time are urgent
+	if ((hyp->getEvent() == false) && (bayes >= pGlass->getReportThresh())) {
+		priority += pGlass->getHypoPriorityReportWeight();
+	}
+
+	// hypos that have used up more of their cycles have had their turns
+	int cycleLimit = pGlass->getCycleLimit();
+	if (cycleLimit > 0) {
+		priority -= pGlass->getHypoPriorityCycleWeight()
+				* std::min(static_cast<double>(hyp->getCycle()) / cycleLimit,
+							1.0);
+	}
+
+	return (priority);
+}
+
 // ---------------------------------------------------------processHypos
 void CHypoList::processHypos() {
 	glassutil::CLogit::log(glassutil::log_level::debug,
@@ -1358,40 +1303,79 @@ void CHypoList::remHypo(std::shared_ptr<CHypo> hypo, bool reportCancel) {
 
 	std::lock_guard<std::recursive_mutex> listGuard(m_vHypoMutex);
 
-	// get the id
+	// get the id and origin time
 	std::string pid = hypo->getPid();
+	double tOrg = hypo->getTOrg();
 
 	// unlink all the hypo's data
 	hypo->clearPicks();
 	hypo->clearCorrelations();
 
-	// erase this hypo from the vector
-	// search through all hypos
-	for (int iq = 0; iq < vHypo.size(); iq++) {
-		// get current hypo
-		auto q = vHypo[iq];
-
-		// if the current hypo matches the id of the
-		// hypo to delete
-		if (q.second == pid) {
-			// erase this hypo
-			vHypo.erase(vHypo.begin() + iq);
-
-			// Send cancellation message for this hypo
-			if (reportCancel == true) {
-				// only if we've sent an event message
-				if (hypo->getEvent()) {
-					// create cancellation message
-					hypo->cancel();
-				}
-			}
-			// done
-			break;
+	// erase this hypo from the time index
+	m_TimeIndexMutex.lock();
+	bool found = eraseTimeIndex(hypo.get(), tOrg);
+	m_TimeIndexMutex.unlock();
+
+	// Send cancellation message for this hypo
+	if ((found == true) && (reportCancel == true)) {
+		// only if we've sent an event message
+		if (hypo->getEvent()) {
+			// create cancellation message
+			hypo->cancel();
 		}
 	}
 
 	// erase this hypo from the map
 	mHypo.erase(pid);
+
+	// and from the processing queue
+	m_QueueMutex.lock();
+	qFifo.remove(pid);
+	m_QueueMutex.unlock();
+}
+
+// ---------------------------------------------------------moveHypo
+void CHypoList::moveHypo(const CHypo * hypo, double oldTOrg, double newTOrg) {
+	if ((hypo == NULL) || (oldTOrg == newTOrg)) {
+		return;
+	}
+
+	std::lock_guard<std::mutex> indexGuard(m_TimeIndexMutex);
+
+	// find the hypo at its old origin time
+	auto range = mTimeIndex.equal_range(oldTOrg);
+	for (auto it = range.first; it != range.second; ++it) {
+		if (it->second.get() == hypo) {
+			// reinsert it at the new origin time, near where it was since
+			// relocations are small
+			std::shared_ptr<CHypo> movedHypo = it->second;
+			auto hint = mTimeIndex.erase(it);
+			mTimeIndex.insert(hint, std::make_pair(newTOrg, movedHypo));
+			return;
+		}
+	}
+}
+
+// ---------------------------------------------------------eraseTimeIndex
+bool CHypoList::eraseTimeIndex(const CHypo * hypo, double tOrg) {
+	// look where the hypo should be first
+	auto range = mTimeIndex.equal_range(tOrg);
+	for (auto it = range.first; it != range.second; ++it) {
+		if (it->second.get() == hypo) {
+			mTimeIndex.erase(it);
+			return (true);
+		}
+	}
+
+	// the origin time changed since it was read, search everything
+	for (auto it = mTimeIndex.begin(); it != mTimeIndex.end(); ++it) {
+		if (it->second.get() == hypo) {
+			mTimeIndex.erase(it);
+			return (true);
+		}
+	}
+
+	return (false);
 }
 
 // ---------------------------------------------------------ReqHypo
@@ -1458,8 +1442,15 @@ bool CHypoList::reqHypo(std::shared_ptr<json::Object> com) {
 		return (true);
 	}
 
-	// generate the hypo message
-	hyp->hypo();
+	// requests may allow an incremental update instead of a full snapshot
+	bool snapshot = true;
+	if (com->HasKey("Delta")
+			&& ((*com)["Delta"].GetType() == json::ValueType::BoolVal)) {
+		snapshot = !((*com)["Delta"].ToBool());
+	}
+
+	// generate and send the hypo record
+	hyp->hypoRecord(true, snapshot);
 
 	// done
 	return (true);
@@ -1481,14 +1472,16 @@ bool CHypoList::resolve(std::shared_ptr<CHypo> hyp) {
 		return (false);
 	}
 
-	// this lock guard exists to avoid a deadlock that occurs
-	// when it isn't present
-	std::lock_guard<std::recursive_mutex> listGuard(m_vHypoMutex);
-
 	// return whether we've changed the pick set
 	return (hyp->resolve(hyp));
 }
 
+// ---------------------------------------------------------setExecutor
+void CHypoList::setExecutor(glassutil::CExecutor* executor) {
+	std::lock_guard<std::recursive_mutex> hypoListGuard(m_HypoListMutex);
+	pExecutor = executor;
+}
+
 // ---------------------------------------------------------setGlass
 void CHypoList::setGlass(CGlass* glass) {
 	std::lock_guard<std::recursive_mutex> hypoListGuard(m_HypoListMutex);
@@ -1511,13 +1504,6 @@ void CHypoList::setStatus(bool status) {
 	}
 }
 
-// ---------------------------------------------------------sort
-void CHypoList::sort() {
-	std::lock_guard<std::recursive_mutex> listGuard(m_vHypoMutex);
-	// sort hypos
-	std::sort(vHypo.begin(), vHypo.end(), sortHypo);
-}
-
 // ---------------------------------------------------------statusCheck
 bool CHypoList::statusCheck() {
 	// if we have a negative check interval,
@@ -1572,4 +1558,31 @@ bool CHypoList::statusCheck() {
 	// everything is awesome
 	return (true);
 }
+
+// ---------------------------------------------------------getMemoryUsage
+size_t CHypoList::getMemoryUsage() {
+	size_t bytes = sizeof(CHypoList);
+
+	m_vHypoMutex.lock();
+	m_TimeIndexMutex.lock();
+	bytes += mTimeIndex.size()
+			* (glassutil::CMemory::mapNodeBytes()
+					+ sizeof(std::pair<const double, std::shared_ptr<CHypo>>));
+	m_TimeIndexMutex.unlock();
+	bytes += mHypo.size()
+					* (glassutil::CMemory::mapNodeBytes()
+							+ sizeof(std::pair<std::string,
+									std::shared_ptr<CHypo>>));
+	for (const auto &entry : mHypo) {
+		bytes += entry.second->getMemoryUsage();
+	}
+	m_vHypoMutex.unlock();
+
+	// hypos waiting to be processed
+	m_QueueMutex.lock();
+	bytes += qFifo.getMemoryUsage() - sizeof(CHypoQueue);
+	m_QueueMutex.unlock();
+
+	return (bytes);
+}
 }  // namespace glasscore
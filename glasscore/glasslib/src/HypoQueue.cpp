@@ -0,0 +1,209 @@
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "HypoQueue.h"
+#include "Memory.h"
+
+namespace glasscore {
+
+// ---------------------------------------------------------CHypoQueue
+CHypoQueue::CHypoQueue() {
+	iNextSequence = 0;
+	dDataWeight = 0.0;
+	dAgingWeight = 0.0;
+}
+
+// ---------------------------------------------------------~CHypoQueue
+CHypoQueue::~CHypoQueue() {
+	clear();
+}
+
+// ---------------------------------------------------------clear
+void CHypoQueue::clear() {
+	vHeap.clear();
+	mIndex.clear();
+	iNextSequence = 0;
+}
+
+// ---------------------------------------------------------push
+bool CHypoQueue::push(const std::string &pid, double priority, double tNow) {
+	auto found = mIndex.find(pid);
+
+	// already queued, update the priority and count the new data
+	if (found != mIndex.end()) {
+		int index = found->second;
+		QueueEntry &entry = vHeap[index];
+		double oldKey = entry.dKey;
+
+		entry.dPriority = priority;
+		entry.nPush++;
+		entry.dKey = key(entry);
+
+		if (entry.dKey > oldKey) {
+			siftUp(index);
+		} else {
+			siftDown(index);
+		}
+
+		return (false);
+	}
+
+	// add it
+	QueueEntry entry;
+	entry.sPid = pid;
+	entry.dPriority = priority;
+	entry.tQueued = tNow;
+	entry.nPush = 1;
+	entry.iSequence = iNextSequence++;
+	entry.dKey = key(entry);
+
+	int index = vHeap.size();
+	vHeap.push_back(entry);
+	mIndex[pid] = index;
+	siftUp(index);
+
+	return (true);
+}
+
+// ---------------------------------------------------------pop
+std::string CHypoQueue::pop() {
+	if (vHeap.empty()) {
+		return ("");
+	}
+
+	std::string pid = vHeap[0].sPid;
+	remove(pid);
+
+	return (pid);
+}
+
+// ---------------------------------------------------------remove
+bool CHypoQueue::remove(const std::string &pid) {
+	auto found = mIndex.find(pid);
+	if (found == mIndex.end()) {
+		return (false);
+	}
+
+	// move the last entry into the removed entry's place
+	int index = found->second;
+	int last = vHeap.size() - 1;
+	if (index != last) {
+		swapEntries(index, last);
+	}
+
+	mIndex.erase(vHeap[last].sPid);
+	vHeap.pop_back();
+
+	// restore the heap around the moved entry
+	if (index < static_cast<int>(vHeap.size())) {
+		siftUp(index);
+		siftDown(index);
+	}
+
+	return (true);
+}
+
+// ---------------------------------------------------------contains
+bool CHypoQueue::contains(const std::string &pid) const {
+	return (mIndex.find(pid) != mIndex.end());
+}
+
+// ---------------------------------------------------------size
+int CHypoQueue::size() const {
+	return (vHeap.size());
+}
+
+// ---------------------------------------------------------setWeights
+void CHypoQueue::setWeights(double dataWeight, double agingWeight) {
+	if ((dataWeight == dDataWeight) && (agingWeight == dAgingWeight)) {
+		return;
+	}
+
+	dDataWeight = dataWeight;
+	dAgingWeight = agingWeight;
+
+	// the keys changed, rebuild the heap
+	for (auto &entry : vHeap) {
+		entry.dKey = key(entry);
+	}
+	for (int i = static_cast<int>(vHeap.size()) / 2 - 1; i >= 0; i--) {
+		siftDown(i);
+	}
+}
+
+// ---------------------------------------------------------getMemoryUsage
+size_t CHypoQueue::getMemoryUsage() const {
+	size_t bytes = sizeof(CHypoQueue) + vHeap.capacity() * sizeof(QueueEntry)
+			+ mIndex.bucket_count() * sizeof(void *)
+			+ mIndex.size()
+					* (2 * sizeof(void *)
+							+ sizeof(std::pair<std::string, int>));
+	for (const auto &entry : vHeap) {
+		// once for the heap and once for the index
+		bytes += 2 * glassutil::CMemory::stringBytes(entry.sPid);
+	}
+
+	return (bytes);
+}
+
+// ---------------------------------------------------------key
+double CHypoQueue::key(const QueueEntry &entry) const {
+	// waiting longer is the same as being queued earlier, so aging can be
+	// folded into a key that doesn't change while the hypo waits
+	return (entry.dPriority + dDataWeight * (entry.nPush - 1)
+			- dAgingWeight * entry.tQueued);
+}
+
+// ---------------------------------------------------------before
+bool CHypoQueue::before(int a, int b) const {
+	if (vHeap[a].dKey != vHeap[b].dKey) {
+		return (vHeap[a].dKey > vHeap[b].dKey);
+	}
+
+	// first come first served
+	return (vHeap[a].iSequence < vHeap[b].iSequence);
+}
+
+// ---------------------------------------------------------swapEntries
+void CHypoQueue::swapEntries(int a, int b) {
+	std::swap(vHeap[a], vHeap[b]);
+	mIndex[vHeap[a].sPid] = a;
+	mIndex[vHeap[b].sPid] = b;
+}
+
+// ---------------------------------------------------------siftUp
+void CHypoQueue::siftUp(int index) {
+	while (index > 0) {
+		int parent = (index - 1) / 2;
+		if (!before(index, parent)) {
+			break;
+		}
+		swapEntries(index, parent);
+		index = parent;
+	}
+}
+
+// ---------------------------------------------------------siftDown
+void CHypoQueue::siftDown(int index) {
+	int count = vHeap.size();
+	while (true) {
+		int best = index;
+		int left = 2 * index + 1;
+		int right = left + 1;
+
+		if ((left < count) && before(left, best)) {
+			best = left;
+		}
+		if ((right < count) && before(right, best)) {
+			best = right;
+		}
+		if (best == index) {
+			break;
+		}
+
+		swapEntries(index, best);
+		index = best;
+	}
+}
+}  // namespace glasscore
@@ -1,8 +1,8 @@
 #include <json.h>
+#include <cmath>
 #include <memory>
 #include <string>
 #include <utility>
-#include <tuple>
 #include <mutex>
 #include <algorithm>
 #include <vector>
@@ -14,20 +14,22 @@
 #include "Pick.h"
 #include "Date.h"
 #include "Logit.h"
+#include "Memory.h"
+#include "Pool.h"
 
 namespace glasscore {
 
 // site Link sorting function
 // Compares site links using travel times
 bool sortSiteLink(const SiteLink &lhs, const SiteLink &rhs) {
-	double travelTime1 = std::get< LINK_TT1>(lhs);
+	double travelTime1 = lhs.dTravelTime1;
 	if (travelTime1 < 0) {
-		travelTime1 = std::get< LINK_TT2>(lhs);
+		travelTime1 = lhs.dTravelTime2;
 	}
 
-	double travelTime2 = std::get< LINK_TT1>(rhs);
+	double travelTime2 = rhs.dTravelTime1;
 	if (travelTime2 < 0) {
-		travelTime2 = std::get< LINK_TT2>(rhs);
+		travelTime2 = rhs.dTravelTime2;
 	}
 
 	// compare
@@ -59,10 +61,12 @@ CNode::~CNode() {
 
 // ---------------------------------------------------------clear
 void CNode::clear() {
-	std::lock_guard<std::recursive_mutex> nodeGuard(nodeMutex);
-
+	// unlink before taking the node mutex, a site may be nucleating this
+	// node while holding its own link mutex
 	clearSiteLinks();
 
+	std::lock_guard<std::recursive_mutex> nodeGuard(nodeMutex);
+
 	sName = "Nemo";
 	pWeb = NULL;
 	dLat = 0;
@@ -74,21 +78,21 @@ void CNode::clear() {
 }
 
 void CNode::clearSiteLinks() {
-	if (vSite.size() == 0) {
-		return;
-	}
+	// keep a site being cleared at the same time from being freed while
+	// this node unlinks from it
+	std::lock_guard<std::mutex> teardownGuard(getLinkTeardownMutex());
 
-	// lock mutex for this scope
-	std::lock_guard<std::mutex> guard(vSiteMutex);
+	// remove all the links from this node to sites
+	std::vector<SiteLink> oldLinks;
+	vSiteMutex.lock();
+	oldLinks.swap(vSite);
+	vSiteMutex.unlock();
 
 	// remove any links that sites have TO this node
-	for (auto &link : vSite) {
-		std::shared_ptr<CSite> aSite = std::get< LINK_PTR>(link);
-		aSite->remNode(sPid);
+	// done after unlock to avoid node-site deadlocks
+	for (auto &link : oldLinks) {
+		link.pSite->remNode(this);
 	}
-
-	// remove all the links from this node to sites
-	vSite.clear();
 }
 
 bool CNode::initialize(std::string name, double lat, double lon, double z,
@@ -109,7 +113,8 @@ bool CNode::initialize(std::string name, double lat, double lon, double z,
 }
 
 bool CNode::linkSite(std::shared_ptr<CSite> site, std::shared_ptr<CNode> node,
-						double travelTime1, double travelTime2) {
+						double travelTime1, double travelTime2,
+						double slowness1, double slowness2) {
 	// nullchecks
 	// check site
 	if (site == NULL) {
@@ -124,24 +129,35 @@ bool CNode::linkSite(std::shared_ptr<CSite> site, std::shared_ptr<CNode> node,
 		return (false);
 	}
 
-	// lock mutex for this scope
-	std::lock_guard<std::mutex> guard(vSiteMutex);
+	// compute the azimuth and distance from the site to this node once,
+	// so that beam matching in nucleate is a lookup
+	glassutil::CGeoPoint nodePoint;
+	nodePoint.setGeographic(dLat, dLon);
 
 	// Link node to site using traveltime
 	// NOTE: No validation on travel times
-	SiteLink link = std::make_tuple(site, travelTime1, travelTime2);
+	SiteLink link;
+	link.pSite = site.get();
+	link.dTravelTime1 = travelTime1;
+	link.dTravelTime2 = travelTime2;
+	link.fAzimuth = RAD2DEG * site->getGeoPoint().azimuth(nodePoint);
+	link.fDistance = RAD2DEG * site->getGeoPoint().delta(nodePoint);
+	link.fSlowness1 = slowness1;
+	link.fSlowness2 = slowness2;
+
+	vSiteMutex.lock();
 	vSite.push_back(link);
+	vSiteMutex.unlock();
 
 	// link site to node, again using the traveltime
-	// NOTE: this used to be site->addNode(shared_ptr<CNode>(this), tt);
-	// but that caused problems when deleting site-node links.
+	// done after unlock to avoid node-site deadlocks
 	site->addNode(node, travelTime1, travelTime2);
 
 	// successfully linked site
 	return (true);
 }
 
-bool CNode::unlinkSite(std::shared_ptr<CSite> site) {
+bool CNode::unlinkSite(CSite *site) {
 	// nullchecks
 	// check site
 	if (site == NULL) {
@@ -154,29 +170,11 @@ bool CNode::unlinkSite(std::shared_ptr<CSite> site) {
 	vSiteMutex.lock();
 
 	// search through each site linked to this node
-	bool found = false;
-	SiteLink foundLink;
-	std::shared_ptr<CSite> foundSite;
-	for (const auto &link : vSite) {
+	for (auto it = vSite.begin(); it != vSite.end(); ++it) {
 		// get the site
-		std::shared_ptr<CSite> currentSite = std::get< LINK_PTR>(link);
-
-		// if the new station would be before
-		// the current station
-		if (currentSite->getScnl() == site->getScnl()) {
-			found = true;
-			foundLink = link;
-			foundSite = currentSite;
+		CSite *foundSite = it->pSite;
 
-			// done
-			break;
-		}
-	}
-
-	if (found == true) {
-		// find site iterator to remove
-		auto it = std::find(vSite.begin(), vSite.end(), foundLink);
-		if (it != vSite.end()) {
+		if (foundSite == site) {
 			// remove site
 			// unlink site from node
 			vSite.erase(it);
@@ -186,7 +184,7 @@ bool CNode::unlinkSite(std::shared_ptr<CSite> site) {
 
 			// unlink node from site
 			// done after unlock to avoid node-site deadlocks
-			foundSite->remNode(sPid);
+			foundSite->remNode(this);
 
 			return (true);
 		}
@@ -199,7 +197,7 @@ bool CNode::unlinkSite(std::shared_ptr<CSite> site) {
 
 bool CNode::unlinkLastSite() {
 	// get the last site in the list
-	std::shared_ptr<CSite> lastSite = getLastSite();
+	CSite *lastSite = getLastSite();
 
 	if (lastSite == NULL) {
 		return (false);
@@ -208,7 +206,7 @@ bool CNode::unlinkLastSite() {
 	// unlink node from last site
 	// done before lock guard to prevent
 	// deadlock between node and site list mutexes.
-	lastSite->remNode(sPid);
+	lastSite->remNode(this);
 
 	// lock mutex for this scope
 	std::lock_guard<std::mutex> guard(vSiteMutex);
@@ -249,16 +247,22 @@ std::shared_ptr<CTrigger> CNode::nucleate(double tOrigin) {
 	int nCut = pWeb->getNucleate();
 	double dThresh = pWeb->getThresh();
 	double dAzimuthRange = pWeb->getGlass()->getBeamMatchingAzimuthWindow();
-	// commented out because slowness matching of beams is not yet implemented
-	// but is scheduled to be soon
-	// double dDistanceRange = pWeb->pGlass->getBeamMatchingDistanceWindow();
+	double dSlownessRange = pWeb->getGlass()->getBeamMatchingSlownessWindow();
 
 	// init overall significance sum and node site count
 	// to 0
 	double dSum = 0.0;
 	int nCount = 0;
 
-	std::vector<std::shared_ptr<CPick>> vPick;
+	// the picks that make up a trigger with the link to each pick's site,
+	// and the pick records at each site, kept per nucleation thread and
+	// reused between calls so that nucleating does not allocate unless a
+	// trigger is made
+	static thread_local std::vector<std::shared_ptr<CPick>> vPick;
+	static thread_local std::vector<SiteLink> vPickLink;
+	static thread_local std::vector<PickRecord> vSitePicks;
+	vPick.clear();
+	vPickLink.clear();
 
 	// lock mutex for this scope
 	std::lock_guard<std::mutex> guard(vSiteMutex);
@@ -271,78 +275,66 @@ std::shared_ptr<CTrigger> CNode::nucleate(double tOrigin) {
 		// init sigbest
 		double dSigBest = -1.0;
 
-		// get shared pointer to site
-		std::shared_ptr<CSite> site = std::get< LINK_PTR>(link);
+		// get the site
+		CSite *site = link.pSite;
 
 		// Ignore if station out of service
 		if (!site->getUse()) {
 			continue;
 		}
 
-		std::vector<std::shared_ptr<CPick>> vSitePicks = site->getVPick();
-
-		// search through each pick at this site
-		for (const auto &pick : vSitePicks) {
-			if (pick == NULL) {
-				continue;
-			}
+		// get the records of the picks at this site that arrive no earlier
+		// than this potential origin and no later than 1000 seconds after
+		// (about 100 degrees)
+		// NOTE: Time cutoff is hard coded
+		site->getPickRecords(tOrigin, tOrigin + 1000.0, &vSitePicks);
 
-			// get the pick's arrival time
-			double tPick = pick->getTPick();
+		// the best nucleating pick record at this site
+		const PickRecord *recordBest = NULL;
 
-			// get the picks back azimuth
-			double backAzimuth = pick->getBackAzimuth();
+		// search through each pick at this site
+		for (const auto &record : vSitePicks) {
+			// get the picks back azimuth and slowness
+			double backAzimuth = record.dBackAzimuth;
+			double slowness = record.dSlowness;
 
 			// compute observed travel time from the pick time and
 			// the provided origin time
-			double tObs = tPick - tOrigin;
-
-			// Ignore arrivals past earlier than this potential origin and
-			// past 1000 seconds (about 100 degrees)
-			// NOTE: Time cutoff is hard coded
-			if (tObs < 0 || tObs > 1000.0) {
-				continue;
-			}
+			double tObs = record.tPick - tOrigin;
 
 			// check backazimuth if present
 			if (backAzimuth > 0) {
-				// set up a geo for distance calculations
-				glassutil::CGeo nodeGeo;
-				nodeGeo.setGeographic(dLat, dLon, 6371.0 - dZ);
-
-				// compute azimith from the site to the node
-				double siteAzimuth = pick->getSite()->getGeo().azimuth(
-						&nodeGeo);
+				// get the azimith from the site to the node
+				double siteAzimuth = link.fAzimuth;
 
 				// check to see if pick's backazimuth is within the
-				// valid range
-				if ((backAzimuth < (siteAzimuth - dAzimuthRange))
-						|| (backAzimuth > (siteAzimuth + dAzimuthRange))) {
+				// valid range, allowing for wrap around north
+				double azimuthDiff = std::fabs(backAzimuth - siteAzimuth);
+				if (azimuthDiff > 180.0) {
+					azimuthDiff = 360.0 - azimuthDiff;
+				}
+				if (azimuthDiff > dAzimuthRange) {
 					// it is not, do not nucleate
 					continue;
 				}
 			}
 
-			// check slowness if present
-			// Need modify travel time libraries to support getting distance
-			// from slowness, and it's of limited value compared to the back
-			// azimuth check
-			/*if (pick->dSlowness > 0) {
-			 // compute distance from the site to the node
-			 double siteDistance = pick->pSite->getGeo().delta(&nodeGeo);
-
-			 // compute observed distance from slowness (1/velocity)
-			 // and tObs (distance = velocity * time)
-			 double obsDistance = (1 / pick->dSlowness) * tObs;
-
-			 // check to see if the observed distance is within the
-			 // valid range
-			 if ((obsDistance < (siteDistance - dDistanceRange))
-			 || (obsDistance > (siteDistance + dDistanceRange))) {
-			 // it is not, do not nucleate
-			 continue;
-			 }
-			 }*/
+			// check slowness if present, and if the node predicts one
+			if ((slowness > 0)
+					&& ((link.fSlowness1 > 0) || (link.fSlowness2 > 0))) {
+				// check to see if the pick's slowness is within the valid
+				// range of the slowness predicted for either phase
+				bool match1 = (link.fSlowness1 > 0)
+						&& (std::fabs(slowness - link.fSlowness1)
+								<= dSlownessRange);
+				bool match2 = (link.fSlowness2 > 0)
+						&& (std::fabs(slowness - link.fSlowness2)
+								<= dSlownessRange);
+				if ((match1 == false) && (match2 == false)) {
+					// it is not, do not nucleate
+					continue;
+				}
+			}
 
 			// get the best significance from the observed time and the
 			// link
@@ -355,7 +347,7 @@ std::shared_ptr<CTrigger> CNode::nucleate(double tOrigin) {
 				dSigBest = dSig;
 
 				// remember the best pick
-				pickBest = pick;
+				recordBest = &record;
 			}
 		}
 
@@ -363,6 +355,13 @@ std::shared_ptr<CTrigger> CNode::nucleate(double tOrigin) {
 		// should be added to the overall sum from this site
 		// NOTE: This significance threshold is hard coded.
 		if (dSigBest >= 0.1) {
+			// look up the pick, skipping it if it was removed since the
+			// records were read
+			pickBest = site->getPick(*recordBest);
+			if (pickBest == NULL) {
+				continue;
+			}
+
 			// count this site
 			nCount++;
 
@@ -372,6 +371,7 @@ std::shared_ptr<CTrigger> CNode::nucleate(double tOrigin) {
 
 			// add the pick to the pick vector
 			vPick.push_back(pickBest);
+			vPickLink.push_back(link);
 		}
 	}
 
@@ -385,6 +385,7 @@ std::shared_ptr<CTrigger> CNode::nucleate(double tOrigin) {
 	// exceeds the nucleation threshold
 	if (nCount < nCut) {
 		// the node did not nucleate an event
+		vPick.clear();
 		return (NULL);
 	}
 
@@ -392,24 +393,28 @@ std::shared_ptr<CTrigger> CNode::nucleate(double tOrigin) {
 	// significance threshold
 	if (dSum < dThresh) {
 		// the node did not nucleate an event
+		vPick.clear();
 		return (NULL);
 	}
 
-	// create trigger
-	std::shared_ptr<CTrigger> trigger(
-			new CTrigger(dLat, dLon, dZ, tOrigin, dResolution, dSum, nCount,
-							vPick, pWeb));
+	// create trigger from the trigger pool, copying the picks and links
+	std::shared_ptr<CTrigger> trigger = std::allocate_shared<CTrigger>(
+			glassutil::CPoolAllocator<CTrigger>(), dLat, dLon, dZ, tOrigin,
+			dResolution, dSum, nCount, vPick, pWeb, vPickLink);
+
+	// release the scratch references so picks are not held past this call
+	vPick.clear();
 
 	// the node nucleated an event
 	return (trigger);
 }
 
-double CNode::getBestSig(double tObservedTT, SiteLink link) {
+double CNode::getBestSig(double tObservedTT, const SiteLink &link) {
 	// get traveltime1 to site
-	double travelTime1 = std::get< LINK_TT1>(link);
+	double travelTime1 = link.dTravelTime1;
 
 	// get traveltime2 to site
-	double travelTime2 = std::get< LINK_TT2>(link);
+	double travelTime2 = link.dTravelTime2;
 
 	// use observed travel time, travel times to site, and a dT/dKm of
 	// 0.1 s/km to calculate distance residuals
@@ -452,22 +457,20 @@ double CNode::getBestSig(double tObservedTT, SiteLink link) {
 	}
 }
 
-std::shared_ptr<CSite> CNode::getSite(std::string sScnl) {
-	if (sScnl == "") {
+CSite * CNode::getSite(const CSite *site) {
+	if (site == NULL) {
 		return (NULL);
 	}
 
 	// lock mutex for this scope
 	std::lock_guard<std::mutex> guard(vSiteMutex);
 
-	// NOTE: could be made more efficient (faster)
-	// if we had a std::map
-	// for all sites
+	// the link list is short, and interned sites compare by integer id
 	for (const auto &link : vSite) {
 		// get the site
-		auto aSite = std::get< LINK_PTR>(link);
+		CSite *aSite = link.pSite;
 
-		if (aSite->getScnl() == sScnl) {
+		if (aSite->isSameSite(site)) {
 			// found
 			return (aSite);
 		}
@@ -477,19 +480,16 @@ std::shared_ptr<CSite> CNode::getSite(std::string sScnl) {
 	return (NULL);
 }
 
-std::shared_ptr<CSite> CNode::getLastSite() {
-	if (getSiteLinksCount() == 0) {
-		return (NULL);
-	}
-
+CSite * CNode::getLastSite() {
 	// lock mutex for this scope
 	std::lock_guard<std::mutex> guard(vSiteMutex);
 
-	SiteLink lastLink = vSite[vSite.size() - 1];
-	std::shared_ptr<CSite> lastSite = std::get< LINK_PTR>(lastLink);
+	if (vSite.size() == 0) {
+		return (NULL);
+	}
 
 	// found
-	return (lastSite);
+	return (vSite[vSite.size() - 1].pSite);
 }
 
 void CNode::sortSiteLinks() {
@@ -508,7 +508,7 @@ std::string CNode::getSitesString() {
 	// write to station file
 	for (const auto &link : vSite) {
 		// get the site
-		std::shared_ptr<CSite> currentSite = std::get< LINK_PTR>(link);
+		CSite *currentSite = link.pSite;
 		double lat, lon, r;
 
 		currentSite->getGeo().getGeographic(&lat, &lon, &r);
@@ -577,4 +577,15 @@ const std::string& CNode::getName() const {
 const std::string& CNode::getPid() const {
 	return (sPid);
 }
+
+// ---------------------------------------------------------getMemoryUsage
+size_t CNode::getMemoryUsage() const {
+	size_t bytes = sizeof(CNode) + glassutil::CMemory::stringBytes(sName)
+			+ glassutil::CMemory::stringBytes(sPid);
+
+	std::lock_guard<std::mutex> guard(vSiteMutex);
+	bytes += vSite.capacity() * sizeof(SiteLink);
+
+	return (bytes);
+}
 }  // namespace glasscore
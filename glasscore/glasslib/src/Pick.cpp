@@ -15,6 +15,8 @@
 #include "Date.h"
 #include "Glass.h"
 #include "Logit.h"
+#include "Memory.h"
+#include "Pool.h"
 
 namespace glasscore {
 
@@ -166,14 +168,12 @@ CPick::CPick(std::shared_ptr<json::Object> pick, int pickId,
 			&& ((*pick)["Time"].GetType() == json::ValueType::StringVal)) {
 		// Time is formatted in iso8601, convert to julian seconds
 		ttt = (*pick)["Time"].ToString();
-		glassutil::CDate dt = glassutil::CDate();
-		tpick = dt.decodeISO8601Time(ttt);
+		tpick = glassutil::CDate::parseISO8601(ttt.c_str(), ttt.length());
 	} else if (pick->HasKey("T")
 			&& ((*pick)["T"].GetType() == json::ValueType::StringVal)) {
 		// T is formatted in datetime, convert to julian seconds
 		ttt = (*pick)["T"].ToString();
-		glassutil::CDate dt = glassutil::CDate();
-		tpick = dt.decodeDateTime(ttt);
+		tpick = glassutil::CDate::parseDateTime(ttt.c_str(), ttt.length());
 	} else {
 		glassutil::CLogit::log(
 				glassutil::log_level::error,
@@ -251,6 +251,7 @@ void CPick::clear() {
 	std::lock_guard<std::recursive_mutex> guard(pickMutex);
 
 	wpSite.reset();
+	iSiteId = -1;
 	wpHypo.reset();
 	jPick.reset();
 
@@ -276,6 +277,7 @@ bool CPick::initialize(std::shared_ptr<CSite> pickSite, double pickTime,
 	}
 
 	wpSite = pickSite;
+	iSiteId = pickSite->getSiteId();
 	tPick = pickTime;
 	idPick = pickId;
 	sPid = pickIdString;
@@ -313,6 +315,22 @@ void CPick::addHypo(std::shared_ptr<CHypo> hyp, std::string ass, bool force) {
 	}
 }
 
+// ---------------------------------------------------------replaceHypo
+bool CPick::replaceHypo(std::shared_ptr<CHypo> oldHyp,
+							std::shared_ptr<CHypo> newHyp, std::string ass) {
+	std::lock_guard<std::recursive_mutex> guard(pickMutex);
+
+	// only move the link if nobody else has since
+	if (wpHypo.lock() != oldHyp) {
+		return (false);
+	}
+
+	wpHypo = newHyp;
+	sAss = ass;
+
+	return (true);
+}
+
 // ---------------------------------------------------------remHypo
 void CPick::remHypo(std::shared_ptr<CHypo> hyp) {
 	// nullcheck
@@ -326,17 +344,18 @@ void CPick::remHypo(std::shared_ptr<CHypo> hyp) {
 }
 
 void CPick::remHypo(std::string pid) {
-	std::lock_guard<std::recursive_mutex> guard(pickMutex);
+	// check the linked hypo's id without holding the pick lock, a pick
+	// never locks a hypo while it is locked itself
+	std::shared_ptr<CHypo> pHypo = getHypo();
+	if ((pHypo != NULL) && (pHypo->getPid() != pid)) {
+		return;
+	}
 
-	// is the pointer still valid
-	if (auto pHypo = wpHypo.lock()) {
-		// Remove hypo reference from this pick
-		if (pHypo->getPid() == pid) {
-			clearHypo();
-		}
-	} else {
-		// remove invalid pointer
-		clearHypo();
+	// Remove hypo reference (or invalid pointer) from this pick, unless
+	// it was relinked in the meantime
+	std::lock_guard<std::recursive_mutex> guard(pickMutex);
+	if (wpHypo.lock() == pHypo) {
+		wpHypo.reset();
 	}
 }
 
@@ -366,7 +385,8 @@ bool CPick::nucleate() {
 		return (false);
 	}
 
-	std::string pt = glassutil::CDate::encodeDateTime(tPick);
+	char pt[DATETIMELENGTH + 1];
+	glassutil::CDate::formatDateTime(tPick, pt);
 	char sLog[1024];
 
 	// check to see if the pick is currently associated to a hypo
@@ -440,9 +460,14 @@ bool CPick::nucleate() {
 			}
 		}
 
+		// don't build a hypo that can't survive
+		if (!screen(trigger, pGlass)) {
+			continue;
+		}
+
 		// create the hypo using the node
-		std::shared_ptr<CHypo> hypo = std::make_shared<CHypo>(
-				trigger, pGlass->getTTT());
+		std::shared_ptr<CHypo> hypo = std::allocate_shared<CHypo>(
+				glassutil::CPoolAllocator<CHypo>(), trigger, pGlass->getTTT());
 
 		// set hypo glass pointer and such
 		hypo->setGlass(pGlass);
@@ -530,7 +555,8 @@ bool CPick::nucleate() {
 		}
 
 		// log the hypo
-		std::string st = glassutil::CDate::encodeDateTime(hypo->getTOrg());
+		char st[DATETIMELENGTH + 1];
+		glassutil::CDate::formatDateTime(hypo->getTOrg(), st);
 		glassutil::CLogit::log(
 				glassutil::log_level::debug,
 				"CPick::nucleate: TRG site:" + pickSite->getScnl() + "; tPick:"
@@ -550,6 +576,72 @@ bool CPick::nucleate() {
 	return (true);
 }
 
+// ---------------------------------------------------------screen
+bool CPick::screen(std::shared_ptr<CTrigger> trigger, CGlass *glass) {
+	const CWeb *web = trigger->getWeb();
+	int ncut = web->getNucleate();
+	double thresh = web->getThresh();
+	double resolution = trigger->getResolution();
+
+	// the annealing in nucleate can move the hypo about a node spacing from
+	// the node, forgive each pick the travel time that movement could take
+	// NOTE: The slowness is hard coded, slow enough to cover S close in
+	double slack = resolution * 0.3;
+
+	int count = 0;
+	double origin = 0;
+	double bayes = trigger->estimateBayes(glass, slack, &count, &origin);
+
+	char sLog[1024];
+
+	// check to see if the estimate can reach the nucleation cut and threshold
+	if ((count < ncut) || (bayes < thresh)) {
+		snprintf(sLog, sizeof(sLog),
+					"CPick::nucleate: SKIPTRG screened, estimate below cut "
+					"(count:%d/ncut:%d; bayes:%f/thresh:%f)",
+					count, ncut, bayes, thresh);
+		glassutil::CLogit::log(glassutil::log_level::debug, sLog);
+		return (false);
+	}
+
+	// look for an existing hypo close to the trigger
+	CHypoList *hypoList = glass->getHypoList();
+	if (hypoList == NULL) {
+		return (true);
+	}
+	std::shared_ptr<CHypo> hypo = hypoList->findHypo(
+			origin - slack, origin + slack, trigger->getLat(),
+			trigger->getLon(), resolution / 111.12);
+	if (hypo == NULL) {
+		return (true);
+	}
+
+	// count the trigger picks the hypo already has
+	std::string hypoPid = hypo->getPid();
+	std::vector<std::shared_ptr<CPick>> vTriggerPicks = trigger->getVPick();
+	int shared = 0;
+	for (const auto &pick : vTriggerPicks) {
+		if (pick->getHypoPid() == hypoPid) {
+			shared++;
+		}
+	}
+
+	// a trigger that can't make a hypo without the existing hypo's picks,
+	// and can't outweigh it, would only duplicate it
+	int nFree = static_cast<int>(vTriggerPicks.size()) - shared;
+	double hypoBayes = hypo->getBayes();
+	if ((nFree < ncut) && (bayes <= hypoBayes)) {
+		snprintf(sLog, sizeof(sLog),
+					"CPick::nucleate: SKIPTRG screened, duplicates %s "
+					"(free:%d/ncut:%d; bayes:%f/hypo bayes:%f)",
+					hypoPid.c_str(), nFree, ncut, bayes, hypoBayes);
+		glassutil::CLogit::log(glassutil::log_level::debug, sLog);
+		return (false);
+	}
+
+	return (true);
+}
+
 double CPick::getBackAzimuth() const {
 	return (dBackAzimuth);
 }
@@ -572,15 +664,9 @@ const std::shared_ptr<CHypo> CPick::getHypo() const {
 }
 
 const std::string CPick::getHypoPid() const {
-	std::lock_guard<std::recursive_mutex> pickGuard(pickMutex);
 	std::string hypoPid = "";
 
-	// make sure we have a hypo,
-	if (wpHypo.expired() == true) {
-		return (hypoPid);
-	}
-
-	// get the hypo
+	// get the hypo, without holding our lock while the hypo is locked
 	std::shared_ptr<CHypo> pHypo = getHypo();
 	if (pHypo != NULL) {
 		// get the hypo pid
@@ -595,6 +681,10 @@ const std::shared_ptr<CSite> CPick::getSite() const {
 	return (wpSite.lock());
 }
 
+int CPick::getSiteId() const {
+	return (iSiteId);
+}
+
 const std::string& CPick::getAss() const {
 	std::lock_guard<std::recursive_mutex> pickGuard(pickMutex);
 	return (sAss);
@@ -612,4 +702,18 @@ double CPick::getTPick() const {
 	return (tPick);
 }
 
+// ---------------------------------------------------------getMemoryUsage
+size_t CPick::getMemoryUsage() const {
+	std::lock_guard<std::recursive_mutex> pickGuard(pickMutex);
+
+	size_t bytes = sizeof(CPick) + glassutil::CMemory::stringBytes(sAss)
+			+ glassutil::CMemory::stringBytes(sPhs)
+			+ glassutil::CMemory::stringBytes(sPid);
+
+	if (jPick != NULL) {
+		bytes += glassutil::CMemory::jsonBytes(*jPick);
+	}
+
+	return (bytes);
+}
 }  // namespace glasscore
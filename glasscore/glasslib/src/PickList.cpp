@@ -19,6 +19,8 @@
 #include "PickList.h"
 #include "HypoList.h"
 #include "Logit.h"
+#include "Memory.h"
+#include "Pool.h"
 
 namespace glasscore {
 
@@ -43,6 +45,7 @@ CPickList::CPickList(int numThreads, int sleepTime, int checkInterval) {
 	m_iSleepTimeMS = sleepTime;
 	m_iStatusCheckInterval = checkInterval;
 	std::time(&tLastStatusCheck);
+	pExecutor = NULL;
 
 	clear();
 
@@ -203,21 +206,21 @@ bool CPickList::addPick(std::shared_ptr<json::Object> pick) {
 		return (false);
 	}
 
-	// create new pick from json message
-	CPick * newPick = new CPick(pick, nPick + 1, pSiteList);
+	// create new pick from json message, the pick and its shared pointer
+	// control block come from the pick pool
+	std::shared_ptr<CPick> pck = std::allocate_shared<CPick>(
+			glassutil::CPoolAllocator<CPick>(), pick, nPick + 1, pSiteList);
 
 	// check to see if we got a valid pick
-	if ((newPick->getSite() == NULL) || (newPick->getTPick() == 0)
-			|| (newPick->getPid() == "")) {
-		// cleanup
-		delete (newPick);
+	if ((pck->getSite() == NULL) || (pck->getTPick() == 0)
+			|| (pck->getPid() == "")) {
 		// message was processed
 		return (true);
 	}
 
 	// check if pick is duplicate, if pGlass exists
 	if (pGlass) {
-		bool duplicate = checkDuplicate(newPick,
+		bool duplicate = checkDuplicate(pck.get(),
 										pGlass->getPickDuplicateWindow());
 
 		// it is a duplicate, log and don't add pick
@@ -225,7 +228,6 @@ bool CPickList::addPick(std::shared_ptr<json::Object> pick) {
 			glassutil::CLogit::log(
 					glassutil::log_level::warn,
 					"CPickList::addPick: Duplicate pick not passed in.");
-			delete (newPick);
 			// message was processed
 			return (true);
 		}
@@ -233,9 +235,6 @@ bool CPickList::addPick(std::shared_ptr<json::Object> pick) {
 
 	m_vPickMutex.lock();
 
-	// create new shared pointer to this pick
-	std::shared_ptr<CPick> pck(newPick);
-
 	// Add pick to cache (mPick) and time sorted
 	// index (vPick). If vPick has reached its
 	// maximum capacity (nPickMax), then the
@@ -310,6 +309,20 @@ bool CPickList::addPick(std::shared_ptr<json::Object> pick) {
 
 	m_vPickMutex.unlock();
 
+	// hand the pick to the shared executor if we have one
+	if ((pExecutor) && (pGlass) && (pGlass->getHypoList())) {
+		// wait until there's space in the queue, as below
+		while (pExecutor->getQueueSize(task_class::nucleation)
+				>= pExecutor->getMaxConcurrent(task_class::nucleation)) {
+			std::this_thread::sleep_for(std::chrono::milliseconds(100));
+		}
+
+		pExecutor->submit(task_class::nucleation,
+							[this, pck]() {process(pck);});
+
+		return (true);
+	}
+
 	// get the current size of the queue
 	m_qProcessMutex.lock();
 	int queueSize = qProcessList.size();
@@ -466,7 +479,7 @@ bool CPickList::checkDuplicate(CPick *newPick, double window) {
 		// check if time difference is within window
 		if (std::abs(newPick->getTPick() - pck->getTPick()) < window) {
 			// check if sites match
-			if (newPick->getSite()->getScnl() == pck->getSite()->getScnl()) {
+			if (newPick->getSite()->isSameSite(pck->getSite().get())) {
 				// if match is found, set to true, log, and break out of loop
 				matched = true;
 				glassutil::CLogit::log(
@@ -487,8 +500,8 @@ bool CPickList::checkDuplicate(CPick *newPick, double window) {
 
 // ---------------------------------------------------------scavenge
 bool CPickList::scavenge(std::shared_ptr<CHypo> hyp, double tDuration) {
-	// Scan all picks within specified time range, adding any
-	// that meet association criteria to hypo object provided.
+	// Scan all picks that could arrive within specified time range, adding
+	// any that meet association criteria to hypo object provided.
 	// Returns true if any associated.
 
 	// null check
@@ -513,37 +526,23 @@ bool CPickList::scavenge(std::shared_ptr<CHypo> hyp, double tDuration) {
 	// Calculate range for possible associations
 	double sdassoc = pGlass->getSdAssociate();
 
-	std::lock_guard<std::recursive_mutex> listGuard(m_vPickMutex);
-
-	// get the index of the pick to start with
-	// based on the hypo origin time
-	int it1 = indexPick(hyp->getTOrg());
-
-	// index can't be negative
-	// Primarily occurs if origin time is before first pick
-	if (it1 < 0) {
-		it1 = 0;
-	}
-
-	// get the index of the pick to end with by using the hypo
-	// origin time plus the provided duration
-	int it2 = indexPick(hyp->getTOrg() + tDuration);
+	// get the picks at sites within the hypo's distance cutoff that fall
+	// near a predicted arrival time, rather than every pick in the duration.
+	// This is a snapshot taken from the sites, so the pick list isn't
+	// locked while we work through it
+	std::vector<std::shared_ptr<CPick>> candidates = hyp->getCandidatePicks(
+			sdassoc, tDuration);
 
 	// don't bother if there's no picks
-	if (it1 == it2) {
+	if (candidates.size() == 0) {
 		return (false);
 	}
 
 	int addCount = 0;
 
-	// for each pick index between it1 and it2
+	// for each candidate pick
 	bool bAss = false;
-	for (int it = it1; it < it2; it++) {
-		// get the pick from the vector
-		auto q = vPick[it];
-		std::shared_ptr<CPick> pck = mPick[q.second];
-		std::shared_ptr<CHypo> pickHyp = pck->getHypo();
-
+	for (auto pck : candidates) {
 		// check to see if this pick is already in this hypo
 		if (hyp->hasPick(pck)) {
 			// it is, skip it
@@ -556,28 +555,17 @@ bool CPickList::scavenge(std::shared_ptr<CHypo> hyp, double tDuration) {
 			continue;
 		}
 
-		// check to see if this pick is part of ANY hypo
-		if (pickHyp == NULL) {
-			// unassociated with any existing hypo
-			// link pick to the hypo we're working on
-			pck->addHypo(hyp, "W", true);
-
-			// add pick to this hypo
-			hyp->addPick(pck);
-
-			// we've associated a pick
-			bAss = true;
-			addCount++;
-		} else {
-			// associated with an existing hypo
-			// Add it to this hypo, but don't change the pick's hypo link
-			// Let resolve() sort out which hypo the pick fits best with
-			hyp->addPick(pck);
-
-			// we've associated a pick
-			bAss = true;
-			addCount++;
-		}
+		// link pick to the hypo we're working on if it is unassociated
+		// with any existing hypo. If it is, don't change the pick's hypo
+		// link, let resolve() sort out which hypo the pick fits best with
+		pck->addHypo(hyp, "W");
+
+		// add pick to this hypo
+		hyp->addPick(pck);
+
+		// we've associated a pick
+		bAss = true;
+		addCount++;
 	}
 
 	glassutil::CLogit::log(
@@ -589,68 +577,6 @@ bool CPickList::scavenge(std::shared_ptr<CHypo> hyp, double tDuration) {
 	return (bAss);
 }
 
-// ---------------------------------------------------------rogues
-std::vector<std::shared_ptr<CPick>> CPickList::rogues(std::string pidHyp,
-														double tOrg,
-														double tDuration) {
-	// Generate rogue list (all picks that are not associated
-	// with given event, but could be)
-	std::vector<std::shared_ptr<CPick>> vRogue;
-
-	// null checks
-	if (pidHyp == "") {
-		glassutil::CLogit::log(glassutil::log_level::error,
-								"CPickList::rogues: Empty pidHyp provided.");
-		return (vRogue);
-	}
-	if (tOrg <= 0) {
-		glassutil::CLogit::log(glassutil::log_level::error,
-								"CPickList::rogues: Invalid tOrg provided.");
-		return (vRogue);;
-	}
-	if (tDuration <= 0) {
-		glassutil::CLogit::log(
-				glassutil::log_level::error,
-				"CPickList::rogues: Invalid tDuration provided.");
-		return (vRogue);
-	}
-
-	std::lock_guard<std::recursive_mutex> listGuard(m_vPickMutex);
-
-	// get the index of the pick to start with
-	// based on the provided origin time
-	int it1 = indexPick(tOrg);
-
-	// index can't be negative
-	// Primarily occurs if origin time is before first pick
-	if (it1 < 0) {
-		it1 = 0;
-	}
-
-	// get the index of the pick to end with by using the provided
-	// origin time plus the provided duration
-	int it2 = indexPick(tOrg + tDuration);
-
-	// for each pick index between it1 and it2
-	for (int it = it1; it < it2; it++) {
-		// get the current pick from the vector
-		auto q = vPick[it];
-		std::shared_ptr<CPick> pck = mPick[q.second];
-		std::shared_ptr<CHypo> pickHyp = pck->getHypo();
-
-		// if the current pick is associated to this event
-		if ((pickHyp != NULL) && (pickHyp->getPid() == pidHyp)) {
-			// skip to next pick
-			continue;
-		}
-
-		// Add current pick to rogues list
-		vRogue.push_back(pck);
-	}
-
-	return (vRogue);
-}
-
 void CPickList::processPick() {
 	while (m_bRunProcessLoop == true) {
 		// update thread status
@@ -700,23 +626,8 @@ void CPickList::processPick() {
 		// done with queue
 		m_qProcessMutex.unlock();
 
-		if (pck == NULL) {
-			// give up some time at the end of the loop
-			if (m_bRunProcessLoop == true) {
-				jobSleep();
-			}
-
-			// on to the next loop
-			continue;
-		}
-
-		// Attempt both association and nucleation of the new pick.
-		// If both succeed, the mess is sorted out in darwin/evolve
-		// associate
-		pGlass->getHypoList()->associate(pck);
-
-		// nucleate
-		pck->nucleate();
+		// process it
+		process(pck);
 
 		// give up some time at the end of the loop
 		if (m_bRunProcessLoop == true) {
@@ -729,6 +640,24 @@ void CPickList::processPick() {
 							"CPickList::processPick(): Thread Exit.)");
 }
 
+// ---------------------------------------------------------process
+void CPickList::process(std::shared_ptr<CPick> pck) {
+	if (pck == NULL) {
+		return;
+	}
+	if ((pGlass == NULL) || (pGlass->getHypoList() == NULL)) {
+		return;
+	}
+
+	// Attempt both association and nucleation of the new pick.
+	// If both succeed, the mess is sorted out in darwin/evolve
+	// associate
+	pGlass->getHypoList()->associate(pck);
+
+	// nucleate
+	pck->nucleate();
+}
+
 // ---------------------------------------------------------setStatus
 void CPickList::jobSleep() {
 	// if we're processing jobs
@@ -818,6 +747,11 @@ void CPickList::setSiteList(CSiteList* siteList) {
 	pSiteList = siteList;
 }
 
+void CPickList::setExecutor(glassutil::CExecutor* executor) {
+	std::lock_guard<std::recursive_mutex> pickListGuard(m_PickListMutex);
+	pExecutor = executor;
+}
+
 const CGlass* CPickList::getGlass() const {
 	std::lock_guard<std::recursive_mutex> pickListGuard(m_PickListMutex);
 	return (pGlass);
@@ -853,4 +787,25 @@ int CPickList::getVPickSize() const {
 	return (vPick.size());
 }
 
+// ---------------------------------------------------------getMemoryUsage
+size_t CPickList::getMemoryUsage() {
+	size_t bytes = sizeof(CPickList);
+
+	m_vPickMutex.lock();
+	bytes += vPick.capacity() * sizeof(std::pair<double, int>)
+			+ mPick.size()
+					* (glassutil::CMemory::mapNodeBytes()
+							+ sizeof(std::pair<int, std::shared_ptr<CPick>>));
+	for (const auto &entry : mPick) {
+		bytes += entry.second->getMemoryUsage();
+	}
+	m_vPickMutex.unlock();
+
+	// picks waiting to be processed
+	m_qProcessMutex.lock();
+	bytes += qProcessList.size() * sizeof(std::shared_ptr<CPick>);
+	m_qProcessMutex.unlock();
+
+	return (bytes);
+}
 }  // namespace glasscore
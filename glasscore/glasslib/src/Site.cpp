@@ -9,10 +9,13 @@
 #include <algorithm>
 #include <mutex>
 #include <ctime>
+#include <thread>
+#include <atomic>
 #include "Glass.h"
 #include "Pick.h"
 #include "Site.h"
 #include "Logit.h"
+#include "Memory.h"
 #include "Node.h"
 #include "Trigger.h"
 #include "Hypo.h"
@@ -48,6 +51,7 @@ std::vector<std::string> split(const std::string &s, char delim) {
 
 // ---------------------------------------------------------CSite
 CSite::CSite() {
+	nPickSequence = 0;
 	clear();
 }
 
@@ -55,6 +59,8 @@ CSite::CSite() {
 CSite::CSite(std::string sta, std::string comp, std::string net,
 				std::string loc, double lat, double lon, double elv,
 				double qual, bool enable, bool useTele, CGlass *glassPtr) {
+	nPickSequence = 0;
+
 	// pass to initialization function
 	initialize(sta, comp, net, loc, lat, lon, elv, qual, enable, useTele,
 				glassPtr);
@@ -62,6 +68,7 @@ CSite::CSite(std::string sta, std::string comp, std::string net,
 
 // ---------------------------------------------------------CSite
 CSite::CSite(std::shared_ptr<json::Object> site, CGlass *glassPtr) {
+	nPickSequence = 0;
 	clear();
 
 	// null check json
@@ -288,6 +295,17 @@ bool CSite::initialize(std::string sta, std::string comp, std::string net,
 		nSitePickMax = pGlass->getSitePickMax();
 	}
 
+	// allocate the pick ring, this is the only place it is sized, so that
+	// getPickRecords can read it without locking once the site is in use
+	vPickMutex.lock();
+	beginPickWrite();
+	vPickRecord = std::vector<PickSlot>(std::max(nSitePickMax, 1));
+	vPick = std::vector<std::shared_ptr<CPick>>(vPickRecord.size());
+	endPickWrite();
+	vPickMutex.unlock();
+
+	clearVPick();
+
 	return (true);
 }
 
@@ -297,9 +315,14 @@ CSite::~CSite() {
 }
 
 void CSite::clear() {
+	// unlink before taking the site mutex, a node may be nucleating with
+	// this site while holding its own link mutex
+	clearNodeLinks();
+
 	std::lock_guard<std::recursive_mutex> guard(siteMutex);
 	// clear scnl
 	sScnl = "";
+	iSiteId = -1;
 	sSite = "";
 	sComp = "";
 	sNet = "";
@@ -313,28 +336,66 @@ void CSite::clear() {
 
 	// clear geographic
 	geo = glassutil::CGeo();
+	geoPoint = glassutil::CGeoPoint();
 	dVec[0] = 0;
 	dVec[1] = 0;
 	dVec[2] = 0;
 
-	// clear lists
-	vNodeMutex.lock();
-	vNode.clear();
-	vNodeMutex.unlock();
-
-	clearVPick();
-
 	// reset max picks
 	nSitePickMax = 200;
 
+	clearVPick();
+
 	// reset last pick added time
 	std::time(&tLastPickAdded);
 }
 
 void CSite::clearVPick() {
-	vPickMutex.lock();
-	vPick.clear();
-	vPickMutex.unlock();
+	std::lock_guard<std::mutex> guard(vPickMutex);
+
+	beginPickWrite();
+
+	for (auto &pck : vPick) {
+		pck.reset();
+	}
+	iPickHead = 0;
+	nPick = 0;
+	nPickRemoved = 0;
+
+	endPickWrite();
+}
+
+// ---------------------------------------------------------PickSlot::load
+PickRecord PickSlot::load() const {
+	PickRecord record;
+	record.tPick = tPick.load(std::memory_order_relaxed);
+	record.dBackAzimuth = dBackAzimuth.load(std::memory_order_relaxed);
+	record.dSlowness = dSlowness.load(std::memory_order_relaxed);
+	record.idPick = idPick.load(std::memory_order_relaxed);
+	record.bRemoved = bRemoved.load(std::memory_order_relaxed);
+	return (record);
+}
+
+// ---------------------------------------------------------PickSlot::store
+void PickSlot::store(const PickRecord &record) {
+	tPick.store(record.tPick, std::memory_order_relaxed);
+	dBackAzimuth.store(record.dBackAzimuth, std::memory_order_relaxed);
+	dSlowness.store(record.dSlowness, std::memory_order_relaxed);
+	idPick.store(record.idPick, std::memory_order_relaxed);
+	bRemoved.store(record.bRemoved, std::memory_order_relaxed);
+}
+
+// ---------------------------------------------------------beginPickWrite
+void CSite::beginPickWrite() {
+	// make the sequence odd before touching the ring
+	nPickSequence.fetch_add(1, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+}
+
+// ---------------------------------------------------------endPickWrite
+void CSite::endPickWrite() {
+	// make the sequence even again once the ring is consistent
+	nPickSequence.fetch_add(1, std::memory_order_release);
 }
 
 void CSite::update(CSite *aSite) {
@@ -351,6 +412,7 @@ void CSite::update(CSite *aSite) {
 
 	// update location
 	geo = glassutil::CGeo(aSite->getGeo());
+	geoPoint = aSite->getGeoPoint();
 	double vec[3];
 	aSite->getVec(vec);
 
@@ -387,6 +449,7 @@ void CSite::setLocation(double lat, double lon, double z) {
 
 	// set geographic object
 	geo.setGeographic(lat, lon, 6371.0 - z);
+	geoPoint = glassutil::CGeoPoint(geo);
 }
 
 // ---------------------------------------------------------getDelta
@@ -437,7 +500,7 @@ void CSite::addPick(std::shared_ptr<CPick> pck) {
 	}
 
 	// ensure this pick is for this site
-	if (pck->getSite()->sScnl != sScnl) {
+	if (!isSameSite(pck->getSite().get())) {
 		glassutil::CLogit::log(
 				glassutil::log_level::warn,
 				"CSite::addPick: CPick for different site: (" + sScnl + "!="
@@ -445,15 +508,58 @@ void CSite::addPick(std::shared_ptr<CPick> pck) {
 		return;
 	}
 
+	// the ring is only allocated by initialize
+	int capacity = vPickRecord.size();
+	if (capacity == 0) {
+		glassutil::CLogit::log(glassutil::log_level::warn,
+								"CSite::addPick: Site not initialized.");
+		return;
+	}
+
+	PickRecord record;
+	record.tPick = pck->getTPick();
+	record.dBackAzimuth = pck->getBackAzimuth();
+	record.dSlowness = pck->getSlowness();
+	record.idPick = pck->getIdPick();
+	record.bRemoved = false;
+
+	beginPickWrite();
+
 	// check to see if we're at the pick limit
-	if (vPick.size() == nSitePickMax) {
-		// erase first pick from vector
-		vPick.erase(vPick.begin());
+	if (nPick == capacity) {
+		if (nPickRemoved > 0) {
+			// reclaim the removed records
+			compactPicks();
+		} else {
+			// drop the first (oldest) pick
+			vPick[iPickHead].reset();
+			iPickHead = (iPickHead + 1) % capacity;
+			nPick--;
+		}
 	}
 
-	// add pick to site pick vector
+	// add pick to the ring, in time order. Picks almost always arrive in
+	// time order, so this is usually an append
 	// NOTE: Need to add duplicate pick protection
-	vPick.push_back(pck);
+	int pos = nPick;
+	while (pos > 0) {
+		int prev = (iPickHead + pos - 1) % capacity;
+		if (vPickRecord[prev].tPick <= record.tPick) {
+			break;
+		}
+
+		int cur = (iPickHead + pos) % capacity;
+		vPickRecord[cur].store(vPickRecord[prev].load());
+		vPick[cur] = std::move(vPick[prev]);
+		pos--;
+	}
+
+	int cur = (iPickHead + pos) % capacity;
+	vPickRecord[cur].store(record);
+	vPick[cur] = pck;
+	nPick++;
+
+	endPickWrite();
 
 	// remember the time the last pick was added
 	std::time(&tLastPickAdded);
@@ -471,17 +577,190 @@ void CSite::remPick(std::shared_ptr<CPick> pck) {
 		return;
 	}
 
-	// remove pick from site pick vector
-	for (auto it = vPick.begin(); it != vPick.end();) {
-		auto aPck = (*it);
+	int capacity = vPickRecord.size();
+	if (nPick == 0) {
+		return;
+	}
+
+	// find the pick, starting from its time
+	int found = -1;
+	for (int pos = findPick(pck->getTPick()); pos < nPick; pos++) {
+		int cur = (iPickHead + pos) % capacity;
+		if (vPickRecord[cur].tPick > pck->getTPick()) {
+			break;
+		}
+		if ((vPick[cur] != NULL) && (vPick[cur]->getPid() == pck->getPid())) {
+			found = pos;
+			break;
+		}
+	}
+
+	if (found < 0) {
+		return;
+	}
+
+	beginPickWrite();
+
+	// mark the record removed
+	int cur = (iPickHead + found) % capacity;
+	vPickRecord[cur].bRemoved = true;
+	vPick[cur].reset();
+	nPickRemoved++;
+
+	// reclaim removed records from the front of the ring, which is
+	// where the pick list removes picks from
+	while ((nPick > 0) && (vPickRecord[iPickHead].bRemoved)) {
+		iPickHead = (iPickHead + 1) % capacity;
+		nPick--;
+		nPickRemoved--;
+	}
+
+	endPickWrite();
+}
 
-		// erase target pick
-		if (aPck->getPid() == pck->getPid()) {
-			it = vPick.erase(it);
+// ---------------------------------------------------------findPick
+int CSite::findPick(double tPick) const {
+	int capacity = vPickRecord.size();
+
+	// binary search for the first pick at or after the time
+	int lo = 0;
+	int hi = nPick;
+	while (lo < hi) {
+		int mid = (lo + hi) / 2;
+		if (vPickRecord[(iPickHead + mid) % capacity].tPick < tPick) {
+			lo = mid + 1;
 		} else {
-			++it;
+			hi = mid;
+		}
+	}
+
+	return (lo);
+}
+
+// ---------------------------------------------------------compactPicks
+void CSite::compactPicks() {
+	int capacity = vPickRecord.size();
+
+	// slide the live picks toward the front of the ring
+	int count = 0;
+	for (int pos = 0; pos < nPick; pos++) {
+		int from = (iPickHead + pos) % capacity;
+		if (vPickRecord[from].bRemoved) {
+			continue;
 		}
+
+		int to = (iPickHead + count) % capacity;
+		if (to != from) {
+			vPickRecord[to].store(vPickRecord[from].load());
+			vPick[to] = std::move(vPick[from]);
+		}
+		count++;
 	}
+
+	// release anything past the live picks
+	for (int pos = count; pos < nPick; pos++) {
+		vPick[(iPickHead + pos) % capacity].reset();
+	}
+
+	nPick = count;
+	nPickRemoved = 0;
+}
+
+// ---------------------------------------------------------getPicks
+void CSite::getPicks(double tStart, double tEnd,
+						std::vector<std::shared_ptr<CPick>> *picks) const {
+	std::lock_guard<std::mutex> guard(vPickMutex);
+
+	int capacity = vPickRecord.size();
+
+	// add picks from the start until the end of the window
+	for (int pos = findPick(tStart); pos < nPick; pos++) {
+		int cur = (iPickHead + pos) % capacity;
+		if (vPickRecord[cur].tPick > tEnd) {
+			break;
+		}
+		if (vPick[cur] != NULL) {
+			picks->push_back(vPick[cur]);
+		}
+	}
+}
+
+// ---------------------------------------------------------getPickRecords
+void CSite::getPickRecords(double tStart, double tEnd,
+							std::vector<PickRecord> *records) const {
+	// the ring is only allocated by initialize, before the site is in use,
+	// so it can be read without the lock, as long as no write happened
+	// during the read
+	int capacity = vPickRecord.size();
+	const PickSlot *ring = vPickRecord.data();
+
+	while (true) {
+		records->clear();
+
+		unsigned int sequence = nPickSequence.load(std::memory_order_acquire);
+		if (sequence & 1) {
+			// a write is in progress
+			std::this_thread::yield();
+			continue;
+		}
+
+		int head = iPickHead.load(std::memory_order_relaxed);
+		int count = nPick.load(std::memory_order_relaxed);
+
+		// these can only be out of range if a write raced the read, which
+		// the sequence check below catches
+		if ((capacity > 0) && (head >= 0) && (head < capacity) && (count > 0)
+				&& (count <= capacity)) {
+			// binary search for the start of the window
+			int lo = 0;
+			int hi = count;
+			while (lo < hi) {
+				int mid = (lo + hi) / 2;
+				if (ring[(head + mid) % capacity].tPick.load(
+						std::memory_order_relaxed) < tStart) {
+					lo = mid + 1;
+				} else {
+					hi = mid;
+				}
+			}
+
+			// copy records until the end of the window
+			for (int pos = lo; pos < count; pos++) {
+				PickRecord record = ring[(head + pos) % capacity].load();
+				if (record.tPick > tEnd) {
+					break;
+				}
+				if (!record.bRemoved) {
+					records->push_back(record);
+				}
+			}
+		}
+
+		std::atomic_thread_fence(std::memory_order_acquire);
+		if (nPickSequence.load(std::memory_order_relaxed) == sequence) {
+			return;
+		}
+	}
+}
+
+// ---------------------------------------------------------getPick
+std::shared_ptr<CPick> CSite::getPick(const PickRecord &record) const {
+	std::lock_guard<std::mutex> guard(vPickMutex);
+
+	int capacity = vPickRecord.size();
+
+	// the pick may have moved in the ring, so find it by time and id
+	for (int pos = findPick(record.tPick); pos < nPick; pos++) {
+		int cur = (iPickHead + pos) % capacity;
+		if (vPickRecord[cur].tPick > record.tPick) {
+			break;
+		}
+		if ((vPick[cur] != NULL) && (vPickRecord[cur].idPick == record.idPick)) {
+			return (vPick[cur]);
+		}
+	}
+
+	return (NULL);
 }
 
 // ---------------------------------------------------------addNode
@@ -508,43 +787,50 @@ void CSite::addNode(std::shared_ptr<CNode> node, double travelTime1,
 	// add node link to vector of nodes linked to this site
 	// NOTE: no duplication check, but multiple nodes from the
 	// same web can exist at the same site (travel times would be different)
-	NodeLink link = std::make_tuple(node, travelTime1, travelTime2);
+	NodeLink link;
+	link.pNode = node.get();
+	link.dTravelTime1 = travelTime1;
+	link.dTravelTime2 = travelTime2;
 	vNode.push_back(link);
 }
 
 // ---------------------------------------------------------remNode
-void CSite::remNode(std::string nodeID) {
+void CSite::remNode(const CNode *node) {
 	// lock for editing
 	std::lock_guard<std::mutex> guard(vNodeMutex);
 
 	// nullcheck
-	if (nodeID == "") {
+	if (node == NULL) {
 		glassutil::CLogit::log(glassutil::log_level::warn,
-								"CSite::remNode: empty web name provided.");
+								"CSite::remNode: NULL CNode provided.");
 		return;
 	}
 
-	// clean up expired pointers
-	for (auto it = vNode.begin(); it != vNode.end();) {
-		if (std::get<LINK_PTR>(*it).expired() == true) {
-			it = vNode.erase(it);
-		} else {
-			++it;
+	for (auto it = vNode.begin(); it != vNode.end(); ++it) {
+		// erase target node
+		if (it->pNode == node) {
+			vNode.erase(it);
+			return;
 		}
 	}
+}
 
-	for (auto it = vNode.begin(); it != vNode.end();) {
-		if (auto aNode = std::get<LINK_PTR>(*it).lock()) {
-			// erase target pick
-			if (aNode->getPid() == nodeID) {
-				it = vNode.erase(it);
-				return;
-			} else {
-				++it;
-			}
-		} else {
-			++it;
-		}
+// ---------------------------------------------------------clearNodeLinks
+void CSite::clearNodeLinks() {
+	// keep a node being cleared at the same time from being freed while
+	// this site unlinks from it
+	std::lock_guard<std::mutex> teardownGuard(getLinkTeardownMutex());
+
+	// remove all the links from this site to nodes
+	std::vector<NodeLink> oldLinks;
+	vNodeMutex.lock();
+	oldLinks.swap(vNode);
+	vNodeMutex.unlock();
+
+	// remove any links that nodes have TO this site
+	// done after unlock to avoid node-site deadlocks
+	for (auto &link : oldLinks) {
+		link.pNode->unlinkSite(this);
 	}
 }
 
@@ -567,17 +853,13 @@ std::vector<std::shared_ptr<CTrigger>> CSite::nucleate(double tPick) {
 	for (const auto &link : vNode) {
 		// compute potential origin time from tpick and traveltime to node
 		// first get traveltime1 to node
-		double travelTime1 = std::get< LINK_TT1>(link);
+		double travelTime1 = link.dTravelTime1;
 
 		// second get traveltime2 to node
-		double travelTime2 = std::get< LINK_TT2>(link);
-
-		// third get shared pointer to node
-		std::shared_ptr<CNode> node = std::get<LINK_PTR>(link).lock();
+		double travelTime2 = link.dTravelTime2;
 
-		if (node == NULL) {
-			continue;
-		}
+		// third get the node
+		CNode *node = link.pNode;
 
 		if (node->getEnabled() == false) {
 			continue;
@@ -706,6 +988,10 @@ glassutil::CGeo &CSite::getGeo() {
 	return (geo);
 }
 
+const glassutil::CGeoPoint &CSite::getGeoPoint() const {
+	return (geoPoint);
+}
+
 int CSite::getSitePickMax() const {
 	return (nSitePickMax);
 }
@@ -730,13 +1016,44 @@ const std::string& CSite::getScnl() const {
 	return (sScnl);
 }
 
+int CSite::getSiteId() const {
+	return (iSiteId);
+}
+
+void CSite::setSiteId(int id) {
+	iSiteId = id;
+}
+
+bool CSite::isSameSite(const CSite *site) const {
+	if (site == NULL) {
+		return (false);
+	}
+
+	// interned sites compare by id
+	if ((iSiteId >= 0) && (site->iSiteId >= 0)) {
+		return (iSiteId == site->iSiteId);
+	}
+
+	return (sScnl == site->sScnl);
+}
+
 const std::string& CSite::getSite() const {
 	return (sSite);
 }
 
 const std::vector<std::shared_ptr<CPick> > CSite::getVPick() const {
 	std::lock_guard<std::mutex> guard(vPickMutex);
-	return (vPick);
+
+	int capacity = vPickRecord.size();
+
+	std::vector<std::shared_ptr<CPick>> picks;
+	for (int pos = 0; pos < nPick; pos++) {
+		int cur = (iPickHead + pos) % capacity;
+		if (vPick[cur] != NULL) {
+			picks.push_back(vPick[cur]);
+		}
+	}
+	return (picks);
 }
 
 time_t CSite::getTLastPickAdded() const {
@@ -744,4 +1061,25 @@ time_t CSite::getTLastPickAdded() const {
 	return (tLastPickAdded);
 }
 
+// ---------------------------------------------------------getMemoryUsage
+size_t CSite::getMemoryUsage() const {
+	size_t bytes = sizeof(CSite) + glassutil::CMemory::stringBytes(sScnl)
+			+ glassutil::CMemory::stringBytes(sSite)
+			+ glassutil::CMemory::stringBytes(sComp)
+			+ glassutil::CMemory::stringBytes(sNet)
+			+ glassutil::CMemory::stringBytes(sLoc);
+
+	// the pick ring
+	vPickMutex.lock();
+	bytes += vPick.capacity() * sizeof(std::shared_ptr<CPick>)
+			+ vPickRecord.capacity() * sizeof(PickSlot);
+	vPickMutex.unlock();
+
+	// the links to nodes
+	vNodeMutex.lock();
+	bytes += vNode.capacity() * sizeof(NodeLink);
+	vNodeMutex.unlock();
+
+	return (bytes);
+}
 }  // namespace glasscore
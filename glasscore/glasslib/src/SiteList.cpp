@@ -12,6 +12,7 @@
 #include "Node.h"
 #include "Web.h"
 #include "Logit.h"
+#include "Memory.h"
 
 namespace glasscore {
 
@@ -61,9 +62,10 @@ void CSiteList::clear() {
 // ---------------------------------------------------------clearSites
 void CSiteList::clearSites() {
 	std::lock_guard<std::mutex> guard(vSiteMutex);
-	// remove all picks from sites
+	// remove all picks from sites, and release their ids
 	for (auto site : vSite) {
 		site->clearVPick();
+		site->setSiteId(-1);
 	}
 
 	// clear the vector and map
@@ -251,8 +253,9 @@ bool CSiteList::addSite(std::shared_ptr<CSite> site) {
 
 	// check if we already had this site
 	if (oldSite) {
-		// update existing site
+		// update existing site, the update carries the existing site's id
 		oldSite->update(site.get());
+		site->setSiteId(oldSite->getSiteId());
 
 		// pass updated site to webs
 		if (pGlass) {
@@ -261,9 +264,12 @@ bool CSiteList::addSite(std::shared_ptr<CSite> site) {
 			}
 		}
 	} else {
-		// add new site to list and map
+		// intern the new site as the next dense id and add it to the list
+		// and index
+		int id = static_cast<int>(vSite.size());
+		site->setSiteId(id);
 		vSite.push_back(site);
-		mSite[site->getScnl()] = site;
+		mSite[site->getScnl()] = id;
 
 		// pass new site to webs
 		if (pGlass) {
@@ -295,6 +301,10 @@ int CSiteList::getSiteCount() {
 // ---------------------------------------------------------getSite
 std::shared_ptr<CSite> CSiteList::getSite(int ix) {
 	std::lock_guard<std::mutex> guard(vSiteMutex);
+	if ((ix < 0) || (ix >= static_cast<int>(vSite.size()))) {
+		return (NULL);
+	}
+
 	// Return shared pointer to site from vector given index
 	return (vSite[ix]);
 }
@@ -309,10 +319,10 @@ std::shared_ptr<CSite> CSiteList::getSite(std::string scnl) {
 
 	std::lock_guard<std::mutex> guard(vSiteMutex);
 
-	// lookup the site in the map by scnl
+	// lookup the site id in the index by scnl
 	auto itsite = mSite.find(scnl);
 	if (itsite != mSite.end()) {
-		return (mSite[scnl]);
+		return (vSite[itsite->second]);
 	}
 
 	// nothing found
@@ -666,4 +676,20 @@ int CSiteList::getHoursBeforeLookingUp() const {
 	return (iHoursBeforeLookingUp);
 }
 
+// ---------------------------------------------------------getMemoryUsage
+size_t CSiteList::getMemoryUsage() const {
+	std::lock_guard<std::mutex> guard(vSiteMutex);
+
+	// the lookup maps are hash tables of scnl to id, count a bucket and a
+	// node per entry
+	size_t bytes = sizeof(CSiteList)
+			+ vSite.capacity() * sizeof(std::shared_ptr<CSite>)
+			+ (mSite.size() + mLookup.size())
+					* (2 * sizeof(void *) + sizeof(std::pair<std::string, int>));
+	for (const auto &site : vSite) {
+		bytes += site->getMemoryUsage();
+	}
+
+	return (bytes);
+}
 }  // namespace glasscore
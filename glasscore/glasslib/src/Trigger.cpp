@@ -4,8 +4,10 @@
 #include <vector>
 #include <mutex>
 #include <algorithm>
+#include <cmath>
 #include "Trigger.h"
 #include "Pick.h"
+#include "Glass.h"
 #include "Logit.h"
 
 namespace glasscore {
@@ -18,8 +20,10 @@ CTrigger::CTrigger() {
 // ---------------------------------------------------------CNode
 CTrigger::CTrigger(double lat, double lon, double z, double ot,
 					double resolution, double sum, int count,
-					std::vector<std::shared_ptr<CPick>> picks, CWeb *web) {
-	if (!initialize(lat, lon, z, ot, resolution, sum, count, picks, web)) {
+					std::vector<std::shared_ptr<CPick>> picks, CWeb *web,
+					std::vector<SiteLink> links) {
+	if (!initialize(lat, lon, z, ot, resolution, sum, count, picks, web,
+					links)) {
 		clear();
 	}
 }
@@ -43,12 +47,13 @@ void CTrigger::clear() {
 	pWeb = NULL;
 
 	vPick.clear();
+	vLink.clear();
 }
 
 bool CTrigger::initialize(double lat, double lon, double z, double ot,
 							double resolution, double sum, int count,
 							std::vector<std::shared_ptr<CPick>> picks,
-							CWeb *web) {
+							CWeb *web, std::vector<SiteLink> links) {
 	clear();
 
 	std::lock_guard<std::recursive_mutex> guard(triggerMutex);
@@ -66,6 +71,11 @@ bool CTrigger::initialize(double lat, double lon, double z, double ot,
 		vPick.push_back(aPick);
 	}
 
+	// the links are only usable if there is one per pick
+	if (links.size() == picks.size()) {
+		vLink = links;
+	}
+
 /*	glassutil::CLogit::log(
 			glassutil::log_level::debug,
 			"CTrigger::initialize: dLat:" + std::to_string(dLat) + "; dLon:"
@@ -122,4 +132,109 @@ const std::vector<std::shared_ptr<CPick> > CTrigger::getVPick() const {
 	return (vPick);
 }
 
+// ---------------------------------------------------------estimateBayes
+double CTrigger::estimateBayes(CGlass *glass, double slack, int *count,
+								double *origin) const {
+	std::lock_guard<std::recursive_mutex> guard(triggerMutex);
+
+	if (count != NULL) {
+		*count = vPick.size();
+	}
+	if (origin != NULL) {
+		*origin = tOrg;
+	}
+
+	// nullcheck
+	if (glass == NULL) {
+		glassutil::CLogit::log(glassutil::log_level::error,
+								"CTrigger::estimateBayes: NULL glass.");
+		return (0);
+	}
+
+	int npick = vPick.size();
+
+	// without the node travel times there is nothing to estimate with,
+	// assume every pick fits
+	if ((npick == 0) || (static_cast<int>(vLink.size()) != npick)) {
+		return (static_cast<double>(npick));
+	}
+
+	// the pick residuals relative to the node origin time for each of the
+	// node's travel times, -1 travel times are not valid
+	std::vector<double> vRes1(npick);
+	std::vector<double> vRes2(npick);
+	std::vector<bool> vValid1(npick);
+	std::vector<bool> vValid2(npick);
+	for (int i = 0; i < npick; i++) {
+		double tObs = vPick[i]->getTPick() - tOrg;
+		vValid1[i] = vLink[i].dTravelTime1 > 0;
+		vValid2[i] = vLink[i].dTravelTime2 > 0;
+		vRes1[i] = tObs - vLink[i].dTravelTime1;
+		vRes2[i] = tObs - vLink[i].dTravelTime2;
+	}
+
+	// the origin time shifts to try, no shift and the shift that fits each
+	// pick exactly, the best shift is among them to within the slack
+	std::vector<double> vShift;
+	vShift.push_back(0);
+	for (int i = 0; i < npick; i++) {
+		if (vValid1[i]) {
+			vShift.push_back(vRes1[i]);
+		}
+		if (vValid2[i]) {
+			vShift.push_back(vRes2[i]);
+		}
+	}
+
+	// the widest sigma CHypo uses for a pick, and the residual beyond which
+	// CHypo::anneal prunes a pick
+	// NOTE: Hard coded to match CHypo::getBayes
+	double sigma = 3.0;
+	double sdAssociate = glass->getSdAssociate();
+
+	double bestSum = -1.0;
+	int bestCount = 0;
+	double bestShift = 0;
+	for (double shift : vShift) {
+		double sum = 0;
+		int fit = 0;
+		for (int i = 0; i < npick; i++) {
+			// the smaller residual after the shift, less the slack
+			double res = -1;
+			if (vValid1[i]) {
+				res = std::fabs(vRes1[i] - shift);
+			}
+			if (vValid2[i]) {
+				double res2 = std::fabs(vRes2[i] - shift);
+				if ((res < 0) || (res2 < res)) {
+					res = res2;
+				}
+			}
+			// a pick without a travel time may get one once the hypo
+			// moves, so it fits
+			res = std::max(res - slack, 0.0);
+
+			if (res <= sdAssociate) {
+				fit++;
+			}
+			sum += glass->sig(res, sigma);
+		}
+
+		if (sum > bestSum) {
+			bestSum = sum;
+			bestCount = fit;
+			bestShift = shift;
+		}
+	}
+
+	if (count != NULL) {
+		*count = bestCount;
+	}
+	if (origin != NULL) {
+		*origin = tOrg + bestShift;
+	}
+
+	return (bestSum);
+}
+
 }  // namespace glasscore
@@ -23,6 +23,7 @@
 #include "SiteList.h"
 #include "Site.h"
 #include "Logit.h"
+#include "Memory.h"
 #include "Pid.h"
 
 #define _USE_MATH_DEFINES
@@ -54,6 +55,9 @@ CWeb::CWeb(int numThreads, int sleepTime, int checkInterval) {
 	m_iSleepTimeMS = sleepTime;
 	m_iStatusCheckInterval = checkInterval;
 	std::time(&tLastStatusCheck);
+	pExecutor = NULL;
+	m_bJobScheduled = false;
+	m_iJobGeneration = 0;
 
 	clear();
 
@@ -94,6 +98,9 @@ CWeb::CWeb(std::string name, double thresh, int numDetect, int numNucleate,
 	m_iSleepTimeMS = sleepTime;
 	m_iStatusCheckInterval = checkInterval;
 	std::time(&tLastStatusCheck);
+	pExecutor = NULL;
+	m_bJobScheduled = false;
+	m_iJobGeneration = 0;
 
 	clear();
 
@@ -190,6 +197,16 @@ void CWeb::clear() {
 
 	pTrv1 = NULL;
 	pTrv2 = NULL;
+
+	// drop any jobs that haven't run, since they hold references to this
+	// web, releasing them when this function returns.  Any task already
+	// scheduled belongs to the old generation and will do nothing
+	std::queue<std::function<void()>> jobs;
+	m_QueueMutex.lock();
+	std::swap(jobs, m_JobQueue);
+	m_bJobScheduled = false;
+	m_iJobGeneration++;
+	m_QueueMutex.unlock();
 }
 
 // ---------------------------------------------------------Initialize
@@ -1399,22 +1416,13 @@ bool CWeb::genSiteList() {
 // ---------------------------------------------------------sortSite
 void CWeb::sortSiteList(double lat, double lon) {
 	// set to provided geographic location
-	glassutil::CGeo geo;
-
 	// NOTE: node depth is ignored here
-	geo.setGeographic(lat, lon, 6371.0);
+	glassutil::CGeoPoint point;
+	point.setGeographic(lat, lon);
 
 	// set the distance to each site
-	for (int i = 0; i < vSite.size(); i++) {
-		// get the site
-		auto p = vSite[i];
-		std::shared_ptr<CSite> site = p.second;
-
-		// compute the distance
-		p.first = site->getDelta(&geo);
-
-		// set the distance in the vector
-		vSite[i] = p;
+	for (auto &p : vSite) {
+		p.first = point.delta(p.second->getGeoPoint());
 	}
 
 	// sort sites
@@ -1521,13 +1529,20 @@ std::shared_ptr<CNode> CWeb::genNodeSites(std::shared_ptr<CNode> node) {
 
 		// compute traveltimes between site and node
 		double travelTime1 = -1;
+		double slowness1 = -1;
 		if (pTrv1 != NULL) {
 			travelTime1 = pTrv1->T(delta);
+			if (travelTime1 > 0) {
+				pTrv1->T(delta, &slowness1, NULL);
+			}
 		}
-
 		double travelTime2 = -1;
+		double slowness2 = -1;
 		if (pTrv2 != NULL) {
 			travelTime2 = pTrv2->T(delta);
+			if (travelTime2 > 0) {
+				pTrv2->T(delta, &slowness2, NULL);
+			}
 		}
 
 		// skip site if there are no valid times
@@ -1536,7 +1551,8 @@ std::shared_ptr<CNode> CWeb::genNodeSites(std::shared_ptr<CNode> node) {
 		}
 
 		// Link node to site using traveltimes
-		node->linkSite(site, node, travelTime1, travelTime2);
+		node->linkSite(site, node, travelTime1, travelTime2, slowness1,
+						slowness2);
 	}
 
 	// sort the site links
@@ -1600,7 +1616,7 @@ void CWeb::addSite(std::shared_ptr<CSite> site) {
 		}
 
 		// check to see if we have this site
-		std::shared_ptr<CSite> foundSite = node->getSite(site->getScnl());
+		CSite *foundSite = node->getSite(site.get());
 
 		// update?
 		if (foundSite != NULL) {
@@ -1612,19 +1628,20 @@ void CWeb::addSite(std::shared_ptr<CSite> site) {
 
 		// set to node geographic location
 		// NOTE: node depth is ignored here
-		glassutil::CGeo geo;
-		geo.setGeographic(node->getLat(), node->getLon(), 6371.0);
+		glassutil::CGeoPoint point;
+		point.setGeographic(node->getLat(), node->getLon());
 
 		// compute delta distance between site and node
-		double newDistance = RAD2DEG * site->getGeo().delta(&geo);
+		double newDistance = RAD2DEG * point.delta(site->getGeoPoint());
 
 		// get site in node list
 		// NOTE: this assumes that the node site list is sorted
 		// on distance
-		std::shared_ptr<CSite> furthestSite = node->getLastSite();
+		CSite *furthestSite = node->getLastSite();
 
 		// compute distance to farthest site
-		double maxDistance = RAD2DEG * geo.delta(&furthestSite->getGeo());
+		double maxDistance = RAD2DEG
+				* point.delta(furthestSite->getGeoPoint());
 
 		// Ignore if new site is farther than last linked site
 		if ((node->getSiteLinksCount() >= nDetect)
@@ -1643,18 +1660,27 @@ void CWeb::addSite(std::shared_ptr<CSite> site) {
 
 		// compute traveltimes between site and node
 		double travelTime1 = -1;
+		double slowness1 = -1;
 		if (pTrv1 != NULL) {
 			travelTime1 = pTrv1->T(newDistance);
+			if (travelTime1 > 0) {
+				pTrv1->T(newDistance, &slowness1, NULL);
+			}
 		}
 		double travelTime2 = -1;
+		double slowness2 = -1;
 		if (pTrv2 != NULL) {
 			travelTime2 = pTrv2->T(newDistance);
+			if (travelTime2 > 0) {
+				pTrv2->T(newDistance, &slowness2, NULL);
+			}
 		}
 
 		// check to see if we're at the limit
 		if (node->getSiteLinksCount() < nDetect) {
 			// Link node to site using traveltimes
-			node->linkSite(site, node, travelTime1, travelTime2);
+			node->linkSite(site, node, travelTime1, travelTime2, slowness1,
+						slowness2);
 
 		} else {
 			// remove last site
@@ -1663,7 +1689,8 @@ void CWeb::addSite(std::shared_ptr<CSite> site) {
 			node->unlinkLastSite();
 
 			// Link node to site using traveltimes
-			node->linkSite(site, node, travelTime1, travelTime2);
+			node->linkSite(site, node, travelTime1, travelTime2, slowness1,
+						slowness2);
 		}
 
 		// resort site links
@@ -1731,7 +1758,7 @@ void CWeb::remSite(std::shared_ptr<CSite> site) {
 		CWeb::setStatus(true);
 
 		// search through each site linked to this node, see if we have it
-		std::shared_ptr<CSite> foundSite = node->getSite(site->getScnl());
+		CSite *foundSite = node->getSite(site.get());
 
 		// don't bother if this node doesn't have this site
 		if (foundSite == NULL) {
@@ -1781,17 +1808,25 @@ void CWeb::remSite(std::shared_ptr<CSite> site) {
 
 			// compute traveltimes between site and node
 			double travelTime1 = -1;
+			double slowness1 = -1;
 			if (pTrv1 != NULL) {
 				travelTime1 = pTrv1->T(newDistance);
+				if (travelTime1 > 0) {
+					pTrv1->T(newDistance, &slowness1, NULL);
+				}
 			}
 			double travelTime2 = -1;
+			double slowness2 = -1;
 			if (pTrv2 != NULL) {
 				travelTime2 = pTrv2->T(newDistance);
+				if (travelTime2 > 0) {
+					pTrv2->T(newDistance, &slowness2, NULL);
+				}
 			}
 
 			// Link node to new site using traveltimes
-			if (node->linkSite(newSite, node, travelTime1, travelTime2)
-					== false) {
+			if (node->linkSite(newSite, node, travelTime1, travelTime2,
+								slowness1, slowness2) == false) {
 				glassutil::CLogit::log(
 						glassutil::log_level::error,
 						"CWeb::remSite: Failed to add station "
@@ -1832,6 +1867,18 @@ void CWeb::remSite(std::shared_ptr<CSite> site) {
 
 // ---------------------------------------------------------addJob
 void CWeb::addJob(std::function<void()> newjob) {
+	if (pExecutor) {
+		std::lock_guard<std::mutex> guard(m_QueueMutex);
+		m_JobQueue.push(newjob);
+
+		// a single task at a time runs the jobs, keeping them in order
+		if (m_bJobScheduled == false) {
+			scheduleJob();
+		}
+
+		return;
+	}
+
 	if (m_iNumThreads == 0) {
 		// no background thread, just run the job
 		try {
@@ -1851,6 +1898,61 @@ void CWeb::addJob(std::function<void()> newjob) {
 	m_JobQueue.push(newjob);
 }
 
+// ---------------------------------------------------------scheduleJob
+void CWeb::scheduleJob() {
+	std::weak_ptr<CWeb> weakWeb = shared_from_this();
+	unsigned int generation = m_iJobGeneration;
+
+	m_bJobScheduled = pExecutor->submit(task_class::maintenance,
+										[weakWeb, generation]() {
+		// the web may have been removed while this task was queued
+		std::shared_ptr<CWeb> web = weakWeb.lock();
+		if (web) {
+			web->runJob(generation);
+		}
+	});
+}
+
+// ---------------------------------------------------------runJob
+void CWeb::runJob(unsigned int generation) {
+	// get the next job
+	m_QueueMutex.lock();
+	if (generation != m_iJobGeneration) {
+		// the jobs were cleared after this task was scheduled
+		m_QueueMutex.unlock();
+		return;
+	}
+	if (m_JobQueue.empty() == true) {
+		m_bJobScheduled = false;
+		m_QueueMutex.unlock();
+		return;
+	}
+	std::function<void()> newjob = m_JobQueue.front();
+	m_JobQueue.pop();
+	m_QueueMutex.unlock();
+
+	// run the job
+	try {
+		newjob();
+	} catch (const std::exception &e) {
+		glassutil::CLogit::log(
+				glassutil::log_level::error,
+				"CWeb::runJob: Exception during job(): "
+						+ std::string(e.what()));
+	}
+
+	// schedule the next job only now, so jobs never overlap
+	std::lock_guard<std::mutex> guard(m_QueueMutex);
+	if (generation != m_iJobGeneration) {
+		return;
+	}
+	if (m_JobQueue.empty() == true) {
+		m_bJobScheduled = false;
+	} else {
+		scheduleJob();
+	}
+}
+
 // ---------------------------------------------------------workLoop
 void CWeb::workLoop() {
 	glassutil::CLogit::log(glassutil::log_level::debug,
@@ -1995,7 +2097,7 @@ bool CWeb::hasSite(std::shared_ptr<CSite> site) {
 	// for each node in web
 	for (auto &node : vNode) {
 		// check to see if we have this site
-		if (node->getSite(site->getScnl()) != NULL) {
+		if (node->getSite(site.get()) != NULL) {
 			return (true);
 		}
 	}
@@ -2018,6 +2120,11 @@ void CWeb::setSiteList(CSiteList* siteList) {
 	pSiteList = siteList;
 }
 
+void CWeb::setExecutor(glassutil::CExecutor* executor) {
+	std::lock_guard<std::mutex> guard(m_QueueMutex);
+	pExecutor = executor;
+}
+
 CGlass* CWeb::getGlass() const {
 	std::lock_guard<std::recursive_mutex> webGuard(m_WebMutex);
 	return (pGlass);
@@ -2093,5 +2200,43 @@ int CWeb::getVNodeSize() const {
 	std::lock_guard<std::mutex> vNodeGuard(m_vNodeMutex);
 	return (vNode.size());
 }
+
+// ---------------------------------------------------------getMemoryUsage
+size_t CWeb::getMemoryUsage() {
+	size_t bytes = sizeof(CWeb);
+
+	m_vNodeMutex.lock();
+	bytes += vNode.capacity() * sizeof(std::shared_ptr<CNode>);
+	for (const auto &node : vNode) {
+		bytes += node->getMemoryUsage();
+
+		// the sites' links back to this node
+		bytes += node->getSiteLinksCount() * sizeof(NodeLink);
+	}
+	m_vNodeMutex.unlock();
+
+	vSiteMutex.lock();
+	bytes += vSite.capacity()
+			* sizeof(std::pair<double, std::shared_ptr<CSite>>);
+	vSiteMutex.unlock();
+
+	for (const auto &filter : vNetFilter) {
+		bytes += sizeof(std::string) + glassutil::CMemory::stringBytes(filter);
+	}
+	for (const auto &filter : vSitesFilter) {
+		bytes += sizeof(std::string) + glassutil::CMemory::stringBytes(filter);
+	}
+
+	m_TrvMutex.lock();
+	if (pTrv1 != NULL) {
+		bytes += pTrv1->getMemoryUsage();
+	}
+	if (pTrv2 != NULL) {
+		bytes += pTrv2->getMemoryUsage();
+	}
+	m_TrvMutex.unlock();
+
+	return (bytes);
+}
 }  // namespace glasscore
 
@@ -9,12 +9,14 @@
 #include "Site.h"
 #include "Pick.h"
 #include "Logit.h"
+#include "Memory.h"
 
 namespace glasscore {
 
 // ---------------------------------------------------------CWebList
 CWebList::CWebList(int numThreads) {
 	m_iNumThreads = numThreads;
+	pExecutor = NULL;
 	clear();
 }
 
@@ -108,12 +110,27 @@ bool CWebList::addWeb(std::shared_ptr<json::Object> com) {
 	if (pSiteList != NULL) {
 		web->setSiteList(pSiteList);
 	}
+	if (pExecutor != NULL) {
+		web->setExecutor(pExecutor);
+	}
 
 	// send the config to web so that it can generate itself
 	if (web->dispatch(com)) {
 		// add the web to the list if it was successfully created
 		vWeb.push_back(web);
 
+		// log what the webs built so far cost, for capacity planning
+		glassutil::CLogit::log(
+				glassutil::log_level::info,
+				"CWebList::addWeb: Added web " + name + " with "
+						+ std::to_string(web->getVNodeSize()) + " nodes using "
+						+ glassutil::CMemory::toString(web->getMemoryUsage()));
+		if (pGlass != NULL) {
+			glassutil::CLogit::log(
+					glassutil::log_level::info,
+					"CWebList::addWeb: Memory usage " + pGlass->getMemoryReport());
+		}
+
 		return (true);
 	}
 
@@ -282,8 +299,30 @@ void CWebList::setGlass(CGlass* glass) {
 	pGlass = glass;
 }
 
+void CWebList::setExecutor(glassutil::CExecutor* executor) {
+	std::lock_guard<std::recursive_mutex> webListGuard(m_WebListMutex);
+	pExecutor = executor;
+
+	for (auto &web : vWeb) {
+		web->setExecutor(pExecutor);
+	}
+}
+
 int CWebList::getVWebSize() const {
 	std::lock_guard<std::recursive_mutex> webListGuard(m_WebListMutex);
 	return(vWeb.size());
 }
+
+// ---------------------------------------------------------getMemoryUsage
+size_t CWebList::getMemoryUsage() const {
+	std::lock_guard<std::recursive_mutex> webListGuard(m_WebListMutex);
+
+	size_t bytes = sizeof(CWebList)
+			+ vWeb.capacity() * sizeof(std::shared_ptr<CWeb>);
+	for (const auto &web : vWeb) {
+		bytes += web->getMemoryUsage();
+	}
+
+	return (bytes);
+}
 }  // namespace glasscore
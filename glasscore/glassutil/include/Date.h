@@ -9,6 +9,12 @@
 
 #include <string>
 
+// the length of the fixed format ISO8601 date string
+#define ISO8601LENGTH 24
+
+// the length of the fixed format date time string
+#define DATETIMELENGTH 18
+
 namespace glassutil {
 
 /**
@@ -20,6 +26,10 @@ namespace glassutil {
  * and internal (epoch time, ISO8601, etc.) storing date
  * internally as a double containing julian seconds.
  *
+ * The static parse and format functions are a fixed format codec for the
+ * ISO8601 and date time strings, working on caller provided buffers with
+ * cached day numbers, for use in the hot paths where a CDate object and
+ * its std::strings aren't needed.
  */
 class CDate {
  public:
@@ -259,6 +269,54 @@ class CDate {
 	 */
 	static std::string encodeISO8601Time(double t);
 
+	/**
+	 * \brief Parse an ISO8601 date string into julian seconds
+	 *
+	 * Parse the fixed format ISO8601 date string 'YYYY-MM-DDTHH:MM:SS.SSSZ'
+	 * without allocating.
+	 * \param iso8601 - A pointer to the characters of the date string, which
+	 * need not be NUL terminated
+	 * \param length - The number of characters in the date string
+	 * \return Returns a double containing the julian seconds, or 0 if the
+	 * string isn't a valid ISO8601 date string
+	 */
+	static double parseISO8601(const char *iso8601, int length);
+
+	/**
+	 * \brief Parse a date time string into julian seconds
+	 *
+	 * Parse the fixed format date time string 'yyyymmddhhmmss.sss' or
+	 * 'yyyymmddhhmmss.ss' without allocating.
+	 * \param datetime - A pointer to the characters of the date string, which
+	 * need not be NUL terminated
+	 * \param length - The number of characters in the date string
+	 * \return Returns a double containing the julian seconds, or 0 if the
+	 * string isn't a valid date time string
+	 */
+	static double parseDateTime(const char *datetime, int length);
+
+	/**
+	 * \brief Format julian seconds as an ISO8601 date string
+	 *
+	 * Format the julian seconds as 'YYYY-MM-DDTHH:MM:SS.SSSZ', rounded to the
+	 * millisecond, without allocating.
+	 * \param t - The julian seconds to format
+	 * \param buffer - A pointer to a buffer of at least ISO8601LENGTH + 1
+	 * characters to hold the NUL terminated date string
+	 */
+	static void formatISO8601(double t, char *buffer);
+
+	/**
+	 * \brief Format julian seconds as a date time string
+	 *
+	 * Format the julian seconds as 'yyyymmddhhmmss.sss', rounded to the
+	 * millisecond, without allocating.
+	 * \param t - The julian seconds to format
+	 * \param buffer - A pointer to a buffer of at least DATETIMELENGTH + 1
+	 * characters to hold the NUL terminated date string
+	 */
+	static void formatDateTime(double t, char *buffer);
+
  protected:
 	/**
 	 * \brief An unsigned integer variable containing the gregorian year.
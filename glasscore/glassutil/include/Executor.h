@@ -0,0 +1,327 @@
+/*****************************************
+ * This file is documented for Doxygen.
+ * If you modify this file please update
+ * the comments so that Doxygen will still
+ * be able to work.
+ ****************************************/
+#ifndef EXECUTOR_H
+#define EXECUTOR_H
+
+#include <atomic>
+#include <condition_variable>
+#include <ctime>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace glassutil {
+
+/**
+ * \brief glassutil work stealing executor class
+ *
+ * The CExecutor class is a single pool of worker threads shared by several
+ * classes of work, so that the threads go to whichever class has work
+ * queued instead of each class being limited to a fixed set of threads of
+ * its own.
+ *
+ * The classes of work are given when the executor is constructed, each with
+ * a priority and a cap on how many of its tasks may run at once. An idle
+ * worker runs the oldest queued task of the highest priority class that is
+ * below its cap, taking it from its own queue when it has one and stealing
+ * it from another worker's queue when it doesn't. Tasks submitted from a
+ * worker are queued on that worker, and all other tasks are spread across
+ * the workers in turn.
+ *
+ * Tasks of the same class may run in any order and at the same time, so a
+ * client that needs its tasks run one at a time and in order should queue
+ * them itself and submit a task to run the next one.
+ *
+ * CExecutor tracks whether each worker is still responsive in the same way
+ * as the glasscore lists that run their own threads, see statusCheck().
+ */
+class CExecutor {
+ public:
+	/**
+	 * \brief A class of work run by the executor
+	 */
+	struct TaskClass {
+		/**
+		 * \brief The name of the class, used for logging
+		 */
+		std::string sName;
+
+		/**
+		 * \brief The priority of the class, queued tasks of higher priority
+		 * classes are run first
+		 */
+		int iPriority;
+
+		/**
+		 * \brief The largest number of tasks of the class allowed to run at
+		 * once, a cap less than 1 does not limit the class
+		 */
+		int iMaxConcurrent;
+	};
+
+	/**
+	 * \brief CExecutor constructor
+	 *
+	 * Starts the worker threads.
+	 *
+	 * \param taskClasses - A std::vector of the classes of work, the class
+	 * of a task is its index in this vector
+	 * \param numThreads - An integer containing the number of worker threads
+	 * \param sleepTime - An integer containing the longest time in
+	 * milliseconds an idle worker waits before looking for work again
+	 * \param checkInterval - An integer containing the interval in seconds
+	 * after which an unresponsive worker is considered dead, a negative
+	 * interval disables status checks
+	 */
+	CExecutor(const std::vector<TaskClass> &taskClasses, int numThreads,
+				int sleepTime = 50, int checkInterval = 60);
+
+	/**
+	 * \brief CExecutor destructor
+	 *
+	 * Stops the worker threads, see stop().
+	 */
+	~CExecutor();
+
+	/**
+	 * \brief Queue a task
+	 *
+	 * \param taskClass - An integer containing the class of the task
+	 * \param task - The task to run
+	 * \return Returns true if the task was queued, false if the class is
+	 * not valid or the executor has been stopped
+	 */
+	bool submit(int taskClass, std::function<void()> task);
+
+	/**
+	 * \brief Stop the executor
+	 *
+	 * Waits for the running tasks to finish and the worker threads to exit,
+	 * and discards any tasks that are still queued.  Must not be called from
+	 * a task.
+	 */
+	void stop();
+
+	/**
+	 * \brief Get the number of queued tasks of a class
+	 *
+	 * \param taskClass - An integer containing the class
+	 * \return Returns the number of tasks of the class waiting to run, or 0
+	 * if the class is not valid
+	 */
+	int getQueueSize(int taskClass) const;
+
+	/**
+	 * \brief Get the number of running tasks of a class
+	 *
+	 * \param taskClass - An integer containing the class
+	 * \return Returns the number of tasks of the class that are running, or
+	 * 0 if the class is not valid
+	 */
+	int getRunningCount(int taskClass) const;
+
+	/**
+	 * \brief Get the largest number of tasks of a class allowed to run
+	 *
+	 * \param taskClass - An integer containing the class
+	 * \return Returns the cap on the number of running tasks of the class,
+	 * which is never more than the number of worker threads, or 0 if the
+	 * class is not valid
+	 */
+	int getMaxConcurrent(int taskClass) const;
+
+	/**
+	 * \brief Get the number of worker threads
+	 *
+	 * \return Returns the number of worker threads
+	 */
+	int getNumThreads() const;
+
+	/**
+	 * \brief check to see if each worker is still functional
+	 *
+	 * Checks each worker to see if it is still responsive.
+	 *
+	 * \return Returns true if every worker responded within the check
+	 * interval, false otherwise
+	 */
+	bool statusCheck();
+
+ private:
+	/**
+	 * \brief The state of a class of work
+	 */
+	struct ClassState {
+		/**
+		 * \brief The class definition
+		 */
+		TaskClass definition;
+
+		/**
+		 * \brief The number of tasks of the class waiting to run
+		 */
+		std::atomic<int> iQueued;
+
+		/**
+		 * \brief The number of tasks of the class that are running
+		 */
+		std::atomic<int> iRunning;
+	};
+
+	/**
+	 * \brief The queues of a worker
+	 */
+	struct WorkerQueue {
+		/**
+		 * \brief A std::vector of the worker's queued tasks, one std::deque
+		 * per class, oldest first
+		 */
+		std::vector<std::deque<std::function<void()>>> vTasks;
+
+		/**
+		 * \brief A mutex to control access to vTasks
+		 */
+		std::mutex queueMutex;
+	};
+
+	/**
+	 * \brief Worker thread loop
+	 *
+	 * \param index - An integer containing the index of the worker
+	 */
+	void workLoop(int index);
+
+	/**
+	 * \brief Run the next task for a worker
+	 *
+	 * \param index - An integer containing the index of the worker
+	 * \return Returns true if a task was run, false if there was nothing
+	 * the worker could run
+	 */
+	bool runNext(int index);
+
+	/**
+	 * \brief Take the oldest task of a class from a worker's queue
+	 *
+	 * \param index - An integer containing the index of the worker
+	 * \param taskClass - An integer containing the class
+	 * \param task - A pointer to the task to fill in
+	 * \return Returns true if a task was taken, false if the worker had no
+	 * tasks of the class queued
+	 */
+	bool take(int index, int taskClass, std::function<void()> *task);
+
+	/**
+	 * \brief Wake an idle worker
+	 *
+	 * \param all - A boolean flag indicating whether to wake every idle
+	 * worker instead of one
+	 */
+	void signal(bool all);
+
+	/**
+	 * \brief thread status update function
+	 *
+	 * Updates the status for the current thread
+	 * \param status - A boolean flag containing the status to set
+	 */
+	void setStatus(bool status);
+
+	/**
+	 * \brief A std::vector of the class states, indexed by class
+	 */
+	std::vector<std::unique_ptr<ClassState>> vClass;
+
+	/**
+	 * \brief A std::vector of the classes, highest priority first
+	 */
+	std::vector<int> vClassOrder;
+
+	/**
+	 * \brief A std::vector of the worker queues, indexed by worker
+	 */
+	std::vector<std::unique_ptr<WorkerQueue>> vWorker;
+
+	/**
+	 * \brief the std::vector of std::threads
+	 */
+	std::vector<std::thread> vProcessThreads;
+
+	/**
+	 * \brief An integer containing the number of worker threads
+	 */
+	int m_iNumThreads;
+
+	/**
+	 * \brief The worker the next task submitted from outside the executor is
+	 * queued on
+	 */
+	std::atomic<unsigned int> m_iNextWorker;
+
+	/**
+	 * \brief A counter bumped whenever there may be new work for an idle
+	 * worker, so that a worker doesn't wait after missing a wakeup
+	 */
+	std::atomic<unsigned int> m_iSignal;
+
+	/**
+	 * \brief the std::mutex for m_WakeCondition, held while m_iSignal is
+	 * bumped
+	 */
+	std::mutex m_WakeMutex;
+
+	/**
+	 * \brief the condition idle workers wait on
+	 */
+	std::condition_variable m_WakeCondition;
+
+	/**
+	 * \brief A std::map containing the status of each thread
+	 */
+	std::map<std::thread::id, bool> m_ThreadStatusMap;
+
+	/**
+	 * \brief An integer containing the longest time in milliseconds an idle
+	 * worker waits before looking for work again
+	 */
+	int m_iSleepTimeMS;
+
+	/**
+	 * \brief the std::mutex for m_ThreadStatusMap
+	 */
+	std::mutex m_StatusMutex;
+
+	/**
+	 * \brief the integer interval in seconds after which the work thread
+	 * will be considered dead. A negative check interval disables thread
+	 * status checks
+	 */
+	int m_iStatusCheckInterval;
+
+	/**
+	 * \brief the time_t holding the last time the thread status was checked
+	 */
+	time_t tLastStatusCheck;
+
+	/**
+	 * \brief the boolean flag indicating that the worker threads should keep
+	 * running
+	 */
+	std::atomic<bool> m_bRunProcessLoop;
+
+	/**
+	 * \brief the std::mutex serializing stop()
+	 */
+	std::mutex m_StopMutex;
+};
+}  // namespace glassutil
+#endif  // EXECUTOR_H
@@ -0,0 +1,213 @@
+/*****************************************
+ * This file is documented for Doxygen.
+ * If you modify this file please update
+ * the comments so that Doxygen will still
+ * be able to work.
+ ****************************************/
+#ifndef GEOPOINT_H
+#define GEOPOINT_H
+
+#include <cmath>
+#include <vector>
+
+#include "Geo.h"
+
+namespace glassutil {
+
+/**
+ * \brief glassutil precomputed geographic point class
+ *
+ * The glassutil CGeoPoint class is a lightweight, non-virtual companion to
+ * CGeo intended for the distance and azimuth computations in the
+ * association hot paths. It stores the geocentric unit vector along with
+ * the sines and cosines of the geocentric latitude and longitude, so that
+ * once a point is set, delta() needs only a dot product and an acos, and
+ * azimuth() only a few multiplies and an atan2, with no other trig.
+ *
+ * CGeoPoint is a plain value type, and is cheap to copy and to store
+ * contiguously. The results match CGeo::delta() and CGeo::azimuth() to
+ * rounding.
+ */
+class CGeoPoint {
+ public:
+	/**
+	 * \brief CGeoPoint constructor
+	 *
+	 * The constructor for the CGeoPoint class, initializes the point to
+	 * latitude 0, longitude 0.
+	 */
+	CGeoPoint() {
+		setGeocentric(0.0, 0.0);
+	}
+
+	/**
+	 * \brief CGeoPoint CGeo constructor
+	 *
+	 * Constructs a CGeoPoint from the geocentric location of a CGeo
+	 *
+	 * \param geo - The CGeo to construct from
+	 */
+	explicit CGeoPoint(const CGeo &geo) {
+		setGeocentric(geo.dLat, geo.dLon);
+	}
+
+	/**
+	 * \brief Set point from geographic coordinates
+	 *
+	 * Sets the point from geographic coordinates, converting the latitude
+	 * to geocentric the same way CGeo::setGeographic() does.
+	 *
+	 * \param lat - The geographic latitude in degrees
+	 * \param lon - The geographic longitude in degrees
+	 */
+	void setGeographic(double lat, double lon) {
+		setGeocentric(RAD2DEG * atan(0.993277 * tan(DEG2RAD * lat)), lon);
+	}
+
+	/**
+	 * \brief Set point from geocentric coordinates
+	 *
+	 * \param lat - The geocentric latitude in degrees
+	 * \param lon - The geocentric longitude in degrees
+	 */
+	void setGeocentric(double lat, double lon) {
+		dSinLat = sin(DEG2RAD * lat);
+		dCosLat = cos(DEG2RAD * lat);
+		dSinLon = sin(DEG2RAD * lon);
+		dCosLon = cos(DEG2RAD * lon);
+
+		uX = dCosLat * dCosLon;
+		uY = dCosLat * dSinLon;
+		uZ = dSinLat;
+	}
+
+	/**
+	 * \brief Calculate distance to a point
+	 *
+	 * \param point - The CGeoPoint to calculate the distance to
+	 * \return Returns the great circle distance in radians
+	 */
+	double delta(const CGeoPoint &point) const {
+		double dot = uX * point.uX + uY * point.uY + uZ * point.uZ;
+
+		if (dot >= 1.0) {
+			return (0.0);
+		}
+		if (dot <= -1.0) {
+			return (PI);
+		}
+		return (acos(dot));
+	}
+
+	/**
+	 * \brief Calculate azimuth to a point
+	 *
+	 * Calculates the azimuth from this point to the given point by
+	 * projecting the given point's unit vector onto this point's north and
+	 * east tangent vectors.
+	 *
+	 * \param point - The CGeoPoint to calculate the azimuth to
+	 * \return Returns the azimuth in radians, from 0 to 2 pi, clockwise from
+	 * north
+	 */
+	double azimuth(const CGeoPoint &point) const {
+		// north tangent vector dot point
+		double n = -dSinLat * (dCosLon * point.uX + dSinLon * point.uY)
+				+ dCosLat * point.uZ;
+
+		// east tangent vector dot point
+		double e = -dSinLon * point.uX + dCosLon * point.uY;
+
+		double azm = atan2(e, n);
+		if (azm < 0.0) {
+			azm += TWOPI;
+		}
+		return (azm);
+	}
+
+	/**
+	 * \brief Calculate distances to a set of points
+	 *
+	 * \param points - A std::vector of the CGeoPoints to calculate the
+	 * distances to
+	 * \param deltas - A pointer to a std::vector to hold the great circle
+	 * distances in radians, resized to match points
+	 */
+	void deltas(const std::vector<CGeoPoint> &points,
+				std::vector<double> *deltas) const {
+		int count = static_cast<int>(points.size());
+		deltas->resize(count);
+
+		// dot products first so that the loop vectorizes, then the acos
+		double *out = deltas->data();
+		const CGeoPoint *p = points.data();
+		for (int i = 0; i < count; i++) {
+			out[i] = uX * p[i].uX + uY * p[i].uY + uZ * p[i].uZ;
+		}
+		for (int i = 0; i < count; i++) {
+			if (out[i] >= 1.0) {
+				out[i] = 0.0;
+			} else if (out[i] <= -1.0) {
+				out[i] = PI;
+			} else {
+				out[i] = acos(out[i]);
+			}
+		}
+	}
+
+	/**
+	 * \brief Calculate azimuths to a set of points
+	 *
+	 * \param points - A std::vector of the CGeoPoints to calculate the
+	 * azimuths to
+	 * \param azimuths - A pointer to a std::vector to hold the azimuths in
+	 * radians, resized to match points
+	 */
+	void azimuths(const std::vector<CGeoPoint> &points,
+					std::vector<double> *azimuths) const {
+		int count = static_cast<int>(points.size());
+		azimuths->resize(count);
+
+		double *out = azimuths->data();
+		for (int i = 0; i < count; i++) {
+			out[i] = azimuth(points[i]);
+		}
+	}
+
+	/**
+	 * \brief The x component of the geocentric unit vector
+	 */
+	double uX;
+
+	/**
+	 * \brief The y component of the geocentric unit vector
+	 */
+	double uY;
+
+	/**
+	 * \brief The z component of the geocentric unit vector
+	 */
+	double uZ;
+
+	/**
+	 * \brief The sine of the geocentric latitude
+	 */
+	double dSinLat;
+
+	/**
+	 * \brief The cosine of the geocentric latitude
+	 */
+	double dCosLat;
+
+	/**
+	 * \brief The sine of the longitude
+	 */
+	double dSinLon;
+
+	/**
+	 * \brief The cosine of the longitude
+	 */
+	double dCosLon;
+};
+}  // namespace glassutil
+#endif  // GEOPOINT_H
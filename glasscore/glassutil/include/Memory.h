@@ -0,0 +1,112 @@
+/*****************************************
+ * This file is documented for Doxygen.
+ * If you modify this file please update
+ * the comments so that Doxygen will still
+ * be able to work.
+ ****************************************/
+#ifndef MEMORY_H
+#define MEMORY_H
+
+#include <json.h>
+#include <cstddef>
+#include <functional>
+#include <string>
+
+namespace glassutil {
+
+/**
+ * \brief glassutil memory estimation class
+ *
+ * The CMemory class provides the size estimators used by the glasscore
+ * classes to report approximately how many bytes they use. The estimates
+ * count the objects themselves, the capacity of their containers, and the
+ * heap storage of their strings, but not allocator overhead, so they are a
+ * lower bound suitable for capacity planning rather than an exact count.
+ *
+ * The estimators are defined here in the header so that libraries outside
+ * of glasscore, such as the util cache, can share them without linking
+ * glasscore.
+ */
+class CMemory {
+ public:
+	/**
+	 * \brief Estimate the heap storage of a string
+	 *
+	 * \param str - The std::string to estimate
+	 * \return Returns the number of bytes the string stores outside of
+	 * itself, zero for strings short enough to be stored inline
+	 */
+	static size_t stringBytes(const std::string &str) {
+		// a short string keeps its characters in a buffer inside the
+		// string object, so its data points into the object itself
+		const char *data = str.data();
+		const char *self = reinterpret_cast<const char *>(&str);
+		if ((std::less_equal<const char *>()(self, data))
+				&& (std::less<const char *>()(data,
+												self + sizeof(std::string)))) {
+			return (0);
+		}
+
+		return (str.capacity() + 1);
+	}
+
+	/**
+	 * \brief Estimate the overhead of a std::map or std::set node
+	 *
+	 * \return Returns the number of bytes each node in a tree based container
+	 * uses in addition to its value
+	 */
+	static size_t mapNodeBytes() {
+		// color, parent, left and right
+		return (4 * sizeof(void *));
+	}
+
+	/**
+	 * \brief Estimate the size of a json object
+	 *
+	 * Estimates the size of a json object from its top level values and the
+	 * number of values in any nested objects and arrays, without copying
+	 * the object.
+	 *
+	 * \param object - The json::Object to estimate
+	 * \return Returns the estimated number of bytes used by the object
+	 */
+	static size_t jsonBytes(const json::Object &object) {
+		size_t entryBytes = mapNodeBytes() + sizeof(std::string)
+				+ sizeof(json::Value);
+		size_t bytes = sizeof(json::Object);
+
+		for (const auto &entry : object) {
+			const json::Value &value = entry.second;
+			bytes += entryBytes + stringBytes(entry.first);
+
+			if (value.GetType() == json::ValueType::StringVal) {
+				bytes += stringBytes(value.ToString());
+			} else if (value.GetType() == json::ValueType::ObjectVal) {
+				// nested objects can only be walked by copying them, so
+				// just count their values
+				bytes += value.size() * entryBytes;
+			} else if (value.GetType() == json::ValueType::ArrayVal) {
+				bytes += value.size() * sizeof(json::Value);
+				for (size_t i = 0; i < value.size(); i++) {
+					if (value[i].GetType() == json::ValueType::ObjectVal) {
+						bytes += value[i].size() * entryBytes;
+					}
+				}
+			}
+		}
+
+		return (bytes);
+	}
+
+	/**
+	 * \brief Format a byte count for logging
+	 *
+	 * \param bytes - The number of bytes to format
+	 * \return Returns a std::string containing the byte count in B, KB, MB,
+	 * or GB
+	 */
+	static std::string toString(size_t bytes);
+};
+}  // namespace glassutil
+#endif  // MEMORY_H
@@ -0,0 +1,256 @@
+/*****************************************
+ * This file is documented for Doxygen.
+ * If you modify this file please update
+ * the comments so that Doxygen will still
+ * be able to work.
+ ****************************************/
+#ifndef POOL_H
+#define POOL_H
+
+#include <cstddef>
+#include <mutex>
+#include <new>
+#include <vector>
+
+namespace glassutil {
+
+/**
+ * \brief glassutil slab pool class
+ *
+ * The CSlabPool class is a thread safe pool of fixed size memory blocks. The
+ * blocks are carved out of large slabs that are allocated as needed and kept
+ * for the life of the process, and freed blocks are kept on a free list and
+ * handed back out before any new slab is allocated. Once a pool has grown to
+ * cover the peak number of live objects, allocating and freeing do not touch
+ * the heap, and objects of the same type are packed together instead of
+ * being scattered through the heap over a long run.
+ *
+ * Pools are normally not used directly, but through CPoolAllocator.
+ */
+class CSlabPool {
+ public:
+	/**
+	 * \brief CSlabPool constructor
+	 *
+	 * \param blockSize - The size of each block in bytes, rounded up to keep
+	 * the blocks aligned
+	 * \param blocksPerSlab - The number of blocks to allocate at a time
+	 */
+	CSlabPool(size_t blockSize, size_t blocksPerSlab);
+
+	/**
+	 * \brief CSlabPool destructor
+	 */
+	~CSlabPool();
+
+	/**
+	 * \brief Allocate a block
+	 *
+	 * \return Returns a pointer to an uninitialized block of at least the
+	 * block size
+	 */
+	void * allocate();
+
+	/**
+	 * \brief Free a block
+	 *
+	 * \param block - A pointer to the block to return to the pool, must have
+	 * come from allocate() on this pool
+	 */
+	void deallocate(void * block);
+
+	/**
+	 * \brief Get the block size
+	 *
+	 * \return Returns the size of each block in bytes
+	 */
+	size_t getBlockSize() const;
+
+	/**
+	 * \brief Get the number of blocks in use
+	 *
+	 * \return Returns the number of blocks that have been allocated and not
+	 * yet freed
+	 */
+	size_t getUsedCount() const;
+
+	/**
+	 * \brief Get the memory used by this pool
+	 *
+	 * \return Returns the number of bytes held by this pool's slabs, whether
+	 * the blocks are in use or not
+	 */
+	size_t getMemoryUsage() const;
+
+	/**
+	 * \brief Get the memory used by all pools
+	 *
+	 * \return Returns the number of bytes held by the slabs of every pool
+	 * created by CPoolAllocator
+	 */
+	static size_t getTotalMemoryUsage();
+
+	/**
+	 * \brief Register a pool for getTotalMemoryUsage()
+	 *
+	 * \param pool - A pointer to the pool to register, which must never be
+	 * destroyed
+	 */
+	static void registerPool(CSlabPool * pool);
+
+ private:
+	/**
+	 * \brief A free block, linked through its first bytes
+	 */
+	struct FreeBlock {
+		FreeBlock * pNext;
+	};
+
+	/**
+	 * \brief Allocate a new slab and add its blocks to the free list
+	 */
+	void grow();
+
+	/**
+	 * \brief The size of each block in bytes
+	 */
+	size_t nBlockSize;
+
+	/**
+	 * \brief The number of blocks in each slab
+	 */
+	size_t nBlocksPerSlab;
+
+	/**
+	 * \brief The number of blocks in use
+	 */
+	size_t nUsed;
+
+	/**
+	 * \brief The head of the free list
+	 */
+	FreeBlock * pFree;
+
+	/**
+	 * \brief The slabs owned by this pool
+	 */
+	std::vector<char *> vSlab;
+
+	/**
+	 * \brief A mutex to control access to the free list and slabs
+	 */
+	mutable std::mutex poolMutex;
+};
+
+/**
+ * \brief glassutil pool allocator class
+ *
+ * The CPoolAllocator class is a standard library allocator that hands out
+ * single objects from a CSlabPool sized for the allocated type, and falls
+ * back to the heap for arrays and over aligned types. Every allocator of the
+ * same type shares the same pool, so allocators are stateless and compare
+ * equal.
+ *
+ * CPoolAllocator is intended for std::allocate_shared(), which rebinds it to
+ * allocate the object and its shared_ptr control block as a single pooled
+ * block:
+ *
+ *   std::allocate_shared<CPick>(glassutil::CPoolAllocator<CPick>(), ...)
+ *
+ * The pools are never destroyed, so objects allocated from them can safely
+ * outlive any static object during shutdown.
+ */
+template<class T>
+class CPoolAllocator {
+ public:
+	/**
+	 * \brief The allocated type
+	 */
+	typedef T value_type;
+
+	/**
+	 * \brief CPoolAllocator constructor
+	 */
+	CPoolAllocator() noexcept {
+	}
+
+	/**
+	 * \brief CPoolAllocator rebind constructor
+	 */
+	template<class U>
+	CPoolAllocator(const CPoolAllocator<U> &) noexcept {  // NOLINT
+	}
+
+	/**
+	 * \brief Allocate storage for n objects
+	 *
+	 * \param n - The number of objects to allocate storage for
+	 * \return Returns a pointer to the uninitialized storage
+	 */
+	T * allocate(size_t n) {
+		if ((n != 1) || (alignof(T) > alignof(std::max_align_t))) {
+			return (static_cast<T *>(::operator new(n * sizeof(T))));
+		}
+		return (static_cast<T *>(getPool().allocate()));
+	}
+
+	/**
+	 * \brief Free storage for n objects
+	 *
+	 * \param p - A pointer to the storage to free
+	 * \param n - The number of objects the storage was allocated for
+	 */
+	void deallocate(T * p, size_t n) {
+		if ((n != 1) || (alignof(T) > alignof(std::max_align_t))) {
+			::operator delete(p);
+			return;
+		}
+		getPool().deallocate(p);
+	}
+
+	/**
+	 * \brief Get the pool for this type
+	 *
+	 * \return Returns a reference to the CSlabPool shared by every
+	 * CPoolAllocator of this type
+	 */
+	static CSlabPool & getPool() {
+		// deliberately never destroyed, see the class description
+		static CSlabPool * pool = createPool();
+		return (*pool);
+	}
+
+ private:
+	/**
+	 * \brief Create and register the pool for this type
+	 */
+	static CSlabPool * createPool() {
+		// aim for slabs of about 64 KB
+		size_t blocks = (64 * 1024) / sizeof(T);
+		if (blocks < 16) {
+			blocks = 16;
+		}
+
+		CSlabPool * pool = new CSlabPool(sizeof(T), blocks);
+		CSlabPool::registerPool(pool);
+		return (pool);
+	}
+};
+
+/**
+ * \brief CPoolAllocator equality operator
+ */
+template<class T, class U>
+bool operator==(const CPoolAllocator<T> &, const CPoolAllocator<U> &) {
+	return (true);
+}
+
+/**
+ * \brief CPoolAllocator inequality operator
+ */
+template<class T, class U>
+bool operator!=(const CPoolAllocator<T> &, const CPoolAllocator<U> &) {
+	return (false);
+}
+}  // namespace glassutil
+#endif  // POOL_H
@@ -1,6 +1,9 @@
 #include <stdio.h>
 #include <sys/timeb.h>
 #include <time.h>
+#include <cmath>
+#include <cstdint>
+#include <algorithm>
 #include <string>
 #include "Date.h"
 
@@ -13,6 +16,198 @@ static char const *cmo[] = { "Jan", "Feb", "Mar", "Apr", "May", "Jun", "Jul",
 
 static int base = 1900;	 // Base year
 
+// the number of years, from the base year, covered by the cached day numbers
+#define NYEARS 200
+
+// ---------------------------------------------------------isLeap
+static bool isLeap(int yr) {
+	if (yr % 400 == 0) {
+		return (true);
+	}
+	if (yr % 100 == 0) {
+		return (false);
+	}
+	return (yr % 4 == 0);
+}
+
+/**
+ * \brief The julian day number of the first day of each year from the base
+ * year, computed once so that conversions don't walk the calendar
+ */
+struct YearTable {
+	YearTable() {
+		days[0] = 0;
+		for (int i = 0; i < NYEARS; i++) {
+			days[i + 1] = days[i] + (isLeap(base + i) ? 366 : 365);
+		}
+	}
+
+	int64_t days[NYEARS + 1];
+};
+
+// ---------------------------------------------------------yearTable
+static const YearTable &yearTable() {
+	static const YearTable table;
+	return (table);
+}
+
+// ---------------------------------------------------------dayNumber
+static int64_t dayNumber(int year, int month, int day) {
+	int64_t jul = 0;
+
+	// Calculate days from base year
+	if ((year >= base) && (year <= base + NYEARS)) {
+		jul = yearTable().days[year - base];
+	} else {
+		for (int yr = base; yr < year; yr++) {
+			jul += isLeap(yr) ? 366 : 365;
+		}
+	}
+
+	// handle leap year
+	int leap = isLeap(year) ? 12 : 0;
+
+	// calculate julian days
+	return (jul + mo[month + leap - 1] + day - 1);
+}
+
+// ---------------------------------------------------------civilDate
+static void civilDate(int64_t jul, int *year, int *month, int *day) {
+	// find the year from the cached day numbers, the last year in the table
+	// takes any later days
+	const YearTable &table = yearTable();
+	int iyr = static_cast<int>(std::upper_bound(table.days,
+												table.days + NYEARS + 1, jul)
+			- table.days) - 1;
+	if (iyr < 0) {
+		iyr = 0;
+	}
+	jul -= table.days[iyr];
+	int yr = base + iyr;
+
+	// handle leap year
+	int leap = isLeap(yr) ? 12 : 0;
+
+	// compute month
+	int mon = 0;
+	for (int i = 0; i < 12; i++) {
+		if (mo[mon + leap] <= jul) {
+			mon++;
+		}
+	}
+
+	*year = yr;
+	*month = mon;
+	*day = static_cast<int>((jul - mo[mon + leap - 1] + 1));
+}
+
+// ---------------------------------------------------------parseDigits
+static int parseDigits(const char *s, int count) {
+	int value = 0;
+	for (int i = 0; i < count; i++) {
+		if ((s[i] < '0') || (s[i] > '9')) {
+			return (-1);
+		}
+		value = 10 * value + (s[i] - '0');
+	}
+	return (value);
+}
+
+// ---------------------------------------------------------writeDigits
+static void writeDigits(char *s, int value, int count) {
+	for (int i = count - 1; i >= 0; i--) {
+		s[i] = static_cast<char>('0' + value % 10);
+		value /= 10;
+	}
+}
+
+// ---------------------------------------------------------parseFields
+static bool parseFields(const char *s, int length, int year, int month,
+						int day, int hour, int minute, int second, int *fields,
+						double *sec) {
+	fields[0] = parseDigits(s + year, 4);
+	fields[1] = parseDigits(s + month, 2);
+	fields[2] = parseDigits(s + day, 2);
+	fields[3] = parseDigits(s + hour, 2);
+	fields[4] = parseDigits(s + minute, 2);
+	int isec = parseDigits(s + second, 2);
+
+	// the fraction runs from after the decimal point to the end
+	int nfrac = length - second - 3;
+	int frac = parseDigits(s + second + 3, nfrac);
+
+	if ((fields[0] < 0) || (fields[1] < 1) || (fields[1] > 12)
+			|| (fields[2] < 0) || (fields[3] < 0) || (fields[4] < 0)
+			|| (isec < 0) || (frac < 0)) {
+		return (false);
+	}
+
+	// scale as an integer so the result matches parsing the decimal string
+	int scale = 1;
+	for (int i = 0; i < nfrac; i++) {
+		scale *= 10;
+	}
+	*sec = (isec * scale + frac) / static_cast<double>(scale);
+
+	return (true);
+}
+
+// ---------------------------------------------------------parseISO8601Fields
+static bool parseISO8601Fields(const char *iso8601, int length, int *fields,
+								double *sec) {
+	// ISO8601 format:
+	// 000000000011111111112222
+	// 012345678901234567890123
+	// YYYY-MM-DDTHH:mm:SS.SSSZ
+	if ((iso8601 == NULL) || (length != ISO8601LENGTH)) {
+		return (false);
+	}
+
+	// leave off the trailing Z
+	return (parseFields(iso8601, length - 1, 0, 5, 8, 11, 14, 17, fields, sec));
+}
+
+// ---------------------------------------------------------parseDateTimeFields
+static bool parseDateTimeFields(const char *datetime, int length, int *fields,
+								double *sec) {
+	// DT format:
+	// 000000000011111111
+	// 012345678901234567
+	// YYYYMMDDHHmmSS.SSS
+	// note that seconds can also be SS.SS
+	if ((datetime == NULL) || (length < DATETIMELENGTH - 1)
+			|| (length > DATETIMELENGTH)) {
+		return (false);
+	}
+
+	return (parseFields(datetime, length, 0, 4, 6, 8, 10, 12, fields, sec));
+}
+
+// ---------------------------------------------------------julianSeconds
+static double julianSeconds(const int *fields, double sec) {
+	int64_t jul = dayNumber(fields[0], fields[1], fields[2]);
+
+	// calculate julian minutes
+	int64_t jmin = 1440L * jul + 60L * fields[3] + fields[4];
+
+	// calculate julian seconds
+	return (60.0 * jmin + sec);
+}
+
+// ---------------------------------------------------------splitTime
+static void splitTime(double t, int *fields, int *millis) {
+	// round to the millisecond first, so that carries reach the minutes
+	int64_t ms = llround(t * 1000.0);
+	int64_t jul = ms / 86400000;
+	int64_t msday = ms - jul * 86400000;
+
+	civilDate(jul, &fields[0], &fields[1], &fields[2]);
+	fields[3] = static_cast<int>(msday / 3600000);
+	fields[4] = static_cast<int>((msday / 60000) % 60);
+	fields[5] = static_cast<int>((msday / 1000) % 60);
+	*millis = static_cast<int>(msday % 1000);
+}
+
 // ---------------------------------------------------------CDate
 CDate::CDate() {
 	clear();
@@ -81,57 +276,17 @@ double CDate::now() {
 
 // ---------------------------------------------------------initialize
 bool CDate::initialize(double time) {
-	int leap;
-	int yr;
-	int days;
-
 	// Elapsed days
 	int64_t jul = static_cast<int64_t>(time / 86400.0);
 
 	// compute seconds
 	double secs = time - jul * 86400.0;
 
-	for (yr = base; yr < 2100; yr++) {
-		days = 365;
-
-		// handle leap year
-		if (yr % 4 == 0) {
-			days = 366;
-		}
-		if (yr % 100 == 0) {
-			days = 365;
-		}
-		if (yr % 400 == 0) {
-			days = 366;
-		}
-		if (days > jul) {
-			break;
-		}
-		jul -= days;
-	}
-
-	// handle leap year
-	leap = 0;
-	if (yr % 4 == 0) {
-		leap = 12;
-	}
-	if (yr % 100 == 0) {
-		leap = 0;
-	}
-	if (yr % 400 == 0) {
-		leap = 12;
-	}
-
-	// compute month
-	int mon = 0;
-	for (int i = 0; i < 12; i++) {
-		if (mo[mon + leap] <= jul) {
-			mon++;
-		}
-	}
-
-	// compute day
-	int day = static_cast<int>((jul - mo[mon + leap - 1] + 1));
+	// compute year, month, and day
+	int yr;
+	int mon;
+	int day;
+	civilDate(jul, &yr, &mon, &day);
 
 	// compute hour
 	int hr = static_cast<int>((secs / 3600.0));
@@ -161,41 +316,8 @@ bool CDate::initialize(double time) {
 // ---------------------------------------------------------initialize
 bool CDate::initialize(unsigned int year, unsigned int month, unsigned int day,
 						unsigned int hour, unsigned int minute, double second) {
-	int64_t jul = 0;
-	int leap;
-
-	// Calculate days from base year
-	for (unsigned int yr = base; yr < year; yr++) {
-		jul += 365;
-
-		// handle leap year
-		leap = 0;
-		if (yr % 4 == 0) {
-			leap = 1;
-		}
-		if (yr % 100 == 0) {
-			leap = 0;
-		}
-		if (yr % 400 == 0) {
-			leap = 1;
-		}
-		jul += leap;
-	}
-
-	// handle leap year
-	leap = 0;
-	if (year % 4 == 0) {
-		leap = 12;
-	}
-	if (year % 100 == 0) {
-		leap = 0;
-	}
-	if (year % 400 == 0) {
-		leap = 12;
-	}
-
 	// calculate julian days
-	jul += mo[month + leap - 1] + day - 1;
+	int64_t jul = dayNumber(year, month, day);
 
 	// calculate julian minutes
 	int64_t jmin = 1440L * jul + 60L * hour + minute;
@@ -336,11 +458,6 @@ std::string CDate::dateTime() {
 
 // ---------------------------------------------------------decodeTime
 double CDate::decodeDateTime(std::string datetime) {
-	// check string lenght
-	if ((datetime.length() < 17) || (datetime.length() > 18)) {
-		return (0);
-	}
-
 	// Time string is in DT format:
 	// 000000000011111111
 	// 012345678901234567
@@ -350,41 +467,20 @@ double CDate::decodeDateTime(std::string datetime) {
 	// HH is the hour of the day (0-23), mm is the minutes of
 	// the hour, and SS.SS is the seconds.
 	// note that seconds can also be SS.SSS
-
-	// check string length to determine seconds
-	// decimal precision
-	int secLength = 6;
-	if (datetime.length() == 17) {
-		secLength = 5;
+	int fields[5];
+	double sec;
+	if (!parseDateTimeFields(datetime.c_str(), datetime.length(), fields,
+								&sec)) {
+		return (0);
 	}
 
-	// parse time components from string
-	int iyr = std::stoi(datetime.substr(0, 4));
-	int imo = std::stoi(datetime.substr(4, 2));
-	int ida = std::stoi(datetime.substr(6, 2));
-	int ihr = std::stoi(datetime.substr(8, 2));
-	int imn = std::stoi(datetime.substr(10, 2));
-	double sec = std::stod(datetime.substr(12, secLength));
-
 	// convert
-	CDate dt = CDate(iyr, imo, ida, ihr, imn, sec);
-	m_dTime = dt.time();
-	m_nYear = dt.year();
-	m_nMonth = dt.month();
-	m_nDay = dt.day();
-	m_nHour = dt.hour();
-	m_nMinute = dt.minute();
-	m_dSeconds = dt.seconds();
+	initialize(fields[0], fields[1], fields[2], fields[3], fields[4], sec);
 	return (m_dTime);
 }
 
 // ---------------------------------------------------------decodeISO8601Time
 double CDate::decodeISO8601Time(std::string iso8601) {
-	// check string length
-	if (iso8601.length() != 24) {
-		return (0);
-	}
-
 	// Time string is in ISO8601 format:
 	// 000000000011111111112222
 	// 012345678901234567890123
@@ -393,36 +489,92 @@ double CDate::decodeISO8601Time(std::string iso8601) {
 	// MM is the month (Jan = 1), DD is the day of the month,
 	// HH is the hour of the day (0-23), mm is the minutes of
 	// the hour, and SS.SSS is the seconds.
-
-	// parse time components from string
-	int iyr = std::stoi(iso8601.substr(0, 4));
-	int imo = std::stoi(iso8601.substr(5, 2));
-	int ida = std::stoi(iso8601.substr(8, 2));
-	int ihr = std::stoi(iso8601.substr(11, 2));
-	int imn = std::stoi(iso8601.substr(14, 2));
-	double sec = std::stod(iso8601.substr(17, 6));
+	int fields[5];
+	double sec;
+	if (!parseISO8601Fields(iso8601.c_str(), iso8601.length(), fields, &sec)) {
+		return (0);
+	}
 
 	// convert
-	CDate dt = CDate(iyr, imo, ida, ihr, imn, sec);
-	m_dTime = dt.time();
-	m_nYear = dt.year();
-	m_nMonth = dt.month();
-	m_nDay = dt.day();
-	m_nHour = dt.hour();
-	m_nMinute = dt.minute();
-	m_dSeconds = dt.seconds();
+	initialize(fields[0], fields[1], fields[2], fields[3], fields[4], sec);
 	return (m_dTime);
 }
 
 // ---------------------------------------------------------encodeDateTime
 std::string CDate::encodeDateTime(double t) {
-	CDate dt(t);
-	return (dt.dateTime());
+	char s[DATETIMELENGTH + 1];
+	formatDateTime(t, s);
+	return (std::string(s));
 }
 
 // ---------------------------------------------------------encodeISO8601Time
 std::string CDate::encodeISO8601Time(double t) {
-	CDate dt(t);
-	return (dt.ISO8601());
+	char s[ISO8601LENGTH + 1];
+	formatISO8601(t, s);
+	return (std::string(s));
+}
+
+// ---------------------------------------------------------parseISO8601
+double CDate::parseISO8601(const char *iso8601, int length) {
+	int fields[5];
+	double sec;
+	if (!parseISO8601Fields(iso8601, length, fields, &sec)) {
+		return (0);
+	}
+
+	return (julianSeconds(fields, sec));
+}
+
+// ---------------------------------------------------------parseDateTime
+double CDate::parseDateTime(const char *datetime, int length) {
+	int fields[5];
+	double sec;
+	if (!parseDateTimeFields(datetime, length, fields, &sec)) {
+		return (0);
+	}
+
+	return (julianSeconds(fields, sec));
+}
+
+// ---------------------------------------------------------formatISO8601
+void CDate::formatISO8601(double t, char *buffer) {
+	int fields[6];
+	int millis;
+	splitTime(t, fields, &millis);
+
+	// YYYY-MM-DDTHH:mm:SS.SSSZ
+	writeDigits(buffer, fields[0], 4);
+	buffer[4] = '-';
+	writeDigits(buffer + 5, fields[1], 2);
+	buffer[7] = '-';
+	writeDigits(buffer + 8, fields[2], 2);
+	buffer[10] = 'T';
+	writeDigits(buffer + 11, fields[3], 2);
+	buffer[13] = ':';
+	writeDigits(buffer + 14, fields[4], 2);
+	buffer[16] = ':';
+	writeDigits(buffer + 17, fields[5], 2);
+	buffer[19] = '.';
+	writeDigits(buffer + 20, millis, 3);
+	buffer[23] = 'Z';
+	buffer[24] = '\0';
+}
+
+// ---------------------------------------------------------formatDateTime
+void CDate::formatDateTime(double t, char *buffer) {
+	int fields[6];
+	int millis;
+	splitTime(t, fields, &millis);
+
+	// YYYYMMDDHHmmSS.SSS
+	writeDigits(buffer, fields[0], 4);
+	writeDigits(buffer + 4, fields[1], 2);
+	writeDigits(buffer + 6, fields[2], 2);
+	writeDigits(buffer + 8, fields[3], 2);
+	writeDigits(buffer + 10, fields[4], 2);
+	writeDigits(buffer + 12, fields[5], 2);
+	buffer[14] = '.';
+	writeDigits(buffer + 15, millis, 3);
+	buffer[18] = '\0';
 }
 }  // namespace glassutil
@@ -0,0 +1,379 @@
+#include "Executor.h"
+#include <algorithm>
+#include <chrono>
+#include <ctime>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "Logit.h"
+
+namespace glassutil {
+
+// the executor and worker the current thread belongs to, if any, so that
+// tasks submitted from a task are queued on the worker running it
+static thread_local const CExecutor * tlsExecutor = NULL;
+static thread_local int tlsWorker = -1;
+
+// ---------------------------------------------------------CExecutor
+CExecutor::CExecutor(const std::vector<TaskClass> &taskClasses,
+						int numThreads, int sleepTime, int checkInterval) {
+	// setup threads
+	m_bRunProcessLoop = true;
+	m_iNumThreads = std::max(numThreads, 1);
+	m_iSleepTimeMS = sleepTime;
+	m_iStatusCheckInterval = checkInterval;
+	std::time(&tLastStatusCheck);
+	m_iNextWorker = 0;
+	m_iSignal = 0;
+
+	// setup classes
+	for (int i = 0; i < static_cast<int>(taskClasses.size()); i++) {
+		std::unique_ptr<ClassState> state(new ClassState());
+		state->definition = taskClasses[i];
+		state->iQueued = 0;
+		state->iRunning = 0;
+
+		// a cap above the number of workers could never be reached
+		if ((state->definition.iMaxConcurrent < 1)
+				|| (state->definition.iMaxConcurrent > m_iNumThreads)) {
+			state->definition.iMaxConcurrent = m_iNumThreads;
+		}
+
+		vClass.push_back(std::move(state));
+		vClassOrder.push_back(i);
+	}
+
+	// classes of equal priority keep their given order
+	std::stable_sort(vClassOrder.begin(), vClassOrder.end(),
+						[this](int a, int b) {
+							return (vClass[a]->definition.iPriority
+									> vClass[b]->definition.iPriority);
+						});
+
+	// setup worker queues
+	for (int i = 0; i < m_iNumThreads; i++) {
+		std::unique_ptr<WorkerQueue> worker(new WorkerQueue());
+		worker->vTasks.resize(vClass.size());
+		vWorker.push_back(std::move(worker));
+	}
+
+	// create threads
+	for (int i = 0; i < m_iNumThreads; i++) {
+		// create thread
+		vProcessThreads.push_back(std::thread(&CExecutor::workLoop, this, i));
+
+		// add to status map if we're tracking status
+		if (m_iStatusCheckInterval > 0) {
+			m_StatusMutex.lock();
+			m_ThreadStatusMap[vProcessThreads[i].get_id()] = true;
+			m_StatusMutex.unlock();
+		}
+	}
+}
+
+// ---------------------------------------------------------~CExecutor
+CExecutor::~CExecutor() {
+	stop();
+}
+
+// ---------------------------------------------------------submit
+bool CExecutor::submit(int taskClass, std::function<void()> task) {
+	if ((taskClass < 0) || (taskClass >= static_cast<int>(vClass.size()))) {
+		glassutil::CLogit::log(
+				glassutil::log_level::error,
+				"CExecutor::submit: Invalid task class "
+						+ std::to_string(taskClass) + ".");
+		return (false);
+	}
+	if (!task) {
+		return (false);
+	}
+	if (m_bRunProcessLoop == false) {
+		return (false);
+	}
+
+	// keep a task submitted from a worker on that worker, it will likely
+	// work on the same data as the task that submitted it
+	int index;
+	if ((tlsExecutor == this) && (tlsWorker >= 0)) {
+		index = tlsWorker;
+	} else {
+		index = m_iNextWorker++ % m_iNumThreads;
+	}
+
+	WorkerQueue &worker = *vWorker[index];
+	worker.queueMutex.lock();
+	worker.vTasks[taskClass].push_back(std::move(task));
+	vClass[taskClass]->iQueued++;
+	worker.queueMutex.unlock();
+
+	signal(false);
+
+	return (true);
+}
+
+// ---------------------------------------------------------stop
+void CExecutor::stop() {
+	std::lock_guard<std::mutex> stopGuard(m_StopMutex);
+
+	// disable status checking
+	m_StatusMutex.lock();
+	m_ThreadStatusMap.clear();
+	m_StatusMutex.unlock();
+
+	// signal threads to finish
+	m_bRunProcessLoop = false;
+	signal(true);
+
+	// wait for threads to finish
+	for (int i = 0; i < static_cast<int>(vProcessThreads.size()); i++) {
+		vProcessThreads[i].join();
+	}
+	vProcessThreads.clear();
+
+	// discard anything left
+	for (auto &worker : vWorker) {
+		std::lock_guard<std::mutex> queueGuard(worker->queueMutex);
+		for (int i = 0; i < static_cast<int>(worker->vTasks.size()); i++) {
+			vClass[i]->iQueued -= static_cast<int>(worker->vTasks[i].size());
+			worker->vTasks[i].clear();
+		}
+	}
+}
+
+// ---------------------------------------------------------getQueueSize
+int CExecutor::getQueueSize(int taskClass) const {
+	if ((taskClass < 0) || (taskClass >= static_cast<int>(vClass.size()))) {
+		return (0);
+	}
+
+	return (vClass[taskClass]->iQueued);
+}
+
+// ---------------------------------------------------------getRunningCount
+int CExecutor::getRunningCount(int taskClass) const {
+	if ((taskClass < 0) || (taskClass >= static_cast<int>(vClass.size()))) {
+		return (0);
+	}
+
+	return (vClass[taskClass]->iRunning);
+}
+
+// ---------------------------------------------------------getMaxConcurrent
+int CExecutor::getMaxConcurrent(int taskClass) const {
+	if ((taskClass < 0) || (taskClass >= static_cast<int>(vClass.size()))) {
+		return (0);
+	}
+
+	return (vClass[taskClass]->definition.iMaxConcurrent);
+}
+
+// ---------------------------------------------------------getNumThreads
+int CExecutor::getNumThreads() const {
+	return (m_iNumThreads);
+}
+
+// ---------------------------------------------------------workLoop
+void CExecutor::workLoop(int index) {
+	glassutil::CLogit::log(glassutil::log_level::debug,
+							"CExecutor::workLoop: startup");
+
+	tlsExecutor = this;
+	tlsWorker = index;
+
+	while (m_bRunProcessLoop == true) {
+		// update thread status
+		setStatus(true);
+
+		// note the signal count before looking for work, so that work
+		// submitted while looking isn't slept through
+		unsigned int signalCount = m_iSignal;
+
+		// run the job
+		bool ran = false;
+		try {
+			ran = runNext(index);
+		} catch (const std::exception &e) {
+			glassutil::CLogit::log(
+					glassutil::log_level::error,
+					"CExecutor::workLoop: Exception during task: "
+							+ std::string(e.what()));
+			break;
+		}
+
+		if (ran == true) {
+			continue;
+		}
+
+		// nothing to do, wait for more work, waking up now and then to
+		// report status
+		std::unique_lock<std::mutex> wakeLock(m_WakeMutex);
+		m_WakeCondition.wait_for(
+				wakeLock, std::chrono::milliseconds(m_iSleepTimeMS),
+				[this, signalCount]() {
+					return ((m_iSignal != signalCount)
+							|| (m_bRunProcessLoop == false));
+				});
+	}
+
+	setStatus(false);
+	glassutil::CLogit::log(glassutil::log_level::debug,
+							"CExecutor::workLoop: thread exit");
+}
+
+// ---------------------------------------------------------runNext
+bool CExecutor::runNext(int index) {
+	for (int taskClass : vClassOrder) {
+		ClassState &state = *vClass[taskClass];
+		if (state.iQueued <= 0) {
+			continue;
+		}
+
+		// claim a slot under the class cap before taking a task, so that a
+		// task is never taken that can't be run
+		int running = state.iRunning;
+		bool claimed = false;
+		while (running < state.definition.iMaxConcurrent) {
+			if (state.iRunning.compare_exchange_weak(running, running + 1)) {
+				claimed = true;
+				break;
+			}
+		}
+		if (claimed == false) {
+			continue;
+		}
+
+		// take from this worker first, then steal from the others
+		std::function<void()> task;
+		bool found = take(index, taskClass, &task);
+		for (int i = 1; (found == false) && (i < m_iNumThreads); i++) {
+			found = take((index + i) % m_iNumThreads, taskClass, &task);
+		}
+		if (found == false) {
+			state.iRunning--;
+			continue;
+		}
+
+		try {
+			task();
+		} catch (...) {
+			state.iRunning--;
+			signal(false);
+			throw;
+		}
+		state.iRunning--;
+
+		// a worker may have passed this class over while it was at its cap
+		if (state.iQueued > 0) {
+			signal(false);
+		}
+
+		return (true);
+	}
+
+	return (false);
+}
+
+// ---------------------------------------------------------take
+bool CExecutor::take(int index, int taskClass, std::function<void()> *task) {
+	WorkerQueue &worker = *vWorker[index];
+	std::lock_guard<std::mutex> queueGuard(worker.queueMutex);
+
+	std::deque<std::function<void()>> &tasks = worker.vTasks[taskClass];
+	if (tasks.empty() == true) {
+		return (false);
+	}
+
+	*task = std::move(tasks.front());
+	tasks.pop_front();
+	vClass[taskClass]->iQueued--;
+
+	return (true);
+}
+
+// ---------------------------------------------------------signal
+void CExecutor::signal(bool all) {
+	// bump the count under the lock, so that a worker can't check it and
+	// start waiting in between
+	m_WakeMutex.lock();
+	m_iSignal++;
+	m_WakeMutex.unlock();
+
+	if (all == true) {
+		m_WakeCondition.notify_all();
+	} else {
+		m_WakeCondition.notify_one();
+	}
+}
+
+// ---------------------------------------------------------setStatus
+void CExecutor::setStatus(bool status) {
+	std::lock_guard<std::mutex> statusGuard(m_StatusMutex);
+
+	// update thread status
+	if (m_ThreadStatusMap.find(std::this_thread::get_id())
+			!= m_ThreadStatusMap.end()) {
+		m_ThreadStatusMap[std::this_thread::get_id()] = status;
+	}
+}
+
+// ---------------------------------------------------------statusCheck
+bool CExecutor::statusCheck() {
+	// if we have a negative check interval,
+	// we shouldn't worry about thread status checks.
+	if (m_iStatusCheckInterval < 0) {
+		return (true);
+	}
+
+	// thread is dead if we're not running
+	if (m_bRunProcessLoop == false) {
+		glassutil::CLogit::log(
+				glassutil::log_level::warn,
+				"CExecutor::statusCheck(): m_bRunProcessLoop is false.");
+		return (false);
+	}
+
+	// see if it's time to check
+	time_t tNow;
+	std::time(&tNow);
+	if ((tNow - tLastStatusCheck) >= m_iStatusCheckInterval) {
+		// get the thread status
+		std::lock_guard<std::mutex> statusGuard(m_StatusMutex);
+
+		// check all the threads
+		std::map<std::thread::id, bool>::iterator StatusItr;
+		for (StatusItr = m_ThreadStatusMap.begin();
+				StatusItr != m_ThreadStatusMap.end(); ++StatusItr) {
+			// get the thread status
+			bool status = static_cast<bool>(StatusItr->second);
+
+			// at least one thread did not respond
+			if (status != true) {
+				glassutil::CLogit::log(
+						glassutil::log_level::error,
+						"CExecutor::statusCheck(): At least one thread"
+								" did not respond in the last"
+								+ std::to_string(m_iStatusCheckInterval)
+								+ "seconds.");
+
+				return (false);
+			}
+
+			// mark check as false until next time
+			// if the thread is alive, it'll mark it
+			// as true again.
+			StatusItr->second = false;
+		}
+
+		// remember the last time we checked
+		tLastStatusCheck = tNow;
+	}
+
+	// everything is awesome
+	return (true);
+}
+}  // namespace glassutil
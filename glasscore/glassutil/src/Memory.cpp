@@ -0,0 +1,22 @@
+#include "Memory.h"
+#include <json.h>
+#include <cstdio>
+#include <string>
+
+namespace glassutil {
+
+// ---------------------------------------------------------toString
+std::string CMemory::toString(size_t bytes) {
+	const char *units[] = { "B", "KB", "MB", "GB" };
+	double value = static_cast<double>(bytes);
+	int unit = 0;
+	while ((value >= 1024.0) && (unit < 3)) {
+		value /= 1024.0;
+		unit++;
+	}
+
+	char buffer[32];
+	snprintf(buffer, sizeof(buffer), "%.1f %s", value, units[unit]);
+	return (std::string(buffer));
+}
+}  // namespace glassutil
@@ -0,0 +1,135 @@
+#include "Pool.h"
+#include <cstddef>
+#include <mutex>
+#include <new>
+#include <vector>
+
+namespace glassutil {
+
+// the pools registered for getTotalMemoryUsage, never destroyed since the
+// pools themselves are not
+static std::mutex & getPoolsMutex() {
+	static std::mutex * poolsMutex = new std::mutex();
+	return (*poolsMutex);
+}
+
+static std::vector<CSlabPool *> & getPools() {
+	static std::vector<CSlabPool *> * pools = new std::vector<CSlabPool *>();
+	return (*pools);
+}
+
+// ---------------------------------------------------------CSlabPool
+CSlabPool::CSlabPool(size_t blockSize, size_t blocksPerSlab) {
+	// round the block size up to keep every block aligned, and large enough
+	// to hold the free list link
+	size_t align = alignof(std::max_align_t);
+	if (blockSize < sizeof(FreeBlock)) {
+		blockSize = sizeof(FreeBlock);
+	}
+	nBlockSize = ((blockSize + align - 1) / align) * align;
+
+	if (blocksPerSlab < 1) {
+		blocksPerSlab = 1;
+	}
+	nBlocksPerSlab = blocksPerSlab;
+
+	nUsed = 0;
+	pFree = NULL;
+}
+
+// ---------------------------------------------------------~CSlabPool
+CSlabPool::~CSlabPool() {
+	for (auto slab : vSlab) {
+		::operator delete(slab);
+	}
+	vSlab.clear();
+	pFree = NULL;
+}
+
+// ---------------------------------------------------------allocate
+void * CSlabPool::allocate() {
+	std::lock_guard<std::mutex> guard(poolMutex);
+
+	if (pFree == NULL) {
+		grow();
+	}
+
+	// pop the first free block
+	FreeBlock * block = pFree;
+	pFree = block->pNext;
+	nUsed++;
+
+	return (block);
+}
+
+// ---------------------------------------------------------deallocate
+void CSlabPool::deallocate(void * block) {
+	if (block == NULL) {
+		return;
+	}
+
+	std::lock_guard<std::mutex> guard(poolMutex);
+
+	// push the block onto the free list, so the most recently freed (and
+	// likely still cached) block is reused first
+	FreeBlock * freeBlock = static_cast<FreeBlock *>(block);
+	freeBlock->pNext = pFree;
+	pFree = freeBlock;
+	nUsed--;
+}
+
+// ---------------------------------------------------------grow
+void CSlabPool::grow() {
+	char * slab = static_cast<char *>(::operator new(
+			nBlockSize * nBlocksPerSlab));
+	vSlab.push_back(slab);
+
+	// thread the new blocks onto the free list in address order
+	for (size_t i = nBlocksPerSlab; i > 0; i--) {
+		FreeBlock * block = reinterpret_cast<FreeBlock *>(slab
+				+ (i - 1) * nBlockSize);
+		block->pNext = pFree;
+		pFree = block;
+	}
+}
+
+// ---------------------------------------------------------getBlockSize
+size_t CSlabPool::getBlockSize() const {
+	return (nBlockSize);
+}
+
+// ---------------------------------------------------------getUsedCount
+size_t CSlabPool::getUsedCount() const {
+	std::lock_guard<std::mutex> guard(poolMutex);
+	return (nUsed);
+}
+
+// ---------------------------------------------------------getMemoryUsage
+size_t CSlabPool::getMemoryUsage() const {
+	std::lock_guard<std::mutex> guard(poolMutex);
+	return (sizeof(CSlabPool) + vSlab.capacity() * sizeof(char *)
+			+ vSlab.size() * nBlockSize * nBlocksPerSlab);
+}
+
+// ---------------------------------------------------------getTotalMemoryUsage
+size_t CSlabPool::getTotalMemoryUsage() {
+	std::lock_guard<std::mutex> guard(getPoolsMutex());
+
+	size_t bytes = 0;
+	for (auto pool : getPools()) {
+		bytes += pool->getMemoryUsage();
+	}
+
+	return (bytes);
+}
+
+// ---------------------------------------------------------registerPool
+void CSlabPool::registerPool(CSlabPool * pool) {
+	if (pool == NULL) {
+		return;
+	}
+
+	std::lock_guard<std::mutex> guard(getPoolsMutex());
+	getPools().push_back(pool);
+}
+}  // namespace glassutil
@@ -25,6 +25,10 @@
 #define TCORRELATION2 3628281943.590000
 #define TCORRELATION3 3628281763.590000
 
+#define TCORRELATIONLOOKUP 3628281703.599
+#define CORRLAT 40.3344
+#define CORRLON -121.44
+
 #define MAXNCORRELATION 5
 
 // NOTE: Need to consider testing scavenge, and rouges functions,
@@ -132,6 +136,24 @@ TEST(CorrelationListTest, CorrelationOperations) {
 	ASSERT_EQ(0, testCorrelationList->indexCorrelation(TCORRELATION3))<<
 	"test indexcorrelation with time within";
 
+	// test looking up correlations by time and location
+	ASSERT_EQ(1, testCorrelationList->getCorrelations(
+			TCORRELATIONLOOKUP, CORRLAT, CORRLON, 1.0, 0.5).size())<<
+	"getCorrelations near first correlation";
+	ASSERT_EQ(2, testCorrelationList->getCorrelations(
+			TCORRELATIONLOOKUP, CORRLAT, CORRLON, 200.0, 0.5).size())<<
+	"getCorrelations with a wide time window";
+	ASSERT_EQ(0, testCorrelationList->getCorrelations(
+			TCORRELATIONLOOKUP, 0.0, 0.0, 200.0, 0.5).size())<<
+	"getCorrelations far away";
+	ASSERT_EQ(2, testCorrelationList->getCorrelations(
+			TCORRELATIONLOOKUP, 0.0, 0.0, 200.0, 180.0).size())<<
+	"getCorrelations with a global window";
+
+	// test duplicate checking against the index
+	ASSERT_TRUE(testCorrelationList->checkDuplicate(testCorrelation.get(), 1.0,
+													0.5))<< "duplicate";
+
 	// add more correlations
 	testCorrelationList->addCorrelation(correlation2JSON);
 	testCorrelationList->addCorrelation(correlation4JSON);
@@ -153,6 +175,11 @@ TEST(CorrelationListTest, CorrelationOperations) {
 	ASSERT_STREQ(sitescnl.c_str(), expectedscnl.c_str())<<
 	"test2Correlation has right scnl";
 
+	// evicted correlations are gone from the index too
+	ASSERT_EQ(MAXNCORRELATION, testCorrelationList->getCorrelations(
+			TCORRELATIONLOOKUP, CORRLAT, CORRLON, 1000.0, 0.5).size())<<
+	"getCorrelations after eviction";
+
 	// test clearing correlations
 	testCorrelationList->clearCorrelations();
 	expectedSize = 0;
@@ -250,3 +250,48 @@ TEST(DateTest, ConvertISO8601ToJulianTime) {
 	double ConvertedJulianTime = dt.decodeISO8601Time(ISO8601Time);
 	ASSERT_NEAR(ConvertedJulianTime, ExpectedJulieanTime, 0.0001);
 }
+
+// tests the fixed format codec
+TEST(DateTest, FixedFormatCodec) {
+	glassutil::CLogit::disable();
+
+	// parse
+	ASSERT_NEAR(JULIANTIME,
+				glassutil::CDate::parseISO8601(ISO8601TIME, ISO8601LENGTH),
+				0.0001)<< "parseISO8601";
+	ASSERT_NEAR(JULIANTIME,
+				glassutil::CDate::parseDateTime(DATETIME, DATETIMELENGTH),
+				0.0001)<< "parseDateTime";
+	ASSERT_NEAR(JULIANTIME - 0.007,
+				glassutil::CDate::parseDateTime("20151228213224.01", 17),
+				0.0001)<< "parseDateTime two decimals";
+
+	// invalid strings
+	ASSERT_EQ(0, glassutil::CDate::parseISO8601(ISO8601TIME, 23))<<
+	"parseISO8601 short";
+	ASSERT_EQ(0, glassutil::CDate::parseISO8601("2015-1x-28T21:32:24.017Z",
+												ISO8601LENGTH))<<
+	"parseISO8601 not a number";
+	ASSERT_EQ(0, glassutil::CDate::parseISO8601("2015-13-28T21:32:24.017Z",
+												ISO8601LENGTH))<<
+	"parseISO8601 bad month";
+
+	// format
+	char buffer[ISO8601LENGTH + 1];
+	glassutil::CDate::formatISO8601(JULIANTIME, buffer);
+	ASSERT_STREQ(ISO8601TIME, buffer)<< "formatISO8601";
+	glassutil::CDate::formatDateTime(JULIANTIME, buffer);
+	ASSERT_STREQ(DATETIME, buffer)<< "formatDateTime";
+
+	// rounding carries into the minutes
+	glassutil::CDate::formatISO8601(3660327179.9996, buffer);
+	ASSERT_STREQ("2015-12-28T21:33:00.000Z", buffer)<< "formatISO8601 carry";
+
+	// leap day round trip
+	double leap = glassutil::CDate::parseISO8601("2016-02-29T12:00:00.000Z",
+													ISO8601LENGTH);
+	glassutil::CDate::formatISO8601(leap, buffer);
+	ASSERT_STREQ("2016-02-29T12:00:00.000Z", buffer)<< "leap day";
+	glassutil::CDate::formatISO8601(leap + 86400.0, buffer);
+	ASSERT_STREQ("2016-03-01T12:00:00.000Z", buffer)<< "after leap day";
+}
@@ -0,0 +1,52 @@
+#include <gtest/gtest.h>
+#include <memory>
+#include <string>
+#include "Detection.h"
+#include "Logit.h"
+
+#define DETECTIONJSON "{\"Type\":\"Detection\",\"ID\":\"12GFH48776857\",\"Source\":{\"AgencyID\":\"US\",\"Author\":\"TestAuthor\"},\"Hypocenter\":{\"Latitude\":40.3344,\"Longitude\":-121.44,\"Depth\":32.44,\"Time\":\"2015-12-28T21:32:24.017Z\"},\"DetectionType\":\"New\",\"EventType\":\"earthquake\",\"Bayes\":2.65,\"MinimumDistance\":2.14,\"RMS\":3.8,\"Gap\":33.67}"  // NOLINT
+#define NOHYPOJSON "{\"Type\":\"Detection\",\"ID\":\"12GFH48776857\",\"Source\":{\"AgencyID\":\"US\",\"Author\":\"TestAuthor\"},\"DetectionType\":\"New\"}"  // NOLINT
+#define NODEPTHJSON "{\"Type\":\"Detection\",\"ID\":\"12GFH48776857\",\"Source\":{\"AgencyID\":\"US\",\"Author\":\"TestAuthor\"},\"Hypocenter\":{\"Latitude\":40.3344,\"Longitude\":-121.44,\"Time\":\"2015-12-28T21:32:24.017Z\"},\"DetectionType\":\"New\"}"  // NOLINT
+
+#define TORG 3660327144.017
+#define LATITUDE 40.3344
+#define LONGITUDE -121.44
+#define DEPTH 32.44
+
+// test to see if the detection can be constructed
+TEST(DetectionTest, Construction) {
+	glassutil::CLogit::disable();
+
+	glasscore::CDetection testDetection;
+
+	// pointers
+	ASSERT_EQ(NULL, testDetection.getGlass())<< "pGlass null";
+}
+
+// test decoding detection messages into records
+TEST(DetectionTest, Decode) {
+	glassutil::CLogit::disable();
+
+	json::Object detectionJSON = json::Deserialize(std::string(DETECTIONJSON));
+
+	glasscore::DetectionRecord detection;
+	ASSERT_TRUE(glasscore::CDetection::decode(detectionJSON, &detection))<<
+	"decode detection";
+	ASSERT_NEAR(TORG, detection.tOrg, 0.0001)<< "tOrg";
+	ASSERT_EQ(LATITUDE, detection.dLat)<< "dLat";
+	ASSERT_EQ(LONGITUDE, detection.dLon)<< "dLon";
+	ASSERT_EQ(DEPTH, detection.dZ)<< "dZ";
+
+	// missing keys
+	json::Object noHypoJSON = json::Deserialize(std::string(NOHYPOJSON));
+	ASSERT_FALSE(glasscore::CDetection::decode(noHypoJSON, &detection))<<
+	"decode without hypocenter";
+
+	json::Object noDepthJSON = json::Deserialize(std::string(NODEPTHJSON));
+	ASSERT_FALSE(glasscore::CDetection::decode(noDepthJSON, &detection))<<
+	"decode without depth";
+
+	// process fails cleanly without a glass
+	glasscore::CDetection testDetection;
+	ASSERT_FALSE(testDetection.process(detection))<< "process without glass";
+}
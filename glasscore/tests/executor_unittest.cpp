@@ -0,0 +1,149 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "Executor.h"
+#include "Logit.h"
+
+#define NUMTHREADS 4
+#define NUMTASKS 200
+#define WAITMS 5000
+
+// the task classes used by the tests
+static std::vector<glassutil::CExecutor::TaskClass> testClasses() {
+	std::vector<glassutil::CExecutor::TaskClass> classes(3);
+	classes[0] = { "Low", 1, 0 };
+	classes[1] = { "High", 3, 0 };
+	classes[2] = { "Capped", 2, 1 };
+	return (classes);
+}
+
+// wait for a count to reach a value, giving up after WAITMS
+static bool waitFor(const std::atomic<int> &count, int value) {
+	for (int i = 0; i < WAITMS; i++) {
+		if (count >= value) {
+			return (true);
+		}
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+	return (count >= value);
+}
+
+// test to see if the executor can be constructed
+TEST(ExecutorTest, Construction) {
+	glassutil::CLogit::disable();
+
+	glassutil::CExecutor testExecutor(testClasses(), NUMTHREADS);
+
+	ASSERT_EQ(NUMTHREADS, testExecutor.getNumThreads())<< "num threads";
+
+	// caps are limited to the number of threads
+	ASSERT_EQ(NUMTHREADS, testExecutor.getMaxConcurrent(0))<< "low cap";
+	ASSERT_EQ(1, testExecutor.getMaxConcurrent(2))<< "capped cap";
+
+	// nothing queued or running
+	ASSERT_EQ(0, testExecutor.getQueueSize(0))<< "queue size";
+	ASSERT_EQ(0, testExecutor.getRunningCount(0))<< "running count";
+
+	// invalid classes
+	ASSERT_EQ(0, testExecutor.getQueueSize(3))<< "invalid queue size";
+	ASSERT_FALSE(testExecutor.submit(-1, []() {}))<< "submit invalid class";
+
+	ASSERT_TRUE(testExecutor.statusCheck())<< "status check";
+}
+
+// test that every task submitted runs, including tasks submitted by tasks
+TEST(ExecutorTest, Submit) {
+	glassutil::CLogit::disable();
+
+	glassutil::CExecutor testExecutor(testClasses(), NUMTHREADS);
+	std::atomic<int> count(0);
+
+	for (int i = 0; i < NUMTASKS; i++) {
+		ASSERT_TRUE(testExecutor.submit(i % 2, [&testExecutor, &count]() {
+			count++;
+			testExecutor.submit(0, [&count]() {count++;});
+		}))<< "submit";
+	}
+
+	ASSERT_TRUE(waitFor(count, 2 * NUMTASKS))<< "all tasks ran";
+	ASSERT_EQ(2 * NUMTASKS, count)<< "each task ran once";
+	ASSERT_EQ(0, testExecutor.getQueueSize(0))<< "queue size";
+}
+
+// test that a class never runs more tasks at once than its cap
+TEST(ExecutorTest, Cap) {
+	glassutil::CLogit::disable();
+
+	glassutil::CExecutor testExecutor(testClasses(), NUMTHREADS);
+	std::atomic<int> count(0);
+	std::atomic<int> running(0);
+	std::atomic<int> maxRunning(0);
+
+	for (int i = 0; i < NUMTHREADS * 4; i++) {
+		testExecutor.submit(2, [&]() {
+			int now = ++running;
+			if (now > maxRunning) {
+				maxRunning = now;
+			}
+			std::this_thread::sleep_for(std::chrono::milliseconds(2));
+			running--;
+			count++;
+		});
+	}
+
+	ASSERT_TRUE(waitFor(count, NUMTHREADS * 4))<< "all tasks ran";
+	ASSERT_EQ(1, maxRunning)<< "cap respected";
+}
+
+// test that queued tasks of higher priority classes run first
+TEST(ExecutorTest, Priority) {
+	glassutil::CLogit::disable();
+
+	glassutil::CExecutor testExecutor(testClasses(), 1);
+	std::atomic<bool> release(false);
+	std::atomic<int> count(0);
+	std::mutex orderMutex;
+	std::vector<int> order;
+
+	// hold the only worker while the rest are queued
+	testExecutor.submit(0, [&]() {
+		while (release == false) {
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		}
+		count++;
+	});
+	std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+	for (int taskClass = 0; taskClass < 3; taskClass++) {
+		testExecutor.submit(taskClass, [&, taskClass]() {
+			std::lock_guard<std::mutex> orderGuard(orderMutex);
+			order.push_back(taskClass);
+			count++;
+		});
+	}
+	release = true;
+
+	ASSERT_TRUE(waitFor(count, 4))<< "all tasks ran";
+	ASSERT_EQ(3, order.size())<< "order size";
+	ASSERT_EQ(1, order[0])<< "high first";
+	ASSERT_EQ(2, order[1])<< "capped second";
+	ASSERT_EQ(0, order[2])<< "low last";
+}
+
+// test that a stopped executor takes no more work
+TEST(ExecutorTest, Stop) {
+	glassutil::CLogit::disable();
+
+	glassutil::CExecutor testExecutor(testClasses(), NUMTHREADS);
+	testExecutor.stop();
+
+	ASSERT_FALSE(testExecutor.submit(0, []() {}))<< "submit after stop";
+	ASSERT_FALSE(testExecutor.statusCheck())<< "status check after stop";
+
+	// stopping again is harmless
+	testExecutor.stop();
+}
@@ -0,0 +1,100 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include <vector>
+#include "Geo.h"
+#include "GeoPoint.h"
+#include "Logit.h"
+
+#define DISTLAT1 0
+#define DISTLON1 0
+
+#define DISTLAT2 42.113419953573087
+#define DISTLON2 -122.56219953573087
+
+#define DISTANCE 113.60733936060119
+#define AZIMUTH 316.81332287453034
+
+#define DEG2RAD	0.01745329251994
+
+// test to see if the point can be constructed
+TEST(GeoPointTest, Construction) {
+	glassutil::CLogit::disable();
+
+	glassutil::CGeoPoint testPoint;
+
+	// default is latitude 0, longitude 0
+	ASSERT_NEAR(1.0, testPoint.uX, 1e-12)<< "uX is one";
+	ASSERT_NEAR(0.0, testPoint.uY, 1e-12)<< "uY is zero";
+	ASSERT_NEAR(0.0, testPoint.uZ, 1e-12)<< "uZ is zero";
+	ASSERT_NEAR(0.0, testPoint.dSinLat, 1e-12)<< "dSinLat is zero";
+	ASSERT_NEAR(1.0, testPoint.dCosLat, 1e-12)<< "dCosLat is one";
+
+	// construct from a CGeo
+	glassutil::CGeo testGeo;
+	testGeo.setGeographic(DISTLAT2, DISTLON2, 6371.0);
+	glassutil::CGeoPoint geoPoint(testGeo);
+	ASSERT_NEAR(testGeo.uX, geoPoint.uX, 1e-12)<< "uX matches CGeo";
+	ASSERT_NEAR(testGeo.uY, geoPoint.uY, 1e-12)<< "uY matches CGeo";
+	ASSERT_NEAR(testGeo.uZ, geoPoint.uZ, 1e-12)<< "uZ matches CGeo";
+}
+
+// test distance and azimuth
+TEST(GeoPointTest, DistanceAzimuth) {
+	glassutil::CLogit::disable();
+
+	glassutil::CGeoPoint point1;
+	point1.setGeographic(DISTLAT1, DISTLON1);
+
+	glassutil::CGeoPoint point2;
+	point2.setGeographic(DISTLAT2, DISTLON2);
+
+	// same values as CGeo
+	ASSERT_NEAR(DISTANCE, point1.delta(point2) / DEG2RAD, 1e-6)<< "delta";
+	ASSERT_NEAR(AZIMUTH, point1.azimuth(point2) / DEG2RAD, 1e-6)<< "azimuth";
+
+	// zero distance to itself
+	ASSERT_EQ(0.0, point1.delta(point1))<< "self delta";
+}
+
+// test that the kernels match CGeo over the globe
+TEST(GeoPointTest, MatchesGeo) {
+	glassutil::CLogit::disable();
+
+	std::vector<glassutil::CGeo> geos;
+	std::vector<glassutil::CGeoPoint> points;
+	for (double lat = -85.0; lat <= 85.0; lat += 17.0) {
+		for (double lon = -175.0; lon <= 180.0; lon += 35.0) {
+			glassutil::CGeo geo;
+			geo.setGeographic(lat, lon, 6371.0);
+			geos.push_back(geo);
+
+			glassutil::CGeoPoint point;
+			point.setGeographic(lat, lon);
+			points.push_back(point);
+		}
+	}
+
+	std::vector<double> deltas;
+	std::vector<double> azimuths;
+	for (int i = 0; i < static_cast<int>(points.size()); i++) {
+		points[i].deltas(points, &deltas);
+		points[i].azimuths(points, &azimuths);
+		ASSERT_EQ(points.size(), deltas.size())<< "deltas size";
+		ASSERT_EQ(points.size(), azimuths.size())<< "azimuths size";
+
+		for (int j = 0; j < static_cast<int>(points.size()); j++) {
+			ASSERT_NEAR(geos[i].delta(&geos[j]), deltas[j], 1e-7)<< "delta";
+			ASSERT_NEAR(deltas[j], points[i].delta(points[j]), 1e-12)<<
+					"batched delta";
+
+			// azimuth is undefined for coincident points
+			if (i == j) {
+				continue;
+			}
+			// compare around the circle, due north can be 0 or 2 pi
+			double diff = std::fabs(geos[i].azimuth(&geos[j]) - azimuths[j]);
+			diff = std::fmin(diff, std::fabs(diff - TWOPI));
+			ASSERT_NEAR(0.0, diff, 1e-7)<< "azimuth";
+		}
+	}
+}
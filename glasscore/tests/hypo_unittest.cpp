@@ -1,10 +1,16 @@
 #include <gtest/gtest.h>
+#include <cmath>
 #include <memory>
 #include <string>
+#include <thread>
+#include <vector>
 #include "Site.h"
 #include "SiteList.h"
 #include "Pick.h"
 #include "Hypo.h"
+#include "HypoList.h"
+#include "Glass.h"
+#include "TTT.h"
 #include "Logit.h"
 
 #define LATITUDE -21.849968
@@ -26,6 +32,12 @@
 #define PICK3JSON "{\"ID\":\"20682833\",\"Phase\":\"P\",\"Polarity\":\"up\",\"Site\":{\"Channel\":\"BHZ\",\"Location\":\"00\",\"Network\":\"US\",\"Station\":\"BOZ\"},\"Source\":{\"AgencyID\":\"228041013\",\"Author\":\"228041013\"},\"Time\":\"2014-12-23T00:03:43.599Z\",\"Type\":\"Pick\"}"  // NOLINT
 #define MAXNPICK 3
 
+#define TESTPATH "testdata"
+#define PHASEFILENAME "P.trv"
+#define NREFINESITES 16
+#define NRESOLVETHREADS 4
+#define NRESOLVECYCLES 50
+
 // NOTE: Need to consider testing associate, prune, affinity, anneal, localize,
 // focus, iterate, weights, and evaluate functions,
 // but that would need a much more involved set of real data, and possibly
@@ -191,3 +203,225 @@ TEST(HypoTest, PickOperations) {
 	expectedSize = 1;
 	ASSERT_EQ(expectedSize, testHypo->getVPickSize())<< "hypo has only one pick";
 }
+
+// test to see if refineLocate converges on a synthetic event
+TEST(HypoTest, RefineLocate) {
+	glassutil::CLogit::disable();
+
+	glasscore::CGlass testGlass;
+
+	// travel times
+	std::string phasefile = "./" + std::string(TESTPATH) + "/"
+			+ std::string(PHASEFILENAME);
+	std::shared_ptr<traveltime::CTTT> ttt =
+			std::make_shared<traveltime::CTTT>();
+	ASSERT_TRUE(ttt->addPhase("P", NULL, NULL, phasefile))<< "P loaded";
+	std::shared_ptr<traveltime::CTravelTime> trav = std::make_shared<
+			traveltime::CTravelTime>();
+	ASSERT_TRUE(trav->setup("P", phasefile))<< "P nucleation loaded";
+	std::shared_ptr<traveltime::CTravelTime> nullTrav;
+
+	// a ring of sites around the event with exact P picks
+	double trueDepth = 30.0;
+	ttt->setOrigin(LATITUDE, LONGITUDE, trueDepth);
+	std::vector<std::shared_ptr<glasscore::CSite>> sites;
+	std::vector<std::shared_ptr<glasscore::CPick>> picks;
+	for (int i = 0; i < NREFINESITES; i++) {
+		double azimuth = DEG2RAD * 360.0 * i / NREFINESITES;
+		double distance = 1.0 + 0.5 * i;
+		std::shared_ptr<glasscore::CSite> site = std::make_shared<
+				glasscore::CSite>("S" + std::to_string(i), "BHZ", "XX", "",
+									LATITUDE + distance * cos(azimuth),
+									LONGITUDE + distance * sin(azimuth), 0.0,
+									1.0, true, true, &testGlass);
+		double travelTime = ttt->T(&site->getGeo(), "P");
+		ASSERT_GT(travelTime, 0.0)<< "valid travel time";
+
+		// picks only hold weak pointers to their sites
+		sites.push_back(site);
+
+		picks.push_back(
+				std::make_shared<glasscore::CPick>(site, TIME + travelTime, i,
+													std::to_string(i), -1.0,
+													-1.0));
+	}
+
+	// start the hypo off the true location
+	glasscore::CHypo testHypo(LATITUDE + 0.1, LONGITUDE - 0.1, trueDepth + 10.0,
+								TIME + 1.0, std::string(ID), std::string(WEB),
+								BAYES, THRESH, CUT, trav, nullTrav, ttt);
+	testHypo.setGlass(&testGlass);
+	for (auto pick : picks) {
+		testHypo.addPick(pick);
+	}
+
+	double bayesStart = testHypo.getBayes(testHypo.getLat(), testHypo.getLon(),
+											testHypo.getZ(),
+											testHypo.getTOrg(), 0);
+	testHypo.refineLocate(50);
+
+	// converges on the true location, every pick fits
+	ASSERT_NEAR(LATITUDE, testHypo.getLat(), 0.01)<< "refined latitude";
+	ASSERT_NEAR(LONGITUDE, testHypo.getLon(), 0.01)<< "refined longitude";
+	ASSERT_NEAR(trueDepth, testHypo.getZ(), 2.0)<< "refined depth";
+	ASSERT_NEAR(TIME, testHypo.getTOrg(), 0.2)<< "refined time";
+	ASSERT_GT(testHypo.getBayes(), bayesStart)<< "bayes improved";
+	ASSERT_NEAR(NREFINESITES, testHypo.getBayes(), 0.1)<< "refined bayes";
+}
+
+// test to see if competing hypos resolve their picks in parallel and agree
+TEST(HypoTest, ConcurrentResolve) {
+	glassutil::CLogit::disable();
+
+	glasscore::CGlass testGlass;
+	testGlass.getHypoList() = new glasscore::CHypoList(0);
+	testGlass.getHypoList()->setGlass(&testGlass);
+
+	// travel times
+	std::string phasefile = "./" + std::string(TESTPATH) + "/"
+			+ std::string(PHASEFILENAME);
+	std::shared_ptr<traveltime::CTTT> ttt =
+			std::make_shared<traveltime::CTTT>();
+	ASSERT_TRUE(ttt->addPhase("P", NULL, NULL, phasefile))<< "P loaded";
+	std::shared_ptr<traveltime::CTravelTime> trav = std::make_shared<
+			traveltime::CTravelTime>();
+	ASSERT_TRUE(trav->setup("P", phasefile))<< "P nucleation loaded";
+	std::shared_ptr<traveltime::CTravelTime> nullTrav;
+
+	// a ring of sites around the event with exact P picks
+	ttt->setOrigin(LATITUDE, LONGITUDE, DEPTH);
+	std::vector<std::shared_ptr<glasscore::CSite>> sites;
+	std::vector<std::shared_ptr<glasscore::CPick>> picks;
+	for (int i = 0; i < NREFINESITES; i++) {
+		double azimuth = DEG2RAD * 360.0 * i / NREFINESITES;
+		double distance = 1.0 + 0.5 * i;
+		std::shared_ptr<glasscore::CSite> site = std::make_shared<
+				glasscore::CSite>("S" + std::to_string(i), "BHZ", "XX", "",
+									LATITUDE + distance * cos(azimuth),
+									LONGITUDE + distance * sin(azimuth), 0.0,
+									1.0, true, true, &testGlass);
+		double travelTime = ttt->T(&site->getGeo(), "P");
+		sites.push_back(site);
+		picks.push_back(
+				std::make_shared<glasscore::CPick>(site, TIME + travelTime, i,
+													std::to_string(i), -1.0,
+													-1.0));
+	}
+
+	// hypos near the event competing for every pick, each starting out
+	// linked to some of them
+	std::vector<std::shared_ptr<glasscore::CHypo>> hypos;
+	for (int i = 0; i < NRESOLVETHREADS; i++) {
+		std::shared_ptr<glasscore::CHypo> hypo = std::make_shared<
+				glasscore::CHypo>(LATITUDE + 0.2 * i, LONGITUDE, DEPTH,
+									TIME + 0.5 * i, std::to_string(i),
+									std::string(WEB), BAYES, THRESH, CUT, trav,
+									nullTrav, ttt);
+		hypo->setGlass(&testGlass);
+		for (int j = 0; j < NREFINESITES; j++) {
+			hypo->addPick(picks[j]);
+			if (j % NRESOLVETHREADS == i) {
+				picks[j]->addHypo(hypo);
+			}
+		}
+		hypos.push_back(hypo);
+	}
+
+	// resolve every hypo at once, over and over
+	std::vector<std::thread> threads;
+	for (int i = 0; i < NRESOLVETHREADS; i++) {
+		threads.push_back(std::thread([&hypos, i]() {
+			for (int cycle = 0; cycle < NRESOLVECYCLES; cycle++) {
+				hypos[i]->resolve(hypos[i]);
+			}
+		}));
+	}
+	for (auto &thread : threads) {
+		thread.join();
+	}
+
+	// every pick belongs to exactly one hypo, the one it is linked to
+	for (auto pick : picks) {
+		std::shared_ptr<glasscore::CHypo> pickHypo = pick->getHypo();
+		ASSERT_TRUE(pickHypo != NULL)<< "pick linked";
+
+		for (auto hypo : hypos) {
+			ASSERT_EQ(hypo == pickHypo, hypo->hasPick(pick))<<
+					"pick only in its hypo";
+		}
+	}
+}
+
+// test to see if the incremental statistics match a full recomputation
+TEST(HypoTest, IncrementalStats) {
+	glassutil::CLogit::disable();
+
+	glasscore::CGlass testGlass;
+	std::shared_ptr<traveltime::CTravelTime> nullTrav;
+	std::shared_ptr<traveltime::CTTT> nullTTT;
+
+	// sites at increasing distance and uneven azimuth around the hypo
+	std::vector<std::shared_ptr<glasscore::CSite>> sites;
+	std::vector<std::shared_ptr<glasscore::CPick>> picks;
+	for (int i = 0; i < NREFINESITES; i++) {
+		double azimuth = DEG2RAD * 200.0 * i / NREFINESITES;
+		double distance = 1.0 + 0.5 * i;
+		std::shared_ptr<glasscore::CSite> site = std::make_shared<
+				glasscore::CSite>("S" + std::to_string(i), "BHZ", "XX", "",
+									LATITUDE + distance * cos(azimuth),
+									LONGITUDE + distance * sin(azimuth), 0.0,
+									1.0, true, true, &testGlass);
+		sites.push_back(site);
+		picks.push_back(
+				std::make_shared<glasscore::CPick>(site, TIME + 10.0 * i, i,
+													std::to_string(i), -1.0,
+													-1.0));
+	}
+
+	// a hypo that keeps its statistics up to date as picks come and go
+	glasscore::CHypo testHypo(LATITUDE, LONGITUDE, DEPTH, TIME, std::string(ID),
+								std::string(WEB), BAYES, THRESH, CUT, nullTrav,
+								nullTrav, nullTTT);
+	testHypo.addPick(picks[0]);
+	testHypo.stats();
+	for (int i = 1; i < NREFINESITES; i++) {
+		testHypo.addPick(picks[i]);
+	}
+	testHypo.remPick(picks[NREFINESITES - 1]);
+	testHypo.remPick(picks[3]);
+	testHypo.stats();
+
+	// and one that computes them from scratch
+	glasscore::CHypo freshHypo(LATITUDE, LONGITUDE, DEPTH, TIME,
+								std::string(ID), std::string(WEB), BAYES, THRESH,
+								CUT, nullTrav, nullTrav, nullTTT);
+	for (int i = 0; i < NREFINESITES - 1; i++) {
+		if (i != 3) {
+			freshHypo.addPick(picks[i]);
+		}
+	}
+	freshHypo.stats();
+
+	ASSERT_NEAR(freshHypo.getMin(), testHypo.getMin(), 1.0e-9)<< "min";
+	ASSERT_NEAR(freshHypo.getMed(), testHypo.getMed(), 1.0e-9)<< "median";
+	ASSERT_NEAR(freshHypo.getSig(), testHypo.getSig(), 1.0e-9)<< "sigma";
+	ASSERT_NEAR(freshHypo.getKrt(), testHypo.getKrt(), 1.0e-6)<< "kurtosis";
+	ASSERT_NEAR(freshHypo.getGap(), testHypo.getGap(), 1.0e-9)<< "gap";
+	ASSERT_GT(testHypo.getGap(), 160.0)<< "gap size";
+
+	// moving the hypo rebuilds the statistics
+	testHypo.setLat(LATITUDE + 1.0);
+	freshHypo.setLat(LATITUDE + 1.0);
+	testHypo.stats();
+	freshHypo.clearPicks();
+	for (int i = 0; i < NREFINESITES - 1; i++) {
+		if (i != 3) {
+			freshHypo.addPick(picks[i]);
+		}
+	}
+	freshHypo.stats();
+	ASSERT_NEAR(freshHypo.getMed(), testHypo.getMed(), 1.0e-9)<<
+			"median after move";
+	ASSERT_NEAR(freshHypo.getGap(), testHypo.getGap(), 1.0e-9)<<
+			"gap after move";
+}
@@ -1,11 +1,19 @@
 #include <gtest/gtest.h>
+#include <chrono>
+#include <cmath>
 #include <memory>
 #include <string>
+#include <thread>
+#include <vector>
 #include "Site.h"
 #include "SiteList.h"
 #include "Hypo.h"
 #include "HypoList.h"
 #include "Pick.h"
+#include "PickList.h"
+#include "CorrelationList.h"
+#include "Glass.h"
+#include "TTT.h"
 #include "Logit.h"
 
 #define TESTHYPOID "3"
@@ -19,6 +27,13 @@
 
 #define MAXNHYPO 5
 
+#define TESTPATH "testdata"
+#define PHASEFILENAME "P.trv"
+#define NBENCHHYPOS 32
+#define NBENCHSITES 20
+#define NBENCHROUNDS 5
+#define BENCHSPACING 3000.0
+
 // NOTE: Need to consider testing associate, resolve, darwin, and evolve
 // functions, but that would need a much more involved set of real data,
 // not this simple setup.
@@ -145,3 +160,189 @@ TEST(HypoListTest, HypoOperations) {
 	// cleanup
 	delete (testHypoList);
 }
+
+// test keeping the time index in order as hypos relocate
+TEST(HypoListTest, TimeIndex) {
+	glassutil::CLogit::disable();
+
+	std::shared_ptr<traveltime::CTravelTime> nullTrav;
+	std::shared_ptr<traveltime::CTTT> nullTTT;
+
+	std::shared_ptr<glasscore::CHypo> hypo1 =
+			std::make_shared<glasscore::CHypo>(-21.84, 170.03, 10.0,
+												3648585210.926340, "1", "Test",
+												0.0, 0.5, 6, nullTrav, nullTrav,
+												nullTTT);
+	std::shared_ptr<glasscore::CHypo> hypo2 =
+			std::make_shared<glasscore::CHypo>(22.84, 70.03, 12.0,
+												3648585222.926340, "2", "Test",
+												0.0, 0.5, 6, nullTrav, nullTrav,
+												nullTTT);
+
+	glasscore::CHypoList * testHypoList = new glasscore::CHypoList();
+	testHypoList->setNHypoMax(MAXNHYPO);
+	testHypoList->addHypo(hypo1, false);
+	testHypoList->addHypo(hypo2, false);
+
+	// move the first hypo after the second
+	testHypoList->moveHypo(hypo1.get(), 3648585210.926340, 3648585230.0);
+
+	std::vector<std::weak_ptr<glasscore::CHypo>> hypos = testHypoList->getHypos(
+			TSTART, TEND);
+	ASSERT_EQ(2, static_cast<int>(hypos.size()))<< "both hypos in range";
+	ASSERT_STREQ("2", hypos[0].lock()->getPid().c_str())<< "hypo 2 first";
+	ASSERT_STREQ("1", hypos[1].lock()->getPid().c_str())<< "hypo 1 second";
+	ASSERT_STREQ("2", testHypoList->findHypo(TSTART, TEND)->getPid().c_str())<<
+			"find hypo 2";
+
+	// find the closest hypo to a location
+	ASSERT_STREQ("1", testHypoList->findHypo(TSTART, TEND, -21.0, 170.0, 5.0)
+			->getPid().c_str())<< "find hypo 1 by location";
+	ASSERT_STREQ("2", testHypoList->findHypo(TSTART, TEND, 22.0, 70.0, 5.0)
+			->getPid().c_str())<< "find hypo 2 by location";
+	ASSERT_TRUE(testHypoList->findHypo(TSTART, TEND, 0.0, 0.0, 5.0) == NULL)<<
+			"no hypo near location";
+
+	// a move from a stale origin time is ignored
+	testHypoList->moveHypo(hypo1.get(), 3648585210.926340, 3648585200.0);
+	ASSERT_EQ(0, testHypoList->indexHypo(3648585225.0))<<
+			"hypo 1 not moved";
+
+	// removing a moved hypo
+	testHypoList->remHypo(hypo1);
+	ASSERT_EQ(1, testHypoList->getVHypoSize())<< "hypo 1 removed";
+	ASSERT_TRUE(testHypoList->findHypo(3648585225.0, TEND) == NULL)<<
+			"hypo 1 not found";
+
+	// cleanup
+	delete (testHypoList);
+}
+
+// time darwin over a fixed set of independent hypos with each number of hypo
+// threads, run with --gtest_also_run_disabled_tests to measure the scaling.
+// It only measures, and shows no scaling on a machine with a single core
+TEST(HypoListTest, DISABLED_DarwinScaling) {
+	glassutil::CLogit::disable();
+
+	// travel times
+	std::string phasefile = "./" + std::string(TESTPATH) + "/"
+			+ std::string(PHASEFILENAME);
+	std::shared_ptr<traveltime::CTTT> ttt =
+			std::make_shared<traveltime::CTTT>();
+	ASSERT_TRUE(ttt->addPhase("P", NULL, NULL, phasefile))<< "P loaded";
+	std::shared_ptr<traveltime::CTravelTime> trav = std::make_shared<
+			traveltime::CTravelTime>();
+	ASSERT_TRUE(trav->setup("P", phasefile))<< "P nucleation loaded";
+	std::shared_ptr<traveltime::CTravelTime> nullTrav;
+
+	int threadCounts[] = { 1, 2, 4 };
+	for (int numThreads : threadCounts) {
+		glasscore::CGlass testGlass;
+		testGlass.piSend = NULL;
+		testGlass.getPickList() = new glasscore::CPickList(0);
+		testGlass.getPickList()->setGlass(&testGlass);
+		testGlass.getCorrelationList() = new glasscore::CCorrelationList();
+		testGlass.getCorrelationList()->setGlass(&testGlass);
+		testGlass.getHypoList() = new glasscore::CHypoList(numThreads, 1);
+		testGlass.getHypoList()->setGlass(&testGlass);
+
+		// each hypo has its own ring of sites with exact P picks, far enough
+		// apart in time that no hypo can take another's picks
+		std::vector<std::shared_ptr<glasscore::CSite>> sites;
+		std::vector<std::shared_ptr<glasscore::CPick>> picks;
+		std::vector<std::shared_ptr<glasscore::CHypo>> hypos;
+		for (int h = 0; h < NBENCHHYPOS; h++) {
+			double lat = -60.0 + 4.0 * (h % 30);
+			double lon = -170.0 + 10.0 * h;
+			double tOrg = TORG + BENCHSPACING * h;
+			ttt->setOrigin(lat, lon, 10.0);
+
+			std::shared_ptr<glasscore::CHypo> hypo = std::make_shared<
+					glasscore::CHypo>(lat + 0.1, lon + 0.1, 10.0, tOrg + 1.0,
+										std::to_string(h), "Bench", NBENCHSITES,
+										0.5, 6, trav, nullTrav, ttt);
+			hypo->setGlass(&testGlass);
+
+			for (int i = 0; i < NBENCHSITES; i++) {
+				double azimuth = DEG2RAD * 360.0 * i / NBENCHSITES;
+				double distance = 1.0 + 0.5 * i;
+				std::shared_ptr<glasscore::CSite> site = std::make_shared<
+						glasscore::CSite>(
+						"S" + std::to_string(h) + "_" + std::to_string(i),
+						"BHZ", "XX", "", lat + distance * cos(azimuth),
+						lon + distance * sin(azimuth), 0.0, 1.0, true, true,
+						&testGlass);
+				double travelTime = ttt->T(&site->getGeo(), "P");
+				std::shared_ptr<glasscore::CPick> pick = std::make_shared<
+						glasscore::CPick>(site, tOrg + travelTime,
+											h * NBENCHSITES + i,
+											std::to_string(h * NBENCHSITES + i),
+											-1.0, -1.0);
+				site->addPick(pick);
+				hypo->addPick(pick);
+				pick->addHypo(hypo);
+				sites.push_back(site);
+				picks.push_back(pick);
+			}
+
+			// settle the hypo the way nucleation does before it is added
+			hypo->anneal();
+			hypos.push_back(hypo);
+		}
+
+		std::chrono::high_resolution_clock::time_point tStart =
+				std::chrono::high_resolution_clock::now();
+
+		for (int round = 0; round < NBENCHROUNDS; round++) {
+			// schedule every hypo, letting each evolve again
+			for (auto hypo : hypos) {
+				hypo->setCycle(0);
+				if (round == 0) {
+					testGlass.getHypoList()->addHypo(hypo);
+				} else {
+					testGlass.getHypoList()->pushFifo(hypo);
+				}
+			}
+
+			// wait for the hypo threads to evolve each of them once
+			bool busy = true;
+			while (busy) {
+				std::this_thread::sleep_for(std::chrono::milliseconds(1));
+				busy = false;
+				for (auto hypo : hypos) {
+					busy = busy || (hypo->getProcessCount() <= round)
+							|| hypo->isLockedForProcessing();
+				}
+			}
+		}
+
+		double elapsed = std::chrono::duration_cast<
+				std::chrono::duration<double>>(
+				std::chrono::high_resolution_clock::now() - tStart).count();
+
+		int processed = 0;
+		for (auto hypo : hypos) {
+			processed += hypo->getProcessCount();
+		}
+
+		// report through the glass log, which the rest of the test keeps
+		// disabled
+		glassutil::CLogit::enable();
+		glassutil::CLogit::log(
+				glassutil::log_level::info,
+				"HypoListTest::DarwinScaling: NumHypoThreads:"
+						+ std::to_string(numThreads) + " evolves:"
+						+ std::to_string(processed) + " seconds:"
+						+ std::to_string(elapsed) + " evolves/s:"
+						+ std::to_string(processed / elapsed));
+		glassutil::CLogit::disable();
+
+		// let go of the hypos before the lists are deleted
+		for (auto hypo : hypos) {
+			hypo->clear();
+		}
+		for (auto pick : picks) {
+			pick->clearHypo();
+		}
+	}
+}
@@ -0,0 +1,113 @@
+#include <gtest/gtest.h>
+#include <string>
+#include "HypoQueue.h"
+#include "Logit.h"
+
+#define TNOW 1000.0
+
+// test to see if the queue can be constructed
+TEST(HypoQueueTest, Construction) {
+	glassutil::CLogit::disable();
+
+	glasscore::CHypoQueue testQueue;
+
+	ASSERT_EQ(0, testQueue.size())<< "size";
+	ASSERT_STREQ("", testQueue.pop().c_str())<< "pop empty";
+	ASSERT_FALSE(testQueue.contains("A"))<< "contains";
+}
+
+// test that the queue is a fifo when there are no priorities
+TEST(HypoQueueTest, Fifo) {
+	glassutil::CLogit::disable();
+
+	glasscore::CHypoQueue testQueue;
+
+	ASSERT_TRUE(testQueue.push("A", 0.0, TNOW))<< "push A";
+	ASSERT_TRUE(testQueue.push("B", 0.0, TNOW))<< "push B";
+	ASSERT_TRUE(testQueue.push("C", 0.0, TNOW))<< "push C";
+
+	// pushing a queued hypo doesn't add or reorder it
+	ASSERT_FALSE(testQueue.push("A", 0.0, TNOW))<< "push A again";
+	ASSERT_EQ(3, testQueue.size())<< "size";
+
+	ASSERT_STREQ("A", testQueue.pop().c_str())<< "pop A";
+	ASSERT_STREQ("B", testQueue.pop().c_str())<< "pop B";
+	ASSERT_STREQ("C", testQueue.pop().c_str())<< "pop C";
+	ASSERT_EQ(0, testQueue.size())<< "size after pop";
+}
+
+// test that higher priority hypos pop first
+TEST(HypoQueueTest, Priority) {
+	glassutil::CLogit::disable();
+
+	glasscore::CHypoQueue testQueue;
+
+	testQueue.push("A", 1.0, TNOW);
+	testQueue.push("B", 3.0, TNOW);
+	testQueue.push("C", 2.0, TNOW);
+
+	// raising a priority moves the hypo ahead
+	testQueue.push("A", 4.0, TNOW);
+
+	ASSERT_STREQ("A", testQueue.pop().c_str())<< "pop A";
+	ASSERT_STREQ("B", testQueue.pop().c_str())<< "pop B";
+	ASSERT_STREQ("C", testQueue.pop().c_str())<< "pop C";
+}
+
+// test removing hypos from the queue
+TEST(HypoQueueTest, Remove) {
+	glassutil::CLogit::disable();
+
+	glasscore::CHypoQueue testQueue;
+
+	testQueue.push("A", 1.0, TNOW);
+	testQueue.push("B", 2.0, TNOW);
+	testQueue.push("C", 3.0, TNOW);
+	testQueue.push("D", 4.0, TNOW);
+
+	ASSERT_TRUE(testQueue.remove("C"))<< "remove C";
+	ASSERT_FALSE(testQueue.remove("C"))<< "remove C again";
+	ASSERT_FALSE(testQueue.contains("C"))<< "contains C";
+	ASSERT_EQ(3, testQueue.size())<< "size";
+
+	ASSERT_STREQ("D", testQueue.pop().c_str())<< "pop D";
+	ASSERT_STREQ("B", testQueue.pop().c_str())<< "pop B";
+	ASSERT_STREQ("A", testQueue.pop().c_str())<< "pop A";
+
+	// clear keeps nothing
+	testQueue.push("A", 1.0, TNOW);
+	testQueue.clear();
+	ASSERT_EQ(0, testQueue.size())<< "size after clear";
+}
+
+// test the data and aging weights
+TEST(HypoQueueTest, Weights) {
+	glassutil::CLogit::disable();
+
+	glasscore::CHypoQueue testQueue;
+
+	// new data moves a hypo ahead
+	testQueue.setWeights(1.0, 0.0);
+	testQueue.push("A", 1.0, TNOW);
+	testQueue.push("B", 1.5, TNOW);
+	testQueue.push("A", 1.0, TNOW);
+
+	ASSERT_STREQ("A", testQueue.pop().c_str())<< "pop A with data";
+	ASSERT_STREQ("B", testQueue.pop().c_str())<< "pop B with data";
+
+	// a hypo that has waited long enough beats a higher priority one
+	testQueue.setWeights(0.0, 1.0);
+	testQueue.push("A", 1.0, TNOW);
+	testQueue.push("B", 5.0, TNOW + 10.0);
+
+	ASSERT_STREQ("A", testQueue.pop().c_str())<< "pop A with aging";
+	ASSERT_STREQ("B", testQueue.pop().c_str())<< "pop B with aging";
+
+	// changing the weights reorders queued hypos
+	testQueue.push("A", 1.0, TNOW);
+	testQueue.push("B", 5.0, TNOW + 10.0);
+	testQueue.setWeights(0.0, 0.0);
+
+	ASSERT_STREQ("B", testQueue.pop().c_str())<< "pop B without aging";
+	ASSERT_STREQ("A", testQueue.pop().c_str())<< "pop A without aging";
+}
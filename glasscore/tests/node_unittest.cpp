@@ -1,6 +1,8 @@
 #include <gtest/gtest.h>
 #include <memory>
 #include <string>
+#include <thread>
+#include <vector>
 #include "Node.h"
 #include "Site.h"
 #include "Logit.h"
@@ -94,3 +96,37 @@ TEST(NodeTest, SiteOperations) {
 	expectedSize = 0;
 	ASSERT_EQ(expectedSize, testNode->getSiteLinksCount())<< "sitelist cleared";
 }
+
+// tests destroying linked nodes and sites at the same time
+TEST(NodeTest, ConcurrentTeardown) {
+	glassutil::CLogit::disable();
+
+	std::shared_ptr<json::Object> siteJSON = std::make_shared<json::Object>(
+			json::Object(json::Deserialize(std::string(SITEJSON))));
+
+	for (int round = 0; round < 20; round++) {
+		// link every node to every site
+		std::vector<std::shared_ptr<glasscore::CNode>> nodes;
+		std::vector<std::shared_ptr<glasscore::CSite>> sites;
+		for (int i = 0; i < 20; i++) {
+			sites.push_back(std::make_shared<glasscore::CSite>(siteJSON, nullptr));
+		}
+		for (int i = 0; i < 20; i++) {
+			std::shared_ptr<glasscore::CNode> node = std::make_shared<
+					glasscore::CNode>(std::string(NAME), LATITUDE, LONGITUDE,
+										DEPTH, RESOLUTION, std::to_string(i));
+			for (auto site : sites) {
+				node->linkSite(site, node, TRAVELTIME);
+			}
+			nodes.push_back(node);
+		}
+		ASSERT_EQ(20, sites[0]->getNodeLinksCount())<< "site linked";
+
+		// drop the nodes and the sites from two threads at once, as when a
+		// web is removed while the site list drops its sites
+		std::thread nodeThread([&nodes]() {nodes.clear();});
+		std::thread siteThread([&sites]() {sites.clear();});
+		nodeThread.join();
+		siteThread.join();
+	}
+}
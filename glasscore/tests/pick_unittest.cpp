@@ -178,4 +178,17 @@ TEST(PickTest, HypoOperations) {
 
 	// check hypo
 	ASSERT_TRUE(testPick->getHypo() == NULL)<< "pHypo null";
+
+	// move the pick only if it is linked to the expected hypo
+	std::shared_ptr<glasscore::CHypo> sharedHypo2 = std::make_shared<
+			glasscore::CHypo>(0.0, 0.0, 0.0, 0.0, "2", "test", 0.0, 0.0, 0,
+								nullTrav, nullTrav, nullTTT);
+	ASSERT_TRUE(testPick->replaceHypo(NULL, sharedHypo))<< "claim unlinked";
+	ASSERT_FALSE(testPick->replaceHypo(NULL, sharedHypo2))<< "claim linked";
+	ASSERT_TRUE(testPick->replaceHypo(sharedHypo, sharedHypo2))<< "move";
+	ASSERT_TRUE(testPick->getHypo() == sharedHypo2)<< "pHypo moved";
+
+	// removing another hypo leaves the link alone
+	testPick->remHypo(sharedHypo);
+	ASSERT_TRUE(testPick->getHypo() == sharedHypo2)<< "pHypo kept";
 }
@@ -0,0 +1,113 @@
+#include <gtest/gtest.h>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <set>
+#include <vector>
+#include "Pool.h"
+#include "Logit.h"
+
+#define BLOCKSIZE 24
+#define BLOCKSPERSLAB 8
+
+// a small type to allocate from a pool
+struct PoolTestObject {
+	explicit PoolTestObject(int value)
+			: nValue(value) {
+	}
+	int nValue;
+	double dPad[3];
+};
+
+// test to see if the pool can be constructed
+TEST(PoolTest, Construction) {
+	glassutil::CLogit::disable();
+
+	glassutil::CSlabPool testPool(BLOCKSIZE, BLOCKSPERSLAB);
+
+	// block size is rounded up to the alignment
+	ASSERT_GE(testPool.getBlockSize(), BLOCKSIZE)<< "block size";
+	ASSERT_EQ(0, testPool.getBlockSize() % alignof(std::max_align_t))<<
+			"block size aligned";
+
+	// nothing allocated yet
+	ASSERT_EQ(0, testPool.getUsedCount())<< "used count";
+	ASSERT_EQ(sizeof(glassutil::CSlabPool), testPool.getMemoryUsage())<<
+			"memory usage";
+}
+
+// test allocating and freeing blocks
+TEST(PoolTest, AllocateDeallocate) {
+	glassutil::CLogit::disable();
+
+	glassutil::CSlabPool testPool(BLOCKSIZE, BLOCKSPERSLAB);
+
+	// allocate more than one slab of distinct, aligned blocks
+	std::set<void *> blocks;
+	for (int i = 0; i < BLOCKSPERSLAB * 2 + 1; i++) {
+		void * block = testPool.allocate();
+		ASSERT_TRUE(block != NULL)<< "block allocated";
+		ASSERT_EQ(0, reinterpret_cast<std::uintptr_t>(block)
+				% alignof(std::max_align_t))<< "block aligned";
+		blocks.insert(block);
+	}
+	ASSERT_EQ(BLOCKSPERSLAB * 2 + 1, blocks.size())<< "blocks distinct";
+	ASSERT_EQ(BLOCKSPERSLAB * 2 + 1, testPool.getUsedCount())<< "used count";
+
+	size_t usage = testPool.getMemoryUsage();
+	ASSERT_GE(usage, testPool.getBlockSize() * BLOCKSPERSLAB * 3)<<
+			"memory usage";
+
+	// free them all
+	for (auto block : blocks) {
+		testPool.deallocate(block);
+	}
+	ASSERT_EQ(0, testPool.getUsedCount())<< "used count after free";
+
+	// freed blocks are reused without growing the pool
+	for (int i = 0; i < BLOCKSPERSLAB * 2 + 1; i++) {
+		void * block = testPool.allocate();
+		ASSERT_TRUE(blocks.find(block) != blocks.end())<< "block reused";
+	}
+	ASSERT_EQ(usage, testPool.getMemoryUsage())<< "pool did not grow";
+}
+
+// test the allocator with std::allocate_shared
+TEST(PoolTest, Allocator) {
+	glassutil::CLogit::disable();
+
+	glassutil::CPoolAllocator<PoolTestObject> allocator;
+
+	std::vector<std::shared_ptr<PoolTestObject>> objects;
+	for (int i = 0; i < 100; i++) {
+		objects.push_back(
+				std::allocate_shared<PoolTestObject>(allocator, i));
+	}
+
+	for (int i = 0; i < 100; i++) {
+		ASSERT_EQ(i, objects[i]->nValue)<< "object value";
+	}
+
+	// all memory comes from the pools
+	size_t usage = glassutil::CSlabPool::getTotalMemoryUsage();
+	ASSERT_GT(usage, 100 * sizeof(PoolTestObject))<< "total memory usage";
+
+	// releasing and reallocating does not grow the pools
+	objects.clear();
+	for (int i = 0; i < 100; i++) {
+		objects.push_back(
+				std::allocate_shared<PoolTestObject>(allocator, i));
+	}
+	ASSERT_EQ(usage, glassutil::CSlabPool::getTotalMemoryUsage())<<
+			"pools did not grow";
+
+	// arrays fall back to the heap
+	PoolTestObject * array = glassutil::CPoolAllocator<PoolTestObject>()
+			.allocate(4);
+	ASSERT_TRUE(array != NULL)<< "array allocated";
+	glassutil::CPoolAllocator<PoolTestObject>().deallocate(array, 4);
+
+	// allocators are interchangeable
+	glassutil::CPoolAllocator<int> other(allocator);
+	ASSERT_TRUE(other == allocator)<< "allocators equal";
+}
@@ -1,7 +1,10 @@
 #include <gtest/gtest.h>
 #include <memory>
 #include <string>
+#include <vector>
 #include <cmath>
+#include <thread>
+#include <atomic>
 #include "Site.h"
 #include "Pick.h"
 #include "Node.h"
@@ -223,6 +226,104 @@ TEST(SiteTest, PickOperations) {
 	testSite->remPick(sharedTestPick);
 	expectedSize = 0;
 	ASSERT_EQ(expectedSize, testSite->getVPick().size())<< "Removed pick";
+
+	// test that picks are kept in time order
+	std::shared_ptr<glasscore::CPick> sharedTestPick3(
+			new glasscore::CPick(sharedTestSite, 30.0, 3, "3", -1, -1));
+	std::shared_ptr<glasscore::CPick> sharedTestPick4(
+			new glasscore::CPick(sharedTestSite, 20.0, 4, "4", -1, -1));
+	testSite->addPick(sharedTestPick3);
+	testSite->addPick(sharedTestPick);
+	testSite->addPick(sharedTestPick4);
+	std::vector<std::shared_ptr<glasscore::CPick>> sitePicks = testSite
+			->getVPick();
+	ASSERT_EQ(3, sitePicks.size())<< "Added picks";
+	ASSERT_EQ(10.0, sitePicks[0]->getTPick())<< "first pick time";
+	ASSERT_EQ(20.0, sitePicks[1]->getTPick())<< "second pick time";
+	ASSERT_EQ(30.0, sitePicks[2]->getTPick())<< "third pick time";
+
+	// test getting picks in a time window
+	std::vector<std::shared_ptr<glasscore::CPick>> windowPicks;
+	testSite->getPicks(15.0, 30.0, &windowPicks);
+	ASSERT_EQ(2, windowPicks.size())<< "picks in window";
+	ASSERT_EQ(20.0, windowPicks[0]->getTPick())<< "first window pick time";
+	ASSERT_EQ(30.0, windowPicks[1]->getTPick())<< "second window pick time";
+
+	windowPicks.clear();
+	testSite->getPicks(31.0, 40.0, &windowPicks);
+	ASSERT_EQ(0, windowPicks.size())<< "no picks in window";
+
+	// test getting pick records in a time window
+	std::vector<glasscore::PickRecord> records;
+	testSite->getPickRecords(15.0, 30.0, &records);
+	ASSERT_EQ(2, records.size())<< "records in window";
+	ASSERT_EQ(20.0, records[0].tPick)<< "first record time";
+	ASSERT_EQ(4, records[0].idPick)<< "first record id";
+	ASSERT_EQ(30.0, records[1].tPick)<< "second record time";
+	ASSERT_EQ(sharedTestPick4, testSite->getPick(records[0]))<<
+	"record pick lookup";
+
+	// test removing a pick from the middle of the ring
+	testSite->remPick(sharedTestPick4);
+	ASSERT_EQ(2, testSite->getVPick().size())<< "Removed middle pick";
+	ASSERT_TRUE(testSite->getPick(records[0]) == NULL)<< "removed record lookup";
+	testSite->getPickRecords(15.0, 30.0, &records);
+	ASSERT_EQ(1, records.size())<< "records in window after remove";
+	ASSERT_EQ(30.0, records[0].tPick)<< "record time after remove";
+}
+
+// tests to see if pick records can be read while picks are added
+TEST(SiteTest, ConcurrentPickRecords) {
+	glassutil::CLogit::disable();
+
+	// create json objects from the strings
+	std::shared_ptr<json::Object> siteJSON = std::make_shared<json::Object>(
+			json::Object(json::Deserialize(std::string(SITEJSON))));
+
+	std::shared_ptr<glasscore::CSite> sharedTestSite(
+			new glasscore::CSite(siteJSON, NULL));
+
+	// a default constructed site has no pick ring to add to
+	glasscore::CSite emptySite;
+	emptySite.addPick(
+			std::make_shared<glasscore::CPick>(sharedTestSite, 1.0, 1, "1", -1,
+												-1));
+	ASSERT_EQ(0, emptySite.getVPick().size())<< "no picks without a ring";
+
+	std::atomic<bool> done(false);
+	std::atomic<int> badRecords(0);
+
+	// read the records while the ring wraps, each record's time matches
+	// its id, so a torn record shows up as a mismatch
+	std::thread reader([&]() {
+		std::vector<glasscore::PickRecord> records;
+		while (!done) {
+			sharedTestSite->getPickRecords(0.0, 10000.0, &records);
+			for (int i = 0; i < static_cast<int>(records.size()); i++) {
+				if ((records[i].tPick != records[i].idPick)
+						|| ((i > 0)
+								&& (records[i].tPick < records[i - 1].tPick))) {
+					badRecords++;
+				}
+			}
+		}
+	});
+
+	for (int i = 1; i <= 2000; i++) {
+		std::shared_ptr<glasscore::CPick> pick = std::make_shared<
+				glasscore::CPick>(sharedTestSite, static_cast<double>(i), i,
+									std::to_string(i), -1, -1);
+		sharedTestSite->addPick(pick);
+		if ((i % 3) == 0) {
+			sharedTestSite->remPick(pick);
+		}
+	}
+
+	done = true;
+	reader.join();
+
+	ASSERT_EQ(0, badRecords)<< "consistent pick records";
+	ASSERT_GT(sharedTestSite->getVPick().size(), 0)<< "picks in ring";
 }
 
 // tests to see if nodes can be added to and removed from the site
@@ -253,7 +354,7 @@ TEST(SiteTest, NodeOperations) {
 	ASSERT_EQ(expectedSize, testSite->getNodeLinksCount())<< "Added Nodes";
 
 	// test removing nodes from site
-	testSite->remNode(testNode->getPid());
+	testSite->remNode(testNode);
 	expectedSize = 1;
 	ASSERT_EQ(expectedSize, testSite->getNodeLinksCount())<< "Removed Node";
 }
@@ -70,6 +70,21 @@ TEST(SiteListTest, SiteOperations) {
 			sharedTestSite4->getScnl());
 	ASSERT_FALSE(updatedSite->getUse())<< "Updated site";
 
+	// sites are interned as dense ids, updates keep the original id
+	ASSERT_EQ(0, sharedTestSite->getSiteId())<< "first site id";
+	ASSERT_EQ(updatedSite->getSiteId(), sharedTestSite4->getSiteId())<<
+			"updated site id";
+	for (int i = 0; i < testSiteList->getSiteCount(); i++) {
+		std::shared_ptr<glasscore::CSite> site = testSiteList->getSite(i);
+		ASSERT_EQ(i, site->getSiteId())<< "site id round trip";
+		ASSERT_TRUE(site->isSameSite(
+				testSiteList->getSite(site->getScnl()).get()))<< "same site";
+	}
+	ASSERT_TRUE(testSiteList->getSite(testSiteList->getSiteCount()) == NULL)<<
+			"out of range id";
+	ASSERT_FALSE(sharedTestSite->isSameSite(testSiteList->getSite(1).get()))<<
+			"different site";
+
 	// cleanup
 	delete (testSiteList);
 }
@@ -15,7 +15,7 @@
 #define LONGITUDE 0.0
 #define DEPTH 50.0
 #define DISTANCE 50.0
-#define TIME 529.2
+#define TIME 529.206
 #define TIME2 50.553
 #define BILINEAR 50.553
 
@@ -128,6 +128,20 @@ TEST(TravelTimeTest, Copy) {
 	ASSERT_TRUE(NULL != traveltime1.pDepthDistanceArray)<< "pDepthDistanceArray "
 			"not null";
 	ASSERT_TRUE(NULL != traveltime1.pPhaseArray)<< "pPhaseArray not null";
+
+	// the copies share the tables
+	ASSERT_TRUE(traveltime1.pTable == traveltime2.pTable)<< "shared table";
+	ASSERT_EQ(traveltime1.pTravelTimeArray, traveltime2.pTravelTimeArray)<<
+			"shared travel times";
+	ASSERT_EQ(traveltime1.pCoefficientArray, traveltime2.pCoefficientArray)<<
+			"shared coefficients";
+
+	// and split their memory usage
+	size_t tableBytes = NDISTANCEWARP * NDEPTHWARP
+			* (2 * sizeof(double) + sizeof(char));
+	ASSERT_EQ(traveltime1.getMemoryUsage(), traveltime2.getMemoryUsage())<<
+			"copy memory usage";
+	ASSERT_GT(traveltime1.getMemoryUsage(), tableBytes)<< "memory usage";
 }
 
 // tests traveltime operations
@@ -174,3 +188,63 @@ TEST(TravelTimeTest, Operations) {
 	// bilinear
 	ASSERT_NEAR(BILINEAR, traveltime.bilinear(DISTANCE,DEPTH), 0.001)<< "bilinear Check"; // NOLINT
 }
+
+// tests the bicubic interpolation and derivatives
+TEST(TravelTimeTest, Derivatives) {
+	glassutil::CLogit::disable();
+
+	std::string phasefile = "./" + std::string(TESTPATH) + "/"
+			+ std::string(PHASEFILENAME);
+	std::string phasename = std::string(PHASE);
+
+	// construct a traveltime
+	traveltime::CTravelTime traveltime;
+
+	// setup
+	traveltime.setup(phasename, phasefile);
+	ASSERT_TRUE(NULL != traveltime.pCoefficientArray)<< "coefficients not null";
+
+	// the interpolation passes through the grid nodes
+	ASSERT_NEAR(traveltime.T(50, 50), traveltime.bicubic(50.0, 50.0), 1e-9)<<
+			"bicubic node Check";
+	ASSERT_NEAR(traveltime.T(51, 51), traveltime.bicubic(51.0, 51.0), 1e-9)<<
+			"bicubic node Check";
+
+	// and stays close to the bilinear interpolation between them
+	ASSERT_NEAR(traveltime.bilinear(50.5, 50.5),
+				traveltime.bicubic(50.5, 50.5), 0.05)<< "bicubic cell Check";
+
+	// out of the grid
+	ASSERT_EQ(-1.0, traveltime.bicubic(-1.0, 50.0))<< "bicubic bounds Check";
+	ASSERT_EQ(-1.0, traveltime.bicubic(50.0, NDEPTHWARP - 1))<<
+			"bicubic bounds Check";
+
+	// derivatives match finite differences
+	double step = 0.001;
+	double dTdDelta = 0;
+	double dTdDepth = 0;
+	traveltime.setOrigin(LATITUDE, LONGITUDE, DEPTH);
+	double time = traveltime.T(DISTANCE, &dTdDelta, &dTdDepth);
+	ASSERT_NEAR(time, traveltime.T(DISTANCE), 1e-9)<< "T Check";
+
+	double deltaPlus = traveltime.T(DISTANCE + step);
+	double deltaMinus = traveltime.T(DISTANCE - step);
+	ASSERT_NEAR((deltaPlus - deltaMinus) / (2.0 * step), dTdDelta, 1e-4)<<
+			"dTdDelta Check";
+
+	traveltime.setOrigin(LATITUDE, LONGITUDE, DEPTH + step);
+	double depthPlus = traveltime.T(DISTANCE);
+	traveltime.setOrigin(LATITUDE, LONGITUDE, DEPTH - step);
+	double depthMinus = traveltime.T(DISTANCE);
+	ASSERT_NEAR((depthPlus - depthMinus) / (2.0 * step), dTdDepth, 1e-4)<<
+			"dTdDepth Check";
+
+	// P slows with distance and shallows with depth
+	ASSERT_GT(dTdDelta, 0.0)<< "dTdDelta sign";
+	ASSERT_LT(dTdDepth, 0.0)<< "dTdDepth sign";
+
+	// copies share the coefficients
+	traveltime::CTravelTime copy(traveltime);
+	ASSERT_EQ(traveltime.pCoefficientArray, copy.pCoefficientArray)<<
+			"shared coefficients";
+}
@@ -7,6 +7,7 @@
 #include "Pick.h"
 #include "Site.h"
 #include "SiteList.h"
+#include "Glass.h"
 #include "Logit.h"
 
 #define LATITUDE -21.849968
@@ -29,6 +30,9 @@
 #define NUMCOLS 4
 #define NUMZ 1
 #define UPDATE true
+#define NESTIMATEPICKS 6
+#define ESTIMATESHIFT 2.0
+#define OUTLIER 50.0
 
 // tests to see if the node can be constructed
 TEST(TriggerTest, Construction) {
@@ -169,3 +173,62 @@ TEST(TriggerTest, Construction) {
 	// pick list
 	ASSERT_EQ(0, testTrigger->getVPick().size())<< "Trigger pick Count 0";
 }
+
+// test to see if the trigger estimate finds the origin time shift
+TEST(TriggerTest, EstimateBayes) {
+	glassutil::CLogit::disable();
+
+	glasscore::CGlass testGlass;
+
+	// picks that all arrive the same time after the node travel times, but
+	// for one outlier
+	std::vector<std::shared_ptr<glasscore::CSite>> sites;
+	std::vector<std::shared_ptr<glasscore::CPick>> picks;
+	std::vector<glasscore::SiteLink> links;
+	for (int i = 0; i < NESTIMATEPICKS; i++) {
+		std::shared_ptr<glasscore::CSite> site = std::make_shared<
+				glasscore::CSite>("S" + std::to_string(i), "BHZ", "XX", "",
+									LATITUDE, LONGITUDE, 0.0, 1.0, true, true,
+									&testGlass);
+		sites.push_back(site);
+
+		double travelTime = 10.0 * (i + 1);
+		double tPick = TIME + travelTime + ESTIMATESHIFT;
+		if (i == NESTIMATEPICKS - 1) {
+			tPick += OUTLIER;
+		}
+		picks.push_back(
+				std::make_shared<glasscore::CPick>(site, tPick, i,
+													std::to_string(i), -1,
+													-1));
+
+		glasscore::SiteLink link = { site.get(), travelTime, -1, 0, 0, -1, -1 };
+		links.push_back(link);
+	}
+
+	glasscore::CTrigger testTrigger(LATITUDE, LONGITUDE, DEPTH, TIME,
+									RESOLUTION, SUM, NESTIMATEPICKS, picks,
+									NULL, links);
+
+	// the shift fits all but the outlier exactly
+	int count = 0;
+	double origin = 0;
+	double bayes = testTrigger.estimateBayes(&testGlass, 0.0, &count, &origin);
+	ASSERT_NEAR(TIME + ESTIMATESHIFT, origin, 0.000001)<< "origin";
+	ASSERT_EQ(NESTIMATEPICKS - 1, count)<< "count";
+	ASSERT_NEAR(NESTIMATEPICKS - 1, bayes, 0.001)<< "bayes";
+
+	// enough slack forgives the outlier too
+	bayes = testTrigger.estimateBayes(&testGlass, OUTLIER, &count, &origin);
+	ASSERT_EQ(NESTIMATEPICKS, count)<< "count with slack";
+	ASSERT_NEAR(NESTIMATEPICKS, bayes, 0.001)<< "bayes with slack";
+
+	// without links every pick is assumed to fit
+	glasscore::CTrigger noLinkTrigger(LATITUDE, LONGITUDE, DEPTH, TIME,
+										RESOLUTION, SUM, NESTIMATEPICKS, picks,
+										NULL);
+	bayes = noLinkTrigger.estimateBayes(&testGlass, 0.0, &count, &origin);
+	ASSERT_EQ(NESTIMATEPICKS, count)<< "count without links";
+	ASSERT_NEAR(NESTIMATEPICKS, bayes, 0.001)<< "bayes without links";
+	ASSERT_EQ(TIME, origin)<< "origin without links";
+}
@@ -17,9 +17,9 @@
 #define BADDISTANCE 160.0
 #define BADDEPTH 800
 #define TIME1 265.0485
-#define TIME2 484.4298
+#define TIME2 484.4310
 #define TIME3 268.3447
-#define TIME4 490.4684
+#define TIME4 490.4671
 #define BADTIME -1
 
 // tests to see if the ttt can be constructed
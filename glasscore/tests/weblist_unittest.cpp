@@ -5,11 +5,17 @@
 #include <sstream>
 #include <iostream>
 #include <fstream>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
 
 #include "Web.h"
 #include "WebList.h"
 #include "Site.h"
 #include "SiteList.h"
+#include "Glass.h"
+#include "Executor.h"
 #include "Logit.h"
 
 #define TESTPATH "testdata"
@@ -237,6 +243,121 @@ TEST(WebListTest, SiteOperations) {
 	delete (testWebList);
 }
 
+// tests removing a web while its site jobs are still queued on an executor
+TEST(WebListTest, RemWebWithQueuedJobs) {
+	glassutil::CLogit::disable();
+
+	// load files
+	// stationlist
+	std::ifstream stationFile;
+	stationFile.open(
+			"./" + std::string(TESTPATH) + "/" + std::string(STATIONFILENAME),
+			std::ios::in);
+	std::string stationLine = "";
+	std::getline(stationFile, stationLine);
+	stationFile.close();
+
+	// grid config
+	std::ifstream gridFile;
+	gridFile.open(
+			"./" + std::string(TESTPATH) + "/" + std::string(GRIDFILENAME),
+			std::ios::in);
+	std::string gridLine = "";
+	std::getline(gridFile, gridLine);
+	gridFile.close();
+
+	std::shared_ptr<json::Object> siteList = std::make_shared<json::Object>(
+			json::Deserialize(stationLine));
+	std::shared_ptr<json::Object> gridConfig = std::make_shared<json::Object>(
+			json::Deserialize(gridLine));
+	std::shared_ptr<json::Object> remGridConfig =
+			std::make_shared<json::Object>(
+					json::Deserialize(std::string(REMWEB)));
+
+	// construct an executor with a single thread, the way glass does
+	std::vector<glassutil::CExecutor::TaskClass> taskClasses(3);
+	taskClasses[glasscore::task_class::nucleation] = { "Nucleation", 2, 1 };
+	taskClasses[glasscore::task_class::evolution] = { "Evolution", 3, 1 };
+	taskClasses[glasscore::task_class::maintenance] = { "Maintenance", 1, 1 };
+	glassutil::CExecutor * testExecutor = new glassutil::CExecutor(
+			taskClasses, 1);
+
+	// construct a sitelist
+	glasscore::CSiteList * testSiteList = new glasscore::CSiteList();
+	testSiteList->dispatch(siteList);
+
+	// construct a WebList
+	glasscore::CWebList * testWebList = new glasscore::CWebList();
+	testWebList->setSiteList(testSiteList);
+	testWebList->setExecutor(testExecutor);
+
+	// add a web
+	testWebList->dispatch(gridConfig);
+	ASSERT_EQ(1, (int)testWebList->getVWebSize())<< "web list added";
+
+	// create site to add
+	std::shared_ptr<json::Object> siteJSON = std::make_shared<json::Object>(
+			json::Object(json::Deserialize(std::string(ADDSITE))));
+	std::shared_ptr<glasscore::CSite> sharedAddSite(
+			new glasscore::CSite(siteJSON, NULL));
+	testSiteList->addSite(sharedAddSite);
+
+	// hold up the executor so the web's job task stays queued
+	std::atomic<bool> release(false);
+	std::atomic<bool> blocking(false);
+	testExecutor->submit(glasscore::task_class::maintenance,
+							[&release, &blocking]() {
+		blocking = true;
+		while (release == false) {
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		}
+	});
+	while (blocking == false) {
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+
+	// queue a job, then remove the web before it runs
+	testWebList->addSite(sharedAddSite);
+	ASSERT_EQ(1, testExecutor->getQueueSize(
+			glasscore::task_class::maintenance))<< "job task queued";
+	testWebList->dispatch(remGridConfig);
+	ASSERT_EQ(0, (int)testWebList->getVWebSize())<< "web list removed";
+
+	// let the queued task run against the removed web
+	release = true;
+	for (int i = 0; i < 5000; i++) {
+		if ((testExecutor->getQueueSize(glasscore::task_class::maintenance)
+				== 0)
+				&& (testExecutor->getRunningCount(
+						glasscore::task_class::maintenance) == 0)) {
+			break;
+		}
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+	ASSERT_EQ(0, testExecutor->getQueueSize(
+			glasscore::task_class::maintenance))<< "job task ran";
+
+	// a web added again under the same name still runs its jobs
+	testWebList->dispatch(gridConfig);
+	ASSERT_EQ(1, (int)testWebList->getVWebSize())<< "web list re-added";
+	ASSERT_TRUE(testWebList->hasSite(sharedAddSite))<< "site in weblist";
+	testWebList->remSite(sharedAddSite);
+
+	// give time for site to remove
+	for (int i = 0; i < 5000; i++) {
+		if (testWebList->hasSite(sharedAddSite) == false) {
+			break;
+		}
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+	ASSERT_FALSE(testWebList->hasSite(sharedAddSite))<< "site removed";
+
+	testExecutor->stop();
+	delete (testWebList);
+	delete (testSiteList);
+	delete (testExecutor);
+}
+
 // Tests various falure cases for weblist
 TEST(WebListTest, FailTests) {
 	glassutil::CLogit::disable();
@@ -64,15 +64,19 @@ class CGenTrv {
 	 * \param modelFile - A std::string containing the model file name
 	 * \param outputPath - A std::string containing the output path
 	 * \param fileExtension - A std::string containing the output file extension
+	 * \param numThreads - An integer containing the number of threads to
+	 * generate depth rows with, 0 (the default) to use one per core
 	 * \return returns true if successful, false otherwise
 	 */
 	bool setup(std::string modelFile, std::string outputPath,
-				std::string fileExtension);
+				std::string fileExtension, int numThreads = 0);
 
 	/**
 	 * \brief Generate travel time file
 	 *
-	 * Generate a travel time file based on the provided json configuration
+	 * Generate a travel time file based on the provided json configuration.
+	 * The depth rows are generated in parallel, each thread with its own
+	 * CRay; the file is the same regardless of the number of threads.
 	 *
 	 * \param com - A pointer to a json object containing the configuration
 	 * for the travel time file
@@ -100,6 +104,29 @@ class CGenTrv {
 	int Row(int iDepth, double *travelTimeArray, double *depthDistanceArray,
 			char *phaseArray);
 
+	/**
+	 * \brief Generate depth row of the travel time interpolation grid
+	 *
+	 * Generate A row of travel times and a row distances indexed by the
+	 * given depth using the given ray, so that rows can be generated in
+	 * parallel.
+	 *
+	 * \param iDepth - An integer containing the index of the depth row being
+	 * generated
+	 * \param travelTimeArray - A pointer to an array of double values
+	 * filled in with the travel times for the given depth index
+	 * \param depthDistanceArray - A pointer to an array of double values
+	 * filled in with the distances for the given depth index
+	 * \param phaseArray - A pointer to an array of characters containing the
+	 * filled in with the phases for the given depth index
+	 * \param ray - A pointer to the CRay to use, which must not be in use by
+	 * another thread
+	 * \return Returns the number of holes (discontinuities?) patched during
+	 * generation.
+	 */
+	int Row(int iDepth, double *travelTimeArray, double *depthDistanceArray,
+			char *phaseArray, CRay *ray);
+
 	/**
 	 * \brief Compute travel time
 	 *
@@ -115,6 +142,26 @@ class CGenTrv {
 	 */
 	bool T(std::string phase, double delta, double depth);
 
+	/**
+	 * \brief Compute travel time
+	 *
+	 * Compute the traveltime from the given phase, distance, and depth
+	 * using the given ray, without modifying this CGenTrv.
+	 *
+	 * \param phase - A std::string containing the phase to use
+	 * \param delta - A double value containing the distance to use
+	 * \param depth - A double value containing the depth to use
+	 * \param ray - A pointer to the CRay to use
+	 * \param outTravelTime - A pointer to a double to hold the travel time
+	 * \param outDepthDistance - A pointer to a double to hold the depth
+	 * distance
+	 * \param outRayParam - A pointer to a double to hold the ray parameter
+	 * \return Returns true if successful, false otherwise
+	 */
+	bool T(std::string phase, double delta, double depth, CRay *ray,
+			double *outTravelTime, double *outDepthDistance,
+			double *outRayParam);
+
 	/**
 	 * \brief A string containing the output path
 	 */
@@ -130,6 +177,12 @@ class CGenTrv {
 	 */
 	bool bSetup = false;
 
+	/**
+	 * \brief An integer variable containing the number of threads used to
+	 * generate depth rows
+	 */
+	int nThreads;
+
 	/**
 	 * \brief An integer variable containing the number of rays to generate
 	 */
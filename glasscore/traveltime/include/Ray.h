@@ -7,6 +7,9 @@
 #ifndef RAY_H
 #define RAY_H
 
+#include <map>
+#include <tuple>
+
 namespace traveltime {
 
 /**
@@ -260,6 +263,29 @@ class CRay {
 	double integrateFunction(int functionIndex, double rayParam,
 								double earthRadius);
 
+	/**
+	 * \brief Integrate a ray segment
+	 *
+	 * Integrates the given function over a ray segment using
+	 * CTerra::integrateRaySegment(), remembering the result. The same
+	 * segments are integrated for the same ray parameters over and over
+	 * while scanning for the travel time minima at neighbouring distances,
+	 * and across phases sharing a segment, so repeats are returned from
+	 * the cache. The cached values are bit for bit those that would be
+	 * recomputed.
+	 *
+	 * \param functionIndex - An integer parameter indicating what to
+	 * integrate
+	 * \param startingRadius - A double containing the starting radius of
+	 * the segment in kilometers
+	 * \param endingRadius - A double containing the ending radius of the
+	 * segment in kilometers
+	 * \param rayParam - A double variable containing the ray parameter.
+	 * \return Returns the integral
+	 */
+	double integrateSegment(int functionIndex, double startingRadius,
+							double endingRadius, double rayParam);
+
 	/**
 	 * \brief Calculates theta function
 	 *
@@ -333,6 +359,14 @@ class CRay {
 	 * for the phase.
 	 */
 	double dMaximumRayParam;
+
+	/**
+	 * \brief A std::map containing the cached ray segment integrals, keyed
+	 * by {function index, starting radius, ending radius, ray parameter}.
+	 * Each CRay has its own cache, so a CRay should only be used by one
+	 * thread at a time.
+	 */
+	std::map<std::tuple<int, double, double, double>, double> mSegmentCache;
 };
 }  // namespace traveltime
 #endif  // RAY_H
@@ -38,7 +38,8 @@ class CTTT {
 	/**
 	 * \brief CTTT copy constructor
 	 *
-	 * The copy constructor for the CTTT class.
+	 * The copy constructor for the CTTT class, the copied travel times share
+	 * the tables of the originals.
 	 */
 	CTTT(const CTTT &ttt);
 
@@ -145,6 +146,43 @@ class CTTT {
 	 */
 	double T(glassutil::CGeo *geo, double tobs);
 
+	/**
+	 * \brief Calculate best travel time in seconds and derivatives
+	 *
+	 * Calculate best travel time in seconds given geographic location and
+	 * the observed arrival time, along with the partial derivatives of the
+	 * chosen phase's travel time with respect to distance and depth
+	 *
+	 * \param geo - A pointer to a glassutil::CGeo object representing the location
+	 * to calculate the travel time from
+	 * \param tobs - A double value containing the observed arrival time.
+	 * \param dTdDelta - A pointer to a double to hold the derivative of the
+	 * travel time with respect to distance in seconds per degree, or NULL
+	 * \param dTdDepth - A pointer to a double to hold the derivative of the
+	 * travel time with respect to source depth in seconds per kilometer, or
+	 * NULL
+	 * \return Returns the travel time in seconds, or -1.0 if there is
+	 * no valid travel time
+	 */
+	double T(glassutil::CGeo *geo, double tobs, double *dTdDelta,
+				double *dTdDepth);
+
+	/**
+	 * \brief Calculate travel times for all phases in seconds
+	 *
+	 * Calculate the travel time in seconds of every phase from the current
+	 * origin given distance in degrees. The phase association ranges are not
+	 * applied, so the result covers every phase T(geo, tobs) could choose.
+	 *
+	 * \param delta - A double value containing the distance in degrees
+	 * to calculate travel times from
+	 * \param travelTimes - A pointer to an array of at least MAX_TRAV doubles
+	 * to hold the travel time of each phase, or -1.0 for a phase with no
+	 * valid travel time at this distance
+	 * \return Returns the number of phases
+	 */
+	int Tall(double delta, double *travelTimes);
+
 	/**
 	 * \brief Print Travel Times to File
 	 *
@@ -152,6 +190,14 @@ class CTTT {
 	 */
 	double testTravelTimes(std::string phase);
 
+	/**
+	 * \brief Estimate memory usage
+	 *
+	 * \return Returns the approximate number of bytes used by this object
+	 * and its travel time tables
+	 */
+	size_t getMemoryUsage() const;
+
 	/**
 	 * \brief A temporary std::std::string variable containing the phase determined
 	 * during the last call to T()
@@ -103,6 +103,17 @@ class CTimeWarp {
 	 */
 	double value(double gridIndex);
 
+	/**
+	 * \brief Calculate grid slope
+	 *
+	 * Calculate the derivative of the grid index with respect to the
+	 * interpolated value at the given value
+	 *
+	 * \param value - A double value containing the interpolated value to use
+	 * \return Returns the grid slope, in grid points per unit of value
+	 */
+	double slope(double value);
+
 	/**
 	 * \brief A double value containing the Lowest value mapped to the grid
 	 */
@@ -8,6 +8,7 @@
 #define TRAVELTIME_H
 #include <json.h>
 #include "Geo.h"
+#include "TimeWarp.h"
 #include <memory>
 #include <vector>
 #include <string>
@@ -24,7 +25,47 @@ namespace traveltime {
 
 // forward declarations
 class CRay;
-class CTimeWarp;
+
+/**
+ * \brief travel time table storage
+ *
+ * The TravelTimeTable struct owns the grids loaded for a phase: the distance
+ * and depth warps, the travel time, depth distance, and phase arrays, and
+ * the bicubic interpolation coefficients. A table is never modified once
+ * setup() has filled it in, so every copy of a CTravelTime shares it.
+ */
+struct TravelTimeTable {
+	/**
+	 * \brief The distance warp
+	 */
+	CTimeWarp distanceWarp;
+
+	/**
+	 * \brief The depth warp
+	 */
+	CTimeWarp depthWarp;
+
+	/**
+	 * \brief The travel times indexed by depth and distance
+	 */
+	std::vector<double> travelTimes;
+
+	/**
+	 * \brief The distances indexed by depth
+	 */
+	std::vector<double> depthDistances;
+
+	/**
+	 * \brief The phases indexed by depth and distance
+	 */
+	std::vector<char> phases;
+
+	/**
+	 * \brief The bicubic coefficients, with room to align them to a cache
+	 * line
+	 */
+	std::vector<double> coefficients;
+};
 
 /**
  * \brief travel time phase class
@@ -34,6 +75,11 @@ class CTimeWarp;
  * of valid depths for a given phase or phase class.
  * CTravelTime supports calculating travel times based on distance
  * or geographic location for the given phase or phase class.
+ *
+ * The grids themselves live in a shared, immutable TravelTimeTable, so a
+ * CTravelTime is only a query context (the origin and the last distance and
+ * depth) on top of its table, and copying one costs the same no matter how
+ * large the table is.
  */
 class CTravelTime {
  public:
@@ -47,7 +93,8 @@ class CTravelTime {
 	/**
 	 * \brief CTravelTime copy constructor
 	 *
-	 * The copy constructor for the CTravelTime class.
+	 * The copy constructor for the CTravelTime class, the copy shares the
+	 * tables of the original and gets its own query state.
 	 */
 	CTravelTime(const CTravelTime &travelTime);
 
@@ -116,6 +163,44 @@ class CTravelTime {
 	 */
 	double T(double delta);
 
+	/**
+	 * \brief Calculate travel time and derivatives
+	 *
+	 * Calculate travel time in seconds given geographic location, along with
+	 * the partial derivatives of the travel time with respect to distance
+	 * and depth
+	 *
+	 * \param geo - A pointer to a glassutil::CGeo object representing the
+	 * location to calculate the travel time from
+	 * \param dTdDelta - A pointer to a double to hold the derivative of the
+	 * travel time with respect to distance in seconds per degree, or NULL
+	 * \param dTdDepth - A pointer to a double to hold the derivative of the
+	 * travel time with respect to source depth in seconds per kilometer, or
+	 * NULL
+	 * \return Returns the travel time in seconds, or -1.0 if there is
+	 * no valid travel time
+	 */
+	double T(glassutil::CGeo *geo, double *dTdDelta, double *dTdDepth);
+
+	/**
+	 * \brief Calculate travel time and derivatives
+	 *
+	 * Interpolate travel time in seconds given distance in degrees, along
+	 * with the partial derivatives of the travel time with respect to
+	 * distance and depth
+	 *
+	 * \param delta - A double value containing the distance in degrees
+	 * to calculate travel time from
+	 * \param dTdDelta - A pointer to a double to hold the derivative of the
+	 * travel time with respect to distance in seconds per degree, or NULL
+	 * \param dTdDepth - A pointer to a double to hold the derivative of the
+	 * travel time with respect to source depth in seconds per kilometer, or
+	 * NULL
+	 * \return Returns the travel time in seconds, or -1.0 if there is
+	 * no valid travel time
+	 */
+	double T(double delta, double *dTdDelta, double *dTdDepth);
+
 	/**
 	 * \brief Lookup travel time in seconds
 	 *
@@ -142,6 +227,57 @@ class CTravelTime {
 	 */
 	double bilinear(double distance, double depth);
 
+	/**
+	 * \brief Compute travel time in seconds via bicubic interpolation
+	 *
+	 * Compute a traveltime from the precomputed bicubic coefficients of the
+	 * grid cell containing the given distance and depth grid coordinates,
+	 * along with the partial derivatives of the travel time with respect to
+	 * the grid coordinates. The interpolated surface passes through the
+	 * travel time array at the grid nodes and is smooth across cells.
+	 *
+	 * \param distance - A double value containing the distance grid
+	 * coordinate to use
+	 * \param depth - A double value containing the depth grid coordinate to
+	 * use
+	 * \param dTdDistance - A pointer to a double to hold the derivative of the
+	 * travel time with respect to the distance grid coordinate, or NULL
+	 * \param dTdDepth - A pointer to a double to hold the derivative of the
+	 * travel time with respect to the depth grid coordinate, or NULL
+	 * \return Returns the travel time in seconds, or -1.0 if there is
+	 * no valid travel time
+	 */
+	double bicubic(double distance, double depth, double *dTdDistance = NULL,
+					double *dTdDepth = NULL);
+
+	/**
+	 * \brief Compute the bicubic interpolation coefficients
+	 *
+	 * Computes the 16 bicubic coefficients of every grid cell from the
+	 * travel time array, using finite difference estimates of the
+	 * derivatives at the grid nodes. Cells with a corner that has no valid
+	 * travel time are marked invalid. Called by setup() once the travel time
+	 * array is loaded, before the table is shared with any copies.
+	 */
+	void setupCoefficients();
+
+	/**
+	 * \brief Estimate memory usage
+	 *
+	 * Estimates the memory used by this travel time object and its tables.
+	 * The tables are shared between copies, so each copy counts its share of
+	 * them.
+	 *
+	 * \return Returns the approximate number of bytes used
+	 */
+	size_t getMemoryUsage() const;
+
+	/**
+	 * \brief The shared table holding the warps, arrays, and coefficients
+	 * that the pointers below point into
+	 */
+	std::shared_ptr<TravelTimeTable> pTable;
+
 	/**
 	 * \brief A pointer to the distance warp object used
 	 */
@@ -176,6 +312,13 @@ class CTravelTime {
 	 */
 	double *pDepthDistanceArray;
 
+	/**
+	 * \brief An array of double values containing the 16 bicubic
+	 * coefficients of each grid cell, indexed by the cell's lower depth and
+	 * distance node, aligned to the start of a cache line
+	 */
+	double *pCoefficientArray;
+
 	/**
 	 * \brief An array of characters containing the phases
 	 */
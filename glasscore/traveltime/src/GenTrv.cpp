@@ -2,6 +2,10 @@
 #include <cmath>
 #include <cstdio>
 #include <string>
+#include <algorithm>
+#include <thread>
+#include <atomic>
+#include <vector>
 #include "Logit.h"
 #include "Spline.h"
 #include "Terra.h"
@@ -22,6 +26,7 @@ CGenTrv::CGenTrv() {
 	pDepthWarp = NULL;
 	pTerra = NULL;
 	pRay = NULL;
+	nThreads = 1;
 }
 
 // ---------------------------------------------------------CGenTrv
@@ -35,6 +40,7 @@ CGenTrv::CGenTrv(std::string modelFile, std::string outputPath,
 	pDepthWarp = NULL;
 	pTerra = NULL;
 	pRay = NULL;
+	nThreads = 1;
 
 	setup(modelFile, outputPath, fileExtension);
 }
@@ -79,7 +85,7 @@ void CGenTrv::clear() {
 
 // ---------------------------------------------------------setup
 bool CGenTrv::setup(std::string modelFile, std::string outputPath,
-					std::string fileExtension) {
+					std::string fileExtension, int numThreads) {
 	if (bSetup == true) {
 		return(true);
 	}
@@ -107,6 +113,20 @@ bool CGenTrv::setup(std::string modelFile, std::string outputPath,
 
 	m_OutputPath = outputPath;
 	m_FileExtension = fileExtension;
+
+	// one thread per core unless told otherwise
+	if (numThreads <= 0) {
+		numThreads = std::thread::hardware_concurrency();
+	}
+	if (numThreads <= 0) {
+		numThreads = 1;
+	}
+	nThreads = numThreads;
+
+	glassutil::CLogit::log(
+			glassutil::log_level::debug,
+			"CGenTrv::setup: nThreads: " + std::to_string(nThreads));
+
 	bSetup = true;
 
 	return(true);
@@ -462,13 +482,33 @@ bool CGenTrv::generate(json::Object *com) {
 	char *phaseArray = new char[nDistanceWarp * nDepthWarp];
 
 	// generate interpolation grid (depth, time)
+	// each depth row is independent, so the rows are handed out to the
+	// threads one at a time, each thread with its own ray
+	std::atomic<int> nextDepth(0);
+	auto rowWorker = [&]() {
+		CRay ray(pTerra);
+
+		int iDepth;
+		while ((iDepth = nextDepth++) < nDepthWarp) {
+			// generate row
+			Row(iDepth, &travelTimeArray[iDepth * nDistanceWarp],
+				&depthDistanceArray[iDepth * nDistanceWarp],
+				&phaseArray[iDepth * nDistanceWarp], &ray);
+		}
+	};
+
+	int numThreads = std::min(nThreads, nDepthWarp);
+	std::vector<std::thread> vThreads;
+	for (int i = 1; i < numThreads; i++) {
+		vThreads.push_back(std::thread(rowWorker));
+	}
+	rowWorker();
+	for (auto &thread : vThreads) {
+		thread.join();
+	}
+
 	// for each depth
 	for (int iDepth = 0; iDepth < nDepthWarp; iDepth++) {
-		// generate row
-		Row(iDepth, &travelTimeArray[iDepth * nDistanceWarp],
-			&depthDistanceArray[iDepth * nDistanceWarp],
-			&phaseArray[iDepth * nDistanceWarp]);
-
 		// init min/max for this depth
 		int minDelta = -1;
 		int maxDelta = -1;
@@ -559,9 +599,19 @@ bool CGenTrv::generate(json::Object *com) {
 							"CGenTrv::generate: writing file: " + outFileName);
 
 	FILE *outFile = fopen(outFileName.c_str(), "wb");
+	if (outFile == NULL) {
+		glassutil::CLogit::log(
+				glassutil::log_level::error,
+				"CGenTrv::generate: Unable to open file: " + outFileName);
+
+		delete[] (travelTimeArray);
+		delete[] (depthDistanceArray);
+		delete[] (phaseArray);
+		return (false);
+	}
 
 	// write header values
-	fwrite(&fileType, 1, 4, outFile);
+	fwrite(fileType.c_str(), 1, 4, outFile);
 	fwrite(&endianType, 1, 2, outFile);
 	fwrite(branch, 1, 16, outFile);
 	fwrite(phases, 1, 64, outFile);
@@ -604,6 +654,12 @@ bool CGenTrv::generate(json::Object *com) {
 // ---------------------------------------------------------Row
 int CGenTrv::Row(int iDepth, double *travelTimeArray,
 					double *depthDistanceArray, char *phaseArray) {
+	return (Row(iDepth, travelTimeArray, depthDistanceArray, phaseArray, pRay));
+}
+
+// ---------------------------------------------------------Row
+int CGenTrv::Row(int iDepth, double *travelTimeArray,
+					double *depthDistanceArray, char *phaseArray, CRay *ray) {
 	glassutil::CLogit::log(
 			glassutil::log_level::debug,
 			"CGenTrv::Row: iDepth: " + std::to_string(iDepth) + +" depth:"
@@ -636,16 +692,20 @@ int CGenTrv::Row(int iDepth, double *travelTimeArray,
 			double distance = pDistanceWarp->value(distanceIndex);
 
 			// generate traveltime for this phase / distance / depth
-			if (T(phase, distance, depth)) {
+			double travelTime;
+			double depthDistance;
+			double rayParam;
+			if (T(phase, distance, depth, ray, &travelTime, &depthDistance,
+					&rayParam)) {
 				// check to see if the travel time array has either an invalid
 				// travel time OR the new travel time is earlier than the travel
 				// time stored in the array
 				if ((travelTimeArray[distanceIndex] < 0.0)
-						|| (dTravelTime < travelTimeArray[distanceIndex])) {
+						|| (travelTime < travelTimeArray[distanceIndex])) {
 					// set arrays to new time/distance/ray/phase
-					travelTimeArray[distanceIndex] = dTravelTime;
-					depthDistanceArray[distanceIndex] = dDepthDistance;
-					rayParameters[distanceIndex] = rayParameter;
+					travelTimeArray[distanceIndex] = travelTime;
+					depthDistanceArray[distanceIndex] = depthDistance;
+					rayParameters[distanceIndex] = rayParam;
 
 					// NOTE: we're putting an int into a char array?!?!
 					phaseArray[distanceIndex] = phaseIndex;
@@ -750,6 +810,29 @@ int CGenTrv::Row(int iDepth, double *travelTimeArray,
 
 // ---------------------------------------------------------T
 bool CGenTrv::T(std::string phase, double delta, double depth) {
+	dTravelTime = -10.0;
+
+	double travelTime;
+	double depthDistance;
+	double rayParam;
+	if (!T(phase, delta, depth, pRay, &travelTime, &depthDistance,
+			&rayParam)) {
+		return (false);
+	}
+
+	// fill in values
+	dTravelTime = travelTime;
+	dDepthDistance = depthDistance;
+	rayParameter = rayParam;
+	Phase = phase;
+
+	return (true);
+}
+
+// ---------------------------------------------------------T
+bool CGenTrv::T(std::string phase, double delta, double depth, CRay *ray,
+				double *outTravelTime, double *outDepthDistance,
+				double *outRayParam) {
 	// delta in degrees, depth in km
 	// This routine uses reciprocity to calculate travel
 	// times when source is above station
@@ -763,8 +846,8 @@ bool CGenTrv::T(std::string phase, double delta, double depth) {
 	double earthRadius = pTerra->dEarthRadius;
 
 	// init travel time and ray parameter
-	double rayParam = 0.0;
-	dTravelTime = -10.0;
+	double rayParameter = 0.0;
+	double bestTravelTime = -10.0;
 	double travelTime = -10.0;
 
 	// set up radius
@@ -779,12 +862,12 @@ bool CGenTrv::T(std::string phase, double delta, double depth) {
 	}
 
 	// init travel time ray parameters object
-	pRay->setPhase(phase.c_str());
-	pRay->setDepth(earthRadius - sourceRadius);
-	pRay->setupRayParam();
+	ray->setPhase(phase.c_str());
+	ray->setDepth(earthRadius - sourceRadius);
+	ray->setupRayParam();
 
 	// get travel time and ray parameter
-	travelTime = pRay->travel((DEG2RAD * delta), radius, &rayParam);
+	travelTime = ray->travel((DEG2RAD * delta), radius, &rayParameter);
 
 	// check for valid travel time
 	if (travelTime < 0) {
@@ -792,7 +875,7 @@ bool CGenTrv::T(std::string phase, double delta, double depth) {
 		return (false);
 	}
 
-	if ((dTravelTime < 0) || (travelTime < dTravelTime)) {
+	if ((bestTravelTime < 0) || (travelTime < bestTravelTime)) {
 		// set up radius
 		radius = earthRadius + 1;
 		sourceRadius = earthRadius - depth;
@@ -805,11 +888,11 @@ bool CGenTrv::T(std::string phase, double delta, double depth) {
 		}
 
 		// init travel time ray parameters object
-		pRay->setDepth(earthRadius - sourceRadius);
-		pRay->setupRayParam();
+		ray->setDepth(earthRadius - sourceRadius);
+		ray->setupRayParam();
 
 		// get travel time and ray parameter
-		double tdif = pRay->travel((DEG2RAD * delta), radius);
+		double tdif = ray->travel((DEG2RAD * delta), radius);
 
 		// check for valid travel time
 		if (tdif < 0) {
@@ -818,10 +901,9 @@ bool CGenTrv::T(std::string phase, double delta, double depth) {
 		}
 
 		// fill in values
-		dTravelTime = travelTime;
-		dDepthDistance = tdif - dTravelTime;
-		rayParameter = rayParam;
-		Phase = phase;
+		*outTravelTime = travelTime;
+		*outDepthDistance = tdif - travelTime;
+		*outRayParam = rayParameter;
 
 		// have a travel time
 		return (true);
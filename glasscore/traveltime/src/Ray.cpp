@@ -27,6 +27,7 @@ CRay::~CRay() {
 // ---------------------------------------------------------initialize
 void CRay::initialize(CTerra *terra) {
 	pTerra = terra;
+	mSegmentCache.clear();
 }
 
 // ---------------------------------------------------------clear
@@ -37,6 +38,7 @@ void CRay::clear() {
 	dMaximumRayParam = 0;
 	dEarthRadius = 0;
 	iPhaseIndex = -1;
+	mSegmentCache.clear();
 }
 
 // ------------------------------------------------------------------setPhase
@@ -233,20 +235,20 @@ double CRay::travel(double delta, double earthRadius, double *rayParam) {
 		case RAY_Pdiff:
 			rturn = pTerra->dLayerRadii[pTerra->iOuterDiscontinuity + 1];
 			d = 2.0
-					* pTerra->integrateRaySegment(FUN_P_DELTA, rturn,
+					* integrateSegment(FUN_P_DELTA, rturn,
 													dEarthRadius,
 													dMinimumRayParam)
-					+ pTerra->integrateRaySegment(FUN_P_DELTA, dEarthRadius,
+					+ integrateSegment(FUN_P_DELTA, dEarthRadius,
 													earthRadius,
 													dMinimumRayParam);
 			if (delta < d) {
 				return (trav);
 			}
 			time = 2.0
-					* pTerra->integrateRaySegment(FUN_P_TIME, rturn,
+					* integrateSegment(FUN_P_TIME, rturn,
 													dEarthRadius,
 													dMinimumRayParam)
-					+ pTerra->integrateRaySegment(FUN_P_TIME, dEarthRadius,
+					+ integrateSegment(FUN_P_TIME, dEarthRadius,
 													earthRadius,
 													dMinimumRayParam);
 			trav =
@@ -262,19 +264,19 @@ double CRay::travel(double delta, double earthRadius, double *rayParam) {
 		case RAY_Sdiff:
 			rturn = pTerra->dLayerRadii[pTerra->iOuterDiscontinuity + 1];
 			d = 2.0
-					* pTerra->integrateRaySegment(FUN_S_DELTA, rturn,
+					* integrateSegment(FUN_S_DELTA, rturn,
 													dEarthRadius,
 													dMinimumRayParam)
-					+ pTerra->integrateRaySegment(FUN_S_DELTA, dEarthRadius,
+					+ integrateSegment(FUN_S_DELTA, dEarthRadius,
 													earthRadius,
 													dMinimumRayParam);
 			if (delta < d)
 				return (trav);
 			time = 2.0
-					* pTerra->integrateRaySegment(FUN_S_TIME, rturn,
+					* integrateSegment(FUN_S_TIME, rturn,
 													dEarthRadius,
 													dMinimumRayParam)
-					+ pTerra->integrateRaySegment(FUN_S_TIME, dEarthRadius,
+					+ integrateSegment(FUN_S_TIME, dEarthRadius,
 													earthRadius,
 													dMinimumRayParam);
 			trav =
@@ -542,7 +544,7 @@ double CRay::integrateFunction(int functionIndex, double rayParam,
 	val = 0.0;
 	switch (iPhaseIndex) {
 		case RAY_Pup:
-			val = pTerra->integrateRaySegment(functionIndex, dEarthRadius,
+			val = integrateSegment(functionIndex, dEarthRadius,
 												earthRadius, rayParam);
 			break;
 		case RAY_P:
@@ -551,9 +553,9 @@ double CRay::integrateFunction(int functionIndex, double rayParam,
 			rturn = pTerra->calculateTurnRadius(ilay1, ilay2,
 												pTerra->dLayerPVel, rayParam);
 			val = 2.0
-					* pTerra->integrateRaySegment(functionIndex, rturn,
+					* integrateSegment(functionIndex, rturn,
 													dEarthRadius, rayParam)
-					+ pTerra->integrateRaySegment(functionIndex, dEarthRadius,
+					+ integrateSegment(functionIndex, dEarthRadius,
 													earthRadius, rayParam);
 			break;
 		case RAY_Pdiff:
@@ -565,10 +567,10 @@ double CRay::integrateFunction(int functionIndex, double rayParam,
 			rturn = pTerra->calculateTurnRadius(ilay1, ilay2,
 												pTerra->dLayerPVel, rayParam);
 			val = 4.0
-					* pTerra->integrateRaySegment(functionIndex, rturn,
+					* integrateSegment(functionIndex, rturn,
 													dEarthRadius, rayParam)
 					+ 3.0
-							* pTerra->integrateRaySegment(functionIndex,
+							* integrateSegment(functionIndex,
 															dEarthRadius,
 															earthRadius,
 															rayParam);
@@ -579,10 +581,10 @@ double CRay::integrateFunction(int functionIndex, double rayParam,
 			rturn = pTerra->calculateTurnRadius(ilay1, ilay2,
 												pTerra->dLayerPVel, rayParam);
 			val = 6.0
-					* pTerra->integrateRaySegment(functionIndex, rturn,
+					* integrateSegment(functionIndex, rturn,
 													dEarthRadius, rayParam)
 					+ 5.0
-							* pTerra->integrateRaySegment(functionIndex,
+							* integrateSegment(functionIndex,
 															dEarthRadius,
 															earthRadius,
 															rayParam);
@@ -595,9 +597,9 @@ double CRay::integrateFunction(int functionIndex, double rayParam,
 			rturn = pTerra->calculateTurnRadius(ilay1, ilay2,
 												pTerra->dLayerPVel, rayParam);
 			val = 2.0
-					* pTerra->integrateRaySegment(functionIndex, rturn,
+					* integrateSegment(functionIndex, rturn,
 													dEarthRadius, rayParam)
-					+ pTerra->integrateRaySegment(functionIndex, dEarthRadius,
+					+ integrateSegment(functionIndex, dEarthRadius,
 													earthRadius, rayParam);
 			break;
 		case RAY_PKIKP:
@@ -607,22 +609,22 @@ double CRay::integrateFunction(int functionIndex, double rayParam,
 			rturn = pTerra->calculateTurnRadius(ilay1, ilay2,
 												pTerra->dLayerPVel, rayParam);
 			val = 2.0
-					* pTerra->integrateRaySegment(functionIndex, rturn,
+					* integrateSegment(functionIndex, rturn,
 													dEarthRadius, rayParam)
-					+ pTerra->integrateRaySegment(functionIndex, dEarthRadius,
+					+ integrateSegment(functionIndex, dEarthRadius,
 													earthRadius, rayParam);
 			break;
 		case RAY_PcP:
 			rturn = pTerra->dLayerRadii[pTerra->iOuterDiscontinuity + 1];
 			val = 2.0
-					* pTerra->integrateRaySegment(functionIndex, rturn,
+					* integrateSegment(functionIndex, rturn,
 													dEarthRadius, rayParam)
-					+ pTerra->integrateRaySegment(functionIndex, dEarthRadius,
+					+ integrateSegment(functionIndex, dEarthRadius,
 													earthRadius, rayParam);
 
 			break;
 		case RAY_Sup:
-			val = pTerra->integrateRaySegment(functionIndex + 1, dEarthRadius,
+			val = integrateSegment(functionIndex + 1, dEarthRadius,
 												earthRadius, rayParam);
 			break;
 		case RAY_S:
@@ -631,9 +633,9 @@ double CRay::integrateFunction(int functionIndex, double rayParam,
 			rturn = pTerra->calculateTurnRadius(ilay1, ilay2,
 												pTerra->dLayerSVel, rayParam);
 			val = 2.0
-					* pTerra->integrateRaySegment(functionIndex + 1, rturn,
+					* integrateSegment(functionIndex + 1, rturn,
 													dEarthRadius, rayParam)
-					+ pTerra->integrateRaySegment(functionIndex + 1,
+					+ integrateSegment(functionIndex + 1,
 													dEarthRadius, earthRadius,
 													rayParam);
 			break;
@@ -645,10 +647,10 @@ double CRay::integrateFunction(int functionIndex, double rayParam,
 			rturn = pTerra->calculateTurnRadius(ilay1, ilay2,
 												pTerra->dLayerSVel, rayParam);
 			val = 4.0
-					* pTerra->integrateRaySegment(functionIndex + 1, rturn,
+					* integrateSegment(functionIndex + 1, rturn,
 													dEarthRadius, rayParam)
 					+ 3.0
-							* pTerra->integrateRaySegment(functionIndex + 1,
+							* integrateSegment(functionIndex + 1,
 															dEarthRadius,
 															earthRadius,
 															rayParam);
@@ -659,10 +661,10 @@ double CRay::integrateFunction(int functionIndex, double rayParam,
 			rturn = pTerra->calculateTurnRadius(ilay1, ilay2,
 												pTerra->dLayerSVel, rayParam);
 			val = 6.0
-					* pTerra->integrateRaySegment(functionIndex + 1, rturn,
+					* integrateSegment(functionIndex + 1, rturn,
 													dEarthRadius, rayParam)
 					+ 5.0
-							* pTerra->integrateRaySegment(functionIndex + 1,
+							* integrateSegment(functionIndex + 1,
 															dEarthRadius,
 															earthRadius,
 															rayParam);
@@ -673,6 +675,31 @@ double CRay::integrateFunction(int functionIndex, double rayParam,
 	return val;
 }
 
+// -----------------------------------------------------------integrateSegment
+double CRay::integrateSegment(int functionIndex, double startingRadius,
+								double endingRadius, double rayParam) {
+	std::tuple<int, double, double, double> key(functionIndex, startingRadius,
+												endingRadius, rayParam);
+
+	// check the cache
+	auto found = mSegmentCache.find(key);
+	if (found != mSegmentCache.end()) {
+		return (found->second);
+	}
+
+	// keep the cache from growing without bound
+	// NOTE: Cache limit is hard coded
+	if (mSegmentCache.size() >= 250000) {
+		mSegmentCache.clear();
+	}
+
+	double val = pTerra->integrateRaySegment(functionIndex, startingRadius,
+												endingRadius, rayParam);
+	mSegmentCache[key] = val;
+
+	return (val);
+}
+
 // ------------------------------------------------------calculateThetaFunction
 double CRay::calculateThetaFunction(double rayParam, double dFunFac,
 									double dDelta, double dRcvr) {
@@ -690,15 +717,13 @@ double CRay::calculateThetaFunction(double rayParam, double dFunFac,
 }
 
 // ------------------------------------------------------calculateBracketMinima
-static double dArg1;
-static double dArg2;
 #define ITMAX 50
 #define SHFT(a, b, c, d) (a)=(b); (b)=(c); (c)=(d);
 #define GOLD 1.618034
 #define GLIMIT 100.0
 #define TINY 1.0e-20
 #define SIGN(a, b) ((b) > 0.0 ? fabs(a) : -fabs(a))
-#define FMAX(a, b) (dArg1 = (a), dArg2 = (b), (dArg1 > dArg2) ? dArg1 : dArg2)
+#define FMAX(a, b) (((a) > (b)) ? (a) : (b))
 void CRay::calculateBracketMinima(double *x, double dFunFac, double dDelta,
 									double dRcvr) {
 	// calculateBracketMinima: Bracket function minima (1-dimensional)
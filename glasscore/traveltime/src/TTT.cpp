@@ -6,6 +6,7 @@
 #include "TravelTime.h"
 #include "Ray.h"
 #include "Logit.h"
+#include "Memory.h"
 
 namespace traveltime {
 
@@ -202,6 +203,20 @@ double CTTT::T(double delta, std::string phase) {
 	return (-1.0);
 }
 
+// ---------------------------------------------------------Tall
+int CTTT::Tall(double delta, double *travelTimes) {
+	// Calculate time from delta (degrees) for every phase
+	for (int i = 0; i < nTrv; i++) {
+		// set origin
+		pTrv[i]->setOrigin(dLat, dLon, dZ);
+
+		// get travel time
+		travelTimes[i] = pTrv[i]->T(delta);
+	}
+
+	return (nTrv);
+}
+
 // ---------------------------------------------------------T
 double CTTT::testTravelTimes(std::string phase) {
 	// Calculate time from delta (degrees)
@@ -237,11 +252,35 @@ double CTTT::testTravelTimes(std::string phase) {
 	return (1.0);
 }
 
+// ---------------------------------------------------------getMemoryUsage
+size_t CTTT::getMemoryUsage() const {
+	size_t bytes = sizeof(CTTT) + glassutil::CMemory::stringBytes(sPhase);
+
+	for (int i = 0; i < MAX_TRAV; i++) {
+		if (pTrv[i] != NULL) {
+			bytes += pTrv[i]->getMemoryUsage();
+		}
+		if (pTaper[i] != NULL) {
+			bytes += sizeof(glassutil::CTaper);
+		}
+	}
+
+	return (bytes);
+}
+
 // ---------------------------------------------------------T
 double CTTT::T(glassutil::CGeo *geo, double tObserved) {
-	// Find Phase with least residual, returns time
+	return (T(geo, tObserved, NULL, NULL));
+}
+
+// ---------------------------------------------------------T
+double CTTT::T(glassutil::CGeo *geo, double tObserved, double *dTdDelta,
+				double *dTdDepth) {
+	// Find Phase with least residual, returns time and derivatives
 
 	double bestTraveltime;
+	double bestDTdDelta = 0;
+	double bestDTdDepth = 0;
 	std::string bestPhase;
 	double weight;
 	double minResidual = 1000.0;
@@ -255,7 +294,9 @@ double CTTT::T(glassutil::CGeo *geo, double tObserved) {
 		aTrv->setOrigin(dLat, dLon, dZ);
 
 		// get traveltime
-		double traveltime = aTrv->T(geo);
+		double derivativeDelta = 0;
+		double derivativeDepth = 0;
+		double traveltime = aTrv->T(geo, &derivativeDelta, &derivativeDepth);
 
 		// check traveltime
 		if (traveltime < 0.0) {
@@ -290,6 +331,8 @@ double CTTT::T(glassutil::CGeo *geo, double tObserved) {
 			minResidual = residual;
 			bestPhase = aTrv->sPhase;
 			bestTraveltime = traveltime;
+			bestDTdDelta = derivativeDelta;
+			bestDTdDepth = derivativeDepth;
 
 			// use taper to compute weight if present
 			if (pTaper[i] != NULL) {
@@ -305,6 +348,13 @@ double CTTT::T(glassutil::CGeo *geo, double tObserved) {
 		sPhase = bestPhase;
 		dWeight = weight;
 
+		if (dTdDelta != NULL) {
+			*dTdDelta = bestDTdDelta;
+		}
+		if (dTdDepth != NULL) {
+			*dTdDepth = bestDTdDepth;
+		}
+
 		return (bestTraveltime);
 	}
 
@@ -84,8 +84,6 @@ double CTimeWarp::value(double gridIndex) {
 	}
 
 	// init
-	double a = 1.0 / dSlopeInfinity;
-	double b = 1.0 / dSlopeZero - 1.0 / dSlopeInfinity;
 	double val = 0.5 * (dGridMinimum + dGridMaximum);
 
 	// Calculate interpolated value
@@ -96,9 +94,17 @@ double CTimeWarp::value(double gridIndex) {
 			break;
 		}
 
-		double fp = a + b * exp(-dDecayConstant * val);
-		val -= f / fp;
+		val -= f / slope(val);
 	}
 	return (val);
 }
+
+// ---------------------------------------------------------slope
+double CTimeWarp::slope(double val) {
+	// Calculate derivative of grid index at value
+	double a = 1.0 / dSlopeInfinity;
+	double b = 1.0 / dSlopeZero - 1.0 / dSlopeInfinity;
+
+	return (a + b * exp(-dDecayConstant * val));
+}
 }  // namespace traveltime
@@ -2,8 +2,12 @@
 #include <cmath>
 #include <cstdio>
 #include <cstring>
+#include <cstdint>
+#include <memory>
+#include <vector>
 #include "Geo.h"
 #include "Logit.h"
+#include "Memory.h"
 #include "TimeWarp.h"
 #include "TravelTime.h"
 
@@ -15,6 +19,7 @@ CTravelTime::CTravelTime() {
 	pDepthWarp = NULL;
 	pTravelTimeArray = NULL;
 	pDepthDistanceArray = NULL;
+	pCoefficientArray = NULL;
 	pPhaseArray = NULL;
 
 	clear();
@@ -26,6 +31,7 @@ CTravelTime::CTravelTime(const CTravelTime &travelTime) {
 	pDepthWarp = NULL;
 	pTravelTimeArray = NULL;
 	pDepthDistanceArray = NULL;
+	pCoefficientArray = NULL;
 	pPhaseArray = NULL;
 
 	clear();
@@ -35,20 +41,16 @@ CTravelTime::CTravelTime(const CTravelTime &travelTime) {
 	dDepth = travelTime.dDepth;
 	dDelta = travelTime.dDelta;
 	sPhase = travelTime.sPhase;
-
-	// null check these?
-	pDistanceWarp = new CTimeWarp(*travelTime.pDistanceWarp);
-	pDepthWarp = new CTimeWarp(*travelTime.pDepthWarp);
-
-	pTravelTimeArray = new double[nDistanceWarp * nDepthWarp];
-	pDepthDistanceArray = new double[nDistanceWarp * nDepthWarp];
-	pPhaseArray = new char[nDistanceWarp * nDepthWarp];
-
-	for (int i = 0; i < (nDistanceWarp * nDepthWarp); i++) {
-		pTravelTimeArray[i] = travelTime.pTravelTimeArray[i];
-		pDepthDistanceArray[i] = travelTime.pDepthDistanceArray[i];
-		pPhaseArray[i] = travelTime.pPhaseArray[i];
-	}
+	geoOrg = travelTime.geoOrg;
+
+	// the tables are immutable, share them
+	pTable = travelTime.pTable;
+	pDistanceWarp = travelTime.pDistanceWarp;
+	pDepthWarp = travelTime.pDepthWarp;
+	pTravelTimeArray = travelTime.pTravelTimeArray;
+	pDepthDistanceArray = travelTime.pDepthDistanceArray;
+	pCoefficientArray = travelTime.pCoefficientArray;
+	pPhaseArray = travelTime.pPhaseArray;
 }
 
 // ---------------------------------------------------------~CTravelTime
@@ -63,30 +65,33 @@ void CTravelTime::clear() {
 	dDepth = 0;
 	dDelta = 0;
 
-	if (pDistanceWarp) {
-		delete (pDistanceWarp);
-	}
+	// release our reference to the tables, they are freed along with the
+	// last copy using them
+	pTable.reset();
 	pDistanceWarp = NULL;
-
-	if (pDepthWarp) {
-		delete (pDepthWarp);
-	}
 	pDepthWarp = NULL;
-
-	if (pTravelTimeArray) {
-		delete (pTravelTimeArray);
-	}
 	pTravelTimeArray = NULL;
-
-	if (pDepthDistanceArray) {
-		delete (pDepthDistanceArray);
-	}
 	pDepthDistanceArray = NULL;
+	pCoefficientArray = NULL;
+	pPhaseArray = NULL;
+}
 
-	if (pPhaseArray) {
-		delete (pPhaseArray);
+// ---------------------------------------------------------getMemoryUsage
+size_t CTravelTime::getMemoryUsage() const {
+	size_t bytes = sizeof(CTravelTime)
+			+ glassutil::CMemory::stringBytes(sPhase);
+
+	// this copy's share of the tables
+	if (pTable != NULL) {
+		size_t tableBytes = sizeof(TravelTimeTable)
+				+ pTable->travelTimes.capacity() * sizeof(double)
+				+ pTable->depthDistances.capacity() * sizeof(double)
+				+ pTable->phases.capacity() * sizeof(char)
+				+ pTable->coefficients.capacity() * sizeof(double);
+		bytes += tableBytes / pTable.use_count();
 	}
-	pPhaseArray = NULL;
+
+	return (bytes);
 }
 
 // ---------------------------------------------------------Setup
@@ -166,8 +171,10 @@ bool CTravelTime::setup(std::string phase, std::string file) {
 				nDistanceWarp, vlow, vhigh, alpha, bzero, binf);
 	glassutil::CLogit::log(sLog);
 
-	// create distance warp
-	pDistanceWarp = new CTimeWarp(vlow, vhigh, alpha, bzero, binf);
+	// create the table this travel time will share, and its distance warp
+	std::shared_ptr<TravelTimeTable> table =
+			std::make_shared<TravelTimeTable>();
+	table->distanceWarp.setup(vlow, vhigh, alpha, bzero, binf);
 
 	// read depth warp
 	vlow = 0;
@@ -189,21 +196,34 @@ bool CTravelTime::setup(std::string phase, std::string file) {
 	glassutil::CLogit::log(sLog);
 
 	// create depth warp
-	pDepthWarp = new CTimeWarp(vlow, vhigh, alpha, bzero, binf);
+	table->depthWarp.setup(vlow, vhigh, alpha, bzero, binf);
 
 	// create interpolation grids
-	pTravelTimeArray = new double[nDistanceWarp * nDepthWarp];
-	pDepthDistanceArray = new double[nDistanceWarp * nDepthWarp];
-	pPhaseArray = new char[nDistanceWarp * nDepthWarp];
+	table->travelTimes.resize(nDistanceWarp * nDepthWarp);
+	table->depthDistances.resize(nDistanceWarp * nDepthWarp);
+	table->phases.resize(nDistanceWarp * nDepthWarp);
 
 	// read interpolation grids
-	fread(pTravelTimeArray, 1, 8 * nDistanceWarp * nDepthWarp, inFile);
-	fread(pDepthDistanceArray, 1, 8 * nDistanceWarp * nDepthWarp, inFile);
-	fread(pPhaseArray, 1, nDistanceWarp * nDepthWarp, inFile);
+	fread(table->travelTimes.data(), 1, 8 * nDistanceWarp * nDepthWarp,
+			inFile);
+	fread(table->depthDistances.data(), 1, 8 * nDistanceWarp * nDepthWarp,
+			inFile);
+	fread(table->phases.data(), 1, nDistanceWarp * nDepthWarp, inFile);
 
 	// done with file
 	fclose(inFile);
 
+	// point at the new table, releasing any previous one
+	pTable = table;
+	pDistanceWarp = &table->distanceWarp;
+	pDepthWarp = &table->depthWarp;
+	pTravelTimeArray = table->travelTimes.data();
+	pDepthDistanceArray = table->depthDistances.data();
+	pPhaseArray = table->phases.data();
+
+	// precompute interpolation coefficients
+	setupCoefficients();
+
 	return (true);
 }
 
@@ -222,16 +242,40 @@ double CTravelTime::T(glassutil::CGeo *geo) {
 }
 
 // ---------------------------------------------------------T
-
 double CTravelTime::T(double delta) {
+	return (T(delta, NULL, NULL));
+}
+
+// ---------------------------------------------------------T
+double CTravelTime::T(glassutil::CGeo *geo, double *dTdDelta,
+						double *dTdDepth) {
+	// Calculate travel time and derivatives given CGeo
+	dDelta = RAD2DEG * geoOrg.delta(geo);
+
+	return (T(dDelta, dTdDelta, dTdDepth));
+}
+
+// ---------------------------------------------------------T
+double CTravelTime::T(double delta, double *dTdDelta, double *dTdDepth) {
 	// Calculate travel time given delta in degrees
 	double depth = pDepthWarp->grid(dDepth);
 	double distance = pDistanceWarp->grid(delta);
 
-	// compute travel time using bilinear interpolation
-	double travelTime = bilinear(distance, depth);
+	// compute travel time using bicubic interpolation
+	double dTdDistanceGrid = 0;
+	double dTdDepthGrid = 0;
+	double travelTime = bicubic(distance, depth, &dTdDistanceGrid,
+								&dTdDepthGrid);
 	dDelta = delta;
 
+	// convert the derivatives from grid coordinates
+	if (dTdDelta != NULL) {
+		*dTdDelta = dTdDistanceGrid * pDistanceWarp->slope(delta);
+	}
+	if (dTdDepth != NULL) {
+		*dTdDepth = dTdDepthGrid * pDepthWarp->slope(dDepth);
+	}
+
 	return (travelTime);
 }
 
@@ -254,49 +298,211 @@ double CTravelTime::T(int deltaIndex, int depthIndex) {
 
 // ---------------------------------------------------------Bilinear
 double CTravelTime::bilinear(double distance, double depth) {
-	double interpolationGrid[2][2];
-	double travelTime;
-	int startingDelta = static_cast<int>(distance);
-	int startingDepth = static_cast<int>(depth);
-	bool error = false;
-
-	// generate interpolation grid
-	for (int i = 0; i < 2; i++) {
-		// calculate distance index
-		int deltaIndex = startingDelta + i;
-
-		for (int j = 0; j < 2; j++) {
-			// calculate depth index
-			int depthIndex = startingDepth + j;
-
-			// get current travel time from travel time array
-			double time = T(deltaIndex, depthIndex);
-
-			// check current travel time
-			if (time < 0.0) {
-				error = true;
-			}
+	int deltaIndex = static_cast<int>(floor(distance));
+	int depthIndex = static_cast<int>(floor(depth));
 
-			// store travel time in interpolation grid
-			interpolationGrid[i][j] = time;
-		}
+	// bounds checks, both corners of the cell must be in the grid
+	if ((deltaIndex < 0) || (deltaIndex + 1 >= nDistanceWarp)) {
+		return (-1.0);
+	}
+	if ((depthIndex < 0) || (depthIndex + 1 >= nDepthWarp)) {
+		return (-1.0);
+	}
+
+	// get the travel times at the corners of the cell
+	const double *lower = &pTravelTimeArray[depthIndex * nDistanceWarp
+			+ deltaIndex];
+	const double *upper = lower + nDistanceWarp;
+	if ((lower[0] < 0.0) || (lower[1] < 0.0) || (upper[0] < 0.0)
+			|| (upper[1] < 0.0)) {
+		// no traveltime
+		return (-1.0);
+	}
+
+	double s = distance - deltaIndex;
+	double t = depth - depthIndex;
 
-		double s = distance - floor(distance);
-		double t = depth - floor(depth);
+	// compute overall travel time by interpolating grid
+	double travelTime = lower[0] * (1.0 - s) * (1.0 - t)
+			+ upper[0] * (1.0 - s) * t + lower[1] * s * (1.0 - t)
+			+ upper[1] * s * t;
 
-		// compute overall travel time by interpolating grid
-		travelTime = interpolationGrid[0][0] * (1.0f - s) * (1.0f - t)
-				+ interpolationGrid[0][1] * (1.0f - s) * t
-				+ interpolationGrid[1][0] * s * (1.0f - t)
-				+ interpolationGrid[1][1] * s * t;
+	return (travelTime);
+}
+
+// ---------------------------------------------------------bicubic
+double CTravelTime::bicubic(double distance, double depth,
+							double *dTdDistance, double *dTdDepth) {
+	if (pCoefficientArray == NULL) {
+		return (-1.0);
 	}
 
-	// check if we had errors
-	if (error) {
-		// no traveltime
+	int deltaIndex = static_cast<int>(floor(distance));
+	int depthIndex = static_cast<int>(floor(depth));
+
+	// bounds checks, both corners of the cell must be in the grid
+	if ((deltaIndex < 0) || (deltaIndex + 1 >= nDistanceWarp)) {
+		return (-1.0);
+	}
+	if ((depthIndex < 0) || (depthIndex + 1 >= nDepthWarp)) {
+		return (-1.0);
+	}
+
+	// the single cell fetch
+	const double *a = &pCoefficientArray[16
+			* (depthIndex * nDistanceWarp + deltaIndex)];
+
+	// invalid cells are marked with a negative constant term
+	if (a[0] < 0.0) {
 		return (-1.0);
 	}
 
+	double s = distance - deltaIndex;
+	double t = depth - depthIndex;
+
+	// evaluate the cubic in t for each power of s, then the cubic in s,
+	// T = sum a[4i+j] s^i t^j
+	double c[4];
+	double dc[4];
+	for (int i = 0; i < 4; i++) {
+		const double *row = &a[4 * i];
+		c[i] = ((row[3] * t + row[2]) * t + row[1]) * t + row[0];
+		dc[i] = (3.0 * row[3] * t + 2.0 * row[2]) * t + row[1];
+	}
+
+	double travelTime = ((c[3] * s + c[2]) * s + c[1]) * s + c[0];
+
+	if (dTdDistance != NULL) {
+		*dTdDistance = (3.0 * c[3] * s + 2.0 * c[2]) * s + c[1];
+	}
+	if (dTdDepth != NULL) {
+		*dTdDepth = ((dc[3] * s + dc[2]) * s + dc[1]) * s + dc[0];
+	}
+
 	return (travelTime);
 }
+
+// ---------------------------------------------------------setupCoefficients
+void CTravelTime::setupCoefficients() {
+	pCoefficientArray = NULL;
+
+	if ((pTable == NULL) || (pTravelTimeArray == NULL) || (nDistanceWarp < 2)
+			|| (nDepthWarp < 2)) {
+		return;
+	}
+
+	int nNode = nDistanceWarp * nDepthWarp;
+	const double *tt = pTravelTimeArray;
+
+	// finite difference estimate of the derivative of a node array along
+	// one grid axis, central where both neighbors have travel times, one
+	// sided where only one does
+	auto difference = [&](const std::vector<double> &values, int deltaIndex,
+			int depthIndex, int step) {
+		int node = depthIndex * nDistanceWarp + deltaIndex;
+		int index = (step == 1) ? deltaIndex : depthIndex;
+		int count = (step == 1) ? nDistanceWarp : nDepthWarp;
+		int stride = (step == 1) ? 1 : nDistanceWarp;
+
+		bool before = (index > 0) && (tt[node - stride] >= 0.0);
+		bool after = (index + 1 < count) && (tt[node + stride] >= 0.0);
+
+		if (before && after) {
+			return (0.5 * (values[node + stride] - values[node - stride]));
+		} else if (after) {
+			return (values[node + stride] - values[node]);
+		} else if (before) {
+			return (values[node] - values[node - stride]);
+		}
+		return (0.0);
+	};
+
+	// derivatives at the nodes, in grid coordinates
+	std::vector<double> times(tt, tt + nNode);
+	std::vector<double> fs(nNode, 0.0);
+	std::vector<double> ft(nNode, 0.0);
+	std::vector<double> fst(nNode, 0.0);
+	for (int j = 0; j < nDepthWarp; j++) {
+		for (int i = 0; i < nDistanceWarp; i++) {
+			if (tt[j * nDistanceWarp + i] < 0.0) {
+				continue;
+			}
+			fs[j * nDistanceWarp + i] = difference(times, i, j, 1);
+			ft[j * nDistanceWarp + i] = difference(times, i, j, 2);
+		}
+	}
+	for (int j = 0; j < nDepthWarp; j++) {
+		for (int i = 0; i < nDistanceWarp; i++) {
+			if (tt[j * nDistanceWarp + i] < 0.0) {
+				continue;
+			}
+			fst[j * nDistanceWarp + i] = difference(ft, i, j, 1);
+		}
+	}
+
+	// allocate 16 coefficients per node, with room to align the array to a
+	// 64 byte cache line so that each cell spans exactly two lines
+	pTable->coefficients.assign(16 * nNode + 8, 0.0);
+	double *buffer = pTable->coefficients.data();
+	uintptr_t offset = reinterpret_cast<uintptr_t>(buffer) % 64;
+	pCoefficientArray = buffer + ((offset == 0) ? 0 : (64 - offset) / 8);
+
+	// hermite basis, p(x) = sum M[i][k] x^i over the values and derivatives
+	// at 0 and 1
+	static const double M[4][4] = { { 1.0, 0.0, 0.0, 0.0 }, { 0.0, 0.0, 1.0,
+			0.0 }, { -3.0, 3.0, -2.0, -1.0 }, { 2.0, -2.0, 1.0, 1.0 } };
+
+	for (int j = 0; j < nDepthWarp; j++) {
+		for (int i = 0; i < nDistanceWarp; i++) {
+			double *a = &pCoefficientArray[16 * (j * nDistanceWarp + i)];
+
+			// the last row and column of nodes do not start a cell
+			bool valid = (i + 1 < nDistanceWarp) && (j + 1 < nDepthWarp);
+
+			int n00 = j * nDistanceWarp + i;
+			int n10 = n00 + 1;
+			int n01 = n00 + nDistanceWarp;
+			int n11 = n01 + 1;
+			if (valid && ((tt[n00] < 0.0) || (tt[n10] < 0.0) || (tt[n01] < 0.0)
+					|| (tt[n11] < 0.0))) {
+				valid = false;
+			}
+
+			if (!valid) {
+				for (int k = 0; k < 16; k++) {
+					a[k] = 0.0;
+				}
+				a[0] = -1.0;
+				continue;
+			}
+
+			// values and derivatives at the corners, rows are s = 0, s = 1,
+			// and the s derivatives at each, columns likewise in t
+			double F[4][4] = { { tt[n00], tt[n01], ft[n00], ft[n01] }, {
+					tt[n10], tt[n11], ft[n10], ft[n11] }, { fs[n00], fs[n01],
+					fst[n00], fst[n01] }, { fs[n10], fs[n11], fst[n10],
+					fst[n11] } };
+
+			// a = M F M^T
+			double MF[4][4];
+			for (int r = 0; r < 4; r++) {
+				for (int c = 0; c < 4; c++) {
+					MF[r][c] = 0.0;
+					for (int k = 0; k < 4; k++) {
+						MF[r][c] += M[r][k] * F[k][c];
+					}
+				}
+			}
+			for (int r = 0; r < 4; r++) {
+				for (int c = 0; c < 4; c++) {
+					double sum = 0.0;
+					for (int k = 0; k < 4; k++) {
+						sum += MF[r][k] * M[c][k];
+					}
+					a[4 * r + c] = sum;
+				}
+			}
+		}
+	}
+}
 }  // namespace traveltime
@@ -8,6 +8,8 @@
 #define OUTPUT_H
 
 #include <json.h>
+#include <IGlassSend.h>
+#include <HypoRecord.h>
 #include <threadbaseclass.h>
 #include <outputinterface.h>
 #include <associatorinterface.h>
@@ -24,6 +26,10 @@
 #include <fstream>
 #include <vector>
 #include <memory>
+#include <queue>
+#include <map>
+#include <functional>
+#include <utility>
 
 namespace glass {
 /**
@@ -34,9 +40,11 @@ namespace glass {
  * and writes the messages out to disk.
  *
  * output inherits from the threadbaseclass class.
- * output implements the ioutput interface.
+ * output implements the ioutput and IGlassSend interfaces, the latter
+ * to receive typed hypo records from glasscore.
  */
-class output : public util::iOutput, public util::ThreadBaseClass {
+class output : public util::iOutput, public glasscore::IGlassSend,
+		public util::ThreadBaseClass {
  public:
 	/**
 	 * \brief output constructor
@@ -84,6 +92,27 @@ class output : public util::iOutput, public util::ThreadBaseClass {
 	 */
 	void sendToOutput(std::shared_ptr<json::Object> message) override;
 
+	/**
+	 * \brief glasscore message receiver function
+	 *
+	 * The function (from IGlassSend) used to receive communication from
+	 * glasscore, equivalent to sendToOutput.
+	 *
+	 * \param message - A json::Object containing the message to send to output.
+	 */
+	void Send(std::shared_ptr<json::Object> message) override;
+
+	/**
+	 * \brief glasscore hypo record receiver function
+	 *
+	 * The function (from IGlassSend) used to receive typed hypo records from
+	 * glasscore. Records are queued and written without being converted to
+	 * an intermediate json::Object.
+	 *
+	 * \param hypo - A shared pointer to the immutable HypoRecord to output.
+	 */
+	void Send(std::shared_ptr<const glasscore::HypoRecord> hypo) override;
+
 	bool start() override;
 	bool stop() override;
 	bool isRunning() override;
@@ -213,11 +242,15 @@ class output : public util::iOutput, public util::ThreadBaseClass {
 	/**
 	 * \brief output work function
 	 *
-	 * The function (from threadclassbase) used to do work.
+	 * The function (from threadclassbase) used to do work. Handles one
+	 * hypo record and one queued message per call, the work loop calls it
+	 * repeatedly while there is data.
 	 *
-	 * \return returns true if work was successful, false otherwise.
+	 * \return returns util::WorkState::OK if anything was handled,
+	 * util::WorkState::Idle if there was nothing to handle, and
+	 * util::WorkState::Error if something went wrong.
 	 */
-	bool work() override;
+	util::WorkState work() override;
 
 	void checkEventsLoop();
 
@@ -231,6 +264,74 @@ class output : public util::iOutput, public util::ThreadBaseClass {
 	 */
 	void writeOutput(std::shared_ptr<json::Object> data);
 
+	/**
+	 * \brief hypo record writing function
+	 *
+	 * The function used to output a typed hypo record as a detection
+	 *
+	 * \param hypo - A shared pointer to the immutable HypoRecord to output.
+	 * \param isUpdate - A boolean flag indicating whether this detection is an
+	 * update to a previously published detection
+	 */
+	void writeHypoOutput(std::shared_ptr<const glasscore::HypoRecord> hypo,
+							bool isUpdate);
+
+	/**
+	 * \brief hypo record delta writing function
+	 *
+	 * The function used to output a typed hypo record as an incremental
+	 * update relative to the previously published record
+	 *
+	 * \param hypo - A shared pointer to the immutable HypoRecord to output.
+	 * \param previous - A shared pointer to the immutable HypoRecord last
+	 * published for this hypo
+	 */
+	void writeHypoDeltaOutput(std::shared_ptr<const glasscore::HypoRecord> hypo,
+								std::shared_ptr<const glasscore::HypoRecord> previous);  // NOLINT
+
+	/**
+	 * \brief published record removal function
+	 *
+	 * Forget the last published record for the given id, so that the next
+	 * publication for it is a full snapshot
+	 *
+	 * \param id - A std::string containing the id to forget
+	 */
+	void removePublishedRecord(const std::string &id);
+
+	/**
+	 * \brief hypo record job scheduling function
+	 *
+	 * Queue a job that converts and sends a record for the given hypo id.
+	 * The jobs for one hypo run one at a time and in order on the thread pool,
+	 * so that a delta is never sent ahead of the record it is relative to,
+	 * while the jobs for different hypos run in parallel.
+	 *
+	 * \param id - A std::string containing the hypo id
+	 * \param job - A std::function<void()> containing the job to run
+	 */
+	void addHypoJob(const std::string &id, std::function<void()> job);
+
+	/**
+	 * \brief hypo record job running function
+	 *
+	 * Run the queued jobs for the given hypo id on a thread pool thread,
+	 * until there are none left.
+	 *
+	 * \param id - A std::string containing the hypo id
+	 */
+	void runHypoJobs(std::string id);
+
+	/**
+	 * \brief hypo record work function
+	 *
+	 * The function used by work() to handle the next queued hypo record,
+	 * if any.
+	 *
+	 * \return returns true if a hypo record was handled, false otherwise
+	 */
+	bool workHypoRecord();
+
 	virtual void sendOutput(const std::string &type, const std::string &id,
 							const std::string &message) = 0;
 
@@ -276,6 +377,16 @@ class output : public util::iOutput, public util::ThreadBaseClass {
 	 */
 	util::Queue* m_OutputQueue;
 
+	/**
+	 * \brief the queue of typed hypo records received from glasscore
+	 */
+	std::queue<std::shared_ptr<const glasscore::HypoRecord>> m_HypoRecordQueue;
+
+	/**
+	 * \brief the mutex for m_HypoRecordQueue
+	 */
+	std::mutex m_HypoRecordQueueMutex;
+
 	/**
 	 * \brief pointer to the util::queue class used to manage
 	 * incoming lookup messages
@@ -286,6 +397,41 @@ class output : public util::iOutput, public util::ThreadBaseClass {
 
 	bool m_bPubOnExpiration;
 
+	/**
+	 * \brief A boolean flag indicating whether to publish incremental updates
+	 * instead of full detections for events that have already been published
+	 */
+	bool m_bPublishDeltas;
+
+	/**
+	 * \brief The number of consecutive incremental updates to publish for an
+	 * event before publishing a full snapshot again
+	 */
+	int m_iSnapshotInterval;
+
+	/**
+	 * \brief The last published record and the number of incremental updates
+	 * published since the last full snapshot, indexed by id
+	 */
+	std::map<std::string,
+			std::pair<std::shared_ptr<const glasscore::HypoRecord>, int>> m_PublishedRecords;  // NOLINT
+
+	/**
+	 * \brief the mutex for m_PublishedRecords
+	 */
+	std::mutex m_PublishedRecordsMutex;
+
+	/**
+	 * \brief The hypo record jobs waiting to run, indexed by id.  An id is
+	 * present while a thread pool job is running its queue
+	 */
+	std::map<std::string, std::queue<std::function<void()>>> m_HypoJobs;
+
+	/**
+	 * \brief the mutex for m_HypoJobs
+	 */
+	std::mutex m_HypoJobsMutex;
+
 	/**
 	 * \brief the total messages performance counter
 	 */
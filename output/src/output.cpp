@@ -149,6 +149,40 @@ bool output::setup(json::Object *config) {
 		}
 	}
 
+	// publish deltas
+	if (!(config->HasKey("PublishDeltas"))) {
+		// publish deltas is optional, default to false
+		m_bPublishDeltas = false;
+		logger::log(
+				"info",
+				"output::setup(): PublishDeltas not specified, using default "
+				"of false.");
+	} else {
+		m_bPublishDeltas = (*config)["PublishDeltas"].ToBool();
+
+		logger::log(
+				"info",
+				"output::setup(): Using PublishDeltas: "
+						+ std::to_string(m_bPublishDeltas) + " .");
+	}
+
+	// snapshot interval
+	if (!(config->HasKey("SnapshotInterval"))) {
+		// snapshot interval is optional, default to 10
+		m_iSnapshotInterval = 10;
+		logger::log(
+				"info",
+				"output::setup(): SnapshotInterval not specified, using default "
+				"of 10.");
+	} else {
+		m_iSnapshotInterval = (*config)["SnapshotInterval"].ToInt();
+
+		logger::log(
+				"info",
+				"output::setup(): Using SnapshotInterval: "
+						+ std::to_string(m_iSnapshotInterval) + " .");
+	}
+
 	// agencyid
 	if (!(config->HasKey("OutputAgencyID"))) {
 		// agencyid is optional
@@ -200,6 +234,9 @@ bool output::setup(json::Object *config) {
 				"output::setup(): Using StationFile: " + m_sStationFile + ".");
 	}
 
+	// work batch size and time
+	setupWorkBatch(config);
+
 	// unlock our configuration
 	m_ConfigMutex.unlock();
 
@@ -241,6 +278,8 @@ void output::clear() {
 	m_PublicationTimes.clear();
 	m_iSiteListDelay = -1;
 	m_sStationFile = "";
+	m_bPublishDeltas = false;
+	m_iSnapshotInterval = 10;
 
 	// unlock our configuration
 	m_ConfigMutex.unlock();
@@ -280,6 +319,19 @@ void output::sendToOutput(std::shared_ptr<json::Object> message) {
 	}
 }
 
+void output::Send(std::shared_ptr<json::Object> message) {
+	sendToOutput(message);
+}
+
+void output::Send(std::shared_ptr<const glasscore::HypoRecord> hypo) {
+	if (hypo == NULL) {
+		return;
+	}
+
+	std::lock_guard<std::mutex> guard(m_HypoRecordQueueMutex);
+	m_HypoRecordQueue.push(hypo);
+}
+
 bool output::start() {
 	// are we already running
 	if (m_bRunEventThread == true) {
@@ -571,6 +623,9 @@ bool output::haveTrackingData(std::string ID) {
 void output::clearTrackingData() {
 	std::lock_guard<std::mutex> guard(m_TrackingCacheMutex);
 	m_TrackingCache->clearCache();
+
+	std::lock_guard<std::mutex> publishedGuard(m_PublishedRecordsMutex);
+	m_PublishedRecords.clear();
 }
 
 void output::checkEventsLoop() {
@@ -635,6 +690,13 @@ void output::checkEventsLoop() {
 					(*datarequest)["Cmd"] = "ReqHypo";
 					(*datarequest)["Pid"] = id;
 
+					// let glass know an incremental update is acceptable
+					m_ConfigMutex.lock();
+					if (m_bPublishDeltas == true) {
+						(*datarequest)["Delta"] = true;
+					}
+					m_ConfigMutex.unlock();
+
 					// send the request
 					Associator->sendToAssociator(datarequest);
 				}
@@ -651,7 +713,7 @@ void output::checkEventsLoop() {
 	return;
 }
 
-bool output::work() {
+util::WorkState output::work() {
 	// pull data from our config at the start of each loop
 	// so that we can have config that changes
 	// should I do this?
@@ -665,9 +727,12 @@ bool output::work() {
 		logger::log(
 				"critical",
 				"output::work(): No m_OutputQueue and/or m_LookupQueue.");
-		return (false);
+		return (util::WorkState::Error);
 	}
 
+	// handle any hypo records glass has sent us
+	bool hypoRecord = workHypoRecord();
+
 	// first see what we're supposed to do with a new message
 	// see if there's an output in the message queue
 	std::shared_ptr<json::Object> message = m_OutputQueue->getDataFromQueue();
@@ -703,7 +768,7 @@ bool output::work() {
 			logger::log(
 					"critical",
 					"output::work(): BAD message passed in, no Cmd/Type found.");
-			return (false);
+			return (util::WorkState::Error);
 		}
 
 		std::string messageid;
@@ -724,7 +789,7 @@ bool output::work() {
 					messageid);
 
 			if (trackingData == NULL) {
-				return (false);
+				return (util::WorkState::Error);
 			}
 
 			logger::log(
@@ -795,6 +860,7 @@ bool output::work() {
 
 				// remove from the tracking cache
 				removeTrackingData(messageid);
+				removePublishedRecord(messageid);
 			}
 
 			m_iCancelCounter++;
@@ -847,6 +913,7 @@ bool output::work() {
 				// first try to remove any pending events
 				// from the tracking cache
 				removeTrackingData(message);
+				removePublishedRecord(messageid);
 			}
 			m_iExpireCounter++;
 		} else if (messagetype == "SiteLookup") {
@@ -900,6 +967,17 @@ bool output::work() {
 														- tLastWorkReport))
 								+ " dps)");
 
+			if (m_TrackingCache != NULL) {
+				logger::log(
+						"info",
+						"output::work(): Tracking cache holds "
+								+ std::to_string(m_TrackingCache->size())
+								+ " detections using about "
+								+ std::to_string(
+										m_TrackingCache->getMemoryUsage()
+												/ 1024) + " KB.");
+			}
+
 			tLastWorkReport = tNow;
 			m_iMessageCounter = 0;
 			m_iEventCounter = 0;
@@ -935,7 +1013,82 @@ bool output::work() {
 		}
 	}
 
+	// nothing was handled, let the work loop sleep
+	if ((hypoRecord == false) && (message == NULL)) {
+		return (util::WorkState::Idle);
+	}
+
 	// work was successful
+	return (util::WorkState::OK);
+}
+
+bool output::workHypoRecord() {
+	// get the next hypo record, if any
+	std::shared_ptr<const glasscore::HypoRecord> hypo;
+	m_HypoRecordQueueMutex.lock();
+	if (m_HypoRecordQueue.empty() == false) {
+		hypo = m_HypoRecordQueue.front();
+		m_HypoRecordQueue.pop();
+	}
+	m_HypoRecordQueueMutex.unlock();
+
+	if (hypo == NULL) {
+		return (false);
+	}
+
+	// count the message
+	m_iMessageCounter++;
+
+	std::shared_ptr<json::Object> trackingData = getTrackingData(hypo->sPid);
+	if (trackingData == NULL) {
+		return (false);
+	}
+
+	logger::log(
+			"debug",
+			"output::workHypoRecord(): Outputting a Hypo record for "
+					+ hypo->sPid + " version "
+					+ std::to_string(hypo->iVersion) + ".");
+
+	// check to see if we've published this event before
+	// for this check, we want to know if the current version
+	// has been marked as pub
+	bool isUpdate = isDataPublished(trackingData, false);
+
+	m_ConfigMutex.lock();
+	bool publishDeltas = m_bPublishDeltas;
+	int snapshotInterval = m_iSnapshotInterval;
+	m_ConfigMutex.unlock();
+
+	// decide between an incremental update and a full snapshot, and
+	// remember what we published
+	std::shared_ptr<const glasscore::HypoRecord> previous;
+	m_PublishedRecordsMutex.lock();
+	auto published = m_PublishedRecords.find(hypo->sPid);
+	if ((publishDeltas == true) && (isUpdate == true)
+			&& (hypo->bSnapshot == false)
+			&& (published != m_PublishedRecords.end())
+			&& (published->second.second < snapshotInterval)) {
+		previous = published->second.first;
+		published->second = std::make_pair(hypo, published->second.second + 1);
+	} else {
+		m_PublishedRecords[hypo->sPid] = std::make_pair(hypo, 0);
+	}
+	m_PublishedRecordsMutex.unlock();
+
+	// write out the hypo using the threadpool, a delta is relative to the
+	// record published before it, so the records for a hypo are sent in the
+	// order they were queued
+	if (previous != NULL) {
+		addHypoJob(hypo->sPid,
+					std::bind(&output::writeHypoDeltaOutput, this, hypo,
+								previous));
+	} else {
+		addHypoJob(hypo->sPid,
+					std::bind(&output::writeHypoOutput, this, hypo, isUpdate));
+	}
+	m_iHypoCounter++;
+
 	return (true);
 }
 
@@ -994,6 +1147,93 @@ void output::writeOutput(std::shared_ptr<json::Object> data) {
 	}
 }
 
+// handle hypo record output
+void output::writeHypoOutput(std::shared_ptr<const glasscore::HypoRecord> hypo,
+								bool isUpdate) {
+	if (hypo == NULL) {
+		logger::log("error",
+					"output::writeHypoOutput(): Null hypo record passed in.");
+		return;
+	}
+
+	// convert the record directly to a detection
+	std::string detectionString = parse::hypoToJSONDetection(
+			hypo, isUpdate, getSOutputAgencyId(), getSOutputAuthor());
+
+	sendOutput("Detection", hypo->sPid, detectionString);
+}
+
+// handle hypo record delta output
+void output::writeHypoDeltaOutput(
+		std::shared_ptr<const glasscore::HypoRecord> hypo,
+		std::shared_ptr<const glasscore::HypoRecord> previous) {
+	if ((hypo == NULL) || (previous == NULL)) {
+		logger::log(
+				"error",
+				"output::writeHypoDeltaOutput(): Null hypo record passed in.");
+		return;
+	}
+
+	// convert the record to an incremental detection update
+	std::string deltaString = parse::hypoToJSONDetectionDelta(
+			hypo, previous, getSOutputAgencyId(), getSOutputAuthor());
+
+	sendOutput("DetectionDelta", hypo->sPid, deltaString);
+}
+
+void output::removePublishedRecord(const std::string &id) {
+	std::lock_guard<std::mutex> guard(m_PublishedRecordsMutex);
+	m_PublishedRecords.erase(id);
+}
+
+// queue a hypo record job
+void output::addHypoJob(const std::string &id, std::function<void()> job) {
+	m_HypoJobsMutex.lock();
+	auto found = m_HypoJobs.find(id);
+	if (found != m_HypoJobs.end()) {
+		// a pool job is already running this hypo's jobs, it will get to
+		// this one in turn
+		found->second.push(job);
+		m_HypoJobsMutex.unlock();
+		return;
+	}
+	m_HypoJobs[id].push(job);
+	m_HypoJobsMutex.unlock();
+
+	m_ThreadPool->addJob(std::bind(&output::runHypoJobs, this, id));
+}
+
+// run the queued jobs for a hypo
+void output::runHypoJobs(std::string id) {
+	while (true) {
+		m_HypoJobsMutex.lock();
+		auto found = m_HypoJobs.find(id);
+		if (found == m_HypoJobs.end()) {
+			m_HypoJobsMutex.unlock();
+			return;
+		}
+		if (found->second.empty() == true) {
+			// done, the next job for this hypo starts a new pool job
+			m_HypoJobs.erase(found);
+			m_HypoJobsMutex.unlock();
+			return;
+		}
+		std::function<void()> job = found->second.front();
+		found->second.pop();
+		m_HypoJobsMutex.unlock();
+
+		// a failed job must not stall the jobs queued behind it
+		try {
+			job();
+		} catch (const std::exception &e) {
+			logger::log(
+					"error",
+					"output::runHypoJobs(): Exception during job(): "
+							+ std::string(e.what()));
+		}
+	}
+}
+
 // filter
 bool output::isDataReady(std::shared_ptr<json::Object> data) {
 	if (data == NULL) {
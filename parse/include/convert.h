@@ -8,6 +8,7 @@
 #define CONVERT_H
 
 #include <json.h>
+#include <HypoRecord.h>
 #include <string>
 #include <memory>
 
@@ -30,6 +31,50 @@ std::string hypoToJSONDetection(std::shared_ptr<json::Object>,
 								const std::string &outputAgencyID,
 								const std::string &outputAuthor);
 
+/**
+ * \brief hypo record conversion function
+ *
+ * The function is used to convert a glasscore hypo record directly to the
+ * json detection format, reading the supporting data from the shared input
+ * messages without building an intermediate json::Object
+ *
+ * \param hypo - A shared pointer to the immutable HypoRecord to convert
+ * \param isUpdate - A boolean flag indicating whether this detection is an
+ * update to a previously published detection
+ * \param outputAgencyID - A std::string containing the agency id to use for
+ * output
+ * \param outputAuthor - A std::string containing the author to use for output
+ * \return Returns a string containing the converted json detection, empty
+ * string otherwise
+ */
+std::string hypoToJSONDetection(
+		std::shared_ptr<const glasscore::HypoRecord> hypo, bool isUpdate,
+		const std::string &outputAgencyID, const std::string &outputAuthor);
+
+/**
+ * \brief hypo record delta conversion function
+ *
+ * The function is used to convert a glasscore hypo record to an incremental
+ * json detection update relative to a previously published record. The
+ * update contains the current origin, the picks and correlations associated
+ * since the previous record, those still associated whose residual, sigma,
+ * distance or azimuth changed (usually after a relocation), and the ids of
+ * those no longer associated.
+ *
+ * \param hypo - A shared pointer to the immutable HypoRecord to convert
+ * \param previous - A shared pointer to the immutable HypoRecord that was
+ * last published for this hypo
+ * \param outputAgencyID - A std::string containing the agency id to use for
+ * output
+ * \param outputAuthor - A std::string containing the author to use for output
+ * \return Returns a string containing the converted json detection update,
+ * empty string otherwise
+ */
+std::string hypoToJSONDetectionDelta(
+		std::shared_ptr<const glasscore::HypoRecord> hypo,
+		std::shared_ptr<const glasscore::HypoRecord> previous,
+		const std::string &outputAgencyID, const std::string &outputAuthor);
+
 /**
  * \brief json cancel conversion function
  *
@@ -1,16 +1,332 @@
 #include <convert.h>
 #include <json.h>
+#include <HypoRecord.h>
 #include <logger.h>
 #include <timeutil.h>
 #include <stringutil.h>
 #include <detection-formats.h>
 #include <string>
 #include <ctime>
+#include <cmath>
 #include <vector>
 #include <memory>
+#include <unordered_map>
 
 namespace parse {
 
+namespace {
+
+// fills in the base pick values from a pick json object, the object
+// is only read so that shared input messages can be used directly
+bool buildPick(const json::Object &dataobject, detectionformats::pick *pick) {
+	if ((!(dataobject.HasKey("ID"))) || (!(dataobject.HasKey("Site")))
+			|| (!(dataobject.HasKey("Source")))
+			|| (!(dataobject.HasKey("Time")))) {
+		logger::log("error",
+					"hypoToJSONDetection: Pick missing ID, Site, Source, or "
+					"Time.");
+		return (false);
+	}
+
+	const json::Value &siteobj = (dataobject)["Site"];
+	const json::Value &sourceobj = (dataobject)["Source"];
+	if ((!(siteobj.HasKey("Station"))) || (!(siteobj.HasKey("Network")))
+			|| (!(sourceobj.HasKey("AgencyID")))
+			|| (!(sourceobj.HasKey("Author")))) {
+		logger::log("error",
+					"hypoToJSONDetection: Pick missing Station, Network, "
+					"AgencyID, or Author.");
+		return (false);
+	}
+
+	// base pick
+	// required values
+	// id
+	pick->id = (dataobject)["ID"].ToString();
+
+	// station and network are required
+	pick->site.station = (siteobj)["Station"].ToString();
+	pick->site.network = (siteobj)["Network"].ToString();
+
+	// channel and location are optional
+	if (siteobj.HasKey("Channel")) {
+		pick->site.channel = (siteobj)["Channel"].ToString();
+	}
+	if (siteobj.HasKey("Location")) {
+		pick->site.location = (siteobj)["Location"].ToString();
+	}
+
+	// source
+	pick->source.agencyid = (sourceobj)["AgencyID"].ToString();
+	pick->source.author = (sourceobj)["Author"].ToString();
+
+	// time
+	pick->time = detectionformats::ConvertISO8601ToEpochTime(
+			(dataobject)["Time"].ToString());
+
+	// optional values
+	// phase
+	if (dataobject.HasKey("Phase")) {
+		pick->phase = (dataobject)["Phase"].ToString();
+	}
+
+	// picker
+	if (dataobject.HasKey("Picker")) {
+		pick->picker = (dataobject)["Picker"].ToString();
+	}
+
+	// polarity
+	if (dataobject.HasKey("Polarity")) {
+		pick->polarity = (dataobject)["Polarity"].ToString();
+	}
+
+	// onset
+	if (dataobject.HasKey("Onset")) {
+		pick->onset = (dataobject)["Onset"].ToString();
+	}
+
+	// filter
+	if (dataobject.HasKey("Filter")) {
+		// get the array of filters
+		const json::Value &filterarray = (dataobject)["Filter"];
+
+		// for each filter
+		for (int filtercount = 0; filtercount < filterarray.size();
+				filtercount++) {
+			// get the object
+			const json::Value &filterobject = filterarray[filtercount];
+
+			// create the new filter
+			detectionformats::filter newfilter;
+			if (filterobject.HasKey("HighPass")) {
+				newfilter.highpass = (filterobject)["HighPass"].ToDouble();
+			}
+			if (filterobject.HasKey("LowPass")) {
+				newfilter.lowpass = (filterobject)["LowPass"].ToDouble();
+			}
+
+			// add it to the list
+			pick->filterdata.push_back(newfilter);
+		}
+	}
+
+	// amplitude
+	if (dataobject.HasKey("Amplitude")) {
+		// get the object
+		const json::Value &amplitudeobject = (dataobject)["Amplitude"];
+
+		if (amplitudeobject.HasKey("Amplitude")) {
+			pick->amplitude.ampvalue = (amplitudeobject)["Amplitude"]
+					.ToDouble();
+		}
+		if (amplitudeobject.HasKey("Period")) {
+			pick->amplitude.period = (amplitudeobject)["Period"].ToDouble();
+		}
+		if (amplitudeobject.HasKey("SNR")) {
+			pick->amplitude.snr = (amplitudeobject)["SNR"].ToDouble();
+		}
+	}
+
+	return (true);
+}
+
+// fills in the base correlation values from a correlation json object, the
+// object is only read so that shared input messages can be used directly
+bool buildCorrelation(const json::Object &dataobject,
+						detectionformats::correlation *correlation) {
+	if ((!(dataobject.HasKey("ID"))) || (!(dataobject.HasKey("Site")))
+			|| (!(dataobject.HasKey("Source")))
+			|| (!(dataobject.HasKey("Time")))
+			|| (!(dataobject.HasKey("Phase")))
+			|| (!(dataobject.HasKey("Hypocenter")))
+			|| (!(dataobject.HasKey("Correlation")))) {
+		logger::log("error",
+					"hypoToJSONDetection: Correlation missing ID, Site, Source, "
+					"Time, Phase, Hypocenter, or Correlation.");
+		return (false);
+	}
+
+	const json::Value &siteobj = (dataobject)["Site"];
+	const json::Value &sourceobj = (dataobject)["Source"];
+	const json::Value &hypoobj = (dataobject)["Hypocenter"];
+	if ((!(siteobj.HasKey("Station"))) || (!(siteobj.HasKey("Network")))
+			|| (!(sourceobj.HasKey("AgencyID")))
+			|| (!(sourceobj.HasKey("Author")))
+			|| (!(hypoobj.HasKey("Latitude")))
+			|| (!(hypoobj.HasKey("Longitude")))
+			|| (!(hypoobj.HasKey("Depth"))) || (!(hypoobj.HasKey("Time")))) {
+		logger::log("error",
+					"hypoToJSONDetection: Correlation missing Station, "
+					"Network, AgencyID, Author, or Hypocenter values.");
+		return (false);
+	}
+
+	// base correlation
+	// required values
+	// id
+	correlation->id = (dataobject)["ID"].ToString();
+
+	// station and network are required
+	correlation->site.station = (siteobj)["Station"].ToString();
+	correlation->site.network = (siteobj)["Network"].ToString();
+
+	// channel and location are optional
+	if (siteobj.HasKey("Channel")) {
+		correlation->site.channel = (siteobj)["Channel"].ToString();
+	}
+	if (siteobj.HasKey("Location")) {
+		correlation->site.location = (siteobj)["Location"].ToString();
+	}
+
+	// source
+	correlation->source.agencyid = (sourceobj)["AgencyID"].ToString();
+	correlation->source.author = (sourceobj)["Author"].ToString();
+
+	// time
+	correlation->time = detectionformats::ConvertISO8601ToEpochTime(
+			(dataobject)["Time"].ToString());
+
+	// phase
+	correlation->phase = (dataobject)["Phase"].ToString();
+
+	// hypo
+	correlation->hypocenter.latitude = (hypoobj)["Latitude"].ToDouble();
+	correlation->hypocenter.longitude = (hypoobj)["Longitude"].ToDouble();
+	correlation->hypocenter.depth = (hypoobj)["Depth"].ToDouble();
+	correlation->hypocenter.time = detectionformats::ConvertISO8601ToEpochTime(
+			(hypoobj)["Time"].ToString());
+
+	if (hypoobj.HasKey("LatitudeError")) {
+		correlation->hypocenter.latitudeerror = (hypoobj)["LatitudeError"]
+				.ToDouble();
+	}
+	if (hypoobj.HasKey("LongitudeError")) {
+		correlation->hypocenter.longitudeerror = (hypoobj)["LongitudeError"]
+				.ToDouble();
+	}
+	if (hypoobj.HasKey("DepthError")) {
+		correlation->hypocenter.deptherror = (hypoobj)["DepthError"].ToDouble();
+	}
+	if (hypoobj.HasKey("TimeError")) {
+		correlation->hypocenter.timeerror = (hypoobj)["TimeError"].ToDouble();
+	}
+
+	// correlation value
+	correlation->correlationvalue = (dataobject)["Correlation"].ToDouble();
+
+	// optional values
+	// event type
+	if (dataobject.HasKey("EventType")) {
+		correlation->eventtype = (dataobject)["EventType"].ToString();
+	}
+
+	// magnitude
+	if (dataobject.HasKey("Magnitude")) {
+		correlation->magnitude = (dataobject)["Magnitude"].ToDouble();
+	}
+
+	// snr
+	if (dataobject.HasKey("SNR")) {
+		correlation->snr = (dataobject)["SNR"].ToDouble();
+	}
+
+	// zscore
+	if (dataobject.HasKey("ZScore")) {
+		correlation->zscore = (dataobject)["ZScore"].ToDouble();
+	}
+
+	// detectionthreshold
+	if (dataobject.HasKey("DetectionThreshold")) {
+		correlation->detectionthreshold = (dataobject)["DetectionThreshold"]
+				.ToDouble();
+	}
+
+	// thresholdtype
+	if (dataobject.HasKey("ThresholdType")) {
+		correlation->thresholdtype = (dataobject)["ThresholdType"].ToString();
+	}
+
+	return (true);
+}
+
+// fills in the association info for a pick or correlation
+template<typename T>
+void setAssociationInfo(T *data, const std::string &phasename,
+						double residual, double sigma, double distance,
+						double azimuth) {
+	// handle unknown phase "?"
+	if (phasename.compare("?") != 0) {
+		data->associationinfo.phase = phasename;
+		data->associationinfo.residual = residual;
+		data->associationinfo.sigma = sigma;
+	} else {
+		data->associationinfo.phase = "";
+		data->associationinfo.residual = -1.0;
+		data->associationinfo.sigma = -1.0;
+	}
+
+	// handle everything else
+	data->associationinfo.distance = distance;
+	data->associationinfo.azimuth = azimuth;
+}
+
+// whether a datum's association info moved enough between two published
+// records that consumers need the new values
+// NOTE: Hard coded tolerances, well below what the output formats resolve
+bool associationChanged(const glasscore::AssociatedDataRecord &data,
+						const glasscore::AssociatedDataRecord &previous) {
+	return ((std::fabs(data.dResidual - previous.dResidual) > 0.01)
+			|| (std::fabs(data.dSigma - previous.dSigma) > 0.01)
+			|| (std::fabs(data.dDistance - previous.dDistance) > 0.001)
+			|| (std::fabs(data.dAzimuth - previous.dAzimuth) > 0.01));
+}
+
+// validates a pick, logging any errors
+bool validatePick(detectionformats::pick &pick) {  // NOLINT
+	if (pick.isvalid() == false) {
+		std::vector<std::string> errors = pick.geterrors();
+
+		logger::log("error", "Error validating pick.");
+		for (int errorcount = 0; errorcount < static_cast<int>(errors.size());
+				errorcount++) {
+			logger::log("error",
+						"hypoToJSONDetection: Pick Error: " + errors[errorcount]);
+		}
+		return (false);
+	}
+
+	return (true);
+}
+
+// validates a correlation, logging any errors
+bool validateCorrelation(detectionformats::correlation &correlation) {  // NOLINT
+	if (correlation.isvalid() == false) {
+		std::vector<std::string> errors = correlation.geterrors();
+
+		logger::log("error",
+					"hypoToJSONDetection: Error validating correlation.");
+		for (int errorcount = 0; errorcount < static_cast<int>(errors.size());
+				errorcount++) {
+			logger::log(
+					"error",
+					"hypoToJSONDetection: Correlation Error: "
+							+ errors[errorcount]);
+		}
+		return (false);
+	}
+
+	return (true);
+}
+
+// generates the json string for a detection
+std::string detectionToString(detectionformats::detection &detection) {  // NOLINT
+	rapidjson::Document detectiondocument;
+	return (detectionformats::ToJSONString(
+			detection.tojson(detectiondocument,
+								detectiondocument.GetAllocator())));
+}
+}  // namespace
+
 std::string hypoToJSONDetection(std::shared_ptr<json::Object> data,
 								const std::string &outputAgencyID,
 								const std::string &outputAuthor) {
@@ -103,288 +419,340 @@ std::string hypoToJSONDetection(std::shared_ptr<json::Object> data,
 		for (int i = 0; i < dataarray.size(); i++) {
 			json::Object dataobject = dataarray[i];
 
-			json::Object siteobj = (dataobject)["Site"].ToObject();
-			json::Object sourceobj = (dataobject)["Source"].ToObject();
 			json::Object assocobj = (dataobject)["AssociationInfo"].ToObject();
 
 			// add the contributing data
 			std::string typestring = (dataobject)["Type"].ToString();
 			if (typestring == "Pick") {
 				detectionformats::pick pick;
+				if (buildPick(dataobject, &pick) == false) {
+					continue;
+				}
 
-				// base pick
-				// required values
-				// id
-				pick.id = (dataobject)["ID"].ToString();
-
-				// station and network are required
-				pick.site.station = (siteobj)["Station"].ToString();
-				pick.site.network = (siteobj)["Network"].ToString();
+				// add association info
+				setAssociationInfo(&pick, (assocobj)["Phase"].ToString(),
+									(assocobj)["Residual"].ToDouble(),
+									(assocobj)["Sigma"].ToDouble(),
+									(assocobj)["Distance"].ToDouble(),
+									(assocobj)["Azimuth"].ToDouble());
 
-				// channel and location are optional
-				if (siteobj.HasKey("Channel")) {
-					pick.site.channel = (siteobj)["Channel"].ToString();
+				if (validatePick(pick) == true) {
+					pickdata.push_back(pick);
 				}
-				if (siteobj.HasKey("Location")) {
-					pick.site.location = (siteobj)["Location"].ToString();
+			} else if (typestring == "Correlation") {
+				detectionformats::correlation correlation;
+				if (buildCorrelation(dataobject, &correlation) == false) {
+					continue;
 				}
 
-				// source
-				pick.source.agencyid = (sourceobj)["AgencyID"].ToString();
-				pick.source.author = (sourceobj)["Author"].ToString();
+				// add association info
+				setAssociationInfo(&correlation,
+									(assocobj)["Phase"].ToString(),
+									(assocobj)["Residual"].ToDouble(),
+									(assocobj)["Sigma"].ToDouble(),
+									(assocobj)["Distance"].ToDouble(),
+									(assocobj)["Azimuth"].ToDouble());
+
+				if (validateCorrelation(correlation) == true) {
+					correlationdata.push_back(correlation);
+				}
+			}
+		}
 
-				// time
-				pick.time = detectionformats::ConvertISO8601ToEpochTime(
-						(dataobject)["Time"]);
+		// set the vectors
+		detection.pickdata = pickdata;
+		detection.correlationdata = correlationdata;
+	} catch (const std::exception &e) {
+		logger::log(
+				"warning",
+				"hypoToJSONDetection: Problem building detection message: "
+						+ std::string(e.what()));
+	}
 
-				// optional values
-				// phase
-				if (dataobject.HasKey("Phase")) {
-					pick.phase = (dataobject)["Phase"].ToString();
-				}
+	// need to check if detection is valid
+	OutputData = detectionToString(detection);
 
-				// picker
-				if (dataobject.HasKey("Picker")) {
-					pick.picker = (dataobject)["Picker"].ToString();
-				}
+	// done
+	return (OutputData);
+}
 
-				// polarity
-				if (dataobject.HasKey("Polarity")) {
-					pick.polarity = (dataobject)["Polarity"].ToString();
-				}
+std::string hypoToJSONDetection(
+		std::shared_ptr<const glasscore::HypoRecord> hypo, bool isUpdate,
+		const std::string &outputAgencyID, const std::string &outputAuthor) {
+	if (hypo == NULL) {
+		logger::log("error",
+					"hypoToJSONDetection(): Null hypo record passed in.");
+		return ("");
+	}
 
-				// onset
-				if (dataobject.HasKey("Onset")) {
-					pick.onset = (dataobject)["Onset"].ToString();
-				}
+	logger::log(
+			"info",
+			"hypoToJSONDetection(): Converting a hypo record with id: "
+					+ hypo->sPid + ".");
 
-				// filter
-				if (dataobject.HasKey("Filter")) {
-					// get the array of filters
-					json::Array filterarray = (dataobject)["Filter"].ToArray();
-
-					// for each filter
-					for (int filtercount = 0; filtercount < filterarray.size();
-							filtercount++) {
-						// get the object
-						json::Object filterobject = filterarray[filtercount];
-
-						// create the new filter
-						detectionformats::filter newfilter;
-						newfilter.highpass =
-								(filterobject)["HighPass"].ToDouble();
-						newfilter.lowpass =
-								(filterobject)["LowPass"].ToDouble();
-
-						// add it to the list
-						pick.filterdata.push_back(newfilter);
-					}
-				}
+	// what time is it now
+	time_t tNow;
+	std::time(&tNow);
 
-				// amplitude
-				if (dataobject.HasKey("Amplitude")) {
-					// get the object
-					json::Object amplitudeobject = (dataobject)["Amplitude"]
-							.ToObject();
-
-					pick.amplitude.ampvalue = (amplitudeobject)["Amplitude"]
-							.ToDouble();
-					pick.amplitude.period =
-							(amplitudeobject)["Period"].ToDouble();
-					pick.amplitude.snr = (amplitudeobject)["SNR"].ToDouble();
-				}
+	std::string OutputData = "";
 
-				// add association info
-				std::string phasename = (assocobj)["Phase"].ToString();
-
-				// handle unknown phase "?"
-				if (phasename.compare("?") != 0) {
-					pick.associationinfo.phase = phasename;
-					pick.associationinfo.residual = (assocobj)["Residual"]
-							.ToDouble();
-					pick.associationinfo.sigma = (assocobj)["Sigma"].ToDouble();
-				} else {
-					pick.associationinfo.phase = "";
-					pick.associationinfo.residual = -1.0;
-					pick.associationinfo.sigma = -1.0;
-				}
-				// handle everything else
-				pick.associationinfo.distance =
-						(assocobj)["Distance"].ToDouble();
-				pick.associationinfo.azimuth = (assocobj)["Azimuth"].ToDouble();
-
-				if (pick.isvalid() == false) {
-					std::vector<std::string> errors = pick.geterrors();
-
-					logger::log("error", "Error validating pick.");
-					for (int errorcount = 0;
-							errorcount < static_cast<int>(errors.size());
-							errorcount++) {
-						logger::log(
-								"error",
-								"hypoToJSONDetection: Pick Error: "
-										+ errors[errorcount]);
-					}
-				} else {
-					pickdata.push_back(pick);
-				}
-			} else if (typestring == "Correlation") {
-				detectionformats::correlation correlation;
+	// build detection message
+	detectionformats::detection detection;
+
+	try {
+		// required values
+		detection.id = hypo->sPid;
+		detection.source.agencyid = outputAgencyID;
+		detection.source.author = outputAuthor;
+		detection.hypocenter.latitude = hypo->dLat;
+		detection.hypocenter.longitude = hypo->dLon;
+		detection.hypocenter.time = detectionformats::ConvertISO8601ToEpochTime(
+				hypo->sOrgTime);
+		detection.hypocenter.depth = hypo->dZ;
 
-				// base correlation
-				// required values
-				// id
-				correlation.id = (dataobject)["ID"].ToString();
+		if (isUpdate == false) {
+			detection.detectiontype =
+					detectionformats::detectiontypevalues[detectionformats::detectiontypeindex::newdetection];  // NOLINT
+		} else {
+			detection.detectiontype =
+					detectionformats::detectiontypevalues[detectionformats::detectiontypeindex::update];  // NOLINT
+		}
 
-				// station and network are required
-				correlation.site.station = (siteobj)["Station"].ToString();
-				correlation.site.network = (siteobj)["Network"].ToString();
+		// optional values that we have
+		detection.minimumdistance = hypo->dMin;
+		detection.gap = hypo->dGap;
+		detection.bayes = hypo->dBayes;
+		detection.detectiontime = tNow;
 
-				// channel and location are optional
-				if (siteobj.HasKey("Channel")) {
-					correlation.site.channel = (siteobj)["Channel"].ToString();
-				}
-				if (siteobj.HasKey("Location")) {
-					correlation.site.location =
-							(siteobj)["Location"].ToString();
-				}
+		// optional data
+		detection.pickdata.clear();
+		detection.correlationdata.clear();
 
-				// source
-				correlation.source.agencyid =
-						(sourceobj)["AgencyID"].ToString();
-				correlation.source.author = (sourceobj)["Author"].ToString();
-
-				// time
-				correlation.time = detectionformats::ConvertISO8601ToEpochTime(
-						(dataobject)["Time"]);
-
-				// phase
-				correlation.phase = (dataobject)["Phase"].ToString();
-
-				// hypo
-				json::Object hypoobj = (dataobject)["Hypocenter"].ToObject();
-				correlation.hypocenter.latitude =
-						(hypoobj)["Latitude"].ToDouble();
-				correlation.hypocenter.longitude = (hypoobj)["Longitude"]
-						.ToDouble();
-				correlation.hypocenter.depth = (hypoobj)["Depth"].ToDouble();
-				correlation.hypocenter.time =
-						detectionformats::ConvertISO8601ToEpochTime(
-								(hypoobj)["Time"]);
-
-				if (hypoobj.HasKey("LatitudeError")) {
-					correlation.hypocenter.latitudeerror =
-							(hypoobj)["LatitudeError"].ToDouble();
-				}
-				if (hypoobj.HasKey("LongitudeError")) {
-					correlation.hypocenter.longitudeerror =
-							(hypoobj)["LongitudeError"].ToDouble();
+		for (const auto &data : hypo->vData) {
+			// data without an input message can't be converted
+			if (data.jSource == NULL) {
+				continue;
+			}
+
+			if (data.eType == glasscore::AssociatedDataRecord::DataType::Pick) {
+				detectionformats::pick pick;
+				if (buildPick(*data.jSource, &pick) == false) {
+					continue;
 				}
-				if (hypoobj.HasKey("DepthError")) {
-					correlation.hypocenter.deptherror = (hypoobj)["DepthError"]
-							.ToDouble();
+
+				// add association info
+				setAssociationInfo(&pick, data.sPhase, data.dResidual,
+									data.dSigma, data.dDistance,
+									data.dAzimuth);
+
+				if (validatePick(pick) == true) {
+					detection.pickdata.push_back(pick);
 				}
-				if (hypoobj.HasKey("TimeError")) {
-					correlation.hypocenter.timeerror = (hypoobj)["TimeError"]
-							.ToDouble();
+			} else {
+				detectionformats::correlation correlation;
+				if (buildCorrelation(*data.jSource, &correlation) == false) {
+					continue;
 				}
 
-				// phase
-				correlation.correlationvalue = (dataobject)["Correlation"]
-						.ToDouble();
+				// add association info
+				setAssociationInfo(&correlation, data.sPhase, data.dResidual,
+									data.dSigma, data.dDistance,
+									data.dAzimuth);
 
-				// optional values
-				// phase
-				if (dataobject.HasKey("EventType")) {
-					correlation.eventtype =
-							(dataobject)["EventType"].ToString();
+				if (validateCorrelation(correlation) == true) {
+					detection.correlationdata.push_back(correlation);
 				}
+			}
+		}
+	} catch (const std::exception &e) {
+		logger::log(
+				"warning",
+				"hypoToJSONDetection: Problem building detection message: "
+						+ std::string(e.what()));
+	}
 
-				// magnitude
-				if (dataobject.HasKey("Magnitude")) {
-					correlation.magnitude =
-							(dataobject)["Magnitude"].ToDouble();
-				}
+	OutputData = detectionToString(detection);
 
-				// snr
-				if (dataobject.HasKey("SNR")) {
-					correlation.snr = (dataobject)["SNR"].ToDouble();
-				}
+	// done
+	return (OutputData);
+}
 
-				// zscore
-				if (dataobject.HasKey("ZScore")) {
-					correlation.zscore = (dataobject)["ZScore"].ToDouble();
-				}
+std::string hypoToJSONDetectionDelta(
+		std::shared_ptr<const glasscore::HypoRecord> hypo,
+		std::shared_ptr<const glasscore::HypoRecord> previous,
+		const std::string &outputAgencyID, const std::string &outputAuthor) {
+	if ((hypo == NULL) || (previous == NULL)) {
+		logger::log("error",
+					"hypoToJSONDetectionDelta(): Null hypo record passed in.");
+		return ("");
+	}
 
-				// detectionthreshold
-				if (dataobject.HasKey("DetectionThreshold")) {
-					correlation.detectionthreshold =
-							(dataobject)["DetectionThreshold"].ToDouble();
+	if (hypo->sPid != previous->sPid) {
+		logger::log("error",
+					"hypoToJSONDetectionDelta(): Mismatched hypo records "
+					"passed in.");
+		return ("");
+	}
+
+	logger::log(
+			"info",
+			"hypoToJSONDetectionDelta(): Converting a hypo record with id: "
+					+ hypo->sPid + " version: " + std::to_string(hypo->iVersion)
+					+ " relative to version: "
+					+ std::to_string(previous->iVersion) + ".");
+
+	// index the previously published data by id
+	std::unordered_map<std::string, const glasscore::AssociatedDataRecord *> previousData;  // NOLINT
+	for (const auto &data : previous->vData) {
+		previousData[data.sPid] = &data;
+	}
+
+	rapidjson::Document delta;
+	delta.SetObject();
+	rapidjson::Document::AllocatorType &allocator = delta.GetAllocator();
+
+	std::string OutputData = "";
+
+	try {
+		// basic info
+		delta.AddMember("Type", "DetectionDelta", allocator);
+		delta.AddMember("ID", rapidjson::Value(hypo->sPid.c_str(), allocator),
+						allocator);
+		delta.AddMember("Version", hypo->iVersion, allocator);
+		delta.AddMember("BaseVersion", previous->iVersion, allocator);
+
+		// source
+		rapidjson::Value source(rapidjson::kObjectType);
+		source.AddMember("AgencyID",
+							rapidjson::Value(outputAgencyID.c_str(), allocator),
+							allocator);
+		source.AddMember("Author",
+							rapidjson::Value(outputAuthor.c_str(), allocator),
+							allocator);
+		delta.AddMember("Source", source, allocator);
+
+		// the origin is always included, it is small and nearly always changes
+		rapidjson::Value hypocenter(rapidjson::kObjectType);
+		hypocenter.AddMember("Latitude", hypo->dLat, allocator);
+		hypocenter.AddMember("Longitude", hypo->dLon, allocator);
+		hypocenter.AddMember("Depth", hypo->dZ, allocator);
+		hypocenter.AddMember("Time",
+								rapidjson::Value(hypo->sOrgTime.c_str(),
+													allocator),
+								allocator);
+		delta.AddMember("Hypocenter", hypocenter, allocator);
+		delta.AddMember("MinimumDistance", hypo->dMin, allocator);
+		delta.AddMember("Gap", hypo->dGap, allocator);
+		delta.AddMember("Bayes", hypo->dBayes, allocator);
+
+		// added data, anything new or now associated with a different phase,
+		// and changed data, anything still associated with the same phase
+		// whose residual, sigma, distance or azimuth moved, typically
+		// because the hypo relocated
+		rapidjson::Value addedPicks(rapidjson::kArrayType);
+		rapidjson::Value addedCorrelations(rapidjson::kArrayType);
+		rapidjson::Value changedPicks(rapidjson::kArrayType);
+		rapidjson::Value changedCorrelations(rapidjson::kArrayType);
+		for (const auto &data : hypo->vData) {
+			bool changed = false;
+			auto found = previousData.find(data.sPid);
+			if (found != previousData.end()) {
+				bool samePhase = (found->second->sPhase == data.sPhase);
+				changed = samePhase
+						&& associationChanged(data, *found->second);
+
+				// either way it is accounted for
+				previousData.erase(found);
+
+				if ((samePhase == true) && (changed == false)) {
+					continue;
 				}
+			}
 
-				// thresholdtype
-				if (dataobject.HasKey("ThresholdType")) {
-					correlation.thresholdtype = (dataobject)["ThresholdType"]
-							.ToString();
+			// data without an input message can't be converted
+			if (data.jSource == NULL) {
+				continue;
+			}
+
+			if (data.eType == glasscore::AssociatedDataRecord::DataType::Pick) {
+				detectionformats::pick pick;
+				if (buildPick(*data.jSource, &pick) == false) {
+					continue;
+				}
+				setAssociationInfo(&pick, data.sPhase, data.dResidual,
+									data.dSigma, data.dDistance,
+									data.dAzimuth);
+				if (validatePick(pick) == false) {
+					continue;
 				}
 
-				// add association info
-				std::string assocphasename = (assocobj)["Phase"].ToString();
-
-				// handle unknown phase "?"
-				if (assocphasename.compare("?") != 0) {
-					correlation.associationinfo.phase = assocphasename;
-					correlation.associationinfo.residual =
-							(assocobj)["Residual"].ToDouble();
-					correlation.associationinfo.sigma = (assocobj)["Sigma"]
-							.ToDouble();
+				rapidjson::Value pickvalue(rapidjson::kObjectType);
+				pick.tojson(pickvalue, allocator);
+				if (changed == true) {
+					changedPicks.PushBack(pickvalue, allocator);
 				} else {
-					correlation.associationinfo.phase = "";
-					correlation.associationinfo.residual = -1.0;
-					correlation.associationinfo.sigma = -1.0;
+					addedPicks.PushBack(pickvalue, allocator);
+				}
+			} else {
+				detectionformats::correlation correlation;
+				if (buildCorrelation(*data.jSource, &correlation) == false) {
+					continue;
 				}
-				// handle everything else
-				correlation.associationinfo.distance = (assocobj)["Distance"]
-						.ToDouble();
-				correlation.associationinfo.azimuth = (assocobj)["Azimuth"]
-						.ToDouble();
-
-				if (correlation.isvalid() == false) {
-					std::vector<std::string> errors = correlation.geterrors();
-					logger::log(
-							"error",
-							"hypoToJSONDetection: Error validating correlation.");
-					for (int errorcount = 0;
-							errorcount < static_cast<int>(errors.size());
-							errorcount++) {
-						logger::log(
-								"error",
-								"hypoToJSONDetection: Correlation Error: "
-										+ errors[errorcount]);
-					}
+				setAssociationInfo(&correlation, data.sPhase, data.dResidual,
+									data.dSigma, data.dDistance,
+									data.dAzimuth);
+				if (validateCorrelation(correlation) == false) {
+					continue;
+				}
+
+				rapidjson::Value correlationvalue(rapidjson::kObjectType);
+				correlation.tojson(correlationvalue, allocator);
+				if (changed == true) {
+					changedCorrelations.PushBack(correlationvalue, allocator);
 				} else {
-					correlationdata.push_back(correlation);
+					addedCorrelations.PushBack(correlationvalue, allocator);
 				}
 			}
 		}
 
-		// set the vectors
-		detection.pickdata = pickdata;
-		detection.correlationdata = correlationdata;
+		// removed data, anything left over from the previous record,
+		// identified the same way it was published
+		rapidjson::Value removedPicks(rapidjson::kArrayType);
+		rapidjson::Value removedCorrelations(rapidjson::kArrayType);
+		for (const auto &entry : previousData) {
+			const glasscore::AssociatedDataRecord *data = entry.second;
+			if ((data->jSource == NULL) || (!(data->jSource->HasKey("ID")))) {
+				continue;
+			}
+
+			std::string id = (*data->jSource)["ID"].ToString();
+			if (data->eType == glasscore::AssociatedDataRecord::DataType::Pick) {
+				removedPicks.PushBack(rapidjson::Value(id.c_str(), allocator),
+										allocator);
+			} else {
+				removedCorrelations.PushBack(
+						rapidjson::Value(id.c_str(), allocator), allocator);
+			}
+		}
+
+		delta.AddMember("AddedPickData", addedPicks, allocator);
+		delta.AddMember("ChangedPickData", changedPicks, allocator);
+		delta.AddMember("RemovedPickData", removedPicks, allocator);
+		delta.AddMember("AddedCorrelationData", addedCorrelations, allocator);
+		delta.AddMember("ChangedCorrelationData", changedCorrelations,
+						allocator);
+		delta.AddMember("RemovedCorrelationData", removedCorrelations,
+						allocator);
+
+		OutputData = detectionformats::ToJSONString(delta);
 	} catch (const std::exception &e) {
 		logger::log(
 				"warning",
-				"hypoToJSONDetection: Problem building detection message: "
-						+ std::string(e.what()));
+				"hypoToJSONDetectionDelta: Problem building detection delta "
+				"message: " + std::string(e.what()));
+		OutputData = "";
 	}
 
-	// need to check if detection is valid
-
-	rapidjson::Document detectiondocument;
-	OutputData = detectionformats::ToJSONString(
-			detection.tojson(detectiondocument,
-								detectiondocument.GetAllocator()));
-
 	// done
 	return (OutputData);
 }
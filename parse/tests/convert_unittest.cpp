@@ -12,6 +12,8 @@
 #define BADHYPOSTRING1 "{\"Bayes\":2.087726,\"Cmd\":\"Hypo\",\"Data\":[{\"Amplitude\":{\"Amplitude\":0.000000,\"Period\":0.000000,\"SNR\":3.410000},\"AssociationInfo\":{\"Azimuth\":146.725914,\"Distance\":0.114828,\"Phase\":\"P\",\"Residual\":0.000904,\"Sigma\":1.000000},\"Filter\":[{\"HighPass\":1.050000,\"LowPass\":2.650000}],\"ID\":\"100725\",\"Phase\":\"P\",\"Picker\":\"raypicker\",\"Polarity\":\"up\",\"Site\":{\"Channel\":\"BHZ\",\"Location\":\"--\",\"Network\":\"AK\",\"Station\":\"SSN\"},\"Source\":{\"AgencyID\":\"US\",\"Author\":\"228041013\"},\"Time\":\"2015-08-14T03:35:25.947Z\",\"Type\":\"Pick\"}],\"Depth\":24.717898,\"Gap\":110.554774,\"ID\":\"20311B8E10AF5649BDC52ED099CF173E\",\"IsUpdate\":false,\"Latitude\":61.559315,\"Longitude\":-150.877897,\"MinimumDistance\":0.110850,\"Source\":{\"AgencyID\":\"US\",\"Author\":\"glass\"},\"T\":\"20150814033521.219\",\"Time\":\"2015-08-14T03:35:21.219Z\"}" // NOLINT
 #define BADHYPOSTRING2 "{\"Bayes\":2.087726,\"Cmd\":\"Hypo\",\"Data\":[{\"Amplitude\":{\"Amplitude\":0.000000,\"Period\":0.000000,\"SNR\":3.410000},\"AssociationInfo\":{\"Azimuth\":146.725914,\"Distance\":0.114828,\"Phase\":\"P\",\"Residual\":0.000904,\"Sigma\":1.000000},\"Filter\":[{\"HighPass\":1.050000,\"LowPass\":2.650000}],\"ID\":\"100725\",\"Phase\":\"P\",\"Picker\":\"raypicker\",\"Polarity\":\"up\",\"Site\":{\"Channel\":\"BHZ\",\"Location\":\"--\",\"Network\":\"AK\",\"Station\":\"SSN\"},\"Source\":{\"AgencyID\":\"US\",\"Author\":\"228041013\"},\"Time\":\"2015-08-14T03:35:25.947Z\",\"Type\":\"Pick\"}],\"Depth\":24.717898,\"Gap\":110.554774,\"IsUpdate\":false,\"Latitude\":61.559315,\"Longitude\":-150.877897,\"MinimumDistance\":0.110850,\"Source\":{\"AgencyID\":\"US\",\"Author\":\"glass\"},\"T\":\"20150814033521.219\",\"Time\":\"2015-08-14T03:35:21.219Z\",\"Type\":\"Hypo\"}" // NOLINT
 
+#define PICKSTRING "{\"Amplitude\":{\"Amplitude\":0.000000,\"Period\":0.000000,\"SNR\":3.410000},\"Filter\":[{\"HighPass\":1.050000,\"LowPass\":2.650000}],\"ID\":\"100725\",\"Phase\":\"P\",\"Picker\":\"raypicker\",\"Polarity\":\"up\",\"Site\":{\"Channel\":\"BHZ\",\"Location\":\"--\",\"Network\":\"AK\",\"Station\":\"SSN\"},\"Source\":{\"AgencyID\":\"US\",\"Author\":\"228041013\"},\"Time\":\"2015-08-14T03:35:25.947Z\",\"Type\":\"Pick\"}" // NOLINT
+
 #define CANCELSTRING "{\"Pid\":\"20311B8E10AF5649BDC52ED099CF173E\",\"Type\":\"Cancel\"}" // NOLINT
 #define BADCANCELSTRING1 "{\"Type\":\"Cancel\"}"
 #define BADCANCELSTRING2 "{\"Pid\":\"20311B8E10AF5649BDC52ED099CF173E\"}"
@@ -115,6 +117,159 @@ TEST(Convert, HypoTest) {
 	ASSERT_EQ(detectiongap, expectedgap);
 }
 
+TEST(Convert, HypoRecordTest) {
+	std::string agencyid = std::string(TESTAGENCYID);
+	std::string author = std::string(TESTAUTHOR);
+
+	// failure cases
+	ASSERT_STREQ(
+			parse::hypoToJSONDetection(std::shared_ptr<const glasscore::HypoRecord>(), false, agencyid, author).c_str(),  // NOLINT
+			"");
+
+	// build record
+	std::shared_ptr<glasscore::HypoRecord> hypo = std::make_shared<
+			glasscore::HypoRecord>();
+	hypo->sPid = "20311B8E10AF5649BDC52ED099CF173E";
+	hypo->iVersion = 2;
+	hypo->sOrgTime = "2015-08-14T03:35:21.219Z";
+	hypo->dLat = 61.559315;
+	hypo->dLon = -150.877897;
+	hypo->dZ = 24.717898;
+	hypo->dMin = 0.110850;
+	hypo->dGap = 110.554774;
+	hypo->dBayes = 2.087726;
+
+	glasscore::AssociatedDataRecord data;
+	data.eType = glasscore::AssociatedDataRecord::DataType::Pick;
+	data.sPhase = "P";
+	data.dDistance = 0.114828;
+	data.dAzimuth = 146.725914;
+	data.dResidual = 0.000904;
+	data.dSigma = 1.0;
+	data.jSource = std::make_shared<json::Object>(
+			json::Object(json::Deserialize(PICKSTRING)));
+	hypo->vData.push_back(data);
+
+	// data without a source is skipped
+	data.jSource = NULL;
+	hypo->vData.push_back(data);
+
+	std::string detectionoutput = parse::hypoToJSONDetection(hypo, true,
+																agencyid,
+																author);
+
+	// build detection object
+	rapidjson::Document detectiondocument;
+	detectionformats::detection detectionobject(
+			detectionformats::FromJSONString(detectionoutput,
+												detectiondocument));
+	// check valid code
+	ASSERT_TRUE(detectionobject.isvalid())<< "Converted detection is valid";
+
+	// check id
+	ASSERT_STREQ(detectionobject.id.c_str(),
+					"20311B8E10AF5649BDC52ED099CF173E");
+
+	// check source
+	ASSERT_STREQ(detectionobject.source.agencyid.c_str(), TESTAGENCYID);
+	ASSERT_STREQ(detectionobject.source.author.c_str(), TESTAUTHOR);
+
+	// check hypocenter
+	ASSERT_EQ(detectionobject.hypocenter.latitude, 61.559315);
+	ASSERT_EQ(detectionobject.hypocenter.longitude, -150.877897);
+	ASSERT_EQ(detectionobject.hypocenter.depth, 24.717898);
+	ASSERT_NEAR(detectionobject.hypocenter.time,
+				detectionformats::ConvertISO8601ToEpochTime(
+						"2015-08-14T03:35:21.219Z"),
+				0.0001);
+
+	// check detectiontype
+	ASSERT_STREQ(detectionobject.detectiontype.c_str(), "Update");
+
+	// check supplementary values
+	ASSERT_EQ(detectionobject.bayes, 2.087726);
+	ASSERT_EQ(detectionobject.minimumdistance, 0.11085);
+	ASSERT_EQ(detectionobject.gap, 110.554774);
+
+	// check data
+	ASSERT_EQ(detectionobject.pickdata.size(), 1);
+	ASSERT_STREQ(detectionobject.pickdata[0].id.c_str(), "100725");
+	ASSERT_STREQ(detectionobject.pickdata[0].site.station.c_str(), "SSN");
+	ASSERT_STREQ(detectionobject.pickdata[0].associationinfo.phase.c_str(),
+					"P");
+	ASSERT_EQ(detectionobject.pickdata[0].associationinfo.azimuth,
+				146.725914);
+}
+
+TEST(Convert, HypoRecordDeltaTest) {
+	std::string agencyid = std::string(TESTAGENCYID);
+	std::string author = std::string(TESTAUTHOR);
+
+	// build records
+	std::shared_ptr<glasscore::HypoRecord> previous = std::make_shared<
+			glasscore::HypoRecord>();
+	previous->sPid = "20311B8E10AF5649BDC52ED099CF173E";
+	previous->iVersion = 1;
+	previous->sOrgTime = "2015-08-14T03:35:21.219Z";
+
+	glasscore::AssociatedDataRecord data;
+	data.eType = glasscore::AssociatedDataRecord::DataType::Pick;
+	data.sPid = "1";
+	data.sPhase = "P";
+	data.dDistance = 0.114828;
+	data.dAzimuth = 146.725914;
+	data.dResidual = 0.000904;
+	data.dSigma = 1.0;
+	data.jSource = std::make_shared<json::Object>(
+			json::Object(json::Deserialize(PICKSTRING)));
+	previous->vData.push_back(data);
+
+	std::shared_ptr<glasscore::HypoRecord> hypo = std::make_shared<
+			glasscore::HypoRecord>(*previous);
+	hypo->iVersion = 2;
+	hypo->dLat = 61.559315;
+
+	// failure cases
+	ASSERT_STREQ(
+			parse::hypoToJSONDetectionDelta(hypo, std::shared_ptr<const glasscore::HypoRecord>(), agencyid, author).c_str(),  // NOLINT
+			"");
+
+	// nothing changed but the origin
+	std::string deltaoutput = parse::hypoToJSONDetectionDelta(hypo, previous,
+																agencyid,
+																author);
+	json::Object delta = json::Deserialize(deltaoutput);
+	ASSERT_STREQ(delta["Type"].ToString().c_str(), "DetectionDelta");
+	ASSERT_EQ(delta["Version"].ToInt(), 2);
+	ASSERT_EQ(delta["BaseVersion"].ToInt(), 1);
+	ASSERT_EQ(delta["Hypocenter"]["Latitude"].ToDouble(), 61.559315);
+	ASSERT_EQ(delta["AddedPickData"].ToArray().size(), 0);
+	ASSERT_EQ(delta["ChangedPickData"].ToArray().size(), 0);
+	ASSERT_EQ(delta["RemovedPickData"].ToArray().size(), 0);
+
+	// the hypo relocated, moving the pick's residual and distance
+	hypo->vData[0].dResidual = 0.5;
+	hypo->vData[0].dDistance = 0.2;
+	deltaoutput = parse::hypoToJSONDetectionDelta(hypo, previous, agencyid,
+													author);
+	delta = json::Deserialize(deltaoutput);
+	ASSERT_EQ(delta["AddedPickData"].ToArray().size(), 0);
+	ASSERT_EQ(delta["ChangedPickData"].ToArray().size(), 1);
+	ASSERT_EQ(delta["RemovedPickData"].ToArray().size(), 0);
+	ASSERT_NEAR(
+			delta["ChangedPickData"].ToArray()[0]["AssociationInfo"]["Residual"].ToDouble(),  // NOLINT
+			0.5, 0.0001);
+
+	// the pick was replaced
+	hypo->vData[0].sPid = "2";
+	deltaoutput = parse::hypoToJSONDetectionDelta(hypo, previous, agencyid,
+													author);
+	delta = json::Deserialize(deltaoutput);
+	ASSERT_EQ(delta["AddedPickData"].ToArray().size(), 1);
+	ASSERT_EQ(delta["RemovedPickData"].ToArray().size(), 1);
+	ASSERT_STREQ(delta["RemovedPickData"].ToArray()[0].ToString().c_str(), "100725");
+}
+
 TEST(Convert, CancelTest) {
 	// logger::log_init("converttest", spdlog::level::debug, ".", true);
 	std::string agencyid = std::string(TESTAGENCYID);
@@ -104,6 +104,17 @@ class Associator : public glasscore::IGlassSend, public util::iAssociator,
 	 */
 	void Send(std::shared_ptr<json::Object> communication) override;
 
+	/**
+	 * \brief glasscore hypo record receiver function
+	 *
+	 * The function (from IGlassSend) used to receive typed hypocenter
+	 * records from glasscore.
+	 *
+	 * \param hypo - A shared pointer to the immutable HypoRecord from
+	 * glasscore.
+	 */
+	void Send(std::shared_ptr<const glasscore::HypoRecord> hypo) override;
+
 	/**
 	 * \brief glasscore message sending function
 	 *
@@ -145,15 +156,28 @@ class Associator : public glasscore::IGlassSend, public util::iAssociator,
 	 */
 	int ReportInterval;
 
+	/**
+	 * \brief Memory Report interval
+	 *
+	 * An integer containing the interval (in seconds) between
+	 * logging glass memory reports. The memory report walks the glass lists,
+	 * so it is generated much less often than the informational report.
+	 */
+	int MemoryReportInterval;
+
  protected:
 	/**
 	 * \brief associator work function
 	 *
-	 * The function (from threadclassbase) used to do work.
+	 * The function (from threadclassbase) used to do work. Sends one
+	 * queued message and one input item into glass per call, the work loop
+	 * calls it repeatedly while there is data.
 	 *
-	 * \return returns true if work was successful, false otherwise.
+	 * \return returns util::WorkState::OK if anything was sent into glass,
+	 * util::WorkState::Idle if there was nothing to send, and
+	 * util::WorkState::Error if the associator is not set up.
 	 */
-	bool work() override;
+	util::WorkState work() override;
 
 	/**
 	 * \brief glasscore dispatch function
@@ -167,6 +191,19 @@ class Associator : public glasscore::IGlassSend, public util::iAssociator,
 	 */
 	bool dispatch(std::shared_ptr<json::Object> communication);
 
+	/**
+	 * \brief glasscore hypo record dispatch function
+	 *
+	 * The function the associator class uses to send typed hypocenter
+	 * records from glass to the Output class. The Output class must also
+	 * implement the IGlassSend interface to receive records.
+	 *
+	 * \param hypo - A shared pointer to the immutable HypoRecord from
+	 * glasscore.
+	 * \return returns true if the dispatch was successful, false otherwise.
+	 */
+	bool dispatch(std::shared_ptr<const glasscore::HypoRecord> hypo);
+
 	/**
 	 * \brief glasscore logging function
 	 *
@@ -216,6 +253,11 @@ class Associator : public glasscore::IGlassSend, public util::iAssociator,
 	 */
 	time_t tLastWorkReport;
 
+	/**
+	 * \brief The time the last memory report was generated.
+	 */
+	time_t tLastMemoryReport;
+
 	/**
 	 * \brief The queue of pending messages to send to glasscore
 	 */
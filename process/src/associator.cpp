@@ -22,6 +22,9 @@ Associator::Associator()
 	ReportInterval = 60;
 	std::time(&tLastWorkReport);
 
+	MemoryReportInterval = 600;
+	std::time(&tLastMemoryReport);
+
 	Input = NULL;
 	Output = NULL;
 	m_pGlass = NULL;
@@ -49,6 +52,9 @@ Associator::Associator(util::iInput* inputint, util::iOutput* outputint)
 	ReportInterval = 60;
 	std::time(&tLastWorkReport);
 
+	MemoryReportInterval = 600;
+	std::time(&tLastMemoryReport);
+
 	// clear / create object(s)
 	clear();
 
@@ -97,6 +103,12 @@ bool Associator::setup(json::Object *config) {
 					"associator::setup(): Class Core interface is NULL .");
 		return (false);
 	}
+	// the initialize configuration also sets up the work batch size and time
+	if ((config->HasKey("Cmd"))
+			&& ((*config)["Cmd"].ToString() == "Initialize")) {
+		setupWorkBatch(config);
+	}
+
 	std::shared_ptr<json::Object> pConfig = std::make_shared<json::Object>(
 			*config);
 	// send the config to glass
@@ -151,23 +163,27 @@ void Associator::Send(std::shared_ptr<json::Object> communication) {
 	dispatch(communication);
 }
 
+void Associator::Send(std::shared_ptr<const glasscore::HypoRecord> hypo) {
+	dispatch(hypo);
+}
+
 void Associator::sendToAssociator(std::shared_ptr<json::Object> &message) {
 	if (m_MessageQueue != NULL) {
 		m_MessageQueue->addDataToQueue(message);
 	}
 }
 
-bool Associator::work() {
+util::WorkState Associator::work() {
 	if (Input == NULL) {
-		return (false);
+		return (util::WorkState::Error);
 	}
 
 	if (m_pGlass == NULL) {
-		return (false);
+		return (util::WorkState::Error);
 	}
 
 	if (m_MessageQueue == NULL) {
-		return (false);
+		return (util::WorkState::Error);
 	}
 
 	// first check to see if we have any messages to send
@@ -253,6 +269,18 @@ bool Associator::work() {
 							+ " avg glass time) (" + "vPickSize: "
 							+ std::to_string(pickListSize) + " vHypoSize: "
 							+ std::to_string(hypoListSize) + ").");
+
+		}
+
+		// the memory report walks the glass lists, so only do it occasionally
+		if ((m_pGlass != NULL)
+				&& ((tNow - tLastMemoryReport) >= MemoryReportInterval)) {
+			logger::log(
+					"info",
+					"Associator::work(): Glass memory usage "
+							+ m_pGlass->getMemoryReport() + ".");
+
+			tLastMemoryReport = tNow;
 		}
 
 		tLastWorkReport = tNow;
@@ -260,9 +288,14 @@ bool Associator::work() {
 		tGlassDuration = std::chrono::duration<double>::zero();
 	}
 
-	// we only send in one item per work loop
+	// we only send in one item per work call, the work loop keeps calling
+	// while we're busy and sleeps once we're idle
+	if ((message == NULL) && (data == NULL)) {
+		return (util::WorkState::Idle);
+	}
+
 	// work was successful
-	return (true);
+	return (util::WorkState::OK);
 }
 
 bool Associator::check() {
@@ -305,4 +338,30 @@ bool Associator::dispatch(std::shared_ptr<json::Object> communication) {
 
 	return (true);
 }
+
+// process any hypo records glasscore sends us
+bool Associator::dispatch(std::shared_ptr<const glasscore::HypoRecord> hypo) {
+	// tell base class we're still alive
+	ThreadBaseClass::setWorkCheck();
+
+	if (hypo == NULL) {
+		logger::log("critical",
+					"associator::dispatch(): NULL hypo record passed in.");
+		return (false);
+	}
+
+	// hypo records go to an output that understands them
+	glasscore::IGlassSend * recordOutput =
+			dynamic_cast<glasscore::IGlassSend *>(Output);
+	if (recordOutput != NULL) {
+		recordOutput->Send(hypo);
+	} else {
+		logger::log("error",
+					"associator::dispatch(): Output interface does not accept "
+					"hypo records, nothing to dispatch to.");
+		return (false);
+	}
+
+	return (true);
+}
 }  // namespace glass
@@ -0,0 +1,276 @@
+/*****************************************
+ * This file is documented for Doxygen.
+ * If you modify this file please update
+ * the comments so that Doxygen will still
+ * be able to work.
+ ****************************************/
+#ifndef BATCHPRODUCER_H
+#define BATCHPRODUCER_H
+
+#include <threadbaseclass.h>
+#include <producerinterface.h>
+
+#include <chrono>
+#include <ctime>
+#include <map>
+#include <mutex>
+#include <queue>
+#include <string>
+#include <vector>
+
+namespace util {
+
+/**
+ * \brief util delivery report structure
+ *
+ * The DeliveryReport structure holds the result of sending one batch of
+ * messages to a topic via a util::BatchProducer.
+ */
+struct DeliveryReport {
+	/**
+	 * \brief A std::string containing the topic the batch was sent to
+	 */
+	std::string sTopic;
+
+	/**
+	 * \brief An integer containing the number of messages that were
+	 * successfully handed to the producer
+	 */
+	int iDelivered;
+
+	/**
+	 * \brief An integer containing the number of messages that could not be
+	 * handed to the producer
+	 */
+	int iFailed;
+
+	/**
+	 * \brief A time_t containing the time the batch was sent
+	 */
+	std::time_t tSent;
+};
+
+/**
+ * \brief util batch producer class
+ *
+ * The util batch producer class is a thread class that accumulates
+ * outgoing messages into per topic batches and hands each batch to a
+ * util::iProducer once either the batch size is reached or the oldest
+ * message in the batch has waited for the linger time. Adding a message
+ * never blocks on the producer.
+ *
+ * The result of each batch is queued as a DeliveryReport that the owner
+ * can retrieve asynchronously via getDeliveryReport().
+ *
+ * BatchProducer inherits from the threadbaseclass class.
+ */
+class BatchProducer : public util::ThreadBaseClass {
+ public:
+	/**
+	 * \brief BatchProducer constructor
+	 *
+	 * The constructor for the BatchProducer class.
+	 * Initializes members to default values.
+	 */
+	BatchProducer();
+
+	/**
+	 * \brief BatchProducer advanced constructor
+	 *
+	 * The advanced constructor for the BatchProducer class.
+	 *
+	 * \param producer - A pointer to the util::iProducer to send batches
+	 * with, the BatchProducer does not take ownership
+	 * \param batchsize - An integer containing the maximum number of messages
+	 * in a batch
+	 * \param lingerms - An integer containing the maximum time in
+	 * milliseconds a message waits in a batch before the batch is sent
+	 */
+	BatchProducer(util::iProducer *producer, int batchsize, int lingerms);
+
+	/**
+	 * \brief BatchProducer destructor
+	 *
+	 * The destructor for the BatchProducer class.
+	 * Stops the work thread and sends any remaining batches.
+	 */
+	~BatchProducer();
+
+	/**
+	 * \brief add a message
+	 *
+	 * Add the provided message to the pending batch for the given topic
+	 *
+	 * \param topic - A std::string containing the topic to send the message to
+	 * \param message - A std::string containing the message to send
+	 * \return returns true if successful, false otherwise.
+	 */
+	bool addMessage(const std::string &topic, const std::string &message);
+
+	/**
+	 * \brief flush all batches
+	 *
+	 * Send all pending batches immediately, regardless of size or age
+	 *
+	 * \return returns an integer containing the number of messages sent
+	 */
+	int flush();
+
+	/**
+	 * \brief get the next delivery report
+	 *
+	 * Retrieve and remove the oldest delivery report from the report queue
+	 *
+	 * \param report - A pointer to a DeliveryReport to fill in
+	 * \return returns true if a report was retrieved, false if there were no
+	 * reports
+	 */
+	bool getDeliveryReport(DeliveryReport *report);
+
+	/**
+	 * \brief get the number of pending messages
+	 *
+	 * \return returns an integer containing the number of messages waiting
+	 * to be sent across all topics
+	 */
+	int getPendingCount();
+
+	/**
+	 * \brief get the number of queued delivery reports
+	 *
+	 * \return returns an integer containing the number of delivery reports
+	 * waiting to be retrieved
+	 */
+	int getDeliveryReportCount();
+
+	/**
+	 * \brief set the producer
+	 * \param producer - A pointer to the util::iProducer to send batches with
+	 */
+	void setProducer(util::iProducer *producer);
+
+	/**
+	 * \brief get the producer
+	 * \return returns a pointer to the util::iProducer used to send batches
+	 */
+	util::iProducer * getProducer();
+
+	/**
+	 * \brief set the batch size
+	 * \param batchsize - An integer containing the maximum number of messages
+	 * in a batch, values less than 1 are treated as 1
+	 */
+	void setBatchSize(int batchsize);
+
+	/**
+	 * \brief get the batch size
+	 * \return returns an integer containing the maximum number of messages in
+	 * a batch
+	 */
+	int getBatchSize();
+
+	/**
+	 * \brief set the linger time
+	 *
+	 * Sets the linger time, and adjusts the work thread sleep time so that
+	 * batches are checked at least twice per linger time (and at least
+	 * every 100 milliseconds).
+	 *
+	 * \param lingerms - An integer containing the maximum time in
+	 * milliseconds a message waits in a batch, values less than 0 are
+	 * treated as 0
+	 */
+	void setLingerTime(int lingerms);
+
+	/**
+	 * \brief get the linger time
+	 * \return returns an integer containing the linger time in milliseconds
+	 */
+	int getLingerTime();
+
+ protected:
+	/**
+	 * \brief BatchProducer work function
+	 *
+	 * Sends any batches that are full or have lingered long enough.
+	 *
+	 * \return returns util::WorkState::Idle, since batches are only sent
+	 * when they are full or on the linger timer
+	 */
+	util::WorkState work() override;
+
+	/**
+	 * \brief send batches
+	 *
+	 * Remove the batches that are ready from the pending map, send them,
+	 * and queue a delivery report for each.
+	 *
+	 * \param all - A boolean flag indicating whether to send all batches
+	 * regardless of size or age
+	 * \return returns an integer containing the number of messages sent
+	 */
+	int sendBatches(bool all);
+
+ private:
+	/**
+	 * \brief a pending batch of messages for a topic
+	 */
+	struct Batch {
+		/**
+		 * \brief the messages in the batch, in the order they were added
+		 */
+		std::vector<std::string> vMessages;
+
+		/**
+		 * \brief the time the first message was added to the batch
+		 */
+		std::chrono::steady_clock::time_point tFirst;
+	};
+
+	/**
+	 * \brief the std::map of topic names to pending batches
+	 */
+	std::map<std::string, Batch> m_Batches;
+
+	/**
+	 * \brief the number of messages pending across all batches
+	 */
+	int m_iPendingCount;
+
+	/**
+	 * \brief the mutex for the pending batches
+	 */
+	std::mutex m_BatchMutex;
+
+	/**
+	 * \brief the std::queue of delivery reports
+	 */
+	std::queue<DeliveryReport> m_DeliveryReports;
+
+	/**
+	 * \brief the mutex for the delivery report queue
+	 */
+	std::mutex m_ReportMutex;
+
+	/**
+	 * \brief the mutex serializing calls to the producer
+	 */
+	std::mutex m_SendMutex;
+
+	/**
+	 * \brief the producer used to send batches
+	 */
+	util::iProducer * m_Producer;
+
+	/**
+	 * \brief the maximum number of messages in a batch
+	 */
+	int m_iBatchSize;
+
+	/**
+	 * \brief the maximum time in milliseconds a message waits in a batch
+	 */
+	int m_iLingerTime;
+};
+}  // namespace util
+#endif  // BATCHPRODUCER_H
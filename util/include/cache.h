@@ -158,6 +158,19 @@ class Cache : public util::BaseClass {
 	 */
 	virtual bool isEmpty(bool lock = true);
 
+	/**
+	 *\brief estimate cache memory usage
+	 *
+	 * Estimate the memory used by the cache and the json::Objects in it,
+	 * counting the top level values of each object and the number of values
+	 * nested in them. The estimate walks the cache, so it should be called
+	 * occasionally.
+	 * \param lock - A boolean value indicating whether to lock the mutex.
+	 * Defaults to true
+	 * \return returns the approximate number of bytes used
+	 */
+	size_t getMemoryUsage(bool lock = true);
+
 	/**
 	 *\brief load cache from disk
 	 *
@@ -0,0 +1,48 @@
+/*****************************************
+ * This file is documented for Doxygen.
+ * If you modify this file please update
+ * the comments so that Doxygen will still
+ * be able to work.
+ ****************************************/
+#ifndef CONSUMERINTERFACE_H
+#define CONSUMERINTERFACE_H
+
+#include <string>
+
+namespace util {
+
+/**
+ * \interface iConsumer
+ * \brief message consumption interface
+ *
+ * The iConsumer interface is implemented by concrete classes that
+ * retrieve messages from a message broker, providing a standardized
+ * interface that allows input classes to be used (and tested)
+ * independently of the underlying broker library.
+ */
+class iConsumer {
+ public:
+	/**
+	 * \brief iConsumer destructor
+	 *
+	 * Virtual so that a concrete class can be destroyed through the
+	 * interface.
+	 */
+	virtual ~iConsumer() {
+	}
+
+	/**
+	 * \brief Poll for a message
+	 *
+	 * This pure virtual function is implemented by a concrete class to
+	 * support retrieving the next available message.
+	 *
+	 * \param timeout - An integer containing the maximum time to wait for a
+	 * message in milliseconds, 0 to return immediately
+	 * \return Returns a std::string containing the message, or an empty
+	 * string if no message was available before the timeout
+	 */
+	virtual std::string pollString(int timeout) = 0;
+};
+}  // namespace util
+#endif  // CONSUMERINTERFACE_H
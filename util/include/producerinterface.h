@@ -0,0 +1,53 @@
+/*****************************************
+ * This file is documented for Doxygen.
+ * If you modify this file please update
+ * the comments so that Doxygen will still
+ * be able to work.
+ ****************************************/
+#ifndef PRODUCERINTERFACE_H
+#define PRODUCERINTERFACE_H
+
+#include <string>
+#include <vector>
+
+namespace util {
+
+/**
+ * \interface iProducer
+ * \brief message production interface
+ *
+ * The iProducer interface is implemented by concrete classes that
+ * deliver batches of messages to a named topic on a message broker,
+ * providing a standardized interface that allows the batching logic
+ * in util::BatchProducer to be used (and tested) independently of the
+ * underlying broker library.
+ */
+class iProducer {
+ public:
+	/**
+	 * \brief iProducer destructor
+	 *
+	 * Virtual so that a concrete class can be destroyed through the
+	 * interface.
+	 */
+	virtual ~iProducer() {
+	}
+
+	/**
+	 * \brief Send a batch of messages
+	 *
+	 * This pure virtual function is implemented by a concrete class to
+	 * support sending a batch of messages to a topic.
+	 *
+	 * \param topic - A std::string containing the name of the topic to send
+	 * the messages to
+	 * \param messages - A std::vector of std::strings containing the messages
+	 * to send, in order
+	 * \return Returns an integer value containing the number of messages that
+	 * were successfully handed to the broker
+	 */
+	virtual int sendBatch(const std::string &topic,
+							const std::vector<std::string> &messages) = 0;
+};
+}  // namespace util
+#endif  // PRODUCERINTERFACE_H
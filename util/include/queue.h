@@ -13,6 +13,7 @@
 #include <mutex>
 #include <string>
 #include <queue>
+#include <vector>
 
 namespace util {
 /**
@@ -48,6 +49,20 @@ class Queue {
 	 */
 	bool addDataToQueue(std::shared_ptr<json::Object> data, bool lock = true);
 
+	/**
+	 *\brief add a batch of data to queue
+	 *
+	 * Add the provided data to the queue in order, taking the mutex once
+	 * for the whole batch. NULL entries are skipped.
+	 * \param data - A std::vector of pointers to json::Objects to add to the
+	 * queue
+	 * \param lock - A boolean value indicating whether to lock the mutex.
+	 * Defaults to true
+	 * \return returns the number of items added to the queue
+	 */
+	int addDataToQueue(const std::vector<std::shared_ptr<json::Object>> &data,
+						bool lock = true);
+
 	/**
 	 *\brief get data from queue
 	 *
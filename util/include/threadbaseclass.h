@@ -13,6 +13,19 @@
 #include <string>
 
 namespace util {
+/**
+ * \brief util work state enumeration
+ *
+ * The WorkState enum defines the results of a single work() call, which tell
+ * the work loop whether to stop, to sleep before the next call, or to call
+ * work() again right away.
+ */
+enum class WorkState {
+	Error = -1,
+	Idle = 0,
+	OK = 1
+};
+
 /**
  * \brief util threadbaseclass class
  *
@@ -93,13 +106,62 @@ class ThreadBaseClass : public util::BaseClass {
 	 */
 	int getSleepTime();
 
+	/**
+	 * \brief set thread work batch size
+	 *
+	 * Sets the maximum number of work() calls the work thread makes between
+	 * sleeps while there is work to do
+	 */
+	void setWorkBatchSize(int batchsize);
+
+	/**
+	 * \brief get thread work batch size
+	 *
+	 * Gets the maximum number of work() calls the work thread makes between
+	 * sleeps while there is work to do
+	 * \return Returns the work batch size.
+	 */
+	int getWorkBatchSize();
+
+	/**
+	 * \brief set thread work batch time
+	 *
+	 * Sets the maximum amount of time in milliseconds the work thread spends
+	 * calling work() before it marks itself alive and yields
+	 */
+	void setWorkBatchTime(int batchtimems);
+
+	/**
+	 * \brief get thread work batch time
+	 *
+	 * Gets the maximum amount of time in milliseconds the work thread spends
+	 * calling work() before it marks itself alive and yields
+	 * \return Returns the work batch time.
+	 */
+	int getWorkBatchTime();
+
+	/**
+	 * \brief set up thread work batch from configuration
+	 *
+	 * Sets the work batch size and time from the optional WorkBatchSize and
+	 * WorkBatchTime values of a configuration, keeping the current values
+	 * for any that are not given. Called by the deriving classes' setup().
+	 * \param config - A pointer to the json::Object containing the
+	 * configuration
+	 */
+	void setupWorkBatch(json::Object *config);
+
 	/**
 	 * \brief threadbaseclass work function
 	 *
-	 * Virtual work function to be overridden by deriving classes
-	 * \return Returns true if work was successful, false otherwise
+	 * Virtual work function to be overridden by deriving classes, each call
+	 * should handle one item of work
+	 * \return Returns util::WorkState::OK if work was done,
+	 * util::WorkState::Idle if there was nothing to do, and
+	 * util::WorkState::Error if something went wrong and the work thread
+	 * should stop
 	 */
-	virtual bool work() = 0;
+	virtual WorkState work() = 0;
 
 	/**
 	 * \brief threadbaseclass is running
@@ -169,7 +231,9 @@ class ThreadBaseClass : public util::BaseClass {
 	 * \brief threadbaseclass work loop
 	 *
 	 * threadbaseclass work loop, runs while m_bRunWorkThread
-	 * is true, calls work(), reports run status with setworkcheck()
+	 * is true, calls work() until it is idle or the batch size or batch time
+	 * is reached, reports run status with setworkcheck(), and sleeps only
+	 * when work() was idle
 	 */
 	void workLoop();
 
@@ -209,6 +273,18 @@ class ThreadBaseClass : public util::BaseClass {
 	 * the work thread
 	 */
 	int m_iSleepTimeMS;
+
+	/**
+	 * \brief integer variable indicating the maximum number of work() calls
+	 * between sleeps
+	 */
+	int m_iWorkBatchSize;
+
+	/**
+	 * \brief integer variable indicating the maximum time in milliseconds
+	 * spent calling work() between sleeps
+	 */
+	int m_iWorkBatchTimeMS;
 };
 }  // namespace util
 #endif  // THREADBASECLASS_H
@@ -14,6 +14,7 @@
 #include <map>
 #include <ctime>
 #include <string>
+#include <functional>
 
 namespace util {
 /**
@@ -0,0 +1,215 @@
+#include <batchproducer.h>
+#include <logger.h>
+
+#include <algorithm>
+#include <chrono>
+#include <ctime>
+#include <map>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace util {
+
+BatchProducer::BatchProducer()
+		: util::ThreadBaseClass("batchproducer", 50) {
+	logger::log("debug", "BatchProducer::BatchProducer(): Construction.");
+
+	m_Producer = NULL;
+	m_iPendingCount = 0;
+	m_iBatchSize = 100;
+	setLingerTime(100);
+}
+
+BatchProducer::BatchProducer(util::iProducer *producer, int batchsize,
+								int lingerms)
+		: util::ThreadBaseClass("batchproducer", 50) {
+	logger::log("debug",
+				"BatchProducer::BatchProducer(): Advanced Construction.");
+
+	m_Producer = producer;
+	m_iPendingCount = 0;
+	setBatchSize(batchsize);
+	setLingerTime(lingerms);
+}
+
+BatchProducer::~BatchProducer() {
+	logger::log("debug", "BatchProducer::~BatchProducer(): Destruction.");
+
+	// stop the work thread
+	stop();
+
+	// don't drop anything that is still pending
+	flush();
+}
+
+bool BatchProducer::addMessage(const std::string &topic,
+								const std::string &message) {
+	if (topic == "") {
+		logger::log("error",
+					"BatchProducer::addMessage(): empty topic passed in.");
+		return (false);
+	}
+
+	if (message == "") {
+		logger::log("error",
+					"BatchProducer::addMessage(): empty message passed in.");
+		return (false);
+	}
+
+	std::lock_guard<std::mutex> guard(m_BatchMutex);
+
+	Batch &batch = m_Batches[topic];
+
+	// start the linger clock on the first message in a batch
+	if (batch.vMessages.empty() == true) {
+		batch.tFirst = std::chrono::steady_clock::now();
+	}
+
+	batch.vMessages.push_back(message);
+	m_iPendingCount++;
+
+	return (true);
+}
+
+int BatchProducer::flush() {
+	return (sendBatches(true));
+}
+
+bool BatchProducer::getDeliveryReport(DeliveryReport *report) {
+	if (report == NULL) {
+		return (false);
+	}
+
+	std::lock_guard<std::mutex> guard(m_ReportMutex);
+
+	if (m_DeliveryReports.empty() == true) {
+		return (false);
+	}
+
+	*report = m_DeliveryReports.front();
+	m_DeliveryReports.pop();
+
+	return (true);
+}
+
+int BatchProducer::getPendingCount() {
+	std::lock_guard<std::mutex> guard(m_BatchMutex);
+	return (m_iPendingCount);
+}
+
+int BatchProducer::getDeliveryReportCount() {
+	std::lock_guard<std::mutex> guard(m_ReportMutex);
+	return (static_cast<int>(m_DeliveryReports.size()));
+}
+
+void BatchProducer::setProducer(util::iProducer *producer) {
+	std::lock_guard<std::mutex> guard(m_SendMutex);
+	m_Producer = producer;
+}
+
+util::iProducer * BatchProducer::getProducer() {
+	std::lock_guard<std::mutex> guard(m_SendMutex);
+	return (m_Producer);
+}
+
+void BatchProducer::setBatchSize(int batchsize) {
+	std::lock_guard<std::mutex> guard(m_BatchMutex);
+	m_iBatchSize = std::max(batchsize, 1);
+}
+
+int BatchProducer::getBatchSize() {
+	std::lock_guard<std::mutex> guard(m_BatchMutex);
+	return (m_iBatchSize);
+}
+
+void BatchProducer::setLingerTime(int lingerms) {
+	m_BatchMutex.lock();
+	m_iLingerTime = std::max(lingerms, 0);
+	m_BatchMutex.unlock();
+
+	// check the batches at least twice per linger time so that no message
+	// waits much longer than the linger time, but often enough that the
+	// thread still stops promptly with a long linger time
+	setSleepTime(std::min(std::max(m_iLingerTime / 2, 1), 100));
+}
+
+int BatchProducer::getLingerTime() {
+	std::lock_guard<std::mutex> guard(m_BatchMutex);
+	return (m_iLingerTime);
+}
+
+util::WorkState BatchProducer::work() {
+	sendBatches(false);
+
+	// batches are sent on the linger timer, so always sleep until the next
+	// check
+	return (util::WorkState::Idle);
+}
+
+int BatchProducer::sendBatches(bool all) {
+	// only one thread talks to the producer at a time, this also keeps the
+	// batches for a topic in order between the work thread and flush()
+	std::lock_guard<std::mutex> sendGuard(m_SendMutex);
+
+	// collect the batches that are ready while holding the batch lock,
+	// so that adding messages is never blocked by the producer
+	std::vector<std::pair<std::string, std::vector<std::string>>> ready;
+	m_BatchMutex.lock();
+	auto now = std::chrono::steady_clock::now();
+	auto linger = std::chrono::milliseconds(m_iLingerTime);
+	for (auto &topicBatch : m_Batches) {
+		Batch &batch = topicBatch.second;
+		if (batch.vMessages.empty() == true) {
+			continue;
+		}
+
+		if ((all == true)
+				|| (static_cast<int>(batch.vMessages.size()) >= m_iBatchSize)
+				|| ((now - batch.tFirst) >= linger)) {
+			m_iPendingCount -= static_cast<int>(batch.vMessages.size());
+			ready.push_back(
+					std::make_pair(topicBatch.first, std::vector<std::string>()));
+			ready.back().second.swap(batch.vMessages);
+		}
+	}
+	m_BatchMutex.unlock();
+
+	int sent = 0;
+	for (const auto &topicMessages : ready) {
+		int count = static_cast<int>(topicMessages.second.size());
+		int delivered = 0;
+
+		if (m_Producer != NULL) {
+			try {
+				delivered = m_Producer->sendBatch(topicMessages.first,
+													topicMessages.second);
+			} catch (const std::exception &e) {
+				logger::log(
+						"error",
+						"BatchProducer::sendBatches(): Exception sending batch "
+								"to topic " + topicMessages.first + ": "
+								+ std::string(e.what()));
+				delivered = 0;
+			}
+		}
+
+		delivered = std::min(std::max(delivered, 0), count);
+		sent += delivered;
+
+		// queue the delivery report
+		DeliveryReport report;
+		report.sTopic = topicMessages.first;
+		report.iDelivered = delivered;
+		report.iFailed = count - delivered;
+		std::time(&report.tSent);
+
+		m_ReportMutex.lock();
+		m_DeliveryReports.push(report);
+		m_ReportMutex.unlock();
+	}
+
+	return (sent);
+}
+}  // namespace util
@@ -3,6 +3,7 @@
 #include <logger.h>
 #include <stringutil.h>
 #include <timeutil.h>
+#include <Memory.h>
 #include <mutex>
 #include <string>
 #include <map>
@@ -457,6 +458,29 @@ bool Cache::loadCacheFromDisk(bool lock) {
 	return (true);
 }
 
+size_t Cache::getMemoryUsage(bool lock) {
+	if (lock) {
+		m_CacheMutex.lock();
+	}
+
+	// use the glasscore estimators, so the cache is counted the same way
+	// as the data held in glass
+	size_t bytes = sizeof(Cache);
+	for (const auto &entry : m_Cache) {
+		bytes += glassutil::CMemory::mapNodeBytes() + sizeof(entry)
+				+ glassutil::CMemory::stringBytes(entry.first);
+		if (entry.second != NULL) {
+			bytes += glassutil::CMemory::jsonBytes(*entry.second);
+		}
+	}
+
+	if (lock) {
+		m_CacheMutex.unlock();
+	}
+
+	return (bytes);
+}
+
 bool Cache::isEmpty(bool lock) {
 	if (lock) {
 		m_CacheMutex.lock();
@@ -7,6 +7,7 @@
 #include <mutex>
 #include <string>
 #include <queue>
+#include <vector>
 
 namespace util {
 
@@ -37,6 +38,31 @@ bool Queue::addDataToQueue(std::shared_ptr<json::Object> data, bool lock) {
 	return (true);
 }
 
+int Queue::addDataToQueue(
+		const std::vector<std::shared_ptr<json::Object>> &data, bool lock) {
+	int count = 0;
+
+	if (lock) {
+		m_QueueMutex.lock();
+	}
+
+	// add the new data to the Queue
+	for (const auto &item : data) {
+		if (item == NULL) {
+			continue;
+		}
+
+		m_DataQueue.push(item);
+		count++;
+	}
+
+	if (lock) {
+		m_QueueMutex.unlock();
+	}
+
+	return (count);
+}
+
 std::shared_ptr<json::Object> Queue::getDataFromQueue(bool lock) {
 	if (lock) {
 		m_QueueMutex.lock();
@@ -1,6 +1,7 @@
 #include <threadbaseclass.h>
 #include <logger.h>
 #include <thread>
+#include <chrono>
 #include <string>
 
 namespace util {
@@ -11,6 +12,8 @@ ThreadBaseClass::ThreadBaseClass()
 
 	m_sThreadName = "NYI";
 	m_iSleepTimeMS = 100;
+	m_iWorkBatchSize = 1000;
+	m_iWorkBatchTimeMS = 100;
 	m_bRunWorkThread = false;
 	m_bCheckWorkThread = true;
 	m_bStarted = false;
@@ -32,6 +35,8 @@ ThreadBaseClass::ThreadBaseClass(std::string threadname, int sleeptimems)
 	std::time(&tLastCheck);
 
 	setSleepTime(sleeptimems);
+	setWorkBatchSize(1000);
+	setWorkBatchTime(100);
 }
 
 ThreadBaseClass::~ThreadBaseClass() {
@@ -197,23 +202,90 @@ int ThreadBaseClass::getSleepTime() {
 	return (m_iSleepTimeMS);
 }
 
+void ThreadBaseClass::setWorkBatchSize(int batchsize) {
+	// always do at least one unit of work per wake up
+	if (batchsize < 1) {
+		batchsize = 1;
+	}
+	m_iWorkBatchSize = batchsize;
+}
+
+int ThreadBaseClass::getWorkBatchSize() {
+	return (m_iWorkBatchSize);
+}
+
+void ThreadBaseClass::setWorkBatchTime(int batchtimems) {
+	m_iWorkBatchTimeMS = batchtimems;
+}
+
+int ThreadBaseClass::getWorkBatchTime() {
+	return (m_iWorkBatchTimeMS);
+}
+
+void ThreadBaseClass::setupWorkBatch(json::Object *config) {
+	if (config == NULL) {
+		return;
+	}
+
+	// work batch size
+	if (!(config->HasKey("WorkBatchSize"))) {
+		// work batch size is optional
+		logger::log(
+				"info",
+				"ThreadBaseClass::setupWorkBatch(): (" + m_sThreadName
+						+ ") WorkBatchSize not specified, using "
+						+ std::to_string(getWorkBatchSize()) + ".");
+	} else {
+		setWorkBatchSize((*config)["WorkBatchSize"].ToInt());
+		logger::log(
+				"info",
+				"ThreadBaseClass::setupWorkBatch(): (" + m_sThreadName
+						+ ") Using WorkBatchSize: "
+						+ std::to_string(getWorkBatchSize()) + ".");
+	}
+
+	// work batch time
+	if (!(config->HasKey("WorkBatchTime"))) {
+		// work batch time is optional
+		logger::log(
+				"info",
+				"ThreadBaseClass::setupWorkBatch(): (" + m_sThreadName
+						+ ") WorkBatchTime not specified, using "
+						+ std::to_string(getWorkBatchTime()) + ".");
+	} else {
+		setWorkBatchTime((*config)["WorkBatchTime"].ToInt());
+		logger::log(
+				"info",
+				"ThreadBaseClass::setupWorkBatch(): (" + m_sThreadName
+						+ ") Using WorkBatchTime: "
+						+ std::to_string(getWorkBatchTime()) + ".");
+	}
+}
+
 void ThreadBaseClass::workLoop() {
 	// we're running
 	m_bRunWorkThread = true;
 
 	// run until told to stop
 	while (m_bRunWorkThread) {
+		WorkState state = WorkState::Idle;
+
 		try {
-			// do our work
-			if (work() == false) {
-				// something has gone wrong
-				// break out of the loop
-				logger::log(
-						"error",
-						"ThreadBaseClass::workLoop(): Work returned false, "
-								"something's wrong, stopping thread. ("
-								+ m_sThreadName + ")");
-				break;
+			// do our work, draining up to a batch of work or a batch time
+			// worth before checking in, so that throughput isn't capped by
+			// the sleep time
+			std::chrono::steady_clock::time_point tBatchEnd =
+					std::chrono::steady_clock::now()
+							+ std::chrono::milliseconds(m_iWorkBatchTimeMS);
+			for (int i = 0; i < m_iWorkBatchSize; i++) {
+				state = work();
+
+				// stop the batch if we're idle, something has gone wrong,
+				// we've been told to stop, or we're out of time
+				if ((state != WorkState::OK) || (m_bRunWorkThread == false)
+						|| (std::chrono::steady_clock::now() >= tBatchEnd)) {
+					break;
+				}
 			}
 		} catch (const std::exception &e) {
 			logger::log(
@@ -222,11 +294,29 @@ void ThreadBaseClass::workLoop() {
 							+ std::string(e.what()));
 			break;
 		}
+
+		if (state == WorkState::Error) {
+			// something has gone wrong
+			// break out of the loop
+			logger::log(
+					"error",
+					"ThreadBaseClass::workLoop(): Work returned error, "
+							"something's wrong, stopping thread. ("
+							+ m_sThreadName + ")");
+			break;
+		}
+
 		// signal that we're still running
 		setWorkCheck();
 
-		// give up some time at the end of the loop
-		std::this_thread::sleep_for(std::chrono::milliseconds(m_iSleepTimeMS));
+		if (state == WorkState::Idle) {
+			// nothing to do, give up some time
+			std::this_thread::sleep_for(
+					std::chrono::milliseconds(m_iSleepTimeMS));
+		} else {
+			// there is more to do, just let other threads run
+			std::this_thread::yield();
+		}
 	}
 
 	logger::log(
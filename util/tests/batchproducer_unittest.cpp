@@ -0,0 +1,137 @@
+#include <gtest/gtest.h>
+#include <batchproducer.h>
+#include <producerinterface.h>
+
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#define TESTTOPIC1 "TestTopic1"
+#define TESTTOPIC2 "TestTopic2"
+#define TESTBATCHSIZE 5
+#define TESTLINGERTIME 50
+#define WAITTIME 500
+
+// mock producer that records the batches it was given
+class producerstub : public util::iProducer {
+ public:
+	producerstub() {
+		failcount = 0;
+		batchcount = 0;
+	}
+
+	int sendBatch(const std::string &topic,
+					const std::vector<std::string> &messages) override {
+		std::lock_guard<std::mutex> guard(mutex);
+		batchcount++;
+
+		int delivered = static_cast<int>(messages.size()) - failcount;
+		if (delivered < 0) {
+			delivered = 0;
+		}
+
+		for (int i = 0; i < delivered; i++) {
+			sent[topic].push_back(messages[i]);
+		}
+
+		return (delivered);
+	}
+
+	int getSentCount(const std::string &topic) {
+		std::lock_guard<std::mutex> guard(mutex);
+		return (static_cast<int>(sent[topic].size()));
+	}
+
+	std::map<std::string, std::vector<std::string>> sent;
+	int failcount;
+	int batchcount;
+	std::mutex mutex;
+};
+
+// tests to see if the batch producer batches by topic and flushes
+TEST(BatchProducerTest, FlushTest) {
+	producerstub stub;
+	util::BatchProducer TestProducer(&stub, TESTBATCHSIZE, TESTLINGERTIME);
+
+	// check configuration
+	ASSERT_EQ(TestProducer.getBatchSize(), TESTBATCHSIZE)<< "batch size";
+	ASSERT_EQ(TestProducer.getLingerTime(), TESTLINGERTIME)<< "linger time";
+	ASSERT_EQ(TestProducer.getSleepTime(), TESTLINGERTIME / 2)<< "sleep time";
+	ASSERT_TRUE(TestProducer.getProducer() == &stub)<< "producer";
+
+	// bad messages are rejected
+	ASSERT_FALSE(TestProducer.addMessage("", "message"))<< "empty topic";
+	ASSERT_FALSE(TestProducer.addMessage(TESTTOPIC1, ""))<< "empty message";
+
+	// add messages to two topics without starting the thread
+	ASSERT_TRUE(TestProducer.addMessage(TESTTOPIC1, "a"));
+	ASSERT_TRUE(TestProducer.addMessage(TESTTOPIC2, "b"));
+	ASSERT_TRUE(TestProducer.addMessage(TESTTOPIC1, "c"));
+	ASSERT_EQ(TestProducer.getPendingCount(), 3)<< "3 pending";
+	ASSERT_EQ(stub.batchcount, 0)<< "nothing sent yet";
+
+	// flush sends one batch per topic
+	ASSERT_EQ(TestProducer.flush(), 3)<< "3 sent";
+	ASSERT_EQ(TestProducer.getPendingCount(), 0)<< "none pending";
+	ASSERT_EQ(stub.batchcount, 2)<< "2 batches";
+
+	// check order within a topic
+	ASSERT_EQ(stub.sent[TESTTOPIC1].size(), 2);
+	ASSERT_STREQ(stub.sent[TESTTOPIC1][0].c_str(), "a");
+	ASSERT_STREQ(stub.sent[TESTTOPIC1][1].c_str(), "c");
+	ASSERT_STREQ(stub.sent[TESTTOPIC2][0].c_str(), "b");
+
+	// check delivery reports
+	ASSERT_EQ(TestProducer.getDeliveryReportCount(), 2)<< "2 reports";
+	util::DeliveryReport report;
+	ASSERT_TRUE(TestProducer.getDeliveryReport(&report));
+	ASSERT_STREQ(report.sTopic.c_str(), TESTTOPIC1);
+	ASSERT_EQ(report.iDelivered, 2);
+	ASSERT_EQ(report.iFailed, 0);
+	ASSERT_TRUE(TestProducer.getDeliveryReport(&report));
+	ASSERT_FALSE(TestProducer.getDeliveryReport(&report))<< "no more reports";
+	ASSERT_FALSE(TestProducer.getDeliveryReport(NULL))<< "null report";
+
+	// failed messages are reported
+	stub.failcount = 1;
+	TestProducer.addMessage(TESTTOPIC1, "d");
+	TestProducer.addMessage(TESTTOPIC1, "e");
+	ASSERT_EQ(TestProducer.flush(), 1)<< "1 sent";
+	ASSERT_TRUE(TestProducer.getDeliveryReport(&report));
+	ASSERT_EQ(report.iDelivered, 1);
+	ASSERT_EQ(report.iFailed, 1);
+}
+
+// tests to see if the batch producer sends on batch size and linger time
+TEST(BatchProducerTest, ThreadTest) {
+	producerstub stub;
+	util::BatchProducer TestProducer(&stub, TESTBATCHSIZE, TESTLINGERTIME);
+
+	ASSERT_TRUE(TestProducer.start())<< "start was successful";
+
+	// a single message is sent once it has lingered
+	TestProducer.addMessage(TESTTOPIC1, "a");
+	std::this_thread::sleep_for(std::chrono::milliseconds(WAITTIME));
+	ASSERT_EQ(stub.getSentCount(TESTTOPIC1), 1)<< "lingered message sent";
+	ASSERT_EQ(TestProducer.getPendingCount(), 0)<< "none pending";
+
+	// a full batch is sent as one batch
+	TestProducer.setLingerTime(60000);
+	for (int i = 0; i < TESTBATCHSIZE; i++) {
+		TestProducer.addMessage(TESTTOPIC2, std::to_string(i));
+	}
+	std::this_thread::sleep_for(std::chrono::milliseconds(WAITTIME));
+	ASSERT_EQ(stub.getSentCount(TESTTOPIC2), TESTBATCHSIZE)<< "batch sent";
+	ASSERT_TRUE(TestProducer.check())<< "check is true";
+
+	// a partial batch waits for the linger time
+	TestProducer.addMessage(TESTTOPIC2, "partial");
+	std::this_thread::sleep_for(std::chrono::milliseconds(WAITTIME));
+	ASSERT_EQ(TestProducer.getPendingCount(), 1)<< "partial batch pending";
+
+	ASSERT_TRUE(TestProducer.stop())<< "stop was successful";
+	ASSERT_EQ(TestProducer.flush(), 1)<< "partial batch flushed";
+	ASSERT_EQ(stub.getSentCount(TESTTOPIC2), TESTBATCHSIZE + 1);
+}
@@ -20,6 +20,8 @@ TEST(CacheTest, Construction) {
 	// assert an empty cache was created
 	ASSERT_TRUE(TestCache.isEmpty())<< "empty cache constructed";
 	ASSERT_EQ(TestCache.size(), 0)<< "cache size check";
+	ASSERT_EQ(sizeof(util::Cache), TestCache.getMemoryUsage())<<
+	"empty cache memory usage";
 
 	// assert that we're not setup
 	ASSERT_FALSE(TestCache.m_bIsSetup)<< "cache not setup";
@@ -84,6 +86,9 @@ TEST(CacheTest, CombinedTest) {
 	// assert cache hase data
 	ASSERT_FALSE(TestCache->isEmpty())<< "cache not empty";
 	ASSERT_EQ(TestCache->size(), 3)<< "cache size check";
+	ASSERT_GT(TestCache->getMemoryUsage(),
+			sizeof(util::Cache) + 3 * sizeof(json::Object))<<
+	"cache memory usage";
 
 	// assert the items in the cache
 	ASSERT_FALSE(TestCache->isInCache(""))<< "null id in cache";
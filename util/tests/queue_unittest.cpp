@@ -2,6 +2,7 @@
 #include <queue.h>
 #include <string>
 #include <memory>
+#include <vector>
 
 #define TESTDATA1 "{\"HighPass\":1.000000,\"LowPass\":1.000000}"
 #define TESTDATA2 "{\"HighPass\":2.000000,\"LowPass\":2.000000}"
@@ -59,3 +60,31 @@ TEST(QueueTest, CombinedTest) {
 	// cleanup
 	delete (TestQueue);
 }
+
+// tests to see if adding a batch to the queue is functional
+TEST(QueueTest, BatchTest) {
+	util::Queue TestQueue;
+
+	// create a batch of input data, including a NULL entry
+	std::vector<std::shared_ptr<json::Object>> batch;
+	batch.push_back(
+			std::make_shared<json::Object>(json::Deserialize(TESTDATA1)));
+	batch.push_back(NULL);
+	batch.push_back(
+			std::make_shared<json::Object>(json::Deserialize(TESTDATA2)));
+	batch.push_back(
+			std::make_shared<json::Object>(json::Deserialize(TESTDATA3)));
+
+	// add the batch, the NULL entry is skipped
+	ASSERT_EQ(TestQueue.addDataToQueue(batch), 3)<< "3 items added";
+	ASSERT_EQ(TestQueue.size(), 3)<< "3 items in queue";
+
+	// assert that the batch order was kept
+	ASSERT_STREQ(json::Serialize(*TestQueue.getDataFromQueue()).c_str(),
+					TESTDATA1);
+	ASSERT_STREQ(json::Serialize(*TestQueue.getDataFromQueue()).c_str(),
+					TESTDATA2);
+	ASSERT_STREQ(json::Serialize(*TestQueue.getDataFromQueue()).c_str(),
+					TESTDATA3);
+	ASSERT_TRUE(TestQueue.getDataFromQueue() == NULL)<< "queue empty";
+}
@@ -7,12 +7,20 @@
 #define TESTSLEEPTIMECHANGE 100
 #define TESTSTOPCOUNT 10
 #define WAITTIME 2
+#define TESTBATCHSIZE 50
+#define TESTBATCHTIME 20
+#define TESTBATCHSLEEPTIME 5000
+#define TESTBATCHSTOPCOUNT 1000
+#define TESTBATCHCONFIG "{\"Cmd\":\"Test\",\"WorkBatchSize\":25,\"WorkBatchTime\":10}"  // NOLINT
+#define TESTCONFIGBATCHSIZE 25
+#define TESTCONFIGBATCHTIME 10
 
 class threadbasestub : public util::ThreadBaseClass {
  public:
 	threadbasestub()
 			: util::ThreadBaseClass(TESTTHREADNAME, TESTSLEEPTIME) {
 		runcount = 0;
+		stopcount = TESTSTOPCOUNT;
 		startcount = false;
 		m_iCheckInterval = 1;
 		kill = false;
@@ -28,25 +36,29 @@ class threadbasestub : public util::ThreadBaseClass {
 	// count the runs
 	int runcount;
 
+	// the count to stop at
+	int stopcount;
+
  protected:
-	bool work() override {
+	util::WorkState work() override {
 		if (kill) {
-			return (false);
+			return (util::WorkState::Error);
 		}
 
 		// keep running until count
-		// is 10
-		if ((startcount) && (runcount < TESTSTOPCOUNT)) {
+		// is reached
+		if ((startcount) && (runcount < stopcount)) {
 			// increase count
 			runcount++;
 
 			// work successful
 			setWorkCheck();
-			return (true);
+			return (util::WorkState::OK);
 		}
 
+		// nothing to do
 		setWorkCheck();
-		return (true);
+		return (util::WorkState::Idle);
 	}
 };
 
@@ -162,3 +174,67 @@ TEST(ThreadBaseClassTest, KillTest) {
 	// cleanup
 	delete (TestThreadBaseStub);
 }
+
+// tests to see if the work loop drains work without sleeping
+TEST(ThreadBaseClassTest, BatchTest) {
+	// create a threadbasestub that sleeps longer than the test waits
+	threadbasestub * TestThreadBaseStub = new threadbasestub();
+	TestThreadBaseStub->setSleepTime(TESTBATCHSLEEPTIME);
+	TestThreadBaseStub->stopcount = TESTBATCHSTOPCOUNT;
+	TestThreadBaseStub->startcount = true;
+
+	// check work batch size
+	TestThreadBaseStub->setWorkBatchSize(TESTBATCHSIZE);
+	ASSERT_EQ(TestThreadBaseStub->getWorkBatchSize(), TESTBATCHSIZE)<<
+			"Check work batch size";
+
+	// check work batch time
+	TestThreadBaseStub->setWorkBatchTime(TESTBATCHTIME);
+	ASSERT_EQ(TestThreadBaseStub->getWorkBatchTime(), TESTBATCHTIME)<<
+			"Check work batch time";
+
+	// start the thread
+	ASSERT_TRUE(TestThreadBaseStub->start())<< "start was successful";
+
+	// wait a little while
+	std::this_thread::sleep_for(std::chrono::seconds(WAITTIME));
+
+	// the work was all done, since the thread only sleeps once idle
+	ASSERT_EQ(TestThreadBaseStub->runcount, TESTBATCHSTOPCOUNT)<<
+			"Check count";
+
+	// assert that check is true
+	ASSERT_TRUE(TestThreadBaseStub->check())<<
+			"TestThreadBaseStub check is true";
+
+	// stop the thread, waiting out the sleep
+	ASSERT_TRUE(TestThreadBaseStub->stop())<< "stop was successful";
+
+	// cleanup
+	delete (TestThreadBaseStub);
+}
+
+// tests to see if the work batch can be configured
+TEST(ThreadBaseClassTest, BatchConfigTest) {
+	threadbasestub * TestThreadBaseStub = new threadbasestub();
+
+	// a configuration without the keys keeps the current values
+	json::Object emptyConfig = json::Deserialize("{\"Cmd\":\"Test\"}");
+	TestThreadBaseStub->setupWorkBatch(&emptyConfig);
+	ASSERT_EQ(TestThreadBaseStub->getWorkBatchSize(), 1000)<<
+			"Check default work batch size";
+	ASSERT_EQ(TestThreadBaseStub->getWorkBatchTime(), 100)<<
+			"Check default work batch time";
+
+	// a configuration with the keys sets them
+	json::Object batchConfig = json::Deserialize(
+			std::string(TESTBATCHCONFIG));
+	TestThreadBaseStub->setupWorkBatch(&batchConfig);
+	ASSERT_EQ(TestThreadBaseStub->getWorkBatchSize(), TESTCONFIGBATCHSIZE)<<
+			"Check configured work batch size";
+	ASSERT_EQ(TestThreadBaseStub->getWorkBatchTime(), TESTCONFIGBATCHTIME)<<
+			"Check configured work batch time";
+
+	// cleanup
+	delete (TestThreadBaseStub);
+}